@@ -2,9 +2,31 @@
 #include <memory>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 #include <mutex>
+#include <thread>
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+#include "aligned_buffer.h"
+#include "simd_kernels.h"
+
+#if __has_include(<span>)
+#include <span>
+#endif
 
 /**
  * @file raii_example.cpp
@@ -25,74 +47,59 @@
  * - Ресурс захватывается в конструкторе
  * - Ресурс освобождается в деструкторе
  * - Исключения не нарушают освобождение ресурсов
+ *
+ * Память принадлежит AlignedBuffer из common/aligned_buffer.h: адрес кратен
+ * 64 байтам, а обнуление и fill() идут через SIMD-ядра. operator[] не
+ * проверяет индекс, как у std::vector, чтобы циклы над массивом
+ * векторизовались; проверенный доступ - at().
  */
 class IntArray {
 private:
-    int* data_;
-    size_t size_;
+    cpp_patterns::AlignedBuffer<int> data_;
     
 public:
-    explicit IntArray(size_t size) : size_(size) {
+    explicit IntArray(size_t size) : data_(size, cpp_patterns::kUninitialized) {
         std::cout << "IntArray: Выделяем память для " << size << " элементов" << std::endl;
-        data_ = new int[size];
         
         // Инициализируем массив
-        for (size_t i = 0; i < size_; ++i) {
-            data_[i] = 0;
-        }
+        cpp_patterns::simd::fill(data_, 0);
     }
     
     ~IntArray() {
-        std::cout << "IntArray: Освобождаем память для " << size_ << " элементов" << std::endl;
-        delete[] data_;
-        data_ = nullptr;
+        std::cout << "IntArray: Освобождаем память для " << data_.size() << " элементов" << std::endl;
     }
     
     // Запрещаем копирование для демонстрации единоличного владения
     IntArray(const IntArray&) = delete;
     IntArray& operator=(const IntArray&) = delete;
     
-    // Разрешаем перемещение
+    // Разрешаем перемещение: буфер оставляет источник пустым
     IntArray(IntArray&& other) noexcept 
-        : data_(other.data_), size_(other.size_) {
-        other.data_ = nullptr;
-        other.size_ = 0;
+        : data_(std::move(other.data_)) {
         std::cout << "IntArray: Перемещение объекта" << std::endl;
     }
     
     IntArray& operator=(IntArray&& other) noexcept {
         if (this != &other) {
-            delete[] data_;
-            data_ = other.data_;
-            size_ = other.size_;
-            other.data_ = nullptr;
-            other.size_ = 0;
+            data_ = std::move(other.data_);
             std::cout << "IntArray: Перемещение с присваиванием" << std::endl;
         }
         return *this;
     }
     
     // Методы для работы с данными
-    int& operator[](size_t index) {
-        if (index >= size_) {
-            throw std::out_of_range("Индекс вне диапазона");
-        }
-        return data_[index];
-    }
+    int& operator[](size_t index) noexcept { return data_[index]; }
+    const int& operator[](size_t index) const noexcept { return data_[index]; }
     
-    const int& operator[](size_t index) const {
-        if (index >= size_) {
-            throw std::out_of_range("Индекс вне диапазона");
-        }
-        return data_[index];
-    }
+    int& at(size_t index) { return data_.at(index); }
+    const int& at(size_t index) const { return data_.at(index); }
     
-    size_t size() const { return size_; }
+    int* data() noexcept { return data_.data(); }
+    const int* data() const noexcept { return data_.data(); }
+    size_t size() const { return data_.size(); }
     
     void fill(int value) {
-        for (size_t i = 0; i < size_; ++i) {
-            data_[i] = value;
-        }
+        cpp_patterns::simd::fill(data_, value);
     }
 };
 
@@ -186,6 +193,267 @@ public:
     const std::string& getFilename() const { return filename_; }
 };
 
+// ============================================================================
+// RAII ДЛЯ ОТОБРАЖЁННЫХ В ПАМЯТЬ ФАЙЛОВ
+// ============================================================================
+
+/**
+ * @brief Файл только для чтения, отображённый в память (mmap)
+ * 
+ * В отличие от FileManager::read() нет ни копии в std::string, ни её
+ * предварительного заполнения: view() ссылается прямо на страничный кэш.
+ * Файлы от 2 МиБ отображаются по адресу, кратному 2 МиБ, чтобы ядро
+ * могло подложить huge pages (где файловая система это поддерживает).
+ * 
+ * View действителен, пока жив объект MappedFile.
+ */
+class MappedFile {
+public:
+    // Подсказка ядру о порядке доступа (madvise)
+    enum class Access { Sequential, Random, WillNeed };
+    
+    static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+    
+private:
+    int fd_ = -1;
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    std::string filename_;
+    
+    // Резервируем size + 2 МиБ адресов и кладём файл на выровненный адрес внутри
+    static void* mapAligned(int fd, size_t size) {
+        if (size < kHugePageSize) {
+            return mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        size_t reserve = size + kHugePageSize;
+        void* region = mmap(nullptr, reserve, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (region == MAP_FAILED) {
+            return MAP_FAILED;
+        }
+        uintptr_t start = reinterpret_cast<uintptr_t>(region);
+        uintptr_t aligned = (start + kHugePageSize - 1) & ~(uintptr_t{kHugePageSize} - 1);
+        void* mapped = mmap(reinterpret_cast<void*>(aligned), size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            munmap(region, reserve);
+            return MAP_FAILED;
+        }
+        // Возвращаем ядру неиспользованные края резерва
+        size_t mappedEnd = aligned + ((size + 4095) & ~size_t{4095});
+        if (aligned > start) {
+            munmap(region, aligned - start);
+        }
+        if (start + reserve > mappedEnd) {
+            munmap(reinterpret_cast<void*>(mappedEnd), start + reserve - mappedEnd);
+        }
+        return mapped;
+    }
+    
+    void release() noexcept {
+        if (data_) {
+            munmap(data_, size_);
+            data_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+        size_ = 0;
+    }
+    
+public:
+    explicit MappedFile(const std::string& filename, Access access = Access::Sequential)
+        : filename_(filename) {
+        fd_ = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            throw std::runtime_error("Не удалось открыть файл: " + filename + ": " + std::strerror(errno));
+        }
+        struct stat info{};
+        if (fstat(fd_, &info) < 0) {
+            int error = errno;
+            release();
+            throw std::runtime_error("fstat: " + filename + ": " + std::strerror(error));
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ == 0) {
+            return;  // пустой файл отобразить нельзя, view() просто пуст
+        }
+        void* data = mapAligned(fd_, size_);
+        if (data == MAP_FAILED) {
+            int error = errno;
+            release();
+            throw std::runtime_error("mmap: " + filename + ": " + std::strerror(error));
+        }
+        data_ = data;
+        advise(access);
+#ifdef MADV_HUGEPAGE
+        if (size_ >= kHugePageSize) {
+            madvise(data_, size_, MADV_HUGEPAGE);  // подсказка; ошибка не критична
+        }
+#endif
+    }
+    
+    ~MappedFile() {
+        release();
+    }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    MappedFile(MappedFile&& other) noexcept
+        : fd_(other.fd_), data_(other.data_), size_(other.size_), filename_(std::move(other.filename_)) {
+        other.fd_ = -1;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            fd_ = other.fd_;
+            data_ = other.data_;
+            size_ = other.size_;
+            filename_ = std::move(other.filename_);
+            other.fd_ = -1;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+    
+    /**
+     * @brief Подсказать ядру порядок доступа ко всему файлу или его части
+     */
+    void advise(Access access, size_t offset = 0, size_t length = 0) const {
+        if (!data_) {
+            return;
+        }
+        int advice = access == Access::Sequential ? MADV_SEQUENTIAL
+                   : access == Access::Random     ? MADV_RANDOM
+                                                  : MADV_WILLNEED;
+        size_t begin = offset & ~size_t{4095};  // madvise требует адрес, кратный странице
+        size_t end = length == 0 ? size_ : std::min(size_, offset + length);
+        if (begin < end) {
+            madvise(static_cast<char*>(data_) + begin, end - begin, advice);
+        }
+    }
+    
+    std::string_view view() const noexcept {
+        return std::string_view(static_cast<const char*>(data_), size_);
+    }
+    
+#ifdef __cpp_lib_span
+    std::span<const std::byte> bytes() const noexcept {
+        return std::span<const std::byte>(static_cast<const std::byte*>(data_), size_);
+    }
+#endif
+    
+    size_t size() const noexcept { return size_; }
+    const std::string& getFilename() const { return filename_; }
+};
+
+/**
+ * @brief Запись в конец файла крупными выровненными блоками
+ * 
+ * append() копирует данные в блок и обращается к ядру, только когда блок
+ * заполнен; sync() - явная точка durability (fdatasync) вместо flush на
+ * каждую запись, как в FileManager::write(). Данные крупнее блока пишутся
+ * напрямую, минуя копию.
+ */
+class AppendFileWriter {
+public:
+    static constexpr size_t kDefaultBlockSize = 1024 * 1024;
+    static constexpr size_t kBlockAlignment = 4096;
+    
+private:
+    struct AlignedDelete {
+        void operator()(char* block) const noexcept {
+            ::operator delete(block, std::align_val_t{kBlockAlignment});
+        }
+    };
+    
+    int fd_ = -1;
+    std::unique_ptr<char, AlignedDelete> block_;
+    size_t blockSize_;
+    size_t used_ = 0;
+    std::string filename_;
+    
+    void writeAll(const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd_, data, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("write: " + filename_ + ": " + std::strerror(errno));
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+    
+public:
+    explicit AppendFileWriter(const std::string& filename, size_t blockSize = kDefaultBlockSize)
+        : blockSize_(blockSize), filename_(filename) {
+        if (blockSize_ == 0 || blockSize_ % kBlockAlignment != 0) {
+            throw std::invalid_argument("Размер блока должен быть кратен 4096");
+        }
+        fd_ = open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error("Не удалось открыть файл: " + filename + ": " + std::strerror(errno));
+        }
+        block_.reset(static_cast<char*>(::operator new(blockSize_, std::align_val_t{kBlockAlignment})));
+    }
+    
+    // Незаписанный хвост сбрасывается, но без fdatasync: durability - только через sync()
+    ~AppendFileWriter() {
+        if (fd_ >= 0) {
+            try {
+                flush();
+            } catch (const std::exception& e) {
+                std::cerr << "AppendFileWriter: " << e.what() << std::endl;
+            }
+            close(fd_);
+        }
+    }
+    
+    AppendFileWriter(const AppendFileWriter&) = delete;
+    AppendFileWriter& operator=(const AppendFileWriter&) = delete;
+    
+    void append(std::string_view data) {
+        if (data.size() > blockSize_ - used_) {
+            flush();
+            if (data.size() >= blockSize_) {
+                writeAll(data.data(), data.size());
+                return;
+            }
+        }
+        std::memcpy(block_.get() + used_, data.data(), data.size());
+        used_ += data.size();
+    }
+    
+    /**
+     * @brief Отдать накопленный блок ядру (страничный кэш)
+     */
+    void flush() {
+        if (used_ > 0) {
+            size_t pending = used_;
+            used_ = 0;
+            writeAll(block_.get(), pending);
+        }
+    }
+    
+    /**
+     * @brief flush() и fdatasync: после возврата данные на носителе
+     */
+    void sync() {
+        flush();
+        if (fdatasync(fd_) < 0) {
+            throw std::runtime_error("fdatasync: " + filename_ + ": " + std::strerror(errno));
+        }
+    }
+    
+    size_t buffered() const noexcept { return used_; }
+    const std::string& getFilename() const { return filename_; }
+};
+
 // ============================================================================
 // RAII ДЛЯ СИНХРОНИЗАЦИИ
 // ============================================================================
@@ -371,6 +639,122 @@ void demonstrateFileManagement() {
     }
 }
 
+/**
+ * @brief Демонстрация mmap-чтения и блочной записи
+ */
+void demonstrateMappedFiles() {
+    std::cout << "\n=== Демонстрация MappedFile и AppendFileWriter ===" << std::endl;
+    
+    const std::string filename = "raii_journal.log";
+    std::remove(filename.c_str());
+    
+    try {
+        {
+            AppendFileWriter journal(filename);
+            for (int i = 0; i < 3; ++i) {
+                journal.append("запись " + std::to_string(i) + "\n");
+            }
+            std::cout << "В буфере " << journal.buffered() << " байт, ни одного write()" << std::endl;
+            journal.sync();  // одна запись и одна точка durability
+        }
+        
+        MappedFile journal(filename);
+        std::string_view content = journal.view();  // без копии
+        std::cout << "Отображено " << journal.size() << " байт:\n" << content;
+    } catch (const std::exception& e) {
+        std::cout << "Ошибка работы с файлом: " << e.what() << std::endl;
+    }
+    std::remove(filename.c_str());
+}
+
+/**
+ * @brief Пропускная способность: FileManager против MappedFile/AppendFileWriter
+ * 
+ * Чтение идёт из страничного кэша (файл только что записан), поэтому
+ * меряется стоимость копий и системных вызовов, а не диска.
+ */
+void benchmarkFileIO(size_t maxSize) {
+    std::cout << "\n=== Бенчмарк: FileManager vs MappedFile / AppendFileWriter ===" << std::endl;
+    
+    const std::string filename = "raii_bench.bin";
+    const size_t chunk = 4096;
+    const std::string records(chunk, 'r');
+    
+    struct statvfs fs{};
+    size_t freeBytes = statvfs(".", &fs) == 0 ? static_cast<size_t>(fs.f_bavail) * fs.f_frsize : 0;
+    
+    auto mbps = [](size_t bytes, std::chrono::steady_clock::duration elapsed) {
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        return static_cast<size_t>(static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds);
+    };
+    
+    for (size_t size : {size_t{1} << 10, size_t{1} << 16, size_t{1} << 20, size_t{1} << 26,
+                        size_t{1} << 30, size_t{4} << 30}) {
+        if (size > maxSize || size * 2 > freeBytes) {
+            std::cout << "  " << size / 1024 << " КиБ: пропущен (лимит " << maxSize / (1024 * 1024)
+                      << " МиБ или мало места)" << std::endl;
+            continue;
+        }
+        const size_t recordSize = std::min(chunk, size);
+        const std::string_view record(records.data(), recordSize);
+        const size_t count = size / recordSize;
+        const size_t rounds = std::max<size_t>(1, (64u << 20) / size);  // мелкие файлы - много раз
+        const size_t total = size * rounds;
+        
+        // Запись: flush на каждую запись против блоков по 1 МиБ
+        std::ofstream(filename, std::ios::trunc).close();  // FileManager открывает только существующий файл
+        auto start = std::chrono::steady_clock::now();
+        {
+            FileManager file(filename);
+            std::string piece(record);
+            for (size_t i = 0; i < count * rounds; ++i) file.write(piece);
+        }
+        size_t fstreamWrite = mbps(total, std::chrono::steady_clock::now() - start);
+        
+        std::remove(filename.c_str());
+        start = std::chrono::steady_clock::now();
+        {
+            AppendFileWriter writer(filename);
+            for (size_t i = 0; i < count * rounds; ++i) writer.append(record);
+            writer.flush();
+        }
+        size_t appendWrite = mbps(total, std::chrono::steady_clock::now() - start);
+        
+        // Файл ровно size байт для чтения
+        std::remove(filename.c_str());
+        {
+            AppendFileWriter writer(filename);
+            for (size_t i = 0; i < count; ++i) writer.append(record);
+        }
+        
+        // Чтение с подсчётом суммы, чтобы обе стороны коснулись каждой кэш-линии
+        size_t checksum = 0;
+        start = std::chrono::steady_clock::now();
+        {
+            FileManager file(filename);
+            for (size_t r = 0; r < rounds; ++r) {
+                std::string content = file.read();
+                for (size_t i = 0; i < content.size(); i += 64) checksum += static_cast<unsigned char>(content[i]);
+            }
+        }
+        size_t fstreamRead = mbps(total, std::chrono::steady_clock::now() - start);
+        
+        start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            MappedFile file(filename);
+            std::string_view content = file.view();
+            for (size_t i = 0; i < content.size(); i += 64) checksum += static_cast<unsigned char>(content[i]);
+        }
+        size_t mappedRead = mbps(total, std::chrono::steady_clock::now() - start);
+        
+        std::cout << "  " << size / 1024 << " КиБ: запись fstream+flush " << fstreamWrite
+                  << " МБ/с, AppendFileWriter " << appendWrite
+                  << " МБ/с; чтение fstream " << fstreamRead << " МБ/с, mmap " << mappedRead
+                  << " МБ/с (сумма " << checksum << ")" << std::endl;
+    }
+    std::remove(filename.c_str());
+}
+
 /**
  * @brief Демонстрация синхронизации
  */
@@ -450,11 +834,72 @@ void demonstrateMoveSemantics() {
     // array2 владеет ресурсами
 }
 
+/**
+ * @brief Выровненные буферы и SIMD-ядра вместо ручных циклов над new int[]
+ */
+void demonstrateAlignedBuffers() {
+    std::cout << "\n=== Демонстрация AlignedBuffer и SIMD-ядер ===" << std::endl;
+    using namespace cpp_patterns;
+    
+    std::cout << "Уровни SIMD процессора:";
+    for (simd::SimdLevel level : simd::supportedLevels()) {
+        std::cout << " " << simd::simdLevelName(level);
+    }
+    std::cout << ", выбран " << simd::simdLevelName(simd::activeKernels().level) << std::endl;
+    
+    // Источник целиком перезаписывается fill, поэтому обнулять его незачем
+    constexpr size_t rows = 1024;
+    constexpr size_t cols = 1024;
+    AlignedBuffer<float> samples(rows * cols, kUninitialized);
+    AlignedBuffer<float> scaled(rows * cols, kUninitialized);
+    std::cout << "Адрес буфера по модулю 64: "
+              << reinterpret_cast<uintptr_t>(samples.data()) % AlignedBuffer<float>::alignment << std::endl;
+    
+    simd::fill(samples, 1.5f);
+    
+    // Цикл с проверкой индекса на каждом элементе - как старый IntArray::operator[]
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < samples.size(); ++i) {
+        scaled.at(i) = samples.at(i) * 2.0f + 0.5f;
+    }
+    auto checked = std::chrono::steady_clock::now() - start;
+    
+    start = std::chrono::steady_clock::now();
+    simd::transform(scaled, samples, 2.0f, 0.5f);
+    auto vectorized = std::chrono::steady_clock::now() - start;
+    
+    auto micros = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    };
+    std::cout << "transform 1M float: at() " << micros(checked) << " мкс, SIMD " << micros(vectorized)
+              << " мкс (первый проход включает page faults)" << std::endl;
+    
+    // Двумерное представление без копирования
+    auto grid = scaled.as2D(rows, cols);
+    std::cout << "grid(3, 5) = " << grid(3, 5) << std::endl;
+    
+    try {
+        scaled.at(scaled.size());
+    } catch (const std::out_of_range& e) {
+        std::cout << "at(): " << e.what() << std::endl;
+    }
+    
+    HugePageBuffer<float> large(4 * rows * cols);
+    std::cout << "HugePageBuffer " << large.sizeBytes() / (1024 * 1024) << " МиБ, MADV_HUGEPAGE: "
+              << (large.hugePagesRequested() ? "принят" : "нет") << std::endl;
+}
+
 // ============================================================================
 // ОСНОВНАЯ ФУНКЦИЯ
 // ============================================================================
 
-int main() {
+// Необязательный аргумент - верхний предел размера файла в бенчмарке, МиБ (до 4096)
+int main(int argc, char* argv[]) {
+    size_t benchmarkLimit = size_t{256} << 20;
+    if (argc > 1) {
+        benchmarkLimit = static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) << 20;
+    }
+    
     std::cout << "🏗️ Демонстрация принципа RAII (Resource Acquisition Is Initialization)" << std::endl;
     std::cout << std::string(70, '=') << std::endl;
     
@@ -463,6 +908,9 @@ int main() {
     demonstrateSynchronization();
     demonstrateExceptionSafety();
     demonstrateMoveSemantics();
+    demonstrateMappedFiles();
+    demonstrateAlignedBuffers();
+    benchmarkFileIO(benchmarkLimit);
     
     std::cout << "\n✅ Демонстрация RAII завершена!" << std::endl;
     std::cout << "Ключевые принципы:" << std::endl;
@@ -15,6 +15,21 @@
 #include <functional>
 #include <map>
 #include <algorithm>
+#include <unordered_map>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <climits>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <limits>
+#include <streambuf>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
 
 /**
  * @brief Математическая формализация OCP
@@ -105,6 +120,73 @@ private:
  * без изменения существующего кода.
  */
 
+/**
+ * @brief Таблица валют расчёта: код -> компактный id и курс к USD
+ * 
+ * Строится один раз на расчёт; в пакетном режиме платежи ссылаются на
+ * валюту по id, а поддержка валюты стратегией - это бит в маске.
+ */
+class CurrencyTable {
+private:
+    std::vector<std::string> codes_;
+    std::vector<double> toUsd_;
+    
+public:
+    static constexpr size_t kMaxCurrencies = 64;
+    
+    uint16_t add(const std::string& code, double rateToUsd) {
+        if (codes_.size() == kMaxCurrencies) {
+            throw std::length_error("CurrencyTable: не более 64 валют");
+        }
+        codes_.push_back(code);
+        toUsd_.push_back(rateToUsd);
+        return static_cast<uint16_t>(codes_.size() - 1);
+    }
+    
+    uint16_t id(const std::string& code) const {
+        auto it = std::find(codes_.begin(), codes_.end(), code);
+        if (it == codes_.end()) {
+            throw std::invalid_argument("Неизвестная валюта: " + code);
+        }
+        return static_cast<uint16_t>(it - codes_.begin());
+    }
+    
+    const std::string& code(uint16_t id) const { return codes_[id]; }
+    double toUsd(uint16_t id) const { return toUsd_[id]; }
+    size_t size() const { return codes_.size(); }
+};
+
+/**
+ * @brief Платёж в пакете: стратегия и валюта уже разрешены в индексы
+ */
+struct PaymentRequest {
+    uint32_t strategy;  // индекс из PaymentProcessor::resolveStrategy()
+    uint16_t currency;  // id из CurrencyTable
+    double amount;
+};
+
+enum class PaymentStatus : uint8_t {
+    Approved,
+    Declined,
+    UnsupportedCurrency,
+    UnknownStrategy
+};
+
+struct PaymentResult {
+    PaymentStatus status = PaymentStatus::Declined;
+    double fee = 0.0;
+};
+
+/**
+ * @brief Состояние стратегии на время пакета: то, что не зависит от платежа
+ */
+struct BatchSession {
+    uint64_t supportedCurrencies = 0;  // бит i - валюта с id i
+    bool accountValid = false;         // проверка реквизитов/аутентификация - раз на пакет
+    double limit = 0.0;
+    double feeRate = 0.0;
+};
+
 // Абстрактный класс для стратегии платежей
 class PaymentStrategy {
 public:
@@ -115,6 +197,15 @@ public:
     virtual double getProcessingFee() const = 0;
     virtual bool supportsCurrency(const std::string& currency) const = 0;
     virtual std::vector<std::string> getSupportedCurrencies() const = 0;
+    
+    /**
+     * @brief Точка расширения для пакетного режима
+     * 
+     * Стратегия заполняет проверки, не зависящие от конкретного платежа
+     * (реквизиты, лимит, комиссия). Маску валют заполняет процессор.
+     * Стратегии без переопределения обрабатываются поштучно.
+     */
+    virtual bool openBatchSession(BatchSession& /*session*/) { return false; }
 };
 
 // Конкретные реализации для разных типов платежей
@@ -125,6 +216,9 @@ private:
     std::string cvv;
     
 public:
+    // Лимит платежа: общий для поштучной проверки и пакетной сессии
+    static constexpr double kLimit = 10000.0;
+    
     CreditCardPayment(const std::string& card, const std::string& expiry, const std::string& cvvCode)
         : cardNumber(card), expiryDate(expiry), cvv(cvvCode) {}
     
@@ -166,6 +260,13 @@ public:
         return {"USD", "EUR", "GBP", "JPY"};
     }
     
+    bool openBatchSession(BatchSession& session) override {
+        session.accountValid = validateCard();
+        session.limit = kLimit;
+        session.feeRate = getProcessingFee();
+        return true;
+    }
+    
 private:
     bool validateCard() {
         // Упрощенная валидация
@@ -174,7 +275,7 @@ private:
     
     bool checkLimits(double amount) {
         // Упрощенная проверка лимитов
-        return amount <= 10000.0;
+        return amount <= kLimit;
     }
 };
 
@@ -184,6 +285,8 @@ private:
     std::string password;
     
 public:
+    static constexpr double kLimit = 5000.0;
+    
     PayPalPayment(const std::string& emailAddr, const std::string& pass)
         : email(emailAddr), password(pass) {}
     
@@ -225,6 +328,13 @@ public:
         return {"USD", "EUR", "GBP", "CAD", "AUD", "JPY"};
     }
     
+    bool openBatchSession(BatchSession& session) override {
+        session.accountValid = authenticate();
+        session.limit = kLimit;
+        session.feeRate = getProcessingFee();
+        return true;
+    }
+    
 private:
     bool authenticate() {
         // Упрощенная аутентификация
@@ -233,7 +343,7 @@ private:
     
     bool checkBalance(double amount) {
         // Упрощенная проверка баланса
-        return amount <= 5000.0;
+        return amount <= kLimit;
     }
 };
 
@@ -244,6 +354,8 @@ private:
     std::string bankName;
     
 public:
+    static constexpr double kLimit = 50000.0;
+    
     BankTransferPayment(const std::string& account, const std::string& routing, const std::string& bank)
         : accountNumber(account), routingNumber(routing), bankName(bank) {}
     
@@ -285,6 +397,13 @@ public:
         return {"USD", "EUR", "GBP", "CAD", "AUD", "JPY", "CHF", "SEK", "NOK", "DKK"};
     }
     
+    bool openBatchSession(BatchSession& session) override {
+        session.accountValid = validateBankAccount();
+        session.limit = kLimit;
+        session.feeRate = getProcessingFee();
+        return true;
+    }
+    
 private:
     bool validateBankAccount() {
         // Упрощенная валидация
@@ -293,7 +412,7 @@ private:
     
     bool checkBankLimits(double amount) {
         // Упрощенная проверка лимитов
-        return amount <= 50000.0;
+        return amount <= kLimit;
     }
 };
 
@@ -304,6 +423,8 @@ private:
     std::string cryptoType;
     
 public:
+    static constexpr double kLimit = 100.0;  // в единицах криптовалюты
+    
     CryptocurrencyPayment(const std::string& wallet, const std::string& crypto)
         : walletAddress(wallet), cryptoType(crypto) {}
     
@@ -345,6 +466,13 @@ public:
         return {cryptoType};
     }
     
+    bool openBatchSession(BatchSession& session) override {
+        session.accountValid = validateWallet();
+        session.limit = kLimit;
+        session.feeRate = getProcessingFee();
+        return true;
+    }
+    
 private:
     bool validateWallet() {
         // Упрощенная валидация адреса кошелька
@@ -353,7 +481,7 @@ private:
     
     bool checkCryptoBalance(double amount) {
         // Упрощенная проверка баланса
-        return amount <= 100.0; // Лимит в криптовалюте
+        return amount <= kLimit;
     }
 };
 
@@ -405,6 +533,13 @@ public:
         return {"USD", "EUR", "GBP", "CAD", "AUD", "JPY", "CHF"};
     }
     
+    bool openBatchSession(BatchSession& session) override {
+        session.accountValid = validateDevice() && biometricAuth();
+        session.limit = std::numeric_limits<double>::infinity();
+        session.feeRate = getProcessingFee();
+        return true;
+    }
+    
 private:
     bool validateDevice() {
         // Упрощенная валидация устройства
@@ -417,10 +552,90 @@ private:
     }
 };
 
+/**
+ * @brief Постоянные потоки пакетного режима
+ * 
+ * Потоки создаются при первом пакете, которому они нужны, и живут до
+ * разрушения объекта: следующие пакеты не платят за создание и join
+ * потоков. run() выполняет job(w) для w = 0..count-1, где w = 0 -
+ * вызывающий поток, и возвращается, когда все части завершены.
+ */
+class BatchWorkers {
+public:
+    BatchWorkers() = default;
+    BatchWorkers(const BatchWorkers&) = delete;
+    BatchWorkers& operator=(const BatchWorkers&) = delete;
+    
+    ~BatchWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+    
+    void run(unsigned count, const std::function<void(unsigned)>& job) {
+        std::lock_guard<std::mutex> serial(runMutex_);  // пакеты по очереди
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (threads_.size() + 1 < count) {
+                unsigned id = static_cast<unsigned>(threads_.size()) + 1;
+                threads_.emplace_back([this, id, seen = generation_] { loop(id, seen); });
+            }
+            job_ = &job;
+            active_ = count;
+            pending_ = count - 1;
+            ++generation_;
+        }
+        wake_.notify_all();
+        job(0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        job_ = nullptr;
+    }
+    
+private:
+    void loop(unsigned id, uint64_t seen) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            if (id >= active_) {
+                continue;  // пакету хватило меньшего числа потоков
+            }
+            const auto* job = job_;
+            lock.unlock();
+            (*job)(id);
+            lock.lock();
+            if (--pending_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+    
+    std::mutex runMutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::vector<std::thread> threads_;
+    const std::function<void(unsigned)>* job_ = nullptr;
+    unsigned active_ = 0;
+    unsigned pending_ = 0;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+};
+
 // Класс для обработки платежей (открыт для расширения, закрыт для модификации)
 class PaymentProcessor {
 private:
     std::vector<std::unique_ptr<PaymentStrategy>> strategies;
+    std::unique_ptr<BatchWorkers> workers;  // создаётся при первом многопоточном пакете
     
 public:
     void addPaymentStrategy(std::unique_ptr<PaymentStrategy> strategy) {
@@ -471,6 +686,144 @@ public:
         }
     }
     
+    /**
+     * @brief Разрешить тип платежа в индекс стратегии для PaymentRequest
+     */
+    uint32_t resolveStrategy(const std::string& paymentType) const {
+        for (size_t i = 0; i < strategies.size(); ++i) {
+            if (strategies[i]->getPaymentType() == paymentType) {
+                return static_cast<uint32_t>(i);
+            }
+        }
+        throw std::invalid_argument("Стратегия платежа '" + paymentType + "' не найдена");
+    }
+    
+    struct SettlementSummary {
+        size_t approved = 0;
+        size_t declined = 0;
+        size_t unsupportedCurrency = 0;
+        size_t unknownStrategy = 0;
+        double feesUsd = 0.0;
+        
+        void merge(const SettlementSummary& other) {
+            approved += other.approved;
+            declined += other.declined;
+            unsupportedCurrency += other.unsupportedCurrency;
+            unknownStrategy += other.unknownStrategy;
+            feesUsd += other.feesUsd;
+        }
+    };
+    
+    /**
+     * @brief Пакетный расчёт: группировка по стратегии, сессия на группу, параллельное исполнение
+     * 
+     * results должен быть предвыделен (size() >= payments.size()); results[i]
+     * соответствует payments[i]. Стратегии с openBatchSession() считаются
+     * параллельно на threads потоках (вызывающий и постоянные BatchWorkers);
+     * остальные - построчно через processPayment() в вызывающем потоке.
+     */
+    SettlementSummary processBatch(const std::vector<PaymentRequest>& payments, const CurrencyTable& currencies,
+                                   std::vector<PaymentResult>& results,
+                                   unsigned threads = std::max(1u, std::thread::hardware_concurrency())) {
+        if (results.size() < payments.size()) {
+            throw std::invalid_argument("processBatch: results должен быть предвыделен под все платежи");
+        }
+        
+        // Подготовка на пакет: маска валют и проверки реквизитов - один раз на стратегию
+        const size_t strategyCount = strategies.size();
+        std::vector<BatchSession> sessions(strategyCount);
+        std::vector<uint8_t> batched(strategyCount, 0);
+        for (size_t s = 0; s < strategyCount; ++s) {
+            batched[s] = strategies[s]->openBatchSession(sessions[s]);
+            for (uint16_t c = 0; c < currencies.size(); ++c) {
+                if (strategies[s]->supportsCurrency(currencies.code(c))) {
+                    sessions[s].supportedCurrencies |= uint64_t{1} << c;
+                }
+            }
+        }
+        
+        // Группировка подсчётом: order - индексы платежей, сгруппированные по стратегии
+        const size_t unknownBucket = strategyCount;
+        std::vector<uint32_t> offsets(strategyCount + 2, 0);
+        for (const auto& p : payments) {
+            ++offsets[std::min<size_t>(p.strategy, unknownBucket) + 1];
+        }
+        for (size_t b = 1; b < offsets.size(); ++b) {
+            offsets[b] += offsets[b - 1];
+        }
+        std::vector<uint32_t> order(payments.size());
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (uint32_t i = 0; i < payments.size(); ++i) {
+            order[cursor[std::min<size_t>(payments[i].strategy, unknownBucket)]++] = i;
+        }
+        
+        // Задачи: куски групп пакетных стратегий
+        struct Task {
+            uint32_t strategy;
+            uint32_t begin;
+            uint32_t end;
+        };
+        constexpr uint32_t kTaskSize = 16 * 1024;
+        std::vector<Task> tasks;
+        for (uint32_t s = 0; s < strategyCount; ++s) {
+            if (!batched[s]) continue;
+            for (uint32_t b = offsets[s]; b < offsets[s + 1]; b += kTaskSize) {
+                tasks.push_back({s, b, std::min(b + kTaskSize, offsets[s + 1])});
+            }
+        }
+        
+        unsigned workerCount = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(tasks.size())));
+        std::vector<SettlementSummary> partial(workerCount);
+        std::atomic<size_t> nextTask{0};
+        std::function<void(unsigned)> worker = [&](unsigned w) {
+            SettlementSummary& local = partial[w];
+            for (size_t t; (t = nextTask.fetch_add(1, std::memory_order_relaxed)) < tasks.size();) {
+                const Task& task = tasks[t];
+                settleGroup(sessions[task.strategy], currencies, payments, order.data() + task.begin,
+                            task.end - task.begin, results, local);
+            }
+        };
+        if (workerCount == 1) {
+            worker(0);
+        } else {
+            if (!workers) {
+                workers = std::make_unique<BatchWorkers>();
+            }
+            workers->run(workerCount, worker);
+        }
+        
+        SettlementSummary summary;
+        for (const auto& p : partial) {
+            summary.merge(p);
+        }
+        
+        // Стратегии без пакетного режима и неизвестные стратегии
+        for (uint32_t k = offsets[unknownBucket]; k < offsets[unknownBucket + 1]; ++k) {
+            results[order[k]] = {PaymentStatus::UnknownStrategy, 0.0};
+            ++summary.unknownStrategy;
+        }
+        for (uint32_t s = 0; s < strategyCount; ++s) {
+            if (batched[s]) continue;
+            for (uint32_t k = offsets[s]; k < offsets[s + 1]; ++k) {
+                const auto& p = payments[order[k]];
+                PaymentResult& r = results[order[k]];
+                const std::string& code = currencies.code(p.currency);
+                if (!strategies[s]->supportsCurrency(code)) {
+                    r = {PaymentStatus::UnsupportedCurrency, 0.0};
+                    ++summary.unsupportedCurrency;
+                } else if (strategies[s]->processPayment(p.amount, code, {})) {
+                    r = {PaymentStatus::Approved, p.amount * strategies[s]->getProcessingFee()};
+                    ++summary.approved;
+                    summary.feesUsd += r.fee * currencies.toUsd(p.currency);
+                } else {
+                    r = {PaymentStatus::Declined, 0.0};
+                    ++summary.declined;
+                }
+            }
+        }
+        return summary;
+    }
+    
 private:
     PaymentStrategy* findStrategy(const std::string& paymentType) {
         for (const auto& strategy : strategies) {
@@ -480,6 +833,29 @@ private:
         }
         return nullptr;
     }
+    
+    /**
+     * @brief Ядро пакетного режима: одна стратегия, без строк и виртуальных вызовов
+     */
+    static void settleGroup(const BatchSession& session, const CurrencyTable& currencies,
+                            const std::vector<PaymentRequest>& payments, const uint32_t* indices, size_t count,
+                            std::vector<PaymentResult>& results, SettlementSummary& summary) {
+        for (size_t k = 0; k < count; ++k) {
+            const PaymentRequest& p = payments[indices[k]];
+            PaymentResult& r = results[indices[k]];
+            if (((session.supportedCurrencies >> p.currency) & 1) == 0) {
+                r = {PaymentStatus::UnsupportedCurrency, 0.0};
+                ++summary.unsupportedCurrency;
+            } else if (!session.accountValid || p.amount > session.limit) {
+                r = {PaymentStatus::Declined, 0.0};
+                ++summary.declined;
+            } else {
+                r = {PaymentStatus::Approved, p.amount * session.feeRate};
+                ++summary.approved;
+                summary.feesUsd += r.fee * currencies.toUsd(p.currency);
+            }
+        }
+    }
 };
 
 // ============================================================================
@@ -535,14 +911,21 @@ public:
     }
 };
 
+class ColumnarPlan;
+
 /**
  * @brief Соблюдение OCP: Расширяемый фильтр
+ * 
+ * compileInto() - необязательная точка расширения для колоночного движка:
+ * критерий, который умеет выразить себя через колоночные предикаты,
+ * переопределяет её. Остальные критерии по-прежнему работают через matches().
  */
 class FilterCriteria {
 public:
     virtual ~FilterCriteria() = default;
     virtual bool matches(const BadDataFilter::Employee& employee) const = 0;
     virtual std::string getDescription() const = 0;
+    virtual bool compileInto(ColumnarPlan& /*plan*/) const { return false; }
 };
 
 class NameFilter : public FilterCriteria {
@@ -556,6 +939,8 @@ public:
         return employee.name.find(namePattern) != std::string::npos;
     }
     
+    bool compileInto(ColumnarPlan& plan) const override;
+    
     std::string getDescription() const override {
         return "Имя содержит: " + namePattern;
     }
@@ -573,6 +958,8 @@ public:
         return employee.age >= minAge && employee.age <= maxAge;
     }
     
+    bool compileInto(ColumnarPlan& plan) const override;
+    
     std::string getDescription() const override {
         return "Возраст от " + std::to_string(minAge) + " до " + std::to_string(maxAge);
     }
@@ -590,6 +977,8 @@ public:
         return employee.salary >= minSalary && employee.salary <= maxSalary;
     }
     
+    bool compileInto(ColumnarPlan& plan) const override;
+    
     std::string getDescription() const override {
         return "Зарплата от $" + std::to_string(static_cast<int>(minSalary)) + 
                " до $" + std::to_string(static_cast<int>(maxSalary));
@@ -608,6 +997,8 @@ public:
         return employee.department == department;
     }
     
+    bool compileInto(ColumnarPlan& plan) const override;
+    
     std::string getDescription() const override {
         return "Отдел: " + department;
     }
@@ -627,6 +1018,8 @@ public:
         return estimatedExperience >= minYears;
     }
     
+    bool compileInto(ColumnarPlan& plan) const override;
+    
     std::string getDescription() const override {
         return "Стаж не менее " + std::to_string(minYears) + " лет";
     }
@@ -657,6 +1050,447 @@ public:
     }
 };
 
+// ============================================================================
+// ПРИМЕР 3: КОЛОНОЧНЫЙ ДВИЖОК ФИЛЬТРАЦИИ ПОВЕРХ FilterCriteria
+// ============================================================================
+
+/**
+ * @brief Колоночное (SoA) хранилище сотрудников
+ * 
+ * Каждое поле лежит в отдельном непрерывном массиве, поэтому предикат по
+ * возрасту читает только 4 байта на строку вместо всей структуры Employee.
+ * Имена хранятся в одном буфере со смещениями, отделы - словарно
+ * закодированными идентификаторами.
+ */
+class EmployeeColumns {
+private:
+    std::string nameData;
+    std::vector<uint32_t> nameOffsets{0};
+    std::vector<int32_t> ages;
+    std::vector<double> salaries;
+    std::vector<uint16_t> departmentIds;
+    std::vector<std::string> departmentDictionary;
+    std::unordered_map<std::string, uint16_t> departmentIndex;
+    
+public:
+    static EmployeeColumns fromRows(const std::vector<BadDataFilter::Employee>& rows) {
+        EmployeeColumns columns;
+        columns.reserve(rows.size());
+        for (const auto& emp : rows) {
+            columns.append(emp);
+        }
+        return columns;
+    }
+    
+    void reserve(size_t rows) {
+        nameOffsets.reserve(rows + 1);
+        ages.reserve(rows);
+        salaries.reserve(rows);
+        departmentIds.reserve(rows);
+    }
+    
+    void append(const BadDataFilter::Employee& emp) {
+        nameData += emp.name;
+        nameOffsets.push_back(static_cast<uint32_t>(nameData.size()));
+        ages.push_back(emp.age);
+        salaries.push_back(emp.salary);
+        
+        auto it = departmentIndex.find(emp.department);
+        if (it == departmentIndex.end()) {
+            if (departmentDictionary.size() > UINT16_MAX) {
+                throw std::length_error("Слишком много отделов для 16-битного словаря");
+            }
+            auto id = static_cast<uint16_t>(departmentDictionary.size());
+            departmentDictionary.push_back(emp.department);
+            it = departmentIndex.emplace(emp.department, id).first;
+        }
+        departmentIds.push_back(it->second);
+    }
+    
+    size_t size() const { return ages.size(); }
+    
+    const int32_t* ageData() const { return ages.data(); }
+    const double* salaryData() const { return salaries.data(); }
+    const uint16_t* departmentData() const { return departmentIds.data(); }
+    const std::string& names() const { return nameData; }
+    const std::vector<uint32_t>& offsets() const { return nameOffsets; }
+    
+    /**
+     * @brief Идентификатор отдела в словаре или -1, если такого отдела нет
+     */
+    int findDepartment(const std::string& department) const {
+        auto it = departmentIndex.find(department);
+        return it == departmentIndex.end() ? -1 : it->second;
+    }
+    
+    BadDataFilter::Employee row(size_t i) const {
+        return {nameData.substr(nameOffsets[i], nameOffsets[i + 1] - nameOffsets[i]),
+                ages[i], salaries[i], departmentDictionary[departmentIds[i]]};
+    }
+};
+
+/**
+ * @brief Битовая карта выборки: бит i = 1, если строка i проходит все предикаты
+ */
+class SelectionBitmap {
+private:
+    std::vector<uint64_t> words;
+    size_t rows = 0;
+    
+public:
+    explicit SelectionBitmap(size_t n) : words((n + 63) / 64, ~uint64_t{0}), rows(n) {
+        if (n % 64 != 0) {
+            words.back() = (uint64_t{1} << (n % 64)) - 1;
+        }
+    }
+    
+    size_t size() const { return rows; }
+    size_t wordCount() const { return words.size(); }
+    uint64_t& word(size_t w) { return words[w]; }
+    uint64_t word(size_t w) const { return words[w]; }
+    
+    void clear() { std::fill(words.begin(), words.end(), 0); }
+    
+    size_t count() const {
+        size_t total = 0;
+        for (uint64_t w : words) {
+            total += static_cast<size_t>(__builtin_popcountll(w));
+        }
+        return total;
+    }
+    
+    template<typename Fn>
+    void forEachSet(Fn&& fn) const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            uint64_t bits = words[w];
+            while (bits != 0) {
+                fn(w * 64 + static_cast<size_t>(__builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+};
+
+/**
+ * @brief SIMD-ядра: каждое превращает 64 значения колонки в 64-битную маску
+ * 
+ * AVX2 используется, если компилятор собирает под него (-mavx2/-march=native),
+ * иначе SSE2 (базовый для x86-64), иначе скалярный цикл, который компилятор
+ * может автовекторизовать сам.
+ */
+namespace columnar_kernels {
+
+inline uint64_t int32RangeMask64(const int32_t* values, int32_t lo, int32_t hi) {
+    uint64_t mask = 0;
+#if defined(__AVX2__)
+    const __m256i vlo = _mm256_set1_epi32(lo);
+    const __m256i vhi = _mm256_set1_epi32(hi);
+    for (int i = 0; i < 64; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(vlo, v), _mm256_cmpgt_epi32(v, vhi));
+        auto bits = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(outside)));
+        mask |= static_cast<uint64_t>(~bits & 0xFFu) << i;
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i vlo = _mm_set1_epi32(lo);
+    const __m128i vhi = _mm_set1_epi32(hi);
+    for (int i = 0; i < 64; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        __m128i outside = _mm_or_si128(_mm_cmplt_epi32(v, vlo), _mm_cmpgt_epi32(v, vhi));
+        auto bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(outside)));
+        mask |= static_cast<uint64_t>(~bits & 0xFu) << i;
+    }
+#else
+    for (int i = 0; i < 64; ++i) {
+        mask |= static_cast<uint64_t>(values[i] >= lo && values[i] <= hi) << i;
+    }
+#endif
+    return mask;
+}
+
+inline uint64_t doubleRangeMask64(const double* values, double lo, double hi) {
+    uint64_t mask = 0;
+#if defined(__AVX2__)
+    const __m256d vlo = _mm256_set1_pd(lo);
+    const __m256d vhi = _mm256_set1_pd(hi);
+    for (int i = 0; i < 64; i += 4) {
+        __m256d v = _mm256_loadu_pd(values + i);
+        __m256d inside = _mm256_and_pd(_mm256_cmp_pd(v, vlo, _CMP_GE_OQ), _mm256_cmp_pd(v, vhi, _CMP_LE_OQ));
+        mask |= static_cast<uint64_t>(_mm256_movemask_pd(inside)) << i;
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128d vlo = _mm_set1_pd(lo);
+    const __m128d vhi = _mm_set1_pd(hi);
+    for (int i = 0; i < 64; i += 2) {
+        __m128d v = _mm_loadu_pd(values + i);
+        __m128d inside = _mm_and_pd(_mm_cmpge_pd(v, vlo), _mm_cmple_pd(v, vhi));
+        mask |= static_cast<uint64_t>(_mm_movemask_pd(inside)) << i;
+    }
+#else
+    for (int i = 0; i < 64; ++i) {
+        mask |= static_cast<uint64_t>(values[i] >= lo && values[i] <= hi) << i;
+    }
+#endif
+    return mask;
+}
+
+inline uint64_t uint16EqualsMask64(const uint16_t* values, uint16_t key) {
+    uint64_t mask = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i vkey = _mm_set1_epi16(static_cast<short>(key));
+    for (int i = 0; i < 64; i += 16) {
+        __m128i a = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)), vkey);
+        __m128i b = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 8)), vkey);
+        // packs сжимает 16 масок по 16 бит в 16 байт, movemask - в 16 бит
+        auto bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(a, b)));
+        mask |= static_cast<uint64_t>(bits) << i;
+    }
+#else
+    for (int i = 0; i < 64; ++i) {
+        mask |= static_cast<uint64_t>(values[i] == key) << i;
+    }
+#endif
+    return mask;
+}
+
+/**
+ * @brief Применить ядро ко всей колонке, пересекая результат с выборкой
+ * 
+ * Слова выборки, уже равные нулю, пропускаются - чем селективнее первые
+ * предикаты цепочки, тем меньше работы у последующих.
+ */
+template<typename T, typename Kernel, typename Scalar>
+void andColumn(const T* column, SelectionBitmap& selection, Kernel kernel, Scalar scalar) {
+    const size_t fullWords = selection.size() / 64;
+    for (size_t w = 0; w < fullWords; ++w) {
+        uint64_t& bits = selection.word(w);
+        if (bits != 0) {
+            bits &= kernel(column + w * 64);
+        }
+    }
+    if (fullWords < selection.wordCount()) {
+        uint64_t tail = 0;
+        for (size_t i = fullWords * 64; i < selection.size(); ++i) {
+            tail |= static_cast<uint64_t>(scalar(column[i])) << (i % 64);
+        }
+        selection.word(fullWords) &= tail;
+    }
+}
+
+} // namespace columnar_kernels
+
+/**
+ * @brief Скомпилированный план: конъюнкция колоночных предикатов
+ * 
+ * Критерии, переопределившие compileInto(), становятся векторизованными
+ * предикатами; остальные попадают в "остаток" и проверяются построчно через
+ * matches() только для строк, переживших колоночные предикаты.
+ */
+class ColumnarPlan {
+private:
+    enum class Kind { DepartmentEquals, AgeRange, SalaryRange, NameContains };
+    
+    struct Predicate {
+        Kind kind;
+        int32_t intLo = 0;
+        int32_t intHi = 0;
+        double doubleLo = 0;
+        double doubleHi = 0;
+        std::string text;
+    };
+    
+    const EmployeeColumns& columns;
+    std::vector<Predicate> predicates;
+    std::vector<const FilterCriteria*> residual;
+    bool alwaysFalse = false;
+    
+    void applyNameContains(const std::string& pattern, SelectionBitmap& selection) const {
+        if (pattern.empty()) {
+            return;
+        }
+        const std::string& data = columns.names();
+        const auto& offsets = columns.offsets();
+        const std::boyer_moore_horspool_searcher<std::string::const_iterator> searcher(pattern.begin(), pattern.end());
+        
+        // Разреженная выборка: проверяем только выжившие строки
+        if (selection.count() * 8 < selection.size()) {
+            SelectionBitmap survivors = selection;
+            survivors.forEachSet([&](size_t row) {
+                auto begin = data.cbegin() + offsets[row];
+                auto end = data.cbegin() + offsets[row + 1];
+                if (std::search(begin, end, searcher) == end) {
+                    selection.word(row / 64) &= ~(uint64_t{1} << (row % 64));
+                }
+            });
+            return;
+        }
+        
+        // Плотная выборка: один проход по общему буферу имён вместо find() в каждой строке
+        SelectionBitmap hits(selection.size());
+        hits.clear();
+        auto pos = data.cbegin();
+        while (true) {
+            pos = std::search(pos, data.cend(), searcher);
+            if (pos == data.cend()) {
+                break;
+            }
+            auto offset = static_cast<uint32_t>(pos - data.cbegin());
+            size_t row = static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), offset) - offsets.begin()) - 1;
+            if (offset + pattern.size() <= offsets[row + 1]) {
+                hits.word(row / 64) |= uint64_t{1} << (row % 64);
+                pos = data.cbegin() + offsets[row + 1];  // строка уже подходит
+            } else {
+                ++pos;  // совпадение пересекло границу строк
+            }
+        }
+        for (size_t w = 0; w < selection.wordCount(); ++w) {
+            selection.word(w) &= hits.word(w);
+        }
+    }
+    
+public:
+    explicit ColumnarPlan(const EmployeeColumns& cols) : columns(cols) {}
+    
+    void addAgeRange(int32_t lo, int32_t hi) {
+        predicates.push_back({Kind::AgeRange, lo, hi, 0, 0, {}});
+    }
+    
+    void addSalaryRange(double lo, double hi) {
+        predicates.push_back({Kind::SalaryRange, 0, 0, lo, hi, {}});
+    }
+    
+    void addDepartmentEquals(const std::string& department) {
+        int id = columns.findDepartment(department);
+        if (id < 0) {
+            alwaysFalse = true;  // отдела нет в словаре - результат пуст без сканирования
+            return;
+        }
+        predicates.push_back({Kind::DepartmentEquals, id, id, 0, 0, {}});
+    }
+    
+    void addNameContains(const std::string& pattern) {
+        predicates.push_back({Kind::NameContains, 0, 0, 0, 0, pattern});
+    }
+    
+    static ColumnarPlan compile(const EmployeeColumns& columns,
+                                const std::vector<std::unique_ptr<FilterCriteria>>& criteria) {
+        ColumnarPlan plan(columns);
+        for (const auto& criterion : criteria) {
+            if (!criterion->compileInto(plan)) {
+                plan.residual.push_back(criterion.get());
+            }
+        }
+        // Дешёвые и обычно селективные предикаты - первыми, поиск подстроки - последним
+        std::stable_sort(plan.predicates.begin(), plan.predicates.end(),
+                         [](const Predicate& a, const Predicate& b) { return a.kind < b.kind; });
+        return plan;
+    }
+    
+    size_t vectorizedCount() const { return predicates.size(); }
+    size_t residualCount() const { return residual.size(); }
+    
+    SelectionBitmap execute() const {
+        SelectionBitmap selection(columns.size());
+        if (alwaysFalse) {
+            selection.clear();
+            return selection;
+        }
+        
+        for (const auto& p : predicates) {
+            switch (p.kind) {
+                case Kind::DepartmentEquals: {
+                    auto key = static_cast<uint16_t>(p.intLo);
+                    columnar_kernels::andColumn(columns.departmentData(), selection,
+                        [key](const uint16_t* v) { return columnar_kernels::uint16EqualsMask64(v, key); },
+                        [key](uint16_t v) { return v == key; });
+                    break;
+                }
+                case Kind::AgeRange: {
+                    int32_t lo = p.intLo, hi = p.intHi;
+                    columnar_kernels::andColumn(columns.ageData(), selection,
+                        [lo, hi](const int32_t* v) { return columnar_kernels::int32RangeMask64(v, lo, hi); },
+                        [lo, hi](int32_t v) { return v >= lo && v <= hi; });
+                    break;
+                }
+                case Kind::SalaryRange: {
+                    double lo = p.doubleLo, hi = p.doubleHi;
+                    columnar_kernels::andColumn(columns.salaryData(), selection,
+                        [lo, hi](const double* v) { return columnar_kernels::doubleRangeMask64(v, lo, hi); },
+                        [lo, hi](double v) { return v >= lo && v <= hi; });
+                    break;
+                }
+                case Kind::NameContains:
+                    applyNameContains(p.text, selection);
+                    break;
+            }
+        }
+        
+        if (!residual.empty()) {
+            SelectionBitmap survivors = selection;
+            survivors.forEachSet([&](size_t row) {
+                auto emp = columns.row(row);
+                for (const auto* criterion : residual) {
+                    if (!criterion->matches(emp)) {
+                        selection.word(row / 64) &= ~(uint64_t{1} << (row % 64));
+                        break;
+                    }
+                }
+            });
+        }
+        return selection;
+    }
+};
+
+bool NameFilter::compileInto(ColumnarPlan& plan) const {
+    plan.addNameContains(namePattern);
+    return true;
+}
+
+bool AgeFilter::compileInto(ColumnarPlan& plan) const {
+    plan.addAgeRange(minAge, maxAge);
+    return true;
+}
+
+bool SalaryFilter::compileInto(ColumnarPlan& plan) const {
+    plan.addSalaryRange(minSalary, maxSalary);
+    return true;
+}
+
+bool DepartmentFilter::compileInto(ColumnarPlan& plan) const {
+    plan.addDepartmentEquals(department);
+    return true;
+}
+
+bool SeniorityFilter::compileInto(ColumnarPlan& plan) const {
+    // age - 22 >= minYears  <=>  age >= minYears + 22
+    plan.addAgeRange(minYears > INT32_MAX - 22 ? INT32_MAX : minYears + 22, INT32_MAX);
+    return true;
+}
+
+/**
+ * @brief Колоночный аналог GoodDataFilter с тем же набором критериев
+ */
+class ColumnarDataFilter {
+public:
+    std::vector<uint32_t> filterIndices(const EmployeeColumns& columns,
+                                        const std::vector<std::unique_ptr<FilterCriteria>>& criteria) const {
+        auto selection = ColumnarPlan::compile(columns, criteria).execute();
+        std::vector<uint32_t> result;
+        result.reserve(selection.count());
+        selection.forEachSet([&](size_t row) { result.push_back(static_cast<uint32_t>(row)); });
+        return result;
+    }
+    
+    std::vector<BadDataFilter::Employee> filter(const EmployeeColumns& columns,
+                                                const std::vector<std::unique_ptr<FilterCriteria>>& criteria) const {
+        std::vector<BadDataFilter::Employee> result;
+        for (uint32_t row : filterIndices(columns, criteria)) {
+            result.push_back(columns.row(row));
+        }
+        return result;
+    }
+};
+
 // ============================================================================
 // ДЕМОНСТРАЦИЯ ПРИНЦИПА
 // ============================================================================
@@ -755,6 +1589,241 @@ void demonstrateFilterOCP() {
     }
 }
 
+/**
+ * @brief Критерий без compileInto(): колоночный движок проверит его построчно
+ */
+class SalaryPerAgeFilter : public FilterCriteria {
+private:
+    double minRatio;
+    
+public:
+    SalaryPerAgeFilter(double ratio) : minRatio(ratio) {}
+    
+    bool matches(const BadDataFilter::Employee& employee) const override {
+        return employee.age > 0 && employee.salary / employee.age >= minRatio;
+    }
+    
+    std::string getDescription() const override {
+        return "Зарплата/возраст не менее " + std::to_string(static_cast<int>(minRatio));
+    }
+};
+
+void demonstrateColumnarFilter() {
+    std::cout << "\n📊 КОЛОНОЧНЫЙ ДВИЖОК ПОВЕРХ FilterCriteria:\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    std::vector<BadDataFilter::Employee> employees = {
+        {"Иван Иванов", 30, 50000, "IT"},
+        {"Петр Петров", 25, 45000, "Marketing"},
+        {"Мария Сидорова", 35, 60000, "IT"},
+        {"Анна Козлова", 28, 48000, "HR"},
+        {"Сергей Смирнов", 40, 70000, "IT"}
+    };
+    auto columns = EmployeeColumns::fromRows(employees);
+    
+    std::vector<std::unique_ptr<FilterCriteria>> criteria;
+    criteria.push_back(std::make_unique<DepartmentFilter>("IT"));
+    criteria.push_back(std::make_unique<SalaryFilter>(45000, 65000));
+    criteria.push_back(std::make_unique<NameFilter>("ов"));
+    criteria.push_back(std::make_unique<SalaryPerAgeFilter>(1600));  // не компилируется - остаток
+    
+    auto plan = ColumnarPlan::compile(columns, criteria);
+    std::cout << "План: " << plan.vectorizedCount() << " векторизованных предиката(ов), "
+              << plan.residualCount() << " построчных\n";
+    
+    ColumnarDataFilter columnar;
+    GoodDataFilter rowWise;
+    auto expected = rowWise.filter(employees, criteria);
+    auto actual = columnar.filter(columns, criteria);
+    
+    for (const auto& emp : actual) {
+        std::cout << "  - " << emp.name << " (возраст: " << emp.age
+                  << ", зарплата: $" << emp.salary << ", отдел: " << emp.department << ")\n";
+    }
+    std::cout << (expected.size() == actual.size() ? "✅" : "❌")
+              << " Результат совпадает с построчным GoodDataFilter\n";
+}
+
+void benchmarkColumnarFilter() {
+    std::cout << "\n⏱️ БЕНЧМАРК: построчный vs колоночный фильтр\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    constexpr size_t kRows = 2'000'000;
+    const std::vector<std::string> departments = {"IT", "HR", "Marketing", "Sales", "Finance", "Legal", "Support", "R&D"};
+    const std::vector<std::string> surnames = {"Иванов", "Петров", "Сидоров", "Козлов", "Смирнов", "Попов", "Волков"};
+    
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> ageDist(20, 65);
+    std::uniform_real_distribution<double> salaryDist(20000, 150000);
+    std::uniform_int_distribution<size_t> deptDist(0, departments.size() - 1);
+    std::uniform_int_distribution<size_t> nameDist(0, surnames.size() - 1);
+    
+    std::vector<BadDataFilter::Employee> employees;
+    employees.reserve(kRows);
+    for (size_t i = 0; i < kRows; ++i) {
+        employees.push_back({surnames[nameDist(rng)] + " #" + std::to_string(i), ageDist(rng),
+                             salaryDist(rng), departments[deptDist(rng)]});
+    }
+    auto columns = EmployeeColumns::fromRows(employees);
+    
+    std::vector<std::unique_ptr<FilterCriteria>> chain;
+    auto addStage = [&chain](size_t stage) {
+        switch (stage) {
+            case 0: chain.push_back(std::make_unique<AgeFilter>(25, 55)); break;
+            case 1: chain.push_back(std::make_unique<SalaryFilter>(40000, 120000)); break;
+            case 2: chain.push_back(std::make_unique<SeniorityFilter>(5)); break;
+            case 3: chain.push_back(std::make_unique<DepartmentFilter>("IT")); break;
+            case 4: chain.push_back(std::make_unique<NameFilter>("Петров")); break;
+        }
+    };
+    
+    auto rowsPerSecond = [](size_t rows, std::chrono::nanoseconds elapsed) {
+        return static_cast<double>(rows) / std::max<double>(1e-9, static_cast<double>(elapsed.count()) / 1e9);
+    };
+    
+    GoodDataFilter rowWise;
+    ColumnarDataFilter columnar;
+    std::cout << "Строк: " << kRows << "\n";
+    for (size_t stage = 0; stage < 5; ++stage) {
+        addStage(stage);
+        
+        auto t0 = std::chrono::steady_clock::now();
+        size_t rowMatches = rowWise.filter(employees, chain).size();
+        auto t1 = std::chrono::steady_clock::now();
+        size_t columnMatches = columnar.filterIndices(columns, chain).size();
+        auto t2 = std::chrono::steady_clock::now();
+        
+        std::cout << "  предикатов: " << (stage + 1)
+                  << " | построчно: " << static_cast<long long>(rowsPerSecond(kRows, t1 - t0) / 1e6) << " Мстрок/с"
+                  << " | колоночно: " << static_cast<long long>(rowsPerSecond(kRows, t2 - t1) / 1e6) << " Мстрок/с"
+                  << " | совпадений: " << columnMatches
+                  << (rowMatches == columnMatches ? "" : " ❌ расхождение!") << "\n";
+    }
+}
+
+/**
+ * @brief streambuf, который форматирует и выбрасывает вывод (для бенчмарка)
+ */
+class DiscardingBuffer : public std::streambuf {
+private:
+    char scratch_[256];
+    
+protected:
+    int overflow(int ch) override {
+        setp(scratch_, scratch_ + sizeof(scratch_));
+        return traits_type::not_eof(ch);
+    }
+};
+
+PaymentProcessor makeSettlementProcessor() {
+    PaymentProcessor processor;
+    processor.addPaymentStrategy(std::make_unique<CreditCardPayment>("1234567890123456", "12/25", "123"));
+    processor.addPaymentStrategy(std::make_unique<PayPalPayment>("user@example.com", "password"));
+    processor.addPaymentStrategy(std::make_unique<BankTransferPayment>("12345678", "123456789", "Bank of America"));
+    processor.addPaymentStrategy(std::make_unique<CryptocurrencyPayment>("1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa", "BTC"));
+    processor.addPaymentStrategy(std::make_unique<ApplePayPayment>("iPhone123456", "123456"));
+    return processor;
+}
+
+CurrencyTable makeSettlementCurrencies() {
+    CurrencyTable currencies;
+    currencies.add("USD", 1.0);
+    currencies.add("EUR", 1.08);
+    currencies.add("GBP", 1.27);
+    currencies.add("JPY", 0.0067);
+    currencies.add("CAD", 0.73);
+    currencies.add("AUD", 0.66);
+    currencies.add("CHF", 1.12);
+    currencies.add("BTC", 60000.0);
+    return currencies;
+}
+
+std::vector<PaymentRequest> makeSettlementPayments(size_t count, const CurrencyTable& currencies, uint32_t strategies) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<uint32_t> strategyDist(0, strategies - 1);
+    std::uniform_int_distribution<int> currencyDist(0, static_cast<int>(currencies.size()) - 1);
+    std::uniform_real_distribution<double> amountDist(1.0, 12000.0);
+    std::vector<PaymentRequest> payments(count);
+    for (auto& p : payments) {
+        p = {strategyDist(rng), static_cast<uint16_t>(currencyDist(rng)), amountDist(rng)};
+    }
+    return payments;
+}
+
+void demonstrateBatchPayments() {
+    std::cout << "\n📦 ПАКЕТНЫЙ РАСЧЁТ ПЛАТЕЖЕЙ:\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    auto processor = makeSettlementProcessor();
+    auto currencies = makeSettlementCurrencies();
+    std::vector<PaymentRequest> payments = {
+        {processor.resolveStrategy("Credit Card"), currencies.id("USD"), 100.0},
+        {processor.resolveStrategy("PayPal"), currencies.id("EUR"), 250.0},
+        {processor.resolveStrategy("PayPal"), currencies.id("USD"), 9000.0},   // выше лимита PayPal
+        {processor.resolveStrategy("Cryptocurrency (BTC)"), currencies.id("BTC"), 0.001},
+        {processor.resolveStrategy("Apple Pay"), currencies.id("BTC"), 75.0},  // валюта не поддерживается
+    };
+    std::vector<PaymentResult> results(payments.size());
+    auto summary = processor.processBatch(payments, currencies, results);
+    
+    const char* statusNames[] = {"одобрен", "отклонён", "валюта не поддерживается", "неизвестная стратегия"};
+    for (size_t i = 0; i < payments.size(); ++i) {
+        std::cout << "  #" << i << ": " << statusNames[static_cast<int>(results[i].status)]
+                  << ", комиссия " << results[i].fee << " " << currencies.code(payments[i].currency) << "\n";
+    }
+    std::cout << "Одобрено: " << summary.approved << ", комиссий: $" << summary.feesUsd << "\n";
+}
+
+void benchmarkBatchPayments() {
+    std::cout << "\n⏱️ БЕНЧМАРК: поштучный vs пакетный расчёт\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    auto processor = makeSettlementProcessor();
+    auto currencies = makeSettlementCurrencies();
+    const std::vector<std::string> typeNames = {"Credit Card", "PayPal", "Bank Transfer", "Cryptocurrency (BTC)", "Apple Pay"};
+    auto perSecond = [](size_t n, std::chrono::steady_clock::duration d) {
+        return static_cast<long long>(n / std::chrono::duration<double>(d).count());
+    };
+    
+    // Поштучно: processPayment по имени и коду валюты, вывод форматируется и выбрасывается
+    constexpr size_t kSingle = 200'000;
+    auto sample = makeSettlementPayments(kSingle, currencies, static_cast<uint32_t>(typeNames.size()));
+    size_t singleApproved = 0;
+    {
+        DiscardingBuffer sink;
+        auto* saved = std::cout.rdbuf(&sink);
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& p : sample) {
+            singleApproved += processor.processPayment(typeNames[p.strategy], p.amount, currencies.code(p.currency));
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        std::cout.rdbuf(saved);
+        std::cout << "Поштучно:        " << perSecond(kSingle, elapsed) << " платежей/с\n";
+    }
+    {
+        std::vector<PaymentResult> results(sample.size());
+        auto summary = processor.processBatch(sample, currencies, results, 1);
+        std::cout << (summary.approved == singleApproved ? "✅" : "❌")
+                  << " Пакетный режим одобряет те же платежи (" << summary.approved << ")\n";
+    }
+    
+    constexpr size_t kBatch = 4'000'000;
+    auto payments = makeSettlementPayments(kBatch, currencies, static_cast<uint32_t>(typeNames.size()));
+    std::vector<PaymentResult> results(payments.size());
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts = {1};
+    if (hw > 1) {
+        threadCounts.push_back(hw);
+    }
+    for (unsigned threads : threadCounts) {
+        auto start = std::chrono::steady_clock::now();
+        auto summary = processor.processBatch(payments, currencies, results, threads);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Пакетно x" << threads << ":      " << perSecond(kBatch, elapsed)
+                  << " платежей/с (одобрено " << summary.approved << ")\n";
+    }
+}
+
 void analyzeTradeOffs() {
     std::cout << "\n🔬 АНАЛИЗ КОМПРОМИССОВ OCP:\n";
     std::cout << std::string(50, '-') << "\n";
@@ -786,7 +1855,11 @@ int main() {
     
     demonstrateBadOCP();
     demonstrateGoodOCP();
+    demonstrateBatchPayments();
+    benchmarkBatchPayments();
     demonstrateFilterOCP();
+    demonstrateColumnarFilter();
+    benchmarkColumnarFilter();
     analyzeTradeOffs();
     
     std::cout << "\n📚 МАТЕМАТИЧЕСКОЕ ОБОСНОВАНИЕ:\n";
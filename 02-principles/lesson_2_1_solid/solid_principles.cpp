@@ -16,6 +16,7 @@
 #include <chrono>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 
 // ============================================================================
 // SINGLE RESPONSIBILITY PRINCIPLE (SRP)
@@ -230,6 +231,14 @@ public:
     virtual ~PaymentStrategy() = default;
     virtual void processPayment(double amount) = 0;
     virtual std::string getPaymentType() const = 0;
+    
+    // Пакетная обработка: по умолчанию поштучно, стратегия может переопределить
+    // (полный пакетный конвейер - в ocp_example.cpp)
+    virtual void processPayments(const std::vector<double>& amounts) {
+        for (double amount : amounts) {
+            processPayment(amount);
+        }
+    }
 };
 
 // Конкретные реализации для разных типов платежей
@@ -300,6 +309,16 @@ public:
             std::cout << "❌ Стратегия платежа не установлена!\n";
         }
     }
+    
+    void processBatch(const std::vector<double>& amounts) {
+        if (strategy) {
+            std::cout << "Выбранный тип платежа: " << strategy->getPaymentType()
+                      << " (пакет из " << amounts.size() << ")\n";
+            strategy->processPayments(amounts);
+        } else {
+            std::cout << "❌ Стратегия платежа не установлена!\n";
+        }
+    }
 };
 
 // ============================================================================
@@ -714,6 +733,9 @@ void demonstrateOCP() {
     // Новый тип платежа - добавляется без изменения существующего кода!
     processor.setPaymentStrategy(std::make_unique<CryptoPayment>());
     processor.processPayment(500.0);
+    
+    // Пакет: выбор стратегии один раз на все платежи
+    processor.processBatch({10.0, 20.0, 30.0});
 }
 
 void demonstrateLSP() {
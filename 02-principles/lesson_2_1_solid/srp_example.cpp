@@ -15,6 +15,15 @@
 #include <fstream>
 #include <chrono>
 #include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <string_view>
+#include <charconv>
+#include <ctime>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <filesystem>
 
 /**
  * @brief Математическая формализация SRP
@@ -183,6 +192,12 @@ public:
         : id(orderId), customerName(customer), customerEmail(email), 
           totalAmount(0.0), status("pending"), createdAt(std::chrono::system_clock::now()) {}
     
+    // Восстановление сохранённого заказа (без побочных эффектов addItem)
+    Order(int orderId, std::string customer, std::string email, std::vector<std::string> orderItems,
+          double amount, std::string orderStatus, std::chrono::system_clock::time_point created)
+        : id(orderId), customerName(std::move(customer)), customerEmail(std::move(email)),
+          items(std::move(orderItems)), totalAmount(amount), status(std::move(orderStatus)), createdAt(created) {}
+    
     // Геттеры
     int getId() const { return id; }
     const std::string& getCustomerName() const { return customerName; }
@@ -331,6 +346,41 @@ public:
     }
 };
 
+/**
+ * @brief Курсор, выдающий заказы из хранилища порциями
+ * 
+ * Вместо std::vector<Order> со всей выборкой курсор подгружает по
+ * maxCount заказов за раз (в БД - постраничная выборка по ключу), так что
+ * в памяти одновременно находится только текущая порция.
+ */
+class OrderCursor {
+public:
+    using Loader = std::function<void(size_t offset, size_t count, std::vector<Order>& out)>;
+    
+private:
+    size_t total_;
+    size_t offset_ = 0;
+    Loader loader_;
+    
+public:
+    OrderCursor(size_t total, Loader loader) : total_(total), loader_(std::move(loader)) {}
+    
+    /**
+     * @brief Заполнить chunk следующей порцией (старое содержимое удаляется)
+     * @return false, если заказы закончились
+     */
+    bool next(std::vector<Order>& chunk, size_t maxCount) {
+        chunk.clear();
+        if (offset_ >= total_) {
+            return false;
+        }
+        size_t count = std::min(maxCount, total_ - offset_);
+        loader_(offset_, count, chunk);
+        offset_ += count;
+        return true;
+    }
+};
+
 // Класс для работы с базой данных
 class OrderRepository {
 public:
@@ -357,6 +407,220 @@ public:
         // SELECT * FROM orders WHERE customer_email = ?
         return {}; // заглушка
     }
+    
+    /**
+     * @brief Курсор по всем заказам (демо: синтетическая таблица из total строк)
+     */
+    static OrderCursor scanAll(size_t total) {
+        // SELECT * FROM orders WHERE id > ? ORDER BY id LIMIT ?
+        return OrderCursor(total, [](size_t offset, size_t count, std::vector<Order>& out) {
+            static const char* const catalog[] = {"laptop", "mouse", "keyboard", "monitor", "headphones"};
+            const auto base = std::chrono::system_clock::from_time_t(1'700'000'000);
+            for (size_t i = offset; i < offset + count; ++i) {
+                std::vector<std::string> items;
+                for (size_t k = 0; k <= i % 3; ++k) {
+                    items.emplace_back(catalog[(i + k) % 5]);
+                }
+                Order order(static_cast<int>(i + 1), "Клиент " + std::to_string(i % 1000),
+                            "c" + std::to_string(i % 1000) + "@example.com", std::move(items), 0.0,
+                            "confirmed", base + std::chrono::seconds(i * 37));
+                order.setTotalAmount(PriceCalculator::calculateTotal(order));
+                out.push_back(std::move(order));
+            }
+        });
+    }
+    
+    static OrderCursor scanByCustomer(const std::string& customerEmail) {
+        std::cout << "🔍 Поиск заказов клиента " << customerEmail << "\n";
+        // SELECT * FROM orders WHERE customer_email = ? AND id > ? ORDER BY id LIMIT ?
+        return OrderCursor(0, [](size_t, size_t, std::vector<Order>&) {}); // заглушка
+    }
+};
+
+/**
+ * @brief Буфер отчёта с быстрым форматированием чисел и дат
+ * 
+ * Всё форматирование идёт в один переиспользуемый буфер: целые - через
+ * std::to_chars, деньги - через целые центы, дата - localtime_r не чаще
+ * одного раза на час (минуты и секунды считаются арифметикой).
+ */
+class ReportBuffer {
+private:
+    std::string data_;
+    std::time_t hourStart_ = 0;
+    std::time_t hourEnd_ = 0;
+    char hourPrefix_[16] = {};  // "YYYY-MM-DD HH"
+    
+    void appendTwoDigits(int value) {
+        data_ += static_cast<char>('0' + value / 10);
+        data_ += static_cast<char>('0' + value % 10);
+    }
+    
+    static char* writeDigits(char* out, int value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        return out + width;
+    }
+    
+public:
+    explicit ReportBuffer(size_t capacity) { data_.reserve(capacity); }
+    
+    void append(std::string_view text) { data_.append(text.data(), text.size()); }
+    
+    void appendInt(long long value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        data_.append(digits, result.ptr);
+    }
+    
+    void appendMoney(double amount) {
+        long long cents = std::llround(amount * 100.0);
+        if (cents < 0) {
+            data_ += '-';
+            cents = -cents;
+        }
+        appendInt(cents / 100);
+        data_ += '.';
+        appendTwoDigits(static_cast<int>(cents % 100));
+    }
+    
+    /**
+     * @brief Дата в формате "%Y-%m-%d %H:%M:%S" (локальное время)
+     */
+    void appendDateTime(std::chrono::system_clock::time_point tp) {
+        std::time_t t = std::chrono::system_clock::to_time_t(tp);
+        if (t < hourStart_ || t >= hourEnd_) {
+            std::tm tm{};
+#if defined(_WIN32)
+            localtime_s(&tm, &t);
+#else
+            localtime_r(&t, &tm);
+#endif
+            char* p = writeDigits(hourPrefix_, tm.tm_year + 1900, 4);
+            *p++ = '-';
+            p = writeDigits(p, tm.tm_mon + 1, 2);
+            *p++ = '-';
+            p = writeDigits(p, tm.tm_mday, 2);
+            *p++ = ' ';
+            writeDigits(p, tm.tm_hour, 2);
+            // Переходы на летнее время происходят на границе часа
+            hourStart_ = t - (tm.tm_min * 60 + tm.tm_sec);
+            hourEnd_ = hourStart_ + 3600;
+        }
+        int secondsInHour = static_cast<int>(t - hourStart_);
+        data_.append(hourPrefix_, 13);
+        data_ += ':';
+        appendTwoDigits(secondsInHour / 60);
+        data_ += ':';
+        appendTwoDigits(secondsInHour % 60);
+    }
+    
+    const char* data() const { return data_.data(); }
+    size_t size() const { return data_.size(); }
+    void clear() { data_.clear(); }
+};
+
+/**
+ * @brief Потоковый конвейер отчётов: курсор -> буфер -> файлы партий
+ * 
+ * Заказы читаются порциями, форматируются в большой буфер и пишутся
+ * крупными последовательными write() в файлы по ordersPerFile заказов
+ * (prefix_0.txt, prefix_1.txt, ...). Память не зависит от числа заказов.
+ */
+class StreamingReportPipeline {
+public:
+    struct Options {
+        size_t chunkSize = 4096;          // заказов за одно обращение к курсору
+        size_t ordersPerFile = 100'000;   // размер партии
+        size_t bufferBytes = 1 << 20;     // порог сброса буфера в файл
+    };
+    
+    struct Stats {
+        size_t orders = 0;
+        size_t files = 0;
+        uint64_t bytes = 0;
+    };
+    
+    static void formatOrder(const Order& order, ReportBuffer& out) {
+        out.append("=== ОТЧЕТ ПО ЗАКАЗУ ===\nID: ");
+        out.appendInt(order.getId());
+        out.append("\nКлиент: ");
+        out.append(order.getCustomerName());
+        out.append("\nEmail: ");
+        out.append(order.getCustomerEmail());
+        out.append("\nТовары:\n");
+        for (const auto& item : order.getItems()) {
+            out.append("  - ");
+            out.append(item);
+            out.append("\n");
+        }
+        out.append("Общая сумма: $");
+        out.appendMoney(order.getTotalAmount());
+        out.append("\nСтатус: ");
+        out.append(order.getStatus());
+        out.append("\nДата создания: ");
+        out.appendDateTime(order.getCreatedAt());
+        out.append("\n");
+    }
+    
+    static Stats run(OrderCursor& cursor, const std::string& pathPrefix, const Options& options) {
+        Stats stats;
+        std::vector<Order> chunk;
+        chunk.reserve(options.chunkSize);
+        ReportBuffer buffer(options.bufferBytes + 64 * 1024);
+        std::ofstream out;
+        size_t ordersInFile = 0;
+        
+        auto flush = [&] {
+            if (buffer.size() == 0) {
+                return;
+            }
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            if (!out) {
+                throw std::runtime_error("Ошибка записи отчёта");
+            }
+            stats.bytes += buffer.size();
+            buffer.clear();
+        };
+        
+        auto rotate = [&] {
+            flush();
+            if (out.is_open()) {
+                out.close();
+            }
+            std::string filename = pathPrefix + "_" + std::to_string(stats.files) + ".txt";
+            out.open(filename, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                throw std::runtime_error("Не удалось открыть " + filename);
+            }
+            ++stats.files;
+            ordersInFile = 0;
+        };
+        
+        while (cursor.next(chunk, options.chunkSize)) {
+            for (const auto& order : chunk) {
+                if (!out.is_open() || ordersInFile == options.ordersPerFile) {
+                    rotate();
+                }
+                formatOrder(order, buffer);
+                ++ordersInFile;
+                ++stats.orders;
+                if (buffer.size() >= options.bufferBytes) {
+                    flush();
+                }
+            }
+        }
+        flush();
+        if (out.is_open()) {
+            out.close();
+            if (!out) {
+                throw std::runtime_error("Ошибка закрытия файла отчёта");
+            }
+        }
+        return stats;
+    }
 };
 
 // Класс для генерации отчетов
@@ -385,13 +649,27 @@ public:
         std::cout << "📊 Отчет сохранен в " << filename << "\n";
     }
     
+    /**
+     * @brief Отчёты по всем заказам курсора: файл на партию, а не на заказ
+     */
+    static StreamingReportPipeline::Stats generateOrderReports(OrderCursor& cursor, const std::string& pathPrefix,
+                                                               const StreamingReportPipeline::Options& options = {}) {
+        return StreamingReportPipeline::run(cursor, pathPrefix, options);
+    }
+    
     static void generateCustomerReport(const std::string& customerEmail) {
-        auto orders = OrderRepository::findByCustomer(customerEmail);
+        // Заказы считаются порциями, без материализации всей выборки
+        auto cursor = OrderRepository::scanByCustomer(customerEmail);
+        std::vector<Order> chunk;
+        size_t orderCount = 0;
+        while (cursor.next(chunk, 4096)) {
+            orderCount += chunk.size();
+        }
         
         std::ofstream report("customer_report.txt");
         report << "=== ОТЧЕТ ПО КЛИЕНТУ ===\n";
         report << "Email: " << customerEmail << "\n";
-        report << "Количество заказов: " << orders.size() << "\n";
+        report << "Количество заказов: " << orderCount << "\n";
         report.close();
         
         std::cout << "📊 Отчет по клиенту сохранен в customer_report.txt\n";
@@ -520,6 +798,86 @@ void demonstrateGoodSRP() {
     }
 }
 
+// ============================================================================
+// ПОТОКОВЫЕ ОТЧЕТЫ
+// ============================================================================
+
+void demonstrateStreamingReports() {
+    std::cout << "\n📄 ПОТОКОВАЯ ГЕНЕРАЦИЯ ОТЧЕТОВ:\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    auto prefix = (std::filesystem::temp_directory_path() / "srp_orders_demo").string();
+    auto cursor = OrderRepository::scanAll(10);
+    StreamingReportPipeline::Options options;
+    options.chunkSize = 4;
+    options.ordersPerFile = 5;
+    auto stats = ReportGenerator::generateOrderReports(cursor, prefix, options);
+    
+    std::cout << "Заказов: " << stats.orders << ", файлов: " << stats.files
+              << ", байт: " << stats.bytes << "\n";
+    std::ifstream first(prefix + "_0.txt");
+    std::string line;
+    for (int i = 0; i < 9 && std::getline(first, line); ++i) {
+        std::cout << "  | " << line << "\n";
+    }
+    for (size_t i = 0; i < stats.files; ++i) {
+        std::filesystem::remove(prefix + "_" + std::to_string(i) + ".txt");
+    }
+    
+    ReportGenerator::generateCustomerReport("petr@example.com");
+}
+
+/**
+ * @brief Бенчмарк: файл на заказ против потокового конвейера (заказов/с)
+ */
+void benchmarkReportGeneration() {
+    std::cout << "\n⏱️ БЕНЧМАРК ГЕНЕРАЦИИ ОТЧЕТОВ:\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "srp_report_bench";
+    fs::create_directories(dir);
+    
+    auto ordersPerSecond = [](size_t orders, std::chrono::steady_clock::duration d) {
+        return orders / std::chrono::duration<double>(d).count();
+    };
+    
+    // До: generateOrderReport на каждый заказ (ofstream, localtime, put_time)
+    {
+        constexpr size_t kOrders = 20'000;
+        auto cursor = OrderRepository::scanAll(kOrders);
+        std::vector<Order> chunk;
+        auto* saved = std::cout.rdbuf(nullptr);  // глушим "Отчет сохранен" на каждый заказ
+        auto start = std::chrono::steady_clock::now();
+        while (cursor.next(chunk, 4096)) {
+            for (const auto& order : chunk) {
+                ReportGenerator::generateOrderReport(order, (dir / ("order_" + std::to_string(order.getId()) + ".txt")).string());
+            }
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        std::cout.rdbuf(saved);
+        std::cout.clear();
+        std::cout << "Файл на заказ:       " << static_cast<long long>(ordersPerSecond(kOrders, elapsed)) << " заказов/с\n";
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+    }
+    
+    // После: курсор порциями + буфер 1 МБ + файл на партию
+    {
+        constexpr size_t kOrders = 1'000'000;
+        auto cursor = OrderRepository::scanAll(kOrders);
+        StreamingReportPipeline::Options options;
+        options.ordersPerFile = 250'000;
+        auto start = std::chrono::steady_clock::now();
+        auto stats = ReportGenerator::generateOrderReports(cursor, (dir / "batch").string(), options);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Потоковый конвейер:  " << static_cast<long long>(ordersPerSecond(stats.orders, elapsed))
+                  << " заказов/с (" << stats.files << " файлов, " << stats.bytes / (1024 * 1024) << " МБ)\n";
+    }
+    
+    fs::remove_all(dir);
+}
+
 // ============================================================================
 // АНАЛИЗ КОМПРОМИССОВ
 // ============================================================================
@@ -555,6 +913,8 @@ int main() {
     
     demonstrateBadSRP();
     demonstrateGoodSRP();
+    demonstrateStreamingReports();
+    benchmarkReportGeneration();
     analyzeTradeOffs();
     
     std::cout << "\n📚 МАТЕМАТИЧЕСКОЕ ОБОСНОВАНИЕ:\n";
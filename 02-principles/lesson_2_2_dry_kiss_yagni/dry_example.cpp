@@ -18,6 +18,18 @@
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <variant>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
 
 /**
  * @brief Математическая формализация DRY
@@ -352,6 +364,337 @@ public:
     }
 };
 
+// ============================================================================
+// ПАКЕТНАЯ ВАЛИДАЦИЯ: те же правила без состояния, по колонкам
+// ============================================================================
+
+/**
+ * @brief Флаги ошибок валидации
+ * 
+ * Вместо строки на каждую ошибку правило возвращает битовую маску.
+ * Текст сообщения собирается только по запросу (BatchValidationResult::errors).
+ */
+enum ValidationFlag : uint16_t {
+    kValidationOk         = 0,
+    kValidationEmpty      = 1u << 0,
+    kValidationTooShort   = 1u << 1,
+    kValidationTooLong    = 1u << 2,
+    kValidationMissingAt  = 1u << 3,
+    kValidationMissingDot = 1u << 4,
+    kValidationBadChars   = 1u << 5,
+    kValidationFewDigits  = 1u << 6,
+    kValidationNoUpper    = 1u << 7,
+    kValidationNoLower    = 1u << 8,
+    kValidationNoDigit    = 1u << 9,
+    kValidationNoSpecial  = 1u << 10
+};
+
+/**
+ * @brief Сводка по классам символов строки (только ASCII-классы)
+ */
+struct CharClassSummary {
+    bool hasUpper = false;
+    bool hasLower = false;
+    bool hasDigit = false;
+    bool hasAt = false;
+    bool hasDot = false;
+    bool onlyEmailChars = true;   // [A-Za-z0-9@._-]
+    bool onlyPhoneChars = true;   // [0-9+() -]
+    bool onlyAlnum = true;        // [A-Za-z0-9]
+    uint32_t digits = 0;
+};
+
+/**
+ * @brief Векторизованное сканирование классов символов
+ * 
+ * SSE2 обрабатывает по 16 байт: каждое сравнение даёт байтовую маску,
+ * movemask сжимает её в 16 бит, дальше классы комбинируются побитовыми
+ * операциями без ветвлений на каждый символ. Байты >= 0x80 отрицательны
+ * в знаковом сравнении и не попадают ни в один ASCII-диапазон - как и в isalnum().
+ */
+inline CharClassSummary scanCharClasses(std::string_view s) noexcept {
+    CharClassSummary r;
+    size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    auto inRange = [](__m128i v, char lo, char hi) {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))),
+            _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(hi + 1))))));
+    };
+    auto eq = [](__m128i v, char ch) {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(ch))));
+    };
+    auto accumulate = [&](__m128i v, uint32_t valid) {
+        uint32_t upper = inRange(v, 'A', 'Z');
+        uint32_t lower = inRange(v, 'a', 'z');
+        uint32_t digit = inRange(v, '0', '9');
+        uint32_t at = eq(v, '@');
+        uint32_t dot = eq(v, '.');
+        uint32_t dash = eq(v, '-');
+        uint32_t alnum = upper | lower | digit;
+        uint32_t email = alnum | at | dot | dash | eq(v, '_');
+        uint32_t phone = digit | dash | eq(v, '+') | eq(v, '(') | eq(v, ')') | eq(v, ' ');
+        r.hasUpper |= upper != 0;
+        r.hasLower |= lower != 0;
+        r.hasDigit |= digit != 0;
+        r.hasAt |= at != 0;
+        r.hasDot |= dot != 0;
+        r.onlyEmailChars &= (valid & ~email) == 0;
+        r.onlyPhoneChars &= (valid & ~phone) == 0;
+        r.onlyAlnum &= (valid & ~alnum) == 0;
+        r.digits += static_cast<uint32_t>(__builtin_popcount(digit));
+    };
+    for (; i + 16 <= s.size(); i += 16) {
+        accumulate(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s.data() + i)), 0xFFFFu);
+    }
+    if (i < s.size()) {
+        // Хвост копируется в выровненный блок, лишние байты отсекает маска valid
+        alignas(16) char tail[16] = {};
+        size_t rest = s.size() - i;
+        std::memcpy(tail, s.data() + i, rest);
+        accumulate(_mm_load_si128(reinterpret_cast<const __m128i*>(tail)), (1u << rest) - 1);
+        i = s.size();
+    }
+#endif
+    for (; i < s.size(); ++i) {
+        char ch = s[i];
+        bool upper = ch >= 'A' && ch <= 'Z';
+        bool lower = ch >= 'a' && ch <= 'z';
+        bool digit = ch >= '0' && ch <= '9';
+        bool alnum = upper || lower || digit;
+        r.hasUpper |= upper;
+        r.hasLower |= lower;
+        r.hasDigit |= digit;
+        r.hasAt |= ch == '@';
+        r.hasDot |= ch == '.';
+        r.onlyEmailChars &= alnum || ch == '@' || ch == '.' || ch == '-' || ch == '_';
+        r.onlyPhoneChars &= digit || ch == '+' || ch == '-' || ch == '(' || ch == ')' || ch == ' ';
+        r.onlyAlnum &= alnum;
+        r.digits += digit;
+    }
+    return r;
+}
+
+inline std::string lengthMessage(uint16_t flag, size_t minLength, size_t maxLength) {
+    switch (flag) {
+        case kValidationEmpty:    return "не может быть пустым";
+        case kValidationTooShort: return "слишком короткий (минимум " + std::to_string(minLength) + " символов)";
+        case kValidationTooLong:  return "слишком длинный (максимум " + std::to_string(maxLength) + " символов)";
+        case kValidationBadChars: return "содержит недопустимые символы";
+        default:                  return "неизвестная ошибка";
+    }
+}
+
+/**
+ * @brief Правила без состояния: те же проверки, что у EmailValidator,
+ * PhoneValidator и PasswordValidator, но const и потокобезопасные
+ */
+struct EmailRule {
+    static constexpr const char* fieldName = "Email";
+    
+    uint16_t check(std::string_view email) const noexcept {
+        if (email.empty()) return kValidationEmpty;
+        if (email.size() < 5) return kValidationTooShort;
+        auto c = scanCharClasses(email);
+        if (!c.hasAt) return kValidationMissingAt;
+        if (!c.hasDot) return kValidationMissingDot;
+        if (!c.onlyEmailChars) return kValidationBadChars;
+        return kValidationOk;
+    }
+    
+    std::string message(uint16_t flag) const {
+        if (flag == kValidationMissingAt) return "должен содержать символ @";
+        if (flag == kValidationMissingDot) return "должен содержать точку";
+        return lengthMessage(flag, 5, 0);
+    }
+};
+
+struct PhoneRule {
+    static constexpr const char* fieldName = "Телефон";
+    
+    uint16_t check(std::string_view phone) const noexcept {
+        if (phone.empty()) return kValidationEmpty;
+        if (phone.size() < 7) return kValidationTooShort;
+        if (phone.size() > 15) return kValidationTooLong;
+        auto c = scanCharClasses(phone);
+        if (!c.onlyPhoneChars) return kValidationBadChars;
+        if (c.digits < 7) return kValidationFewDigits;
+        return kValidationOk;
+    }
+    
+    std::string message(uint16_t flag) const {
+        if (flag == kValidationFewDigits) return "должен содержать минимум 7 цифр";
+        return lengthMessage(flag, 7, 15);
+    }
+};
+
+struct PasswordRule {
+    static constexpr const char* fieldName = "Пароль";
+    
+    size_t minLength = 8;
+    bool requireUpper = true;
+    bool requireLower = true;
+    bool requireDigit = true;
+    bool requireSpecial = false;
+    
+    uint16_t check(std::string_view password) const noexcept {
+        if (password.empty()) return kValidationEmpty;
+        if (password.size() < minLength) return kValidationTooShort;
+        auto c = scanCharClasses(password);
+        uint16_t flags = kValidationOk;
+        if (requireUpper && !c.hasUpper) flags |= kValidationNoUpper;
+        if (requireLower && !c.hasLower) flags |= kValidationNoLower;
+        if (requireDigit && !c.hasDigit) flags |= kValidationNoDigit;
+        if (requireSpecial && c.onlyAlnum) flags |= kValidationNoSpecial;
+        return flags;
+    }
+    
+    std::string message(uint16_t flag) const {
+        switch (flag) {
+            case kValidationNoUpper:   return "должен содержать заглавную букву";
+            case kValidationNoLower:   return "должен содержать строчную букву";
+            case kValidationNoDigit:   return "должен содержать цифру";
+            case kValidationNoSpecial: return "должен содержать специальный символ";
+            default:                   return lengthMessage(flag, minLength, 0);
+        }
+    }
+};
+
+using FieldRule = std::variant<EmailRule, PhoneRule, PasswordRule>;
+using StringColumn = std::vector<std::string_view>;
+
+/**
+ * @brief Результат пакетной валидации
+ * 
+ * rowFailed - битовый набор "строка не прошла хотя бы одно правило".
+ * Маски ошибок хранятся по 2 байта на ячейку (если их запросили),
+ * а строки сообщений формируются только в errors(row).
+ */
+class BatchValidationResult {
+    friend class BatchValidationManager;
+    
+private:
+    size_t rows = 0;
+    std::vector<uint64_t> rowFailed;
+    std::vector<FieldRule> rules;
+    std::vector<std::vector<uint16_t>> flags;  // [правило][строка], пусто в режиме StatusOnly
+    
+public:
+    size_t size() const { return rows; }
+    const std::vector<uint64_t>& statusBits() const { return rowFailed; }
+    
+    bool isValid(size_t row) const {
+        return (rowFailed[row / 64] & (uint64_t{1} << (row % 64))) == 0;
+    }
+    
+    size_t failedCount() const {
+        size_t total = 0;
+        for (uint64_t w : rowFailed) {
+            total += static_cast<size_t>(__builtin_popcountll(w));
+        }
+        return total;
+    }
+    
+    std::vector<std::string> errors(size_t row) const {
+        std::vector<std::string> result;
+        for (size_t r = 0; r < rules.size() && r < flags.size(); ++r) {
+            uint16_t mask = flags[r][row];
+            std::visit([&](const auto& rule) {
+                for (uint16_t bit = 1; bit != 0 && mask != 0; bit = static_cast<uint16_t>(bit << 1)) {
+                    if (mask & bit) {
+                        result.push_back(std::string(rule.fieldName) + ": " + rule.message(bit));
+                        mask = static_cast<uint16_t>(mask & ~bit);
+                    }
+                }
+            }, rules[r]);
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Пакетный аналог ValidationManager
+ * 
+ * Поле ищется по имени один раз на пакет, а не на каждую запись. Строки
+ * делятся на куски кратные 64, чтобы каждый поток писал в свои слова
+ * битового набора без синхронизации.
+ */
+class BatchValidationManager {
+public:
+    enum class Mode { StatusOnly, WithErrors };
+    
+private:
+    std::vector<FieldRule> rules;
+    
+public:
+    void addRule(FieldRule rule) {
+        rules.push_back(rule);
+    }
+    
+    BatchValidationResult validate(const std::map<std::string, StringColumn>& columns,
+                                   Mode mode = Mode::WithErrors,
+                                   unsigned threads = std::thread::hardware_concurrency()) const {
+        std::vector<const StringColumn*> bound;
+        size_t rows = 0;
+        for (const auto& rule : rules) {
+            const char* field = std::visit([](const auto& r) { return r.fieldName; }, rule);
+            auto it = columns.find(field);
+            bound.push_back(it == columns.end() ? nullptr : &it->second);
+            if (it != columns.end()) {
+                rows = std::max(rows, it->second.size());
+            }
+        }
+        
+        BatchValidationResult result;
+        result.rows = rows;
+        result.rules = rules;
+        result.rowFailed.assign((rows + 63) / 64, 0);
+        if (mode == Mode::WithErrors) {
+            result.flags.assign(rules.size(), std::vector<uint16_t>(rows, kValidationOk));
+        }
+        
+        constexpr size_t kChunkRows = 64 * 256;
+        const size_t chunks = (rows + kChunkRows - 1) / kChunkRows;
+        std::atomic<size_t> nextChunk{0};
+        
+        auto worker = [&]() {
+            for (size_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++) {
+                size_t begin = chunk * kChunkRows;
+                size_t end = std::min(rows, begin + kChunkRows);
+                for (size_t r = 0; r < rules.size(); ++r) {
+                    const StringColumn* column = bound[r];
+                    if (column == nullptr) {
+                        continue;
+                    }
+                    uint16_t* out = result.flags.empty() ? nullptr : result.flags[r].data();
+                    // visit один раз на кусок: внутренний цикл мономорфный
+                    std::visit([&](const auto& rule) {
+                        size_t last = std::min(end, column->size());
+                        for (size_t row = begin; row < last; ++row) {
+                            uint16_t f = rule.check((*column)[row]);
+                            if (f != kValidationOk) {
+                                result.rowFailed[row / 64] |= uint64_t{1} << (row % 64);
+                                if (out) out[row] = f;
+                            }
+                        }
+                    }, rules[r]);
+                }
+            }
+        };
+        
+        unsigned workerCount = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(chunks)));
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < workerCount; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& th : pool) {
+            th.join();
+        }
+        return result;
+    }
+};
+
 // ============================================================================
 // ПРИМЕР 2: ДУБЛИРОВАНИЕ ФОРМАТИРОВАНИЯ
 // ============================================================================
@@ -662,6 +1005,100 @@ void demonstrateGoodDRY() {
     GoodConfig::printAll();
 }
 
+void demonstrateBatchValidation() {
+    std::cout << "\n📦 ПАКЕТНАЯ ВАЛИДАЦИЯ ПО КОЛОНКАМ:\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    // Колонки ссылаются на буфер импорта - строки не копируются
+    std::map<std::string, StringColumn> columns = {
+        {"Email",   {"user@example.com", "broken-email", "a@b.c", "x@y.z!"}},
+        {"Телефон", {"+1234567890", "+7 495 123-4567", "12ab567", "+1234567890"}},
+        {"Пароль",  {"SecurePass123", "password", "Sh0rt", "ValidPass9"}}
+    };
+    
+    BatchValidationManager manager;
+    manager.addRule(EmailRule{});
+    manager.addRule(PhoneRule{});
+    manager.addRule(PasswordRule{});
+    
+    auto result = manager.validate(columns);
+    for (size_t row = 0; row < result.size(); ++row) {
+        if (result.isValid(row)) {
+            std::cout << "✅ Строка " << row << " валидна\n";
+            continue;
+        }
+        std::cout << "❌ Строка " << row << ":\n";
+        for (const auto& error : result.errors(row)) {
+            std::cout << "   " << error << "\n";
+        }
+    }
+}
+
+void benchmarkBatchValidation() {
+    std::cout << "\n⏱️ БЕНЧМАРК: построчная vs пакетная валидация\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    constexpr size_t kRows = 1'000'000;
+    std::mt19937 rng(7);
+    std::vector<std::string> emails, phones, passwords;
+    emails.reserve(kRows);
+    phones.reserve(kRows);
+    passwords.reserve(kRows);
+    for (size_t i = 0; i < kRows; ++i) {
+        bool bad = rng() % 10 == 0;
+        emails.push_back("user" + std::to_string(i) + (bad ? "#example.com" : "@example.com"));
+        phones.push_back("+7(9" + std::to_string(10 + rng() % 90) + ")" + std::to_string(100 + rng() % 900) + "-1122");
+        passwords.push_back(bad ? "weakpassword" : "Str0ngPass" + std::to_string(i));
+    }
+    
+    std::map<std::string, StringColumn> columns;
+    columns["Email"].assign(emails.begin(), emails.end());
+    columns["Телефон"].assign(phones.begin(), phones.end());
+    columns["Пароль"].assign(passwords.begin(), passwords.end());
+    
+    auto rowsPerSecond = [](std::chrono::steady_clock::duration elapsed) {
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        return static_cast<long long>(static_cast<double>(kRows) / std::max(seconds, 1e-9));
+    };
+    
+    // Исходные валидаторы с состоянием: одна запись за раз, без печати
+    EmailValidator email;
+    PhoneValidator phone;
+    PasswordValidator password;
+    size_t rowWiseFailed = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kRows; ++i) {
+        bool ok = email.validate(emails[i]);
+        ok = phone.validate(phones[i]) && ok;
+        ok = password.validate(passwords[i]) && ok;
+        rowWiseFailed += ok ? 0 : 1;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    std::cout << "Строк: " << kRows << "\n";
+    std::cout << "  BaseValidator построчно:        " << rowsPerSecond(t1 - t0) << " строк/с\n";
+    
+    BatchValidationManager manager;
+    manager.addRule(EmailRule{});
+    manager.addRule(PhoneRule{});
+    manager.addRule(PasswordRule{});
+    
+    std::vector<unsigned> threadCounts = {1};
+    if (std::thread::hardware_concurrency() > 1) {
+        threadCounts.push_back(std::thread::hardware_concurrency());
+    }
+    for (unsigned threads : threadCounts) {
+        for (auto mode : {BatchValidationManager::Mode::StatusOnly, BatchValidationManager::Mode::WithErrors}) {
+            auto start = std::chrono::steady_clock::now();
+            auto result = manager.validate(columns, mode, threads);
+            auto stop = std::chrono::steady_clock::now();
+            std::cout << "  пакетно, потоков " << threads
+                      << (mode == BatchValidationManager::Mode::StatusOnly ? ", только статус: " : ", с ошибками:    ")
+                      << rowsPerSecond(stop - start) << " строк/с"
+                      << (result.failedCount() == rowWiseFailed ? "" : " ❌ расхождение!") << "\n";
+        }
+    }
+}
+
 void analyzeTradeOffs() {
     std::cout << "\n🔬 АНАЛИЗ КОМПРОМИССОВ DRY:\n";
     std::cout << std::string(50, '-') << "\n";
@@ -693,6 +1130,8 @@ int main() {
     
     demonstrateBadDRY();
     demonstrateGoodDRY();
+    demonstrateBatchValidation();
+    benchmarkBatchValidation();
     analyzeTradeOffs();
     
     std::cout << "\n📚 МАТЕМАТИЧЕСКОЕ ОБОСНОВАНИЕ:\n";
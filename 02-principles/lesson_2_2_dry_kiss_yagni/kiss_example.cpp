@@ -17,6 +17,20 @@
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <chrono>
+#include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+#include <array>
+#include <utility>
+
+#include "optimization_barrier.h"
 
 /**
  * @brief Математическая формализация KISS
@@ -299,6 +313,281 @@ public:
     }
 };
 
+/**
+ * @brief Типизированный реестр конфигурации для горячих путей
+ * 
+ * GoodConfig прост, но каждое чтение - поиск в std::map по строке и
+ * std::stoi в try/catch. Здесь ключи интернируются один раз (declare),
+ * значения разбираются один раз при загрузке в типизированные слоты,
+ * а чтение по дескриптору - это одна acquire-загрузка указателя и индекс.
+ * 
+ * Горячая перезагрузка строит новый неизменяемый снимок и публикует его
+ * атомарной заменой указателя - читатели никогда не берут блокировку.
+ * Прежний снимок освобождается после периода ожидания (grace period):
+ * читатель на время чтения отмечается в счётчике своего шарда, а писатель
+ * дважды переключает эпоху и ждёт, пока счётчики прошлых эпох обнулятся.
+ * В памяти остаётся один снимок, сколько бы перезагрузок ни было.
+ */
+struct ConfigSnapshot {
+    uint64_t version = 0;
+    std::vector<int> ints;
+    std::vector<uint8_t> bools;
+    std::vector<double> doubles;
+    std::vector<std::string> strings;
+};
+
+template<typename T>
+class ConfigHandle {
+    friend class ConfigRegistry;
+    
+private:
+    uint32_t index = 0;
+    explicit ConfigHandle(uint32_t i) : index(i) {}
+    
+public:
+    ConfigHandle() = default;
+};
+
+class ConfigRegistry {
+private:
+    enum class SlotType { Int, Bool, Double, String };
+    
+    struct SlotInfo {
+        SlotType type;
+        uint32_t index;
+    };
+    
+    // Счётчики читателей по эпохам; шард на кэш-линию, чтобы потоки не делили линию
+    struct alignas(64) ReaderShard {
+        std::atomic<uint64_t> active[2] = {0, 0};
+    };
+    static constexpr size_t kReaderShards = 16;
+    
+    std::unordered_map<std::string, SlotInfo> keys;           // только для declare/reload
+    std::atomic<const ConfigSnapshot*> current{nullptr};
+    std::unique_ptr<const ConfigSnapshot> owned;               // владеет тем, на что указывает current
+    mutable std::array<ReaderShard, kReaderShards> readers;
+    std::atomic<uint32_t> readerEpoch{0};
+    uint64_t reclaimed = 0;
+    mutable std::mutex writerMutex;
+    
+    static size_t readerShardIndex() {
+        static std::atomic<size_t> nextShard{0};
+        thread_local size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % kReaderShards;
+        return shard;
+    }
+    
+    // Читатель, отметившийся до публикации нового снимка, держит счётчик
+    // одной из эпох; две смены эпохи с ожиданием покрывают обе чётности
+    void waitForReaders() {
+        for (int round = 0; round < 2; ++round) {
+            uint32_t epoch = readerEpoch.load(std::memory_order_relaxed);
+            readerEpoch.store(epoch ^ 1, std::memory_order_seq_cst);
+            for (auto& shard : readers) {
+                while (shard.active[epoch & 1].load(std::memory_order_seq_cst) != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+    
+    template<typename T>
+    static constexpr SlotType slotTypeOf() {
+        if constexpr (std::is_same_v<T, int>) return SlotType::Int;
+        else if constexpr (std::is_same_v<T, bool>) return SlotType::Bool;
+        else if constexpr (std::is_same_v<T, double>) return SlotType::Double;
+        else {
+            static_assert(std::is_same_v<T, std::string>, "Поддерживаются int, bool, double и std::string");
+            return SlotType::String;
+        }
+    }
+    
+    template<typename T>
+    static auto& column(ConfigSnapshot& s) {
+        if constexpr (std::is_same_v<T, int>) return s.ints;
+        else if constexpr (std::is_same_v<T, bool>) return s.bools;
+        else if constexpr (std::is_same_v<T, double>) return s.doubles;
+        else return s.strings;
+    }
+    
+    template<typename T>
+    static const auto& column(const ConfigSnapshot& s) {
+        return column<T>(const_cast<ConfigSnapshot&>(s));
+    }
+    
+    // Вызывается под writerMutex; возвращается, когда прежний снимок освобождён
+    void publish(std::unique_ptr<ConfigSnapshot> next) {
+        next->version = owned ? owned->version + 1 : 1;
+        std::unique_ptr<const ConfigSnapshot> previous = std::move(owned);
+        owned = std::move(next);
+        current.store(owned.get(), std::memory_order_seq_cst);
+        if (previous) {
+            waitForReaders();
+            ++reclaimed;
+        }
+    }
+    
+    std::unique_ptr<ConfigSnapshot> copyCurrent() const {
+        const ConfigSnapshot* prev = current.load(std::memory_order_relaxed);
+        return prev ? std::make_unique<ConfigSnapshot>(*prev) : std::make_unique<ConfigSnapshot>();
+    }
+    
+    static bool parseInto(ConfigSnapshot& s, const SlotInfo& slot, const std::string& raw) {
+        switch (slot.type) {
+            case SlotType::Int: {
+                int value = 0;
+                auto [end, ec] = std::from_chars(raw.data(), raw.data() + raw.size(), value);
+                if (ec != std::errc() || end != raw.data() + raw.size()) return false;
+                s.ints[slot.index] = value;
+                return true;
+            }
+            case SlotType::Bool:
+                if (raw == "true" || raw == "1" || raw == "yes" || raw == "on") {
+                    s.bools[slot.index] = 1;
+                } else if (raw == "false" || raw == "0" || raw == "no" || raw == "off") {
+                    s.bools[slot.index] = 0;
+                } else {
+                    return false;
+                }
+                return true;
+            case SlotType::Double: {
+                char* end = nullptr;
+                double value = std::strtod(raw.c_str(), &end);
+                if (raw.empty() || end != raw.c_str() + raw.size()) return false;
+                s.doubles[slot.index] = value;
+                return true;
+            }
+            case SlotType::String:
+                s.strings[slot.index] = raw;
+                return true;
+        }
+        return false;
+    }
+    
+public:
+    /**
+     * @brief Закреплённый снимок: пока view жив, снимок не освобождается
+     * 
+     * Один view на запрос - и все ключи читаются из одной версии.
+     * Держать view долго нельзя: перезагрузка ждёт его разрушения.
+     */
+    class View {
+        friend class ConfigRegistry;
+        
+    private:
+        std::atomic<uint64_t>* counter;
+        const ConfigSnapshot* pinned;
+        
+        View(std::atomic<uint64_t>* c, const ConfigSnapshot* s) : counter(c), pinned(s) {}
+        
+    public:
+        View(const View&) = delete;
+        View& operator=(const View&) = delete;
+        View(View&& other) noexcept : counter(std::exchange(other.counter, nullptr)), pinned(other.pinned) {}
+        View& operator=(View&&) = delete;
+        
+        ~View() {
+            if (counter) {
+                counter->fetch_sub(1, std::memory_order_release);
+            }
+        }
+        
+        template<typename T>
+        std::conditional_t<std::is_same_v<T, std::string>, const std::string&, T> get(ConfigHandle<T> handle) const {
+            if constexpr (std::is_same_v<T, bool>) {
+                return pinned->bools[handle.index] != 0;
+            } else {
+                return column<T>(*pinned)[handle.index];
+            }
+        }
+        
+        const ConfigSnapshot& snapshot() const { return *pinned; }
+        uint64_t version() const { return pinned->version; }
+    };
+    
+    ConfigRegistry() {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        publish(std::make_unique<ConfigSnapshot>());
+    }
+    
+    ConfigRegistry(const ConfigRegistry&) = delete;
+    ConfigRegistry& operator=(const ConfigRegistry&) = delete;
+    
+    /**
+     * @brief Объявить ключ и получить дескриптор для O(1) чтения
+     * 
+     * Повторное объявление с тем же типом возвращает тот же слот.
+     */
+    template<typename T>
+    ConfigHandle<T> declare(const std::string& key, T defaultValue) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        auto it = keys.find(key);
+        if (it != keys.end()) {
+            if (it->second.type != slotTypeOf<T>()) {
+                throw std::invalid_argument("Ключ '" + key + "' уже объявлен с другим типом");
+            }
+            return ConfigHandle<T>(it->second.index);
+        }
+        
+        auto next = copyCurrent();
+        auto& values = column<T>(*next);
+        auto index = static_cast<uint32_t>(values.size());
+        values.push_back(defaultValue);
+        keys.emplace(key, SlotInfo{slotTypeOf<T>(), index});
+        publish(std::move(next));
+        return ConfigHandle<T>(index);
+    }
+    
+    /**
+     * @brief Горячая перезагрузка: разобрать строки один раз и опубликовать снимок
+     * @return Список ошибок разбора (такие ключи сохраняют прежнее значение)
+     */
+    std::vector<std::string> reload(const std::map<std::string, std::string>& raw) {
+        std::vector<std::string> errors;
+        std::lock_guard<std::mutex> lock(writerMutex);
+        auto next = copyCurrent();
+        for (const auto& [key, value] : raw) {
+            auto it = keys.find(key);
+            if (it == keys.end()) {
+                errors.push_back(key + ": неизвестный ключ");
+            } else if (!parseInto(*next, it->second, value)) {
+                errors.push_back(key + ": не удалось разобрать '" + value + "'");
+            }
+        }
+        publish(std::move(next));
+        return errors;
+    }
+    
+    /**
+     * @brief Закрепить текущий снимок: два атомарных RMW на счётчике своего шарда
+     */
+    View read() const {
+        auto& shard = readers[readerShardIndex()];
+        uint32_t epoch = readerEpoch.load(std::memory_order_relaxed);
+        std::atomic<uint64_t>* counter = &shard.active[epoch & 1];
+        counter->fetch_add(1, std::memory_order_seq_cst);
+        return View(counter, current.load(std::memory_order_seq_cst));
+    }
+    
+    /**
+     * @brief Одиночное чтение; строка возвращается копией, так как снимок
+     * может быть освобождён сразу после возврата
+     */
+    template<typename T>
+    T get(ConfigHandle<T> handle) const {
+        return read().get(handle);
+    }
+    
+    uint64_t version() const {
+        return read().version();
+    }
+    
+    uint64_t reclaimedSnapshots() const {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        return reclaimed;
+    }
+};
+
 // ============================================================================
 // ПРИМЕР 2: ИЗБЫТОЧНАЯ СЛОЖНОСТЬ В СИСТЕМЕ УВЕДОМЛЕНИЙ
 // ============================================================================
@@ -463,7 +752,7 @@ public:
     SimpleNotification(const std::string& msg, const std::string& rec) 
         : message(msg), recipient(rec) {}
     
-    void send() {
+    void send() const {
         std::cout << "📤 Отправка уведомления для " << recipient << ": " << message << "\n";
         // Простая логика отправки
     }
@@ -715,6 +1004,107 @@ void demonstrateGoodKISS() {
     std::cout << "Размер кэша: " << simpleCache.size() << "\n";
 }
 
+void demonstrateConfigRegistry() {
+    std::cout << "\n⚡ ТИПИЗИРОВАННЫЙ РЕЕСТР КОНФИГУРАЦИИ:\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    ConfigRegistry registry;
+    auto dbHost = registry.declare<std::string>("database.host", "localhost");
+    auto dbPort = registry.declare("database.port", 5432);
+    auto debug = registry.declare("debug.enabled", false);
+    auto sampleRate = registry.declare("tracing.sample_rate", 0.01);
+    
+    auto errors = registry.reload({
+        {"database.host", "db.internal"},
+        {"database.port", "6432"},
+        {"debug.enabled", "true"},
+        {"tracing.sample_rate", "не число"},
+        {"unknown.key", "42"}
+    });
+    
+    std::cout << "Версия снимка: " << registry.version() << "\n";
+    std::cout << "DB Host: " << registry.get(dbHost) << "\n";
+    std::cout << "DB Port: " << registry.get(dbPort) << "\n";
+    std::cout << "Debug: " << registry.get(debug) << "\n";
+    std::cout << "Sample rate: " << registry.get(sampleRate) << "\n";
+    for (const auto& error : errors) {
+        std::cout << "⚠️ " << error << "\n";
+    }
+}
+
+void benchmarkConfigReads() {
+    std::cout << "\n⏱️ БЕНЧМАРК: чтение флагов на каждый запрос\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    constexpr size_t kReads = 5'000'000;
+    GoodConfig goodConfig;
+    goodConfig.set("server.max_connections", 1024);
+    goodConfig.set("feature.new_checkout", true);
+    
+    ConfigRegistry registry;
+    auto maxConnections = registry.declare("server.max_connections", 1024);
+    auto newCheckout = registry.declare("feature.new_checkout", true);
+    
+    auto nsPerRead = [](std::chrono::steady_clock::duration elapsed, size_t reads) {
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(reads);
+    };
+    
+    long long sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kReads; ++i) {
+        sink += goodConfig.getInt("server.max_connections") + goodConfig.getBool("feature.new_checkout");
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kReads; ++i) {
+        auto view = registry.read();  // один снимок на "запрос"
+        sink += view.get(maxConnections) + view.get(newCheckout);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    cpp_patterns::doNotOptimize(sink);
+    std::cout << "GoodConfig (map + stoi):       " << nsPerRead(t1 - t0, kReads * 2) << " нс/чтение\n";
+    std::cout << "ConfigRegistry (view на 2):    " << nsPerRead(t2 - t1, kReads * 2) << " нс/чтение\n";
+    
+    // Читатели во всех потоках + писатель, перезагружающий конфигурацию
+    unsigned readers = std::max(2u, std::thread::hardware_concurrency());
+    std::atomic<bool> stop{false};
+    std::atomic<long long> totalReads{0};
+    const uint64_t versionBefore = registry.version();
+    std::thread writer([&]() {
+        int value = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            registry.reload({{"server.max_connections", std::to_string(1000 + (value++ % 100))}});
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < readers; ++t) {
+        pool.emplace_back([&]() {
+            long long local = 0;
+            for (size_t i = 0; i < kReads; ++i) {
+                auto view = registry.read();
+                local += view.get(maxConnections) + view.get(newCheckout);
+            }
+            totalReads.fetch_add(static_cast<long long>(kReads * 2), std::memory_order_relaxed);
+            cpp_patterns::doNotOptimize(local);
+        });
+    }
+    for (auto& th : pool) {
+        th.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    stop = true;
+    writer.join();
+    
+    std::cout << "Потоков-читателей: " << readers << ", перезагрузок: " << registry.version() - versionBefore
+              << ", суммарно " << static_cast<long long>(static_cast<double>(totalReads.load()) /
+                                   std::chrono::duration<double>(elapsed).count() / 1e6)
+              << " млн чтений/с без блокировок\n";
+    std::cout << "Освобождено снимков: " << registry.reclaimedSnapshots()
+              << " (в памяти всегда один текущий)\n";
+}
+
 void analyzeTradeOffs() {
     std::cout << "\n🔬 АНАЛИЗ КОМПРОМИССОВ KISS:\n";
     std::cout << std::string(50, '-') << "\n";
@@ -746,6 +1136,8 @@ int main() {
     
     demonstrateBadKISS();
     demonstrateGoodKISS();
+    demonstrateConfigRegistry();
+    benchmarkConfigReads();
     analyzeTradeOffs();
     
     std::cout << "\n📚 МАТЕМАТИЧЕСКОЕ ОБОСНОВАНИЕ:\n";
@@ -17,6 +17,12 @@
 #include <thread>
 #include <vector>
 #include <chrono>
+#include <atomic>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+#include "optimization_barrier.h"
 
 // ============================================================================
 // КЛАССИЧЕСКИЙ SINGLETON (ПРОБЛЕМНЫЙ)
@@ -71,12 +77,13 @@ ClassicSingleton* ClassicSingleton::instance_ = nullptr;
  * - Правильное уничтожение
  * 
  * Недостатки:
- * - Накладные расходы на блокировку при каждом вызове
- * - Двойная проверка блокировки
+ * - Атомарная загрузка и ветвление при каждом вызове, блокировка при первом
+ * - Двойная проверка блокировки корректна только с атомарным указателем
  */
 class ThreadSafeSingleton {
 private:
-    static std::unique_ptr<ThreadSafeSingleton> instance_;
+    static std::unique_ptr<ThreadSafeSingleton> storage_;
+    static std::atomic<ThreadSafeSingleton*> instance_;
     static std::mutex mutex_;
     std::string data_;
     
@@ -87,13 +94,17 @@ private:
 public:
     static ThreadSafeSingleton& getInstance() {
         // Двойная проверка блокировки (Double-Checked Locking)
-        if (!instance_) {
+        ThreadSafeSingleton* instance = instance_.load(std::memory_order_acquire);
+        if (!instance) {
             std::lock_guard<std::mutex> lock(mutex_);
-            if (!instance_) {
-                instance_ = std::make_unique<ThreadSafeSingleton>();
+            instance = instance_.load(std::memory_order_relaxed);
+            if (!instance) {
+                storage_.reset(new ThreadSafeSingleton());  // make_unique не видит private-конструктор
+                instance = storage_.get();
+                instance_.store(instance, std::memory_order_release);
             }
         }
-        return *instance_;
+        return *instance;
     }
     
     const std::string& getData() const { return data_; }
@@ -105,7 +116,8 @@ public:
 };
 
 // Статические переменные
-std::unique_ptr<ThreadSafeSingleton> ThreadSafeSingleton::instance_ = nullptr;
+std::unique_ptr<ThreadSafeSingleton> ThreadSafeSingleton::storage_ = nullptr;
+std::atomic<ThreadSafeSingleton*> ThreadSafeSingleton::instance_{nullptr};
 std::mutex ThreadSafeSingleton::mutex_;
 
 // ============================================================================
@@ -174,7 +186,7 @@ private:
 public:
     static CallOnceSingleton& getInstance() {
         std::call_once(initialized_, []() {
-            instance_ = std::make_unique<CallOnceSingleton>();
+            instance_.reset(new CallOnceSingleton());
         });
         return *instance_;
     }
@@ -191,6 +203,119 @@ public:
 std::unique_ptr<CallOnceSingleton> CallOnceSingleton::instance_ = nullptr;
 std::once_flag CallOnceSingleton::initialized_;
 
+// ============================================================================
+// SINGLETON БЕЗ КОНКУРЕНЦИИ В УСТОЙЧИВОМ РЕЖИМЕ
+// ============================================================================
+
+/**
+ * @brief Ленивый Singleton с кэшированием указателя в каждом потоке
+ * 
+ * Первый вызов в потоке проходит через Meyers-инициализацию (guard
+ * и, возможно, ожидание), дальше getInstance() - чтение thread_local
+ * указателя: ни блокировки, ни общего guard-флага, который все потоки
+ * читают из одной кэш-линии.
+ * 
+ * T объявляет ThreadCachedSingleton<T> другом, чтобы закрыть конструктор.
+ */
+template<typename T>
+class ThreadCachedSingleton {
+public:
+    static T& getInstance() {
+        thread_local T* cached = nullptr;
+        if (cached == nullptr) {
+            cached = &create();
+        }
+        return *cached;
+    }
+    
+private:
+    static T& create() {
+        static T instance;
+        return instance;
+    }
+};
+
+/**
+ * @brief Singleton, инициализируемый на объявленной фазе запуска
+ * 
+ * initialize() вызывается из main до старта рабочих потоков; создание
+ * потока синхронизирует память, поэтому instance() - обычная загрузка
+ * статического указателя без проверок. Вызов instance() до initialize()
+ * или после shutdown() - ошибка программиста (assert в отладке).
+ */
+template<typename T>
+class StartupSingleton {
+private:
+    static inline std::unique_ptr<T> storage_;
+    static inline T* instance_ = nullptr;
+    
+public:
+    template<typename... Args>
+    static T& initialize(Args&&... args) {
+        if (instance_ != nullptr) {
+            throw std::logic_error("StartupSingleton: повторная инициализация");
+        }
+        storage_.reset(new T(std::forward<Args>(args)...));
+        instance_ = storage_.get();
+        return *instance_;
+    }
+    
+    static T& instance() noexcept {
+        assert(instance_ != nullptr && "StartupSingleton::initialize() не вызван");
+        return *instance_;
+    }
+    
+    /**
+     * @brief Уничтожить экземпляр на фазе остановки (после join всех потоков)
+     */
+    static void shutdown() noexcept {
+        instance_ = nullptr;
+        storage_.reset();
+    }
+};
+
+/**
+ * @brief Сервис с ленивой инициализацией и кэшем в потоках
+ */
+class CachedService {
+private:
+    std::string data_;
+    
+    CachedService() : data_("Thread-Cached Singleton Data") {
+        std::cout << "CachedService: Создан экземпляр" << std::endl;
+    }
+    
+    friend class ThreadCachedSingleton<CachedService>;
+    
+public:
+    const std::string& getData() const { return data_; }
+    void setData(const std::string& data) { data_ = data; }
+    
+    CachedService(const CachedService&) = delete;
+    CachedService& operator=(const CachedService&) = delete;
+};
+
+/**
+ * @brief Сервис, создаваемый на фазе запуска
+ */
+class StartupService {
+private:
+    std::string data_;
+    
+    explicit StartupService(std::string data) : data_(std::move(data)) {
+        std::cout << "StartupService: Создан экземпляр" << std::endl;
+    }
+    
+    friend class StartupSingleton<StartupService>;
+    
+public:
+    const std::string& getData() const { return data_; }
+    void setData(const std::string& data) { data_ = data; }
+    
+    StartupService(const StartupService&) = delete;
+    StartupService& operator=(const StartupService&) = delete;
+};
+
 // ============================================================================
 // ПРАКТИЧЕСКИЙ ПРИМЕР: ЛОГГЕР
 // ============================================================================
@@ -314,6 +439,86 @@ void demonstrateCallOnceSingleton() {
     std::cout << "Данные через singleton2: " << singleton2.getData() << std::endl;
 }
 
+/**
+ * @brief Демонстрация Singleton без конкуренции в устойчивом режиме
+ */
+void demonstrateContentionFreeSingletons() {
+    std::cout << "\n=== Singleton без блокировок на горячем пути ===" << std::endl;
+    
+    auto& cached1 = ThreadCachedSingleton<CachedService>::getInstance();
+    auto& cached2 = ThreadCachedSingleton<CachedService>::getInstance();
+    std::cout << "Thread-cached: cached1 == cached2: " << (&cached1 == &cached2) << std::endl;
+    
+    // Фаза запуска: до создания рабочих потоков
+    StartupSingleton<StartupService>::initialize("Startup Singleton Data");
+    
+    std::thread worker([] {
+        std::cout << "Поток видит: " << StartupSingleton<StartupService>::instance().getData()
+                  << ", тот же CachedService: "
+                  << (&ThreadCachedSingleton<CachedService>::getInstance() == &ThreadCachedSingleton<CachedService>::getInstance())
+                  << std::endl;
+    });
+    worker.join();
+}
+
+/**
+ * @brief Бенчмарк getInstance() для всех вариантов при 1-64 потоках
+ * 
+ * ClassicSingleton не участвует: он не потокобезопасен.
+ */
+void benchmarkSingletonAccess() {
+    std::cout << "\n=== Бенчмарк: getInstance(), нс/операцию ===" << std::endl;
+    
+    constexpr size_t kCallsPerThread = 2'000'000;
+    
+    auto measure = [](unsigned threadCount, auto access) {
+        std::atomic<bool> go{false};
+        std::atomic<unsigned> readyCount{0};
+        std::vector<double> nsPerOp(threadCount);
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                access();  // первая инициализация (и кэш потока) - вне замера
+                readyCount.fetch_add(1);
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                auto start = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < kCallsPerThread; ++i) {
+                    cpp_patterns::doNotOptimize(access());
+                }
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                nsPerOp[t] = std::chrono::duration<double, std::nano>(elapsed).count() / kCallsPerThread;
+            });
+        }
+        while (readyCount.load() < threadCount) {
+            std::this_thread::yield();
+        }
+        go.store(true, std::memory_order_release);
+        for (auto& th : threads) {
+            th.join();
+        }
+        double sum = 0.0;
+        for (double v : nsPerOp) {
+            sum += v;
+        }
+        return sum / threadCount;
+    };
+    
+    std::cout << "Аппаратных потоков: " << std::thread::hardware_concurrency()
+              << " (при превышении время включает вытеснение)" << std::endl;
+    std::cout << "потоков | ThreadSafe | Meyers | CallOnce | ThreadCached | Startup" << std::endl;
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+        std::cout << threads << "\t| "
+                  << measure(threads, [] { return &ThreadSafeSingleton::getInstance(); }) << " | "
+                  << measure(threads, [] { return &MeyersSingleton::getInstance(); }) << " | "
+                  << measure(threads, [] { return &CallOnceSingleton::getInstance(); }) << " | "
+                  << measure(threads, [] { return &ThreadCachedSingleton<CachedService>::getInstance(); }) << " | "
+                  << measure(threads, [] { return &StartupSingleton<StartupService>::instance(); })
+                  << std::endl;
+    }
+}
+
 /**
  * @brief Демонстрация практического использования логгера
  */
@@ -373,13 +578,19 @@ int main() {
     demonstrateThreadSafeSingleton();
     demonstrateMeyersSingleton();
     demonstrateCallOnceSingleton();
+    demonstrateContentionFreeSingletons();
     demonstrateLogger();
     demonstrateMultithreading();
+    benchmarkSingletonAccess();
+    
+    // Фаза остановки: все потоки уже завершены
+    StartupSingleton<StartupService>::shutdown();
     
     std::cout << "\n✅ Демонстрация Singleton завершена!" << std::endl;
     std::cout << "\n🎯 Ключевые выводы:" << std::endl;
     std::cout << "• Meyers Singleton - лучший выбор для большинства случаев" << std::endl;
     std::cout << "• Thread-safe с C++11 без накладных расходов" << std::endl;
+    std::cout << "• На горячем пути: кэш указателя в потоке или инициализация на фазе запуска" << std::endl;
     std::cout << "• Рассмотрите альтернативы: Dependency Injection" << std::endl;
     std::cout << "• Singleton нарушает принципы SOLID" << std::endl;
     std::cout << "• Используйте только когда действительно нужен единственный экземпляр" << std::endl;
@@ -5,6 +5,13 @@
 #include <functional>
 #include <vector>
 #include <stdexcept>
+#include <cmath>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+#include <type_traits>
+
+#include "slot_pool.h"
 
 /**
  * @file factory_method.cpp
@@ -343,6 +350,158 @@ public:
     }
 };
 
+// ============================================================================
+// ФАБРИКА С ПУЛАМИ И АРЕНОЙ КАДРА
+// ============================================================================
+
+/**
+ * @brief Арена кадра: линейное выделение и массовое освобождение в reset()
+ * 
+ * Подходит для объектов, живущих ровно один кадр/тик: выделение - сдвиг
+ * указателя, а вместо delete для каждого объекта - один reset().
+ */
+class FrameArena {
+private:
+    struct Finalizer {
+        void* object;
+        void (*destroy)(void*);
+    };
+    
+    std::unique_ptr<unsigned char[]> buffer_;
+    size_t capacity_;
+    size_t offset_ = 0;
+    std::vector<Finalizer> finalizers_;
+    
+public:
+    explicit FrameArena(size_t bytes) : buffer_(new unsigned char[bytes]), capacity_(bytes) {}
+    
+    ~FrameArena() { reset(); }
+    
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    
+    void* allocate(size_t size, size_t align) {
+        auto base = reinterpret_cast<uintptr_t>(buffer_.get());
+        uintptr_t aligned = (base + offset_ + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+        size_t newOffset = static_cast<size_t>(aligned - base) + size;
+        if (newOffset > capacity_) {
+            throw std::bad_alloc();
+        }
+        offset_ = newOffset;
+        return reinterpret_cast<void*>(aligned);
+    }
+    
+    void onReset(void* object, void (*destroy)(void*)) {
+        finalizers_.push_back({object, destroy});
+    }
+    
+    /**
+     * @brief Разрушить все объекты кадра (в обратном порядке) и сбросить арену
+     */
+    void reset() {
+        for (auto it = finalizers_.rbegin(); it != finalizers_.rend(); ++it) {
+            it->destroy(it->object);
+        }
+        finalizers_.clear();
+        offset_ = 0;
+    }
+    
+    size_t used() const { return offset_; }
+};
+
+/**
+ * @brief Реестр фабрик с пулами на каждый тип
+ * 
+ * В отличие от FactoryRegistry, имя разрешается в целочисленный TypeId
+ * один раз (resolve), а create/createN по TypeId - индекс в векторе,
+ * слот из пула и placement new, без обращения к куче в устойчивом режиме.
+ * Handle - это unique_ptr с deleter'ом, возвращающим слот в пул, поэтому
+ * вызывающий код остаётся таким же, как с make_unique.
+ * Все Handle должны быть уничтожены раньше реестра.
+ */
+template<typename BaseType>
+class PooledFactoryRegistry {
+public:
+    using TypeId = uint32_t;
+    
+    using PoolDeleter = cpp_patterns::SlotPoolDeleter<BaseType>;
+    using Handle = std::unique_ptr<BaseType, PoolDeleter>;
+    
+private:
+    struct Entry {
+        std::string name;
+        size_t size;
+        size_t align;
+        std::unique_ptr<cpp_patterns::SlotPool> pool;
+        std::function<BaseType*(void*)> construct;
+    };
+    
+    std::vector<Entry> entries_;
+    std::map<std::string, TypeId> ids_;
+    
+    BaseType* constructInto(const Entry& entry, void* memory) {
+        return entry.construct(memory);
+    }
+    
+public:
+    template<typename DerivedType, typename... Args>
+    TypeId registerType(const std::string& name, Args... args) {
+        static_assert(std::is_base_of_v<BaseType, DerivedType>, "DerivedType должен наследовать BaseType");
+        if (ids_.count(name) != 0) {
+            throw std::invalid_argument("Тип уже зарегистрирован: " + name);
+        }
+        auto id = static_cast<TypeId>(entries_.size());
+        entries_.push_back({name, sizeof(DerivedType), alignof(DerivedType),
+                            std::make_unique<cpp_patterns::SlotPool>(sizeof(DerivedType), alignof(DerivedType)),
+                            [args...](void* memory) -> BaseType* { return new (memory) DerivedType(args...); }});
+        ids_[name] = id;
+        return id;
+    }
+    
+    TypeId resolve(const std::string& name) const {
+        auto it = ids_.find(name);
+        if (it == ids_.end()) {
+            throw std::invalid_argument("Неизвестный тип: " + name);
+        }
+        return it->second;
+    }
+    
+    Handle create(TypeId id) {
+        Entry& entry = entries_.at(id);
+        void* slot = entry.pool->acquire();
+        try {
+            return Handle(constructInto(entry, slot), PoolDeleter{entry.pool.get()});
+        } catch (...) {
+            entry.pool->release(slot);
+            throw;
+        }
+    }
+    
+    std::vector<Handle> createN(TypeId id, size_t count) {
+        entries_.at(id).pool->reserve(count);
+        std::vector<Handle> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            result.push_back(create(id));
+        }
+        return result;
+    }
+    
+    /**
+     * @brief Создать объект на арене кадра: разрушится при arena.reset()
+     */
+    BaseType* createInArena(TypeId id, FrameArena& arena) {
+        const Entry& entry = entries_.at(id);
+        BaseType* object = constructInto(entry, arena.allocate(entry.size, entry.align));
+        arena.onReset(object, [](void* p) { static_cast<BaseType*>(p)->~BaseType(); });
+        return object;
+    }
+    
+    size_t liveCount(TypeId id) const { return entries_.at(id).pool->inUse(); }
+    size_t pooledCapacity(TypeId id) const { return entries_.at(id).pool->capacity(); }
+    const std::string& nameOf(TypeId id) const { return entries_.at(id).name; }
+};
+
 // ============================================================================
 // ДЕМОНСТРАЦИОННЫЕ ФУНКЦИИ
 // ============================================================================
@@ -454,6 +613,43 @@ void demonstrateRegistryFactory() {
     doc3->close();
 }
 
+/**
+ * @brief Демонстрация фабрики с пулами и ареной кадра
+ */
+void demonstratePooledRegistry() {
+    std::cout << "\n=== Registry с пулами и ареной ===" << std::endl;
+    
+    PooledFactoryRegistry<Document> registry;
+    registry.registerType<PDFDocument>("pdf");
+    registry.registerType<WordDocument>("word");
+    registry.registerType<PDFDocument>("custom_pdf", "custom.pdf");
+    
+    // Имя разрешается один раз, дальше работаем с целым TypeId
+    auto pdf = registry.resolve("pdf");
+    auto word = registry.resolve("word");
+    
+    {
+        auto batch = registry.createN(pdf, 100);
+        auto doc = registry.create(word);
+        doc->open();
+        doc->close();
+        std::cout << "Живых PDF: " << registry.liveCount(pdf)
+                  << ", ёмкость пула: " << registry.pooledCapacity(pdf) << std::endl;
+    }
+    std::cout << "После выхода из области видимости живых PDF: " << registry.liveCount(pdf)
+              << " (слоты вернулись в пул)" << std::endl;
+    
+    FrameArena arena(64 * 1024);
+    auto custom = registry.resolve("custom_pdf");
+    for (int frame = 0; frame < 2; ++frame) {
+        Document* temp = registry.createInArena(custom, arena);
+        temp->open();
+        temp->close();
+        std::cout << "Кадр " << frame << ": занято на арене " << arena.used() << " байт" << std::endl;
+        arena.reset();
+    }
+}
+
 /**
  * @brief Демонстрация обработки ошибок
  */
@@ -490,6 +686,7 @@ int main() {
     demonstrateAdvancedFactory();
     demonstrateStaticFactoryMethods();
     demonstrateRegistryFactory();
+    demonstratePooledRegistry();
     demonstrateErrorHandling();
     
     std::cout << "\n✅ Демонстрация Factory Method завершена!" << std::endl;
@@ -498,6 +695,7 @@ int main() {
     std::cout << "• Используйте полиморфизм для создания объектов" << std::endl;
     std::cout << "• Static Factory Methods для простых случаев" << std::endl;
     std::cout << "• Registry-based Factory для динамической регистрации" << std::endl;
+    std::cout << "• Пулы и арены убирают аллокации из горячего пути создания" << std::endl;
     std::cout << "• Всегда обрабатывайте ошибки создания объектов" << std::endl;
     
     return 0;
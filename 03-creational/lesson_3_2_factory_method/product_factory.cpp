@@ -6,6 +6,16 @@
 #include <functional>
 #include <algorithm>
 #include <stdexcept>
+#include <cstdint>
+#include <cmath>
+#include <tuple>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+#include "slot_pool.h"
 
 /**
  * @file product_factory.cpp
@@ -27,6 +37,10 @@ protected:
     std::string name_;
     int health_;
     int damage_;
+    float x_ = 0.0f;
+    float y_ = 0.0f;
+    float vx_ = 0.0f;
+    float vy_ = 0.0f;
     
 public:
     GameObject(const std::string& name, int health, int damage)
@@ -49,6 +63,19 @@ public:
     }
     
     bool isAlive() const { return health_ > 0; }
+    
+    void setPosition(float x, float y) { x_ = x; y_ = y; }
+    void setVelocity(float vx, float vy) { vx_ = vx; vy_ = vy; }
+    float getX() const { return x_; }
+    float getY() const { return y_; }
+    
+    /**
+     * @brief Шаг симуляции без вывода (update() печатает и годится только для демо)
+     */
+    virtual void tick(float dt) {
+        x_ += vx_ * dt;
+        y_ += vy_ * dt;
+    }
 };
 
 /**
@@ -80,6 +107,11 @@ public:
         return "Player";
     }
     
+    void tick(float dt) override {
+        health_ = std::min(health_ + 1, 100 + (level_ - 1) * 20);
+        GameObject::tick(dt);
+    }
+    
     void gainExperience(int exp) {
         experience_ += exp;
         if (experience_ >= 100) {
@@ -125,6 +157,19 @@ public:
         return "Enemy";
     }
     
+    void tick(float dt) override {
+        // Преследует цель в начале координат, если она в радиусе агрессии
+        constexpr float kAggroRadius = 50.0f;
+        constexpr float kSpeed = 4.0f;
+        float dist2 = x_ * x_ + y_ * y_;
+        if (dist2 < kAggroRadius * kAggroRadius && dist2 > 1e-6f) {
+            float inv = kSpeed / std::sqrt(dist2);
+            vx_ = -x_ * inv;
+            vy_ = -y_ * inv;
+        }
+        GameObject::tick(dt);
+    }
+    
     const std::string& getEnemyType() const { return enemyType_; }
 };
 
@@ -134,6 +179,7 @@ public:
 class NPC : public GameObject {
 private:
     std::string dialogue_;
+    float wanderTimer_ = 2.0f;
     
 public:
     NPC(const std::string& name, const std::string& dialogue, int health = 25)
@@ -155,6 +201,17 @@ public:
         return "NPC";
     }
     
+    void tick(float dt) override {
+        // Бродит туда-обратно, разворачиваясь каждые 2 секунды
+        wanderTimer_ -= dt;
+        if (wanderTimer_ <= 0.0f) {
+            vx_ = -vx_;
+            vy_ = -vy_;
+            wanderTimer_ = 2.0f;
+        }
+        GameObject::tick(dt);
+    }
+    
     void talk() {
         std::cout << "💬 " << name_ << " говорит: \"" << dialogue_ << "\"" << std::endl;
     }
@@ -239,6 +296,510 @@ public:
     }
 };
 
+// ============================================================================
+// ФАБРИКА ИГРОВЫХ ОБЪЕКТОВ С ПУЛАМИ
+// ============================================================================
+
+/**
+ * @brief Фабрика игровых объектов поверх пулов
+ * 
+ * Те же типы и характеристики, что у AdvancedGameObjectFactory, но строка
+ * типа разрешается в TypeId один раз, характеристики лежат в плоской
+ * таблице рецептов, а объекты берутся из пулов по конкретному типу.
+ * Однопоточная: спавн выполняется в игровом цикле.
+ * Все Handle должны быть уничтожены раньше фабрики.
+ */
+class PooledGameObjectFactory {
+public:
+    using TypeId = uint8_t;
+    using Handle = std::unique_ptr<GameObject, cpp_patterns::SlotPoolDeleter<GameObject>>;
+    
+private:
+    enum class Kind : uint8_t { PlayerKind, EnemyKind, NpcKind };
+    
+    struct Recipe {
+        std::string type;
+        Kind kind;
+        std::string label;  // тип врага или реплика NPC
+        int health;
+        int damage;
+    };
+    
+    std::vector<Recipe> recipes_;
+    static constexpr size_t kChunkSlots = 1024;
+    
+    cpp_patterns::SlotPool players_{sizeof(Player), alignof(Player), kChunkSlots};
+    cpp_patterns::SlotPool enemies_{sizeof(Enemy), alignof(Enemy), kChunkSlots};
+    cpp_patterns::SlotPool npcs_{sizeof(NPC), alignof(NPC), kChunkSlots};
+    
+public:
+    PooledGameObjectFactory()
+        : recipes_{{"player", Kind::PlayerKind, "", 100, 0},
+                   {"goblin", Kind::EnemyKind, "Goblin", 30, 10},
+                   {"orc", Kind::EnemyKind, "Orc", 80, 25},
+                   {"dragon", Kind::EnemyKind, "Dragon", 200, 50},
+                   {"merchant", Kind::NpcKind, "Хочешь купить что-нибудь?", 50, 0},
+                   {"guard", Kind::NpcKind, "Стой! Кто идет?", 100, 20}} {}
+    
+    PooledGameObjectFactory(const PooledGameObjectFactory&) = delete;
+    PooledGameObjectFactory& operator=(const PooledGameObjectFactory&) = delete;
+    
+    TypeId resolve(const std::string& type) const {
+        for (size_t i = 0; i < recipes_.size(); ++i) {
+            if (recipes_[i].type == type) {
+                return static_cast<TypeId>(i);
+            }
+        }
+        throw std::invalid_argument("Неподдерживаемый тип игрового объекта: " + type);
+    }
+    
+    Handle create(TypeId id, const std::string& name) {
+        const Recipe& recipe = recipes_.at(id);
+        switch (recipe.kind) {
+            case Kind::PlayerKind:
+                return Handle(players_.construct<Player>(name), {&players_});
+            case Kind::EnemyKind:
+                return Handle(enemies_.construct<Enemy>(name, recipe.label, recipe.health, recipe.damage), {&enemies_});
+            case Kind::NpcKind:
+                return Handle(npcs_.construct<NPC>(name, recipe.label, recipe.health), {&npcs_});
+        }
+        throw std::logic_error("Неизвестный вид объекта");
+    }
+    
+    /**
+     * @brief Создать count объектов одного типа с одним резервированием пула
+     */
+    std::vector<Handle> createN(TypeId id, size_t count, const std::string& namePrefix) {
+        switch (recipes_.at(id).kind) {
+            case Kind::PlayerKind: players_.reserve(count); break;
+            case Kind::EnemyKind: enemies_.reserve(count); break;
+            case Kind::NpcKind: npcs_.reserve(count); break;
+        }
+        std::vector<Handle> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            result.push_back(create(id, namePrefix + std::to_string(i)));
+        }
+        return result;
+    }
+    
+    size_t liveCount() const { return players_.inUse() + enemies_.inUse() + npcs_.inUse(); }
+    size_t pooledCapacity() const { return players_.capacity() + enemies_.capacity() + npcs_.capacity(); }
+    
+    std::vector<std::string> getSupportedTypes() const {
+        std::vector<std::string> types;
+        for (const auto& recipe : recipes_) {
+            types.push_back(recipe.type);
+        }
+        return types;
+    }
+};
+
+// ============================================================================
+// ECS: ТЕ ЖЕ ИГРОВЫЕ ОБЪЕКТЫ КАК ДАННЫЕ
+// ============================================================================
+
+/**
+ * @brief Идентификатор сущности: индекс слота + поколение
+ * 
+ * Поколение увеличивается при уничтожении, поэтому устаревший Entity
+ * не может случайно адресовать новую сущность в том же слоте.
+ */
+struct Entity {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+};
+
+namespace ecs {
+
+struct Position { float x; float y; };
+struct Velocity { float dx; float dy; };
+struct Health { int current; int max; };
+struct Damage { int value; };
+struct Regeneration { int perTick; };
+
+enum class AIMode : uint8_t { Chase, Wander };
+struct AIState { AIMode mode; float timer; };
+
+/**
+ * @brief Хранилище компонента на основе sparse set
+ * 
+ * data_ - плотный массив значений без дыр, по нему и идут системы.
+ * sparse_ отображает индекс сущности в позицию в data_ за O(1);
+ * удаление - swap с последним элементом, плотность сохраняется.
+ */
+template<typename T>
+class ComponentPool {
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+    std::vector<uint32_t> sparse_;
+    std::vector<uint32_t> entities_;
+    std::vector<T> data_;
+    
+public:
+    void reserve(size_t n) {
+        entities_.reserve(n);
+        data_.reserve(n);
+    }
+    
+    void insert(uint32_t entity, const T& value) {
+        if (entity >= sparse_.size()) {
+            sparse_.resize(entity + 1, kNone);
+        }
+        if (sparse_[entity] != kNone) {
+            data_[sparse_[entity]] = value;
+            return;
+        }
+        sparse_[entity] = static_cast<uint32_t>(data_.size());
+        entities_.push_back(entity);
+        data_.push_back(value);
+    }
+    
+    void remove(uint32_t entity) {
+        if (!contains(entity)) {
+            return;
+        }
+        uint32_t slot = sparse_[entity];
+        uint32_t last = entities_.back();
+        data_[slot] = data_.back();
+        entities_[slot] = last;
+        sparse_[last] = slot;
+        data_.pop_back();
+        entities_.pop_back();
+        sparse_[entity] = kNone;
+    }
+    
+    bool contains(uint32_t entity) const {
+        return entity < sparse_.size() && sparse_[entity] != kNone;
+    }
+    
+    T& get(uint32_t entity) { return data_[sparse_[entity]]; }
+    const T& get(uint32_t entity) const { return data_[sparse_[entity]]; }
+    
+    size_t size() const { return data_.size(); }
+    T* data() { return data_.data(); }
+    const uint32_t* entities() const { return entities_.data(); }
+};
+
+} // namespace ecs
+
+/**
+ * @brief Мир ECS: сущности - это индексы, состояние - колонки компонентов
+ * 
+ * Имя хранится в отдельной "холодной" таблице: системам симуляции оно не
+ * нужно и не должно занимать место в кэш-линиях горячих данных.
+ */
+class World {
+private:
+    std::vector<uint32_t> generations_;
+    std::vector<uint32_t> freeList_;
+    std::vector<std::string> names_;
+    size_t alive_ = 0;
+    std::tuple<ecs::ComponentPool<ecs::Position>,
+               ecs::ComponentPool<ecs::Velocity>,
+               ecs::ComponentPool<ecs::Health>,
+               ecs::ComponentPool<ecs::Damage>,
+               ecs::ComponentPool<ecs::Regeneration>,
+               ecs::ComponentPool<ecs::AIState>> pools_;
+    
+public:
+    void reserve(size_t n) {
+        generations_.reserve(n);
+        names_.reserve(n);
+        std::apply([n](auto&... pool) { (pool.reserve(n), ...); }, pools_);
+    }
+    
+    Entity create(std::string name) {
+        uint32_t index;
+        if (!freeList_.empty()) {
+            index = freeList_.back();
+            freeList_.pop_back();
+            names_[index] = std::move(name);
+        } else {
+            index = static_cast<uint32_t>(generations_.size());
+            generations_.push_back(0);
+            names_.push_back(std::move(name));
+        }
+        ++alive_;
+        return {index, generations_[index]};
+    }
+    
+    void destroy(Entity e) {
+        if (!isAlive(e)) {
+            return;
+        }
+        std::apply([&e](auto&... pool) { (pool.remove(e.index), ...); }, pools_);
+        ++generations_[e.index];
+        names_[e.index].clear();
+        freeList_.push_back(e.index);
+        --alive_;
+    }
+    
+    bool isAlive(Entity e) const {
+        return e.index < generations_.size() && generations_[e.index] == e.generation;
+    }
+    
+    template<typename T>
+    ecs::ComponentPool<T>& pool() { return std::get<ecs::ComponentPool<T>>(pools_); }
+    
+    template<typename T>
+    void add(Entity e, const T& component) { pool<T>().insert(e.index, component); }
+    
+    template<typename T>
+    T& get(Entity e) { return pool<T>().get(e.index); }
+    
+    const std::string& nameOf(Entity e) const { return names_[e.index]; }
+    size_t size() const { return alive_; }
+};
+
+/**
+ * @brief Постоянные рабочие потоки для систем, обрабатывающих данные кусками
+ * 
+ * Потоки создаются один раз и засыпают между тиками; каждая система
+ * раздаёт диапазоны плотного массива через атомарный счётчик.
+ */
+class TickWorkers {
+private:
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::function<void(size_t, size_t)> job_;
+    size_t count_ = 0;
+    size_t grain_ = 1;
+    std::atomic<size_t> next_{0};
+    size_t active_ = 0;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+    
+    void runChunks() {
+        for (;;) {
+            size_t begin = next_.fetch_add(grain_, std::memory_order_relaxed);
+            if (begin >= count_) {
+                return;
+            }
+            job_(begin, std::min(count_, begin + grain_));
+        }
+    }
+    
+    void workerLoop() {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            lock.unlock();
+            runChunks();
+            lock.lock();
+            if (--active_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+    
+public:
+    explicit TickWorkers(unsigned threads) {
+        for (unsigned i = 1; i < threads; ++i) {
+            threads_.emplace_back([this] { workerLoop(); });
+        }
+    }
+    
+    ~TickWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : threads_) {
+            t.join();
+        }
+    }
+    
+    TickWorkers(const TickWorkers&) = delete;
+    TickWorkers& operator=(const TickWorkers&) = delete;
+    
+    unsigned threadCount() const { return static_cast<unsigned>(threads_.size() + 1); }
+    
+    void parallelFor(size_t count, size_t grain, std::function<void(size_t, size_t)> fn) {
+        if (threads_.empty() || count <= grain) {
+            fn(0, count);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = std::move(fn);
+            count_ = count;
+            grain_ = grain;
+            next_.store(0, std::memory_order_relaxed);
+            active_ = threads_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+        runChunks();
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [&] { return active_ == 0; });
+    }
+};
+
+/**
+ * @brief Системы: та же логика, что у Player/Enemy/NPC::tick, но по колонкам
+ * 
+ * Каждая система пишет только в компоненты "своей" сущности, поэтому
+ * куски плотного массива обрабатываются параллельно без синхронизации.
+ */
+namespace systems {
+
+constexpr size_t kGrain = 4096;
+
+inline void ai(World& world, TickWorkers& workers, float dt) {
+    auto& states = world.pool<ecs::AIState>();
+    auto& positions = world.pool<ecs::Position>();
+    auto& velocities = world.pool<ecs::Velocity>();
+    ecs::AIState* data = states.data();
+    const uint32_t* ids = states.entities();
+    workers.parallelFor(states.size(), kGrain, [&, data, ids, dt](size_t begin, size_t end) {
+        constexpr float kAggroRadius = 50.0f;
+        constexpr float kSpeed = 4.0f;
+        for (size_t i = begin; i < end; ++i) {
+            const ecs::Position& p = positions.get(ids[i]);
+            ecs::Velocity& v = velocities.get(ids[i]);
+            if (data[i].mode == ecs::AIMode::Chase) {
+                float dist2 = p.x * p.x + p.y * p.y;
+                if (dist2 < kAggroRadius * kAggroRadius && dist2 > 1e-6f) {
+                    float inv = kSpeed / std::sqrt(dist2);
+                    v.dx = -p.x * inv;
+                    v.dy = -p.y * inv;
+                }
+            } else {
+                data[i].timer -= dt;
+                if (data[i].timer <= 0.0f) {
+                    v.dx = -v.dx;
+                    v.dy = -v.dy;
+                    data[i].timer = 2.0f;
+                }
+            }
+        }
+    });
+}
+
+inline void movement(World& world, TickWorkers& workers, float dt) {
+    auto& velocities = world.pool<ecs::Velocity>();
+    auto& positions = world.pool<ecs::Position>();
+    const ecs::Velocity* data = velocities.data();
+    const uint32_t* ids = velocities.entities();
+    workers.parallelFor(velocities.size(), kGrain, [&, data, ids, dt](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ecs::Position& p = positions.get(ids[i]);
+            p.x += data[i].dx * dt;
+            p.y += data[i].dy * dt;
+        }
+    });
+}
+
+inline void regeneration(World& world, TickWorkers& workers) {
+    auto& regen = world.pool<ecs::Regeneration>();
+    auto& health = world.pool<ecs::Health>();
+    const ecs::Regeneration* data = regen.data();
+    const uint32_t* ids = regen.entities();
+    workers.parallelFor(regen.size(), kGrain, [&, data, ids](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ecs::Health& h = health.get(ids[i]);
+            h.current = std::min(h.current + data[i].perTick, h.max);
+        }
+    });
+}
+
+inline void tick(World& world, TickWorkers& workers, float dt) {
+    regeneration(world, workers);
+    ai(world, workers, dt);
+    movement(world, workers, dt);
+}
+
+} // namespace systems
+
+/**
+ * @brief Фабрика сущностей: аналог AdvancedGameObjectFactory для ECS
+ * 
+ * Строковый тип разрешается в целочисленный TypeId один раз, дальше
+ * spawn/spawnN добавляют строки в колонки компонентов вместо make_unique.
+ */
+class EntityFactory {
+public:
+    using TypeId = uint16_t;
+    
+private:
+    struct Archetype {
+        std::string type;
+        int health;
+        int damage;
+        bool regenerates;
+        bool hasAI;
+        ecs::AIMode aiMode;
+    };
+    
+    std::vector<Archetype> archetypes_;
+    
+public:
+    EntityFactory() {
+        // Те же характеристики, что в AdvancedGameObjectFactory
+        archetypes_ = {
+            {"player",   100, 20, true,  false, ecs::AIMode::Chase},
+            {"goblin",    30, 10, false, true,  ecs::AIMode::Chase},
+            {"orc",       80, 25, false, true,  ecs::AIMode::Chase},
+            {"dragon",   200, 50, false, true,  ecs::AIMode::Chase},
+            {"merchant",  50,  0, false, true,  ecs::AIMode::Wander},
+            {"guard",    100,  0, false, true,  ecs::AIMode::Wander}
+        };
+    }
+    
+    TypeId resolve(const std::string& type) const {
+        for (size_t i = 0; i < archetypes_.size(); ++i) {
+            if (archetypes_[i].type == type) {
+                return static_cast<TypeId>(i);
+            }
+        }
+        throw std::invalid_argument("Неподдерживаемый тип игрового объекта: " + type);
+    }
+    
+    Entity spawn(World& world, TypeId type, std::string name, ecs::Position pos, ecs::Velocity vel) const {
+        const Archetype& a = archetypes_.at(type);
+        Entity e = world.create(std::move(name));
+        world.add(e, pos);
+        world.add(e, vel);
+        world.add(e, ecs::Health{a.health, a.health});
+        world.add(e, ecs::Damage{a.damage});
+        if (a.regenerates) {
+            world.add(e, ecs::Regeneration{1});
+        }
+        if (a.hasAI) {
+            world.add(e, ecs::AIState{a.aiMode, 2.0f});
+        }
+        return e;
+    }
+    
+    std::vector<Entity> spawnN(World& world, TypeId type, size_t count, ecs::Position origin, ecs::Velocity vel) const {
+        std::vector<Entity> result;
+        result.reserve(count);
+        world.reserve(world.size() + count);
+        for (size_t i = 0; i < count; ++i) {
+            ecs::Position pos{origin.x + static_cast<float>(i % 100), origin.y + static_cast<float>(i / 100)};
+            result.push_back(spawn(world, type, archetypes_[type].type + "_" + std::to_string(i), pos, vel));
+        }
+        return result;
+    }
+    
+    std::vector<std::string> getSupportedTypes() const {
+        std::vector<std::string> types;
+        for (const auto& a : archetypes_) {
+            types.push_back(a.type);
+        }
+        return types;
+    }
+};
+
 // ============================================================================
 // СИСТЕМА СОЗДАНИЯ UI ЭЛЕМЕНТОВ
 // ============================================================================
@@ -321,7 +882,7 @@ public:
     
     void render() override {
         std::string displayText = text_.empty() ? placeholder_ : text_;
-        std::cout << "📝 Текстовое поле [" << id_ << "] '" << displayText_ << "' в (" << x_ << "," << y_ 
+        std::cout << "📝 Текстовое поле [" << id_ << "] '" << displayText << "' в (" << x_ << "," << y_ 
                   << ") размером " << width_ << "x" << height_ << std::endl;
     }
     
@@ -520,6 +1081,217 @@ void demonstrateDynamicCreation() {
     }
 }
 
+/**
+ * @brief Демонстрация ECS: фабрика создаёт сущности, а не объекты в куче
+ */
+void demonstrateEntityComponentSystem() {
+    std::cout << "\n=== ECS: сущности вместо объектов ===" << std::endl;
+    
+    World world;
+    EntityFactory factory;
+    TickWorkers workers(1);
+    
+    Entity hero = factory.spawn(world, factory.resolve("player"), "Hero", {0.0f, 0.0f}, {0.0f, 0.0f});
+    Entity goblin = factory.spawn(world, factory.resolve("goblin"), "Goblin_1", {24.0f, 32.0f}, {0.0f, 0.0f});
+    Entity merchant = factory.spawn(world, factory.resolve("merchant"), "Shop_Keeper", {5.0f, 5.0f}, {1.0f, 0.0f});
+    world.get<ecs::Health>(hero).current = 90;
+    
+    for (int tick = 0; tick < 3; ++tick) {
+        systems::tick(world, workers, 1.0f);
+    }
+    
+    for (Entity e : {hero, goblin, merchant}) {
+        const auto& p = world.get<ecs::Position>(e);
+        const auto& h = world.get<ecs::Health>(e);
+        std::cout << world.nameOf(e) << ": (" << p.x << ", " << p.y << ") HP " << h.current << "/" << h.max << std::endl;
+    }
+    
+    world.destroy(goblin);
+    std::cout << "Goblin_1 уничтожен, устаревший handle жив? " << std::boolalpha << world.isAlive(goblin)
+              << ", сущностей: " << world.size() << std::endl;
+}
+
+/**
+ * @brief Демонстрация фабрики игровых объектов с пулами
+ */
+void demonstratePooledGameObjectFactory() {
+    std::cout << "\n=== Фабрика игровых объектов с пулами ===" << std::endl;
+    
+    PooledGameObjectFactory factory;
+    auto goblin = factory.resolve("goblin");
+    auto guard = factory.resolve("guard");
+    
+    {
+        auto wave = factory.createN(goblin, 3, "Гоблин_");
+        auto sentry = factory.create(guard, "Часовой");
+        for (const auto& obj : wave) {
+            std::cout << obj->getType() << " " << obj->getName() << " (HP: " << obj->getHealth() << ")" << std::endl;
+        }
+        sentry->attack();
+        std::cout << "Живых: " << factory.liveCount() << ", слотов в пулах: " << factory.pooledCapacity() << std::endl;
+    }
+    std::cout << "После деспавна живых: " << factory.liveCount()
+              << ", слотов в пулах: " << factory.pooledCapacity() << " (память переиспользуется)" << std::endl;
+}
+
+/**
+ * @brief Бенчмарк: волны спавна/деспавна через make_unique и через пулы
+ * 
+ * Каждая волна создаёт kWave врагов, уничтожает каждого второго, досоздаёт
+ * половину и очищает всё. Кроме среднего времени печатается худшая волна:
+ * именно она даёт рывки кадра.
+ */
+void benchmarkSpawnChurn() {
+    std::cout << "\n=== Бенчмарк: спавн/деспавн волнами ===" << std::endl;
+    
+    constexpr size_t kWave = 4096;
+    constexpr int kWaves = 200;
+    const std::vector<std::string> types = {"goblin", "orc", "dragon"};
+    
+    std::vector<std::string> names;
+    for (size_t i = 0; i < kWave; ++i) {
+        names.push_back("e" + std::to_string(i));
+    }
+    
+    auto runWaves = [&](auto spawn, auto& live) {
+        double totalMs = 0.0, worstMs = 0.0;
+        for (int w = 0; w < kWaves; ++w) {
+            auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < kWave; ++i) {
+                live.push_back(spawn(i % types.size(), names[i]));
+            }
+            for (size_t i = 0; i < live.size(); i += 2) {
+                live[i].reset();
+            }
+            for (size_t i = 0; i < kWave / 2; ++i) {
+                live[i * 2] = spawn(i % types.size(), names[i]);
+            }
+            live.clear();
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            totalMs += ms;
+            worstMs = std::max(worstMs, ms);
+        }
+        double opsPerWave = kWave * 1.5;
+        std::cout << totalMs * 1e6 / (kWaves * opsPerWave) << " нс на спавн+деспавн, худшая волна "
+                  << worstMs << " мс" << std::endl;
+    };
+    
+    {
+        AdvancedGameObjectFactory factory;
+        std::vector<std::unique_ptr<GameObject>> live;
+        live.reserve(kWave);
+        std::cout << "make_unique + строковый тип: ";
+        runWaves([&](size_t t, const std::string& name) { return factory.createGameObject(types[t], name); }, live);
+    }
+    {
+        PooledGameObjectFactory factory;
+        std::vector<PooledGameObjectFactory::TypeId> ids;
+        for (const auto& t : types) {
+            ids.push_back(factory.resolve(t));
+        }
+        std::vector<PooledGameObjectFactory::Handle> live;
+        live.reserve(kWave);
+        std::cout << "пулы + TypeId:               ";
+        runWaves([&](size_t t, const std::string& name) { return factory.create(ids[t], name); }, live);
+        std::cout << "Слотов в пулах после прогона: " << factory.pooledCapacity() << std::endl;
+    }
+}
+
+/**
+ * @brief Бенчмарк: время тика для ООП-иерархии и ECS
+ */
+void benchmarkEcsVsOop() {
+    std::cout << "\n=== Бенчмарк: тик ООП vs ECS ===" << std::endl;
+    
+    const std::vector<std::string> types = {"player", "goblin", "orc", "dragon", "merchant", "guard"};
+    constexpr int kTicks = 10;
+    constexpr float kDt = 0.016f;
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    
+    auto spawnPosition = [](size_t i) {
+        return ecs::Position{static_cast<float>(i % 200) - 100.0f, static_cast<float>((i / 200) % 200) - 100.0f};
+    };
+    auto spawnVelocity = [](size_t i) {
+        return ecs::Velocity{static_cast<float>(i % 7) - 3.0f, static_cast<float>(i % 5) - 2.0f};
+    };
+    auto msPerTick = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count() / kTicks;
+    };
+    
+    for (size_t count : {10'000u, 100'000u, 1'000'000u}) {
+        // ООП: vector<unique_ptr<GameObject>> и виртуальный tick()
+        AdvancedGameObjectFactory oopFactory;
+        std::vector<std::unique_ptr<GameObject>> objects;
+        objects.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            auto obj = oopFactory.createGameObject(types[i % types.size()], "e" + std::to_string(i));
+            auto p = spawnPosition(i);
+            auto v = spawnVelocity(i);
+            obj->setPosition(p.x, p.y);
+            obj->setVelocity(v.dx, v.dy);
+            objects.push_back(std::move(obj));
+        }
+        
+        // ECS: те же сущности в колонках; мир строится заново для каждого числа
+        // потоков, иначе второй прогон стартует с уже сдвинутых позиций
+        EntityFactory factory;
+        std::vector<EntityFactory::TypeId> typeIds;
+        for (const auto& t : types) {
+            typeIds.push_back(factory.resolve(t));
+        }
+        auto buildWorld = [&](World& world) {
+            world.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                factory.spawn(world, typeIds[i % typeIds.size()], "e" + std::to_string(i), spawnPosition(i), spawnVelocity(i));
+            }
+        };
+        
+        auto t0 = std::chrono::steady_clock::now();
+        for (int t = 0; t < kTicks; ++t) {
+            for (auto& obj : objects) {
+                obj->tick(kDt);
+            }
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        
+        // Контроль: обе модели должны прийти в одно состояние. Сравниваем
+        // каждую сущность: скорости симметричны, и сумма координат скрыла бы сдвиг
+        auto diverges = [&](World& world) {
+            const auto& positions = world.pool<ecs::Position>();
+            if (positions.size() != objects.size()) {
+                return true;
+            }
+            for (size_t i = 0; i < objects.size(); ++i) {
+                const ecs::Position& p = positions.get(static_cast<uint32_t>(i));
+                if (std::abs(p.x - objects[i]->getX()) > 1e-3f || std::abs(p.y - objects[i]->getY()) > 1e-3f) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        
+        std::cout << count << " сущностей: ООП " << msPerTick(t1 - t0) << " мс/тик";
+        std::vector<unsigned> threadCounts = {1};
+        if (hw > 1) {
+            threadCounts.push_back(hw);
+        }
+        bool mismatch = false;
+        for (unsigned threads : threadCounts) {
+            World world;
+            buildWorld(world);
+            TickWorkers workers(threads);
+            auto s = std::chrono::steady_clock::now();
+            for (int t = 0; t < kTicks; ++t) {
+                systems::tick(world, workers, kDt);
+            }
+            auto e = std::chrono::steady_clock::now();
+            std::cout << " | ECS x" << threads << " " << msPerTick(e - s) << " мс/тик";
+            mismatch = mismatch || diverges(world);
+        }
+        std::cout << (mismatch ? " ❌ расхождение!" : "") << std::endl;
+    }
+}
+
 // ============================================================================
 // ОСНОВНАЯ ФУНКЦИЯ
 // ============================================================================
@@ -531,6 +1303,10 @@ int main() {
     demonstrateGameObjectFactory();
     demonstrateUIElementFactory();
     demonstrateDynamicCreation();
+    demonstratePooledGameObjectFactory();
+    benchmarkSpawnChurn();
+    demonstrateEntityComponentSystem();
+    benchmarkEcsVsOop();
     
     std::cout << "\n✅ Демонстрация продвинутых примеров завершена!" << std::endl;
     std::cout << "\n🎯 Ключевые выводы:" << std::endl;
@@ -1,10 +1,23 @@
 ﻿#include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <optional>
 #include <stdexcept>
 #include <regex>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <utility>
+
+#include <sys/uio.h>
+
+#include "buffer_chain.h"
+#include "counting_resource.h"
 
 /**
  * @file secure_builder_alternatives.cpp
@@ -18,13 +31,14 @@
 
 class SafeMessage {
 private:
-    std::string header_;
-    std::string body_;
-    std::string footer_;
+    std::pmr::string header_;
+    std::pmr::string body_;
+    std::pmr::string footer_;
     
 public:
-    SafeMessage(std::string h, std::string b, std::string f)
-        : header_(std::move(h)), body_(std::move(b)), footer_(std::move(f)) {}
+    SafeMessage(std::string_view h, std::string_view b, std::string_view f,
+                std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : header_(h, memory), body_(b, memory), footer_(f, memory) {}
     
     void display() const {
         std::cout << "Header: " << header_ << "\n";
@@ -33,43 +47,271 @@ public:
     }
 };
 
-class SafeMessageBuilder {
+/**
+ * @brief Часть сообщения: своя копия, чужой view или общий буфер
+ *
+ * View действителен, пока жива память вызывающего: builder не продлевает
+ * её жизнь. SharedPayload держится по счётчику ссылок.
+ */
+class MessagePart {
+public:
+    explicit MessagePart(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : owned_(memory) {}
+    
+    void assignCopy(const std::string& bytes) {
+        owned_.assign(bytes.data(), bytes.size());
+        shared_.reset();
+        borrowed_ = {};
+        kind_ = Kind::Owned;
+    }
+    
+    void assignView(std::string_view bytes) {
+        owned_.clear();
+        shared_.reset();
+        borrowed_ = bytes;
+        kind_ = Kind::View;
+    }
+    
+    void assignShared(cpp_patterns::IntrusivePtr<cpp_patterns::SharedPayload> payload) {
+        owned_.clear();
+        borrowed_ = {};
+        shared_ = std::move(payload);
+        kind_ = Kind::Shared;
+    }
+    
+    // Указатель вычисляется при каждом вызове: после перемещения
+    // std::string (SSO) адрес собственной копии меняется
+    std::string_view view() const noexcept {
+        switch (kind_) {
+            case Kind::Owned: return owned_;
+            case Kind::View: return borrowed_;
+            case Kind::Shared: return shared_ ? std::string_view(shared_->data(), shared_->size()) : std::string_view{};
+        }
+        return {};
+    }
+    
+    size_t size() const noexcept { return view().size(); }
+    
 private:
-    std::string header_;
-    std::string body_;
-    std::string footer_;
+    enum class Kind { Owned, View, Shared };
     
-    static constexpr size_t MAX_HEADER = 64;
-    static constexpr size_t MAX_BODY = 256;
-    static constexpr size_t MAX_FOOTER = 32;
+    Kind kind_ = Kind::Owned;
+    std::pmr::string owned_;
+    std::string_view borrowed_;
+    cpp_patterns::IntrusivePtr<cpp_patterns::SharedPayload> shared_;
+};
+
+/**
+ * @brief Сообщение в одной аллокации точного размера (без zero-fill)
+ */
+class PackedMessage {
+private:
+    std::pmr::memory_resource* memory_;
+    char* data_;
+    size_t header_size_;
+    size_t body_size_;
+    size_t footer_size_;
     
 public:
-    SafeMessageBuilder& setHeader(const std::string& header) {
-        if (header.length() > MAX_HEADER) {
-            throw std::length_error("Header exceeds maximum length");
+    PackedMessage(std::string_view header, std::string_view body, std::string_view footer,
+                  std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : memory_(memory),
+          data_(static_cast<char*>(memory->allocate(header.size() + body.size() + footer.size(), 1))),
+          header_size_(header.size()), body_size_(body.size()), footer_size_(footer.size()) {
+        std::memcpy(data_, header.data(), header.size());
+        std::memcpy(data_ + header_size_, body.data(), body.size());
+        std::memcpy(data_ + header_size_ + body_size_, footer.data(), footer.size());
+    }
+    
+    PackedMessage(PackedMessage&& other) noexcept
+        : memory_(other.memory_), data_(std::exchange(other.data_, nullptr)),
+          header_size_(std::exchange(other.header_size_, 0)), body_size_(std::exchange(other.body_size_, 0)),
+          footer_size_(std::exchange(other.footer_size_, 0)) {}
+    
+    PackedMessage(const PackedMessage&) = delete;
+    PackedMessage& operator=(const PackedMessage&) = delete;
+    PackedMessage& operator=(PackedMessage&&) = delete;
+    
+    ~PackedMessage() {
+        if (data_) {
+            memory_->deallocate(data_, size(), 1);
         }
-        header_ = header;
+    }
+    
+    const char* data() const noexcept { return data_; }
+    size_t size() const noexcept { return header_size_ + body_size_ + footer_size_; }
+    std::string_view body() const noexcept { return std::string_view(data_ + header_size_, body_size_); }
+};
+
+/**
+ * @brief Сообщение как gather-список для writev: части не копируются
+ */
+class GatherMessage {
+private:
+    std::array<MessagePart, 3> parts_;
+    
+public:
+    explicit GatherMessage(std::array<MessagePart, 3> parts) : parts_(std::move(parts)) {}
+    
+    size_t size() const noexcept {
+        return parts_[0].size() + parts_[1].size() + parts_[2].size();
+    }
+    
+    /**
+     * @brief Заполнить iovec непустыми частями; возвращает их число
+     */
+    size_t fillIovecs(std::array<iovec, 3>& iovecs) const noexcept {
+        size_t count = 0;
+        for (const auto& part : parts_) {
+            std::string_view bytes = part.view();
+            if (bytes.empty()) continue;
+            iovecs[count].iov_base = const_cast<char*>(bytes.data());
+            iovecs[count].iov_len = bytes.size();
+            ++count;
+        }
+        return count;
+    }
+    
+    /**
+     * @brief Записать сообщение целиком: после частичной записи writev
+     * повторяется с оставшихся байт
+     * @return записано байт; -1 (errno как у writev), если не записано ничего.
+     * На неблокирующем дескрипторе при EAGAIN возвращается записанная часть.
+     */
+    ssize_t writeTo(int fd) const {
+        std::array<iovec, 3> iovecs{};
+        size_t count = fillIovecs(iovecs);
+        iovec* next = iovecs.data();
+        size_t written = 0;
+        while (count > 0) {
+            ssize_t result = ::writev(fd, next, static_cast<int>(count));
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result <= 0) {
+                return written > 0 ? static_cast<ssize_t>(written) : result;
+            }
+            written += static_cast<size_t>(result);
+            // Пропустить записанные iovec и сдвигать начало недописанного
+            size_t consumed = static_cast<size_t>(result);
+            while (count > 0 && consumed >= next->iov_len) {
+                consumed -= next->iov_len;
+                ++next;
+                --count;
+            }
+            if (count > 0) {
+                next->iov_base = static_cast<char*>(next->iov_base) + consumed;
+                next->iov_len -= consumed;
+            }
+        }
+        return static_cast<ssize_t>(written);
+    }
+};
+
+// Лимиты частей; по умолчанию - прежние значения SafeMessageBuilder
+struct MessageLimits {
+    size_t header = 64;
+    size_t body = 256;
+    size_t footer = 32;
+};
+
+class SafeMessageBuilder {
+private:
+    MessageLimits limits_;
+    std::pmr::memory_resource* memory_;
+    MessagePart header_;
+    MessagePart body_;
+    MessagePart footer_;
+    size_t copied_bytes_ = 0;
+    
+    // Длина проверяется до того, как часть принята: ни копии, ни ссылки на лишнее
+    static void checkLength(size_t length, size_t limit, const char* error) {
+        if (length > limit) {
+            throw std::length_error(error);
+        }
+    }
+    
+public:
+    /**
+     * @param memory ресурс для копий частей и собранных сообщений;
+     * бенчмарк передаёт свой CountingResource, чтобы считать аллокации
+     */
+    explicit SafeMessageBuilder(MessageLimits limits = {},
+                                std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : limits_(limits), memory_(memory), header_(memory), body_(memory), footer_(memory) {}
+    
+    /**
+     * @brief Сколько байт builder скопировал в setter'ах и build*()
+     */
+    size_t copiedBytes() const noexcept { return copied_bytes_; }
+    
+    SafeMessageBuilder& setHeader(const std::string& header) {
+        checkLength(header.length(), limits_.header, "Header exceeds maximum length");
+        header_.assignCopy(header);
+        copied_bytes_ += header.size();
         return *this;
     }
     
     SafeMessageBuilder& setBody(const std::string& body) {
-        if (body.length() > MAX_BODY) {
-            throw std::length_error("Body exceeds maximum length");
-        }
-        body_ = body;
+        checkLength(body.length(), limits_.body, "Body exceeds maximum length");
+        body_.assignCopy(body);
+        copied_bytes_ += body.size();
         return *this;
     }
     
     SafeMessageBuilder& setFooter(const std::string& footer) {
-        if (footer.length() > MAX_FOOTER) {
-            throw std::length_error("Footer exceeds maximum length");
-        }
-        footer_ = footer;
+        checkLength(footer.length(), limits_.footer, "Footer exceeds maximum length");
+        footer_.assignCopy(footer);
+        copied_bytes_ += footer.size();
+        return *this;
+    }
+    
+    // Scatter-режим: части по ссылке, память должна жить до build*()
+    SafeMessageBuilder& setHeaderView(std::string_view header) {
+        checkLength(header.size(), limits_.header, "Header exceeds maximum length");
+        header_.assignView(header);
+        return *this;
+    }
+    
+    SafeMessageBuilder& setBodyView(std::string_view body) {
+        checkLength(body.size(), limits_.body, "Body exceeds maximum length");
+        body_.assignView(body);
+        return *this;
+    }
+    
+    SafeMessageBuilder& setFooterView(std::string_view footer) {
+        checkLength(footer.size(), limits_.footer, "Footer exceeds maximum length");
+        footer_.assignView(footer);
+        return *this;
+    }
+    
+    // Общий буфер (например, закэшированное тело): держится по счётчику ссылок
+    SafeMessageBuilder& setBodyShared(cpp_patterns::IntrusivePtr<cpp_patterns::SharedPayload> body) {
+        checkLength(body ? body->size() : 0, limits_.body, "Body exceeds maximum length");
+        body_.assignShared(std::move(body));
         return *this;
     }
     
     SafeMessage build() {
-        return SafeMessage(header_, body_, footer_);
+        SafeMessage message(header_.view(), body_.view(), footer_.view(), memory_);
+        copied_bytes_ += header_.size() + body_.size() + footer_.size();
+        return message;
+    }
+    
+    /**
+     * @brief Одна аллокация точного размера и одна копия каждой части
+     */
+    PackedMessage buildContiguous() {
+        PackedMessage message(header_.view(), body_.view(), footer_.view(), memory_);
+        copied_bytes_ += message.size();
+        return message;
+    }
+    
+    /**
+     * @brief Gather-список без копирования; части переходят в сообщение
+     */
+    GatherMessage buildGather() {
+        return GatherMessage({std::move(header_), std::move(body_), std::move(footer_)});
     }
 };
 
@@ -426,6 +668,78 @@ void demonstrateCleanBuilder() {
     std::cout << "\n✅ State автоматически очищен\n";
 }
 
+// ============================================================================
+// БЕНЧМАРК: СБОРКА СООБЩЕНИЙ С КОПИРОВАНИЕМ И БЕЗ
+// ============================================================================
+
+void benchmarkMessageAssembly() {
+    std::cout << "\n=== Бенчмарк: сборка сообщений (copy / contiguous / gather) ===\n";
+    
+    const MessageLimits limits{64, 64 * 1024, 32};
+    const std::string header = "POST /api/v1/events HTTP/1.1";
+    const std::string footer = "\r\n-- end --\r\n";
+    
+    for (size_t body_size : {256, 4096, 16384}) {
+        const std::string body(body_size, 'b');
+        auto shared_body = cpp_patterns::makeIntrusive<cpp_patterns::SharedPayload>(body);
+        const size_t total = header.size() + body.size() + footer.size();
+        const size_t messages = 200000;
+        
+        // Аллокации считает ресурс, переданный builder'у, копии - сам builder
+        struct Assembled {
+            size_t bytes;
+            size_t copied;
+        };
+        
+        auto measure = [&](const char* name, auto&& assemble) {
+            cpp_patterns::CountingResource memory;
+            size_t checksum = 0;
+            size_t copied = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < messages; ++i) {
+                Assembled result = assemble(memory);
+                checksum += result.bytes;
+                copied += result.copied;
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "  " << name << ": " << static_cast<size_t>(seconds * 1e9 / messages) << " нс, "
+                      << copied / messages << " байт копий, "
+                      << static_cast<double>(memory.stats().allocations) / messages << " аллокаций/сообщение"
+                      << (checksum == total * messages ? "" : " (ошибка размера)") << "\n";
+        };
+        
+        std::cout << "Тело " << body_size << " байт (сообщение " << total << " байт):\n";
+        
+        // Копия в setter'ах и ещё одна в build()
+        measure("copy       ", [&](std::pmr::memory_resource& memory) {
+            SafeMessageBuilder builder(limits, &memory);
+            builder.setHeader(header).setBody(body).setFooter(footer);
+            SafeMessage message = builder.build();
+            return Assembled{total, builder.copiedBytes()};
+        });
+        
+        // Части по ссылке, одна копия в буфер точного размера
+        measure("contiguous ", [&](std::pmr::memory_resource& memory) {
+            SafeMessageBuilder builder(limits, &memory);
+            PackedMessage message = builder.setHeaderView(header).setBodyView(body).setFooterView(footer)
+                                        .buildContiguous();
+            return Assembled{message.size(), builder.copiedBytes()};
+        });
+        
+        // Ссылки и общий буфер: ни копий, ни аллокаций; writev соберёт сам
+        measure("gather     ", [&](std::pmr::memory_resource& memory) {
+            SafeMessageBuilder builder(limits, &memory);
+            GatherMessage message = builder.setHeaderView(header).setBodyShared(shared_body).setFooterView(footer)
+                                        .buildGather();
+            std::array<iovec, 3> iovecs{};
+            size_t count = message.fillIovecs(iovecs);
+            size_t bytes = 0;
+            for (size_t i = 0; i < count; ++i) bytes += iovecs[i].iov_len;
+            return Assembled{bytes, builder.copiedBytes()};
+        });
+    }
+}
+
 // ============================================================================
 // MAIN
 // ============================================================================
@@ -438,6 +752,7 @@ int main() {
     demonstrateValidatedBuilder();
     demonstrateCompleteObjectOnly();
     demonstrateCleanBuilder();
+    benchmarkMessageAssembly();
     
     std::cout << "\n=== РЕКОМЕНДАЦИИ ===\n";
     std::cout << "✅ Проверяйте границы в каждом setter\n";
@@ -446,6 +761,7 @@ int main() {
     std::cout << "✅ Не позволяйте получить неполный объект\n";
     std::cout << "✅ Очищайте state после build()\n";
     std::cout << "✅ Используйте std::string вместо char[]\n";
+    std::cout << "✅ Для больших сообщений - части по ссылке и gather-список для writev\n";
     std::cout << "✅ Применяйте std::optional для обязательных полей\n";
     
     return 0;
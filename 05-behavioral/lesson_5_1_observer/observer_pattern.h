@@ -0,0 +1,297 @@
+/**
+ * @file observer_pattern.h
+ * @brief Классы урока Observer: классический субъект, std::function, события, RAII и потокобезопасный субъект
+ *
+ * Вынесены из observer_pattern.cpp, чтобы бенчмарки
+ * (benchmarks/bench_observer.cpp) замеряли рассылку урока, а не её копию.
+ * Конкретные наблюдатели (Email, SMS, Logging) остались в .cpp. Флаг verbose
+ * у субъектов отключает вывод о подписке и заголовок каждого уведомления.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// КЛАССИЧЕСКИЙ OBSERVER PATTERN
+// ============================================================================
+
+/**
+ * @brief Интерфейс наблюдателя
+ */
+class Observer {
+public:
+    virtual ~Observer() = default;
+    virtual void update(const std::string& message) = 0;
+    virtual std::string getName() const = 0;
+};
+
+/**
+ * @brief Интерфейс субъекта
+ */
+class Subject {
+public:
+    virtual ~Subject() = default;
+    virtual void attach(std::shared_ptr<Observer> observer) = 0;
+    virtual void detach(std::shared_ptr<Observer> observer) = 0;
+    virtual void notify(const std::string& message) = 0;
+};
+
+/**
+ * @brief Конкретный субъект - система уведомлений
+ */
+class NotificationSystem : public Subject {
+private:
+    std::vector<std::weak_ptr<Observer>> observers_;
+    std::string systemName_;
+    bool verbose_;  // Печатать подписку, отписку и заголовок каждого уведомления
+    
+public:
+    explicit NotificationSystem(const std::string& name, bool verbose = true)
+        : systemName_(name), verbose_(verbose) {}
+    
+    void attach(std::shared_ptr<Observer> observer) override {
+        observers_.push_back(observer);
+        if (verbose_) {
+            std::cout << "Observer '" << observer->getName() 
+                      << "' подписан на систему '" << systemName_ << "'" << std::endl;
+        }
+    }
+    
+    void detach(std::shared_ptr<Observer> observer) override {
+        observers_.erase(
+            std::remove_if(observers_.begin(), observers_.end(),
+                [&observer](const std::weak_ptr<Observer>& weak_obs) {
+                    return weak_obs.lock() == observer;
+                }),
+            observers_.end());
+        if (verbose_) {
+            std::cout << "Observer '" << observer->getName() 
+                      << "' отписан от системы '" << systemName_ << "'" << std::endl;
+        }
+    }
+    
+    void notify(const std::string& message) override {
+        if (verbose_) {
+            std::cout << "\n--- Уведомление от системы '" << systemName_ << "' ---" << std::endl;
+        }
+        
+        for (auto it = observers_.begin(); it != observers_.end();) {
+            if (auto observer = it->lock()) {
+                observer->update(message);
+                ++it;
+            } else {
+                it = observers_.erase(it);
+            }
+        }
+    }
+    
+    void publishMessage(const std::string& message) {
+        notify(message);
+    }
+    
+    size_t getObserverCount() const {
+        return observers_.size();
+    }
+};
+
+// ============================================================================
+// СОВРЕМЕННЫЙ OBSERVER С std::function
+// ============================================================================
+
+/**
+ * @brief Современный субъект с использованием std::function
+ */
+class ModernSubject {
+private:
+    std::vector<std::function<void(const std::string&)>> observers_;
+    std::string subjectName_;
+    bool verbose_;  // Печатать подписку и заголовок каждого уведомления
+    
+public:
+    explicit ModernSubject(const std::string& name, bool verbose = true)
+        : subjectName_(name), verbose_(verbose) {}
+    
+    void attach(std::function<void(const std::string&)> observer) {
+        observers_.push_back(observer);
+        if (verbose_) {
+            std::cout << "Функциональный наблюдатель подписан на '" << subjectName_ << "'" << std::endl;
+        }
+    }
+    
+    void notify(const std::string& message) {
+        if (verbose_) {
+            std::cout << "\n--- Уведомление от современного субъекта '" << subjectName_ << "' ---" << std::endl;
+        }
+        for (const auto& observer : observers_) {
+            observer(message);
+        }
+    }
+    
+    void publishMessage(const std::string& message) {
+        notify(message);
+    }
+    
+    size_t getObserverCount() const {
+        return observers_.size();
+    }
+};
+
+// ============================================================================
+// EVENT-DRIVEN OBSERVER
+// ============================================================================
+
+/**
+ * @brief Шаблонный класс для событий
+ */
+template<typename... Args>
+class Event {
+private:
+    std::vector<std::function<void(Args...)>> handlers_;
+    std::string eventName_;
+    
+public:
+    explicit Event(const std::string& name) : eventName_(name) {}
+    
+    void subscribe(std::function<void(Args...)> handler) {
+        handlers_.push_back(handler);
+        std::cout << "Обработчик подписан на событие '" << eventName_ << "'" << std::endl;
+    }
+    
+    void emit(Args... args) {
+        std::cout << "\n--- Событие '" << eventName_ << "' ---" << std::endl;
+        for (const auto& handler : handlers_) {
+            handler(args...);
+        }
+    }
+    
+    size_t getSubscriberCount() const {
+        return handlers_.size();
+    }
+    
+    const std::string& getName() const {
+        return eventName_;
+    }
+};
+
+// ============================================================================
+// RAII OBSERVER С АВТОМАТИЧЕСКОЙ ОТПИСКОЙ
+// ============================================================================
+
+/**
+ * @brief RAII наблюдатель с автоматической отпиской
+ */
+class RAIIObserver {
+private:
+    std::function<void()> unsubscribe_;
+    std::string observerName_;
+    
+public:
+    template<typename Subject, typename Observer>
+    RAIIObserver(Subject& subject, Observer observer, const std::string& name)
+        : observerName_(name) {
+        subject.attach(observer);
+        unsubscribe_ = [&subject, observer]() {
+            subject.detach(observer);
+        };
+        std::cout << "RAII Observer '" << name << "' создан" << std::endl;
+    }
+    
+    ~RAIIObserver() {
+        if (unsubscribe_) {
+            unsubscribe_();
+            std::cout << "RAII Observer '" << observerName_ << "' автоматически отписан" << std::endl;
+        }
+    }
+    
+    // Запрещаем копирование
+    RAIIObserver(const RAIIObserver&) = delete;
+    RAIIObserver& operator=(const RAIIObserver&) = delete;
+    
+    // Разрешаем перемещение
+    RAIIObserver(RAIIObserver&& other) noexcept 
+        : unsubscribe_(std::move(other.unsubscribe_)), observerName_(std::move(other.observerName_)) {
+        other.unsubscribe_ = nullptr;
+    }
+    
+    const std::string& getName() const {
+        return observerName_;
+    }
+};
+
+// ============================================================================
+// THREAD-SAFE OBSERVER
+// ============================================================================
+
+/**
+ * @brief Потокобезопасный субъект
+ * 
+ * std::function не сравнивается через ==, поэтому attach() возвращает
+ * идентификатор подписки, по которому detach() находит наблюдателя.
+ */
+class ThreadSafeSubject {
+private:
+    using Callback = std::function<void(const std::string&)>;
+    
+    std::vector<std::pair<size_t, Callback>> observers_;
+    mutable std::mutex mutex_;
+    size_t nextId_ = 0;
+    std::string subjectName_;
+    bool verbose_;  // Печатать подписку, отписку и заголовок каждого уведомления
+    
+public:
+    explicit ThreadSafeSubject(const std::string& name, bool verbose = true)
+        : subjectName_(name), verbose_(verbose) {}
+    
+    size_t attach(Callback observer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t id = nextId_++;
+        observers_.emplace_back(id, std::move(observer));
+        if (verbose_) {
+            std::cout << "Потокобезопасный наблюдатель подписан на '" << subjectName_ << "'" << std::endl;
+        }
+        return id;
+    }
+    
+    void detach(size_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        observers_.erase(
+            std::remove_if(observers_.begin(), observers_.end(),
+                [id](const std::pair<size_t, Callback>& entry) { return entry.first == id; }),
+            observers_.end());
+        if (verbose_) {
+            std::cout << "Потокобезопасный наблюдатель отписан от '" << subjectName_ << "'" << std::endl;
+        }
+    }
+    
+    void notify(const std::string& message) {
+        std::vector<std::pair<size_t, Callback>> observers_copy;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            observers_copy = observers_;
+        }
+        
+        if (verbose_) {
+            std::cout << "\n--- Потокобезопасное уведомление от '" << subjectName_ << "' ---" << std::endl;
+        }
+        for (const auto& entry : observers_copy) {
+            entry.second(message);
+        }
+    }
+    
+    void publishMessage(const std::string& message) {
+        notify(message);
+    }
+    
+    size_t getObserverCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return observers_.size();
+    }
+};
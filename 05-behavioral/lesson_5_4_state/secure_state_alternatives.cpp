@@ -4,9 +4,16 @@
 #include <mutex>
 #include <shared_mutex>
 #include <atomic>
-#include <map>
-#include <set>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 /**
@@ -104,12 +111,312 @@ void demonstrateThreadSafeState() {
     std::cout << "✅ Нет race conditions - все операции атомарны\n";
 }
 
+// ============================================================================
+// ДВИЖОК ТАБЛИЧНЫХ АВТОМАТОВ ВРЕМЕНИ КОМПИЛЯЦИИ
+// Состояния и события - enum, переходы - constexpr таблица,
+// guard/action - типы-функторы, которые компилятор встраивает
+// ============================================================================
+
+struct NoGuard {
+    template<typename Context>
+    constexpr bool operator()(const Context&) const noexcept { return true; }
+};
+
+struct NoAction {
+    template<typename Context>
+    constexpr void operator()(Context&) const noexcept {}
+};
+
+struct NoContext {};
+
+/**
+ * @brief Строка таблицы: From --On--> To, если Guard(context), затем Action(context)
+ */
+template<auto From, auto On, auto To, typename Guard = NoGuard, typename Action = NoAction>
+struct Transition {
+    static constexpr auto from = From;
+    static constexpr auto on = On;
+    static constexpr auto to = To;
+    using GuardType = Guard;
+    using ActionType = Action;
+    // Без guard и action переход - это только запись нового состояния
+    static constexpr bool pure = std::is_same_v<Guard, NoGuard> && std::is_same_v<Action, NoAction>;
+};
+
+constexpr uint8_t kNoTransition = 0xFF;
+
+template<typename State>
+struct TransitionCell {
+    State to;
+    uint8_t row;  // номер строки таблицы или kNoTransition
+    bool pure;
+};
+
+template<typename Enum>
+constexpr size_t enumIndex(Enum value) noexcept {
+    return static_cast<size_t>(value);
+}
+
+template<typename State, size_t StateCount, size_t EventCount, typename Row>
+constexpr void addTransitionCell(std::array<std::array<TransitionCell<State>, EventCount>, StateCount>& cells,
+                                 uint8_t row) {
+    static_assert(enumIndex(Row::from) < StateCount && enumIndex(Row::to) < StateCount,
+                  "Состояние вне диапазона таблицы");
+    static_assert(enumIndex(Row::on) < EventCount, "Событие вне диапазона таблицы");
+    TransitionCell<State>& cell = cells[enumIndex(Row::from)][enumIndex(Row::on)];
+    if (cell.row != kNoTransition) {
+        // В constexpr-контексте throw превращается в ошибку компиляции
+        throw std::logic_error("Два перехода для одной пары (состояние, событие)");
+    }
+    cell = TransitionCell<State>{Row::to, row, Row::pure};
+}
+
+// Плотная матрица [состояние][событие]; строится один раз при компиляции
+template<typename State, size_t StateCount, size_t EventCount, typename... Rows>
+constexpr auto buildTransitionCells() {
+    std::array<std::array<TransitionCell<State>, EventCount>, StateCount> cells{};
+    for (auto& row : cells) {
+        for (auto& cell : row) {
+            cell = TransitionCell<State>{State{}, kNoTransition, false};
+        }
+    }
+    uint8_t row = 0;
+    (addTransitionCell<State, StateCount, EventCount, Rows>(cells, row++), ...);
+    return cells;
+}
+
+/**
+ * @brief Таблица переходов: поиск - два индекса в constexpr массиве
+ *
+ * guard/action выбираются по номеру строки fold-выражением: это цепочка
+ * сравнений с константами (или jump table), а тела функторов встроены.
+ */
+template<typename State, typename Event, size_t StateCount, size_t EventCount, typename... Rows>
+class TransitionTable {
+public:
+    using StateType = State;
+    using EventType = Event;
+    using Cell = TransitionCell<State>;
+
+    static_assert(sizeof...(Rows) < kNoTransition, "Слишком много переходов");
+
+    static constexpr const Cell& cell(State state, Event event) noexcept {
+        return cells_[enumIndex(state)][enumIndex(event)];
+    }
+
+    static constexpr bool allowed(State state, Event event) noexcept {
+        return cell(state, event).row != kNoTransition;
+    }
+
+    template<typename Context>
+    static bool guard(uint8_t row, const Context& context) {
+        return guardAt(row, context, std::index_sequence_for<Rows...>{});
+    }
+
+    template<typename Context>
+    static void action(uint8_t row, Context& context) {
+        actionAt(row, context, std::index_sequence_for<Rows...>{});
+    }
+
+private:
+    static constexpr auto cells_ = buildTransitionCells<State, StateCount, EventCount, Rows...>();
+
+    template<typename Context, size_t... I>
+    static bool guardAt(uint8_t row, const Context& context, std::index_sequence<I...>) {
+        bool passed = true;
+        (void)((row == I ? (passed = typename Rows::GuardType{}(context), true) : false) || ...);
+        return passed;
+    }
+
+    template<typename Context, size_t... I>
+    static void actionAt(uint8_t row, Context& context, std::index_sequence<I...>) {
+        (void)((row == I ? (typename Rows::ActionType{}(context), true) : false) || ...);
+    }
+};
+
+/**
+ * @brief Автомат для одного владельца: состояние - один байт, без аллокаций
+ */
+template<typename Table, typename Context = NoContext>
+class TableStateMachine {
+public:
+    using State = typename Table::StateType;
+    using Event = typename Table::EventType;
+
+    explicit TableStateMachine(State initial) noexcept : state_(initial) {}
+
+    bool fire(Event event, Context& context) {
+        const auto& cell = Table::cell(state_, event);
+        if (cell.row == kNoTransition || !Table::guard(cell.row, context)) {
+            return false;
+        }
+        state_ = cell.to;
+        Table::action(cell.row, context);
+        return true;
+    }
+
+    State state() const noexcept { return state_; }
+    void reset(State state) noexcept { state_ = state; }
+
+private:
+    State state_;
+};
+
+/**
+ * @brief Автомат для конкурентных водителей: переход - один CAS
+ *
+ * Из двух потоков, сработавших одно событие, переход выполнит только один.
+ * Переход без guard/action (pure) - один CAS нового состояния. Переход с
+ * guard или action сначала CAS'ом ставит бит «в переходе», затем на
+ * захваченном состоянии проверяет guard, выполняет action и только после
+ * этого публикует новое состояние. Остальные потоки ждут снятия бита, так
+ * что guard видит актуальный контекст, а action двух переходов одного
+ * автомата не выполняются одновременно. Контекст при этом принадлежит
+ * автомату: вне fire() его меняют только под собственной синхронизацией.
+ */
+template<typename Table, typename Context = NoContext>
+class AtomicStateMachine {
+public:
+    using State = typename Table::StateType;
+    using Event = typename Table::EventType;
+
+    explicit AtomicStateMachine(State initial) noexcept : word_(pack(initial)) {}
+
+    bool fire(Event event, Context& context) {
+        Word current = word_.load(std::memory_order_acquire);
+        while (true) {
+            if (current & kTransitioning) {
+                std::this_thread::yield();
+                current = word_.load(std::memory_order_acquire);
+                continue;
+            }
+            const auto& cell = Table::cell(unpack(current), event);
+            if (cell.row == kNoTransition) {
+                return false;
+            }
+            if (cell.pure) {
+                // При неудаче current обновится, и переход проверится заново
+                if (word_.compare_exchange_weak(current, pack(cell.to),
+                                                std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    return true;
+                }
+                continue;
+            }
+            if (word_.compare_exchange_weak(current, current | kTransitioning,
+                                            std::memory_order_acquire, std::memory_order_acquire)) {
+                return runExclusive(cell, current, context);
+            }
+        }
+    }
+
+    State state() const noexcept { return unpack(word_.load(std::memory_order_acquire)); }
+
+    // Только когда fire() не выполняется ни в одном потоке
+    void reset(State state) noexcept { word_.store(pack(state), std::memory_order_release); }
+
+private:
+    using Word = uint32_t;
+    static_assert(sizeof(State) <= 2, "Состояние должно помещаться в 16 бит");
+    static constexpr Word kTransitioning = Word{1} << 16;
+
+    static constexpr Word pack(State state) noexcept { return static_cast<Word>(enumIndex(state)); }
+    static constexpr State unpack(Word word) noexcept { return static_cast<State>(word & 0xFFFF); }
+
+    // Бит «в переходе» захвачен: guard и action выполняет только этот поток
+    template<typename Cell>
+    bool runExclusive(const Cell& cell, Word from, Context& context) {
+        bool passed;
+        try {
+            passed = Table::guard(cell.row, context);
+        } catch (...) {
+            word_.store(from, std::memory_order_release);
+            throw;
+        }
+        if (!passed) {
+            word_.store(from, std::memory_order_release);
+            return false;
+        }
+        // Как в TableStateMachine: исключение из action не отменяет перехода
+        struct Publish {
+            std::atomic<Word>& word;
+            Word to;
+            ~Publish() { word.store(to, std::memory_order_release); }
+        } publish{word_, pack(cell.to)};
+        Table::action(cell.row, context);
+        return true;
+    }
+
+    std::atomic<Word> word_;
+};
+
+/**
+ * @brief Много автоматов в SoA-массивах: состояния подряд, контексты отдельно
+ *
+ * step() проходит по плотному массиву состояний; для переходов без
+ * guard/action контекст не читается вовсе, и цикл не трогает его кэш-линии.
+ */
+template<typename Table, typename Context = NoContext>
+class StateMachineBatch {
+public:
+    using State = typename Table::StateType;
+    using Event = typename Table::EventType;
+
+    StateMachineBatch(size_t count, State initial) : states_(count, initial), contexts_(count) {}
+
+    size_t size() const noexcept { return states_.size(); }
+    State state(size_t index) const { return states_[index]; }
+    Context& context(size_t index) { return contexts_[index]; }
+
+    /**
+     * @brief Применить events[i] к автомату i; возвращает число принятых переходов
+     */
+    size_t step(const Event* events) {
+        size_t accepted = 0;
+        for (size_t i = 0; i < states_.size(); ++i) {
+            accepted += apply(i, events[i]);
+        }
+        return accepted;
+    }
+
+    /**
+     * @brief Одно событие для всех автоматов
+     */
+    size_t step(Event event) {
+        size_t accepted = 0;
+        for (size_t i = 0; i < states_.size(); ++i) {
+            accepted += apply(i, event);
+        }
+        return accepted;
+    }
+
+    void resetAll(State state) { std::fill(states_.begin(), states_.end(), state); }
+
+private:
+    size_t apply(size_t index, Event event) {
+        const auto& cell = Table::cell(states_[index], event);
+        if (cell.row == kNoTransition) {
+            return 0;
+        }
+        if (!cell.pure) {
+            if (!Table::guard(cell.row, contexts_[index])) {
+                return 0;
+            }
+            Table::action(cell.row, contexts_[index]);
+        }
+        states_[index] = cell.to;
+        return 1;
+    }
+
+    std::vector<State> states_;
+    std::vector<Context> contexts_;
+};
+
 // ============================================================================
 // БЕЗОПАСНАЯ РЕАЛИЗАЦИЯ 2: STATE MACHINE С ВАЛИДАЦИЕЙ ПЕРЕХОДОВ
 // Решает: Invalid State Transitions
 // ============================================================================
 
-enum class OrderStatus {
+enum class OrderStatus : uint8_t {
     CREATED,
     PAID,
     SHIPPED,
@@ -117,73 +424,88 @@ enum class OrderStatus {
     CANCELLED
 };
 
+enum class OrderEvent : uint8_t {
+    PAY,
+    SHIP,
+    DELIVER,
+    CANCEL
+};
+
+struct OrderData {
+    double amount = 0.0;
+    bool refunded = false;
+};
+
+struct HasPayment {
+    bool operator()(const OrderData& order) const noexcept { return order.amount > 0; }
+};
+
+struct Refund {
+    void operator()(OrderData& order) const noexcept { order.refunded = order.amount > 0; }
+};
+
+// Допустимые переходы; DELIVERED и CANCELLED - финальные состояния
+using OrderTable = TransitionTable<OrderStatus, OrderEvent, 5, 4,
+    Transition<OrderStatus::CREATED, OrderEvent::PAY,     OrderStatus::PAID>,
+    Transition<OrderStatus::CREATED, OrderEvent::CANCEL,  OrderStatus::CANCELLED>,
+    Transition<OrderStatus::PAID,    OrderEvent::SHIP,    OrderStatus::SHIPPED, HasPayment>,
+    Transition<OrderStatus::PAID,    OrderEvent::CANCEL,  OrderStatus::CANCELLED, NoGuard, Refund>,
+    Transition<OrderStatus::SHIPPED, OrderEvent::DELIVER, OrderStatus::DELIVERED>>;
+
+// Таблица проверяется при компиляции
+static_assert(OrderTable::allowed(OrderStatus::CREATED, OrderEvent::PAY));
+static_assert(!OrderTable::allowed(OrderStatus::DELIVERED, OrderEvent::CANCEL));
+
 class SecureOrder {
 private:
-    OrderStatus state_ = OrderStatus::CREATED;
-    double amount_ = 0.0;
-    bool refunded_ = false;
+    // Переходы, guard HasPayment и action Refund берутся из OrderTable
+    TableStateMachine<OrderTable, OrderData> machine_{OrderStatus::CREATED};
+    OrderData data_;
     mutable std::mutex mutex_;
     
-    // Определяем допустимые переходы
-    static const std::map<OrderStatus, std::set<OrderStatus>>& getAllowedTransitions() {
-        static std::map<OrderStatus, std::set<OrderStatus>> transitions = {
-            {OrderStatus::CREATED,   {OrderStatus::PAID, OrderStatus::CANCELLED}},
-            {OrderStatus::PAID,      {OrderStatus::SHIPPED, OrderStatus::CANCELLED}},
-            {OrderStatus::SHIPPED,   {OrderStatus::DELIVERED}},
-            {OrderStatus::DELIVERED, {}},  // Финальное состояние
-            {OrderStatus::CANCELLED, {}}   // Финальное состояние
-        };
-        return transitions;
-    }
-    
-    bool isTransitionAllowed(OrderStatus from, OrderStatus to) const {
-        const auto& transitions = getAllowedTransitions();
-        auto it = transitions.find(from);
-        if (it == transitions.end()) return false;
-        return it->second.find(to) != it->second.end();
-    }
-    
-    void transition(OrderStatus new_state) {
-        if (!isTransitionAllowed(state_, new_state)) {
+    void transition(OrderEvent event) {
+        const OrderStatus from = machine_.state();
+        if (!machine_.fire(event, data_)) {
             throw std::runtime_error(
-                "Invalid transition from " + std::to_string(static_cast<int>(state_)) +
-                " to " + std::to_string(static_cast<int>(new_state))
+                std::string(OrderTable::allowed(from, event) ? "Guard rejected transition from "
+                                                             : "Invalid transition from ") +
+                std::to_string(static_cast<int>(from)) +
+                " on event " + std::to_string(static_cast<int>(event))
             );
         }
-        state_ = new_state;
     }
     
 public:
     void pay(double amount) {
         std::lock_guard<std::mutex> lock(mutex_);
         
-        transition(OrderStatus::PAID);
-        amount_ = amount;
+        transition(OrderEvent::PAY);
+        data_.amount = amount;
         std::cout << "💳 Оплачено: $" << amount << "\n";
     }
     
     void ship() {
         std::lock_guard<std::mutex> lock(mutex_);
         
-        transition(OrderStatus::SHIPPED);
+        transition(OrderEvent::SHIP);
         std::cout << "📦 Отправлено\n";
     }
     
     void deliver() {
         std::lock_guard<std::mutex> lock(mutex_);
         
-        transition(OrderStatus::DELIVERED);
+        transition(OrderEvent::DELIVER);
         std::cout << "✅ Доставлено\n";
     }
     
     void cancel() {
         std::lock_guard<std::mutex> lock(mutex_);
         
-        transition(OrderStatus::CANCELLED);
+        transition(OrderEvent::CANCEL);
         
-        if (!refunded_ && amount_ > 0) {
-            std::cout << "💰 Возврат: $" << amount_ << "\n";
-            refunded_ = true;
+        // Возврат выполнил action Refund строки PAID -> CANCELLED
+        if (data_.refunded) {
+            std::cout << "💰 Возврат: $" << data_.amount << "\n";
         }
         
         std::cout << "❌ Отменено\n";
@@ -191,7 +513,7 @@ public:
     
     OrderStatus getState() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        return state_;
+        return machine_.state();
     }
 };
 
@@ -221,6 +543,20 @@ void demonstrateValidatedStateMachine() {
         std::cout << "✅ Блокировано: " << e.what() << "\n";
     }
     
+    // Оплата без суммы: SHIP отклоняет guard HasPayment
+    SecureOrder unpaid;
+    unpaid.pay(0.0);
+    try {
+        unpaid.ship();
+    } catch (const std::runtime_error& e) {
+        std::cout << "✅ Блокировано: " << e.what() << "\n";
+    }
+    
+    // Отмена оплаченного заказа: возврат делает action Refund из таблицы
+    SecureOrder paid;
+    paid.pay(50.0);
+    paid.cancel();
+    
     std::cout << "✅ Все недопустимые переходы заблокированы\n";
 }
 
@@ -390,6 +726,190 @@ void demonstrateRAIIState() {
     std::cout << "✅ RAII гарантирует вызов enter/exit и удаление\n";
 }
 
+// ============================================================================
+// БЕЗОПАСНАЯ РЕАЛИЗАЦИЯ 5: ТАБЛИЧНЫЕ АВТОМАТЫ БЕЗ БЛОКИРОВОК
+// Решает: мьютекс, виртуальный вызов и аллокация на каждом переходе
+// ============================================================================
+
+enum class ConnectionEvent : uint8_t {
+    CONNECT,
+    ESTABLISHED,
+    DISCONNECT,
+    CLOSED
+};
+
+using ConnectionTable = TransitionTable<ConnectionState, ConnectionEvent, 4, 4,
+    Transition<ConnectionState::DISCONNECTED,  ConnectionEvent::CONNECT,     ConnectionState::CONNECTING>,
+    Transition<ConnectionState::CONNECTING,    ConnectionEvent::ESTABLISHED, ConnectionState::CONNECTED>,
+    Transition<ConnectionState::CONNECTED,     ConnectionEvent::DISCONNECT,  ConnectionState::DISCONNECTING>,
+    Transition<ConnectionState::DISCONNECTING, ConnectionEvent::CLOSED,      ConnectionState::DISCONNECTED>>;
+
+// Классический вариант для сравнения: объект состояния в куче, виртуальный
+// переход и мьютекс контекста, как в ThreadSafeContext
+class OrderStateNode {
+public:
+    virtual ~OrderStateNode() = default;
+    // nullptr - событие в этом состоянии недопустимо
+    virtual std::unique_ptr<OrderStateNode> on(OrderEvent event, OrderData& order) = 0;
+};
+
+class FinalOrderState : public OrderStateNode {
+public:
+    std::unique_ptr<OrderStateNode> on(OrderEvent, OrderData&) override { return nullptr; }
+};
+
+class ShippedOrderState : public OrderStateNode {
+public:
+    std::unique_ptr<OrderStateNode> on(OrderEvent event, OrderData&) override {
+        if (event == OrderEvent::DELIVER) return std::make_unique<FinalOrderState>();
+        return nullptr;
+    }
+};
+
+class PaidOrderState : public OrderStateNode {
+public:
+    std::unique_ptr<OrderStateNode> on(OrderEvent event, OrderData& order) override {
+        if (event == OrderEvent::SHIP && order.amount > 0) return std::make_unique<ShippedOrderState>();
+        if (event == OrderEvent::CANCEL) {
+            order.refunded = order.amount > 0;
+            return std::make_unique<FinalOrderState>();
+        }
+        return nullptr;
+    }
+};
+
+class CreatedOrderState : public OrderStateNode {
+public:
+    std::unique_ptr<OrderStateNode> on(OrderEvent event, OrderData&) override {
+        if (event == OrderEvent::PAY) return std::make_unique<PaidOrderState>();
+        if (event == OrderEvent::CANCEL) return std::make_unique<FinalOrderState>();
+        return nullptr;
+    }
+};
+
+class VirtualOrder {
+private:
+    std::unique_ptr<OrderStateNode> state_ = std::make_unique<CreatedOrderState>();
+    std::mutex mutex_;
+    
+public:
+    bool fire(OrderEvent event, OrderData& order) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto next = state_->on(event, order);
+        if (!next) return false;
+        state_ = std::move(next);
+        return true;
+    }
+    
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        state_ = std::make_unique<CreatedOrderState>();
+    }
+};
+
+void demonstrateTableStateMachine() {
+    std::cout << "\n=== БЕЗОПАСНАЯ РЕАЛИЗАЦИЯ 5: Табличные автоматы ===\n";
+    
+    // Заказ: guard HasPayment и action Refund из таблицы
+    OrderData order;
+    TableStateMachine<OrderTable, OrderData> machine(OrderStatus::CREATED);
+    machine.fire(OrderEvent::PAY, order);
+    std::cout << "SHIP без оплаты: " << (machine.fire(OrderEvent::SHIP, order) ? "принят" : "отклонён guard'ом") << "\n";
+    order.amount = 100.0;
+    machine.fire(OrderEvent::CANCEL, order);
+    std::cout << "CANCEL после оплаты: состояние " << static_cast<int>(machine.state())
+              << ", возврат " << (order.refunded ? "выполнен" : "не нужен") << "\n";
+    
+    // Соединение: пять потоков одновременно шлют CONNECT, CAS пропускает один
+    AtomicStateMachine<ConnectionTable> connection(ConnectionState::DISCONNECTED);
+    NoContext none;
+    std::atomic<int> winners{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 5; ++i) {
+        threads.emplace_back([&]() {
+            if (connection.fire(ConnectionEvent::CONNECT, none)) {
+                winners.fetch_add(1);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    connection.fire(ConnectionEvent::ESTABLISHED, none);
+    std::cout << "CONNECT из 5 потоков: принят " << winners.load() << " раз, состояние "
+              << static_cast<int>(connection.state()) << "\n";
+    
+    std::cout << "✅ Переход - поиск в constexpr таблице и CAS, без мьютекса и new\n";
+}
+
+// Бенчмарк: жизненный цикл заказа (PAY, SHIP, DELIVER, сброс) на множестве автоматов
+void benchmarkStateMachines() {
+    std::cout << "\n=== Бенчмарк: виртуальные состояния vs таблица ===\n";
+    
+    const size_t machines = 100000;
+    const size_t rounds = 20;
+    const OrderEvent lifecycle[] = {OrderEvent::PAY, OrderEvent::SHIP, OrderEvent::DELIVER};
+    const double transitions = static_cast<double>(machines * rounds * 3);
+    
+    auto measure = [&](const char* name, auto&& run) {
+        auto start = std::chrono::steady_clock::now();
+        size_t accepted = run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  " << name << ": " << static_cast<size_t>(transitions / seconds / 1e6)
+                  << " млн переходов/с (принято " << accepted << ")\n";
+    };
+    
+    std::vector<OrderData> orders(machines);
+    for (auto& order : orders) order.amount = 10.0;
+    
+    std::vector<VirtualOrder> virtual_orders(machines);
+    measure("virtual + mutex + new", [&]() {
+        size_t accepted = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < machines; ++i) {
+                for (OrderEvent event : lifecycle) accepted += virtual_orders[i].fire(event, orders[i]);
+                virtual_orders[i].reset();
+            }
+        }
+        return accepted;
+    });
+    
+    std::vector<TableStateMachine<OrderTable, OrderData>> table_orders(
+        machines, TableStateMachine<OrderTable, OrderData>(OrderStatus::CREATED));
+    measure("таблица", [&]() {
+        size_t accepted = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < machines; ++i) {
+                for (OrderEvent event : lifecycle) accepted += table_orders[i].fire(event, orders[i]);
+                table_orders[i].reset(OrderStatus::CREATED);
+            }
+        }
+        return accepted;
+    });
+    
+    std::deque<AtomicStateMachine<OrderTable, OrderData>> atomic_orders;  // std::atomic не перемещается
+    for (size_t i = 0; i < machines; ++i) atomic_orders.emplace_back(OrderStatus::CREATED);
+    measure("таблица + CAS", [&]() {
+        size_t accepted = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < machines; ++i) {
+                for (OrderEvent event : lifecycle) accepted += atomic_orders[i].fire(event, orders[i]);
+                atomic_orders[i].reset(OrderStatus::CREATED);
+            }
+        }
+        return accepted;
+    });
+    
+    StateMachineBatch<OrderTable, OrderData> batch(machines, OrderStatus::CREATED);
+    for (size_t i = 0; i < machines; ++i) batch.context(i).amount = 10.0;
+    measure("SoA batch", [&]() {
+        size_t accepted = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (OrderEvent event : lifecycle) accepted += batch.step(event);
+            batch.resetAll(OrderStatus::CREATED);
+        }
+        return accepted;
+    });
+}
+
 // ============================================================================
 // MAIN
 // ============================================================================
@@ -401,10 +921,13 @@ int main() {
     demonstrateValidatedStateMachine();
     demonstrateAtomicState();
     demonstrateRAIIState();
+    demonstrateTableStateMachine();
+    benchmarkStateMachines();
     
     std::cout << "\n=== РЕКОМЕНДАЦИИ ===\n";
     std::cout << "✅ Используйте мьютексы для защиты state\n";
     std::cout << "✅ Валидируйте переходы через transition table\n";
+    std::cout << "✅ Для миллионов автоматов - constexpr таблица, CAS и SoA\n";
     std::cout << "✅ Используйте std::atomic для простых состояний\n";
     std::cout << "✅ Применяйте RAII для гарантии enter/exit\n";
     std::cout << "✅ Используйте unique_ptr для владения state\n";
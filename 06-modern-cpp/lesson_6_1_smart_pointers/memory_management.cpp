@@ -9,6 +9,13 @@
 #include <thread>
 #include <mutex>
 #include <cassert>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <cstdint>
+
+#include "intrusive_ptr.h"
 
 /**
  * @file memory_management.cpp
@@ -259,6 +266,259 @@ public:
     }
 };
 
+/**
+ * @brief Шардированный кэш на weak_ptr для общего доступа из многих потоков
+ * 
+ * Ключи распределяются по N шардам, у каждого свой мьютекс и своя таблица,
+ * поэтому попадания в разные шарды не конкурируют. Истекшие записи
+ * удаляются инкрементально: sweep(budget) просматривает не больше budget
+ * записей за вызов и продолжает с места остановки, а промахи подметают
+ * несколько записей своего шарда. getOrCreate строит значение вне
+ * блокировки; конкурентные запросы того же ключа ждут первого строителя,
+ * а не создают дубликаты.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedWeakPtrCache {
+private:
+    /**
+     * @brief Построение значения, на которое могут ждать другие потоки
+     */
+    struct Pending {
+        std::mutex mutex;
+        std::condition_variable ready;
+        bool done = false;
+        std::shared_ptr<Value> value;
+        std::exception_ptr error;
+    };
+    
+    struct Entry {
+        std::weak_ptr<Value> weak;
+        std::shared_ptr<Pending> pending;
+    };
+    
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<Key, Entry, Hash> map;
+        size_t sweepBucket = 0;
+        size_t sweepOffset = 0;  // сколько элементов корзины sweepBucket уже просмотрено
+    };
+    
+    static constexpr size_t kSweepOnMiss = 4;
+    
+    std::unique_ptr<Shard[]> shards_;
+    size_t shardMask_;
+    Hash hash_;
+    std::atomic<size_t> sweepShard_{0};
+    
+    std::thread sweeper_;
+    std::mutex sweeperMutex_;
+    std::condition_variable sweeperWake_;
+    bool sweeperStop_ = false;
+    
+    Shard& shardFor(const Key& key) {
+        // Перемешивание: std::hash для целых - тождественная функция
+        uint64_t h = static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+        return shards_[(h >> 32) & shardMask_];
+    }
+    
+    /**
+     * @brief Просмотреть до budget записей шарда (шард уже заблокирован)
+     * @return число удалённых записей
+     */
+    static size_t sweepLocked(Shard& shard, size_t budget) {
+        auto& map = shard.map;
+        size_t buckets = map.bucket_count();
+        if (map.empty() || buckets == 0) {
+            return 0;
+        }
+        size_t removed = 0;
+        size_t visited = 0;
+        for (size_t advanced = 0; advanced < buckets && visited < budget;) {
+            size_t bucket = shard.sweepBucket % buckets;
+            const Key* expired[8];
+            size_t count = 0;
+            size_t position = 0;
+            auto it = map.begin(bucket);
+            // Начало корзины уже просмотрено прошлым вызовом: erase сохраняет
+            // порядок оставшихся элементов, так что позиция остаётся верной
+            for (; it != map.end(bucket) && position < shard.sweepOffset; ++it, ++position) {
+            }
+            for (; it != map.end(bucket) && count < 8 && visited < budget; ++it, ++visited, ++position) {
+                if (!it->second.pending && it->second.weak.expired()) {
+                    expired[count++] = &it->first;
+                }
+            }
+            bool finished = it == map.end(bucket);
+            // Удаляем после обхода корзины: erase инвалидирует итераторы корзины
+            for (size_t i = 0; i < count; ++i) {
+                map.erase(map.find(*expired[i]));
+            }
+            removed += count;
+            if (finished) {
+                ++shard.sweepBucket;
+                shard.sweepOffset = 0;
+                ++advanced;
+            } else {
+                // Кончился буфер или budget: следующий проход продолжит эту же корзину
+                shard.sweepOffset = position - count;
+            }
+        }
+        return removed;
+    }
+    
+public:
+    explicit ShardedWeakPtrCache(size_t shardCount = 16) {
+        size_t n = 1;
+        while (n < shardCount) {
+            n <<= 1;
+        }
+        shards_ = std::make_unique<Shard[]>(n);
+        shardMask_ = n - 1;
+    }
+    
+    ~ShardedWeakPtrCache() { stopSweeper(); }
+    
+    ShardedWeakPtrCache(const ShardedWeakPtrCache&) = delete;
+    ShardedWeakPtrCache& operator=(const ShardedWeakPtrCache&) = delete;
+    
+    std::shared_ptr<Value> get(const Key& key) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            return nullptr;
+        }
+        return it->second.weak.lock();
+    }
+    
+    void put(const Key& key, std::shared_ptr<Value> value) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.map[key].weak = value;
+        sweepLocked(shard, kSweepOnMiss);
+    }
+    
+    /**
+     * @brief Вернуть живое значение или построить его factory() ровно один раз
+     * 
+     * factory вызывается без блокировок шарда. Если factory бросает
+     * исключение, его получают и строитель, и все ожидавшие потоки.
+     */
+    template<typename Factory>
+    std::shared_ptr<Value> getOrCreate(const Key& key, Factory&& factory) {
+        Shard& shard = shardFor(key);
+        std::shared_ptr<Pending> pending;
+        bool builder = false;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            Entry& entry = shard.map[key];
+            if (auto alive = entry.weak.lock()) {
+                return alive;
+            }
+            if (entry.pending) {
+                pending = entry.pending;
+            } else {
+                pending = entry.pending = std::make_shared<Pending>();
+                builder = true;
+                sweepLocked(shard, kSweepOnMiss);
+            }
+        }
+        
+        if (!builder) {
+            std::unique_lock<std::mutex> lock(pending->mutex);
+            pending->ready.wait(lock, [&] { return pending->done; });
+            if (pending->error) {
+                std::rethrow_exception(pending->error);
+            }
+            return pending->value;
+        }
+        
+        std::shared_ptr<Value> value;
+        std::exception_ptr error;
+        try {
+            value = factory();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.map.find(key);
+            if (it != shard.map.end() && it->second.pending == pending) {
+                if (error) {
+                    shard.map.erase(it);
+                } else {
+                    it->second.weak = value;
+                    it->second.pending.reset();
+                }
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(pending->mutex);
+            pending->value = value;
+            pending->error = error;
+            pending->done = true;
+        }
+        pending->ready.notify_all();
+        
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return value;
+    }
+    
+    /**
+     * @brief Инкрементальная очистка: до budget записей в следующем шарде
+     * @return число удалённых записей
+     */
+    size_t sweep(size_t budget) {
+        Shard& shard = shards_[sweepShard_.fetch_add(1, std::memory_order_relaxed) & shardMask_];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return sweepLocked(shard, budget);
+    }
+    
+    /**
+     * @brief Фоновая очистка: раз в period проходит по всем шардам с бюджетом budget
+     */
+    void startSweeper(std::chrono::milliseconds period, size_t budget) {
+        stopSweeper();
+        sweeperStop_ = false;
+        sweeper_ = std::thread([this, period, budget] {
+            std::unique_lock<std::mutex> lock(sweeperMutex_);
+            while (!sweeperWake_.wait_for(lock, period, [this] { return sweeperStop_; })) {
+                lock.unlock();
+                for (size_t i = 0; i <= shardMask_; ++i) {
+                    sweep(budget);
+                }
+                lock.lock();
+            }
+        });
+    }
+    
+    void stopSweeper() {
+        if (!sweeper_.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(sweeperMutex_);
+            sweeperStop_ = true;
+        }
+        sweeperWake_.notify_all();
+        sweeper_.join();
+    }
+    
+    size_t size() const {
+        size_t total = 0;
+        for (size_t i = 0; i <= shardMask_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            total += shards_[i].map.size();
+        }
+        return total;
+    }
+    
+    size_t shardCount() const { return shardMask_ + 1; }
+};
+
 /**
  * @brief Объект для кэширования
  */
@@ -467,6 +727,144 @@ void demonstrateWeakPtrCache() {
     cache.printStats();
 }
 
+/**
+ * @brief Демонстрация шардированного кэша: getOrCreate и инкрементальная очистка
+ */
+void demonstrateShardedWeakPtrCache() {
+    std::cout << "\n=== Шардированный кэш с weak_ptr ===" << std::endl;
+    
+    ShardedWeakPtrCache<std::string, CacheableObject> cache(8);
+    
+    // 8 потоков одновременно просят один и тот же ключ: объект строится один раз
+    std::atomic<int> constructions{0};
+    std::vector<std::shared_ptr<CacheableObject>> results(8);
+    {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < results.size(); ++t) {
+            threads.emplace_back([&, t] {
+                results[t] = cache.getOrCreate("texture", [&] {
+                    constructions.fetch_add(1);
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    return std::make_shared<CacheableObject>(42, "декодированная текстура");
+                });
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+    }
+    bool same = std::all_of(results.begin(), results.end(), [&](const auto& p) { return p == results[0]; });
+    std::cout << "Построений: " << constructions.load() << ", все потоки получили один объект: "
+              << (same ? "да" : "нет") << std::endl;
+    results.clear();
+    
+    // Истекшие записи убираются порциями, без полного прохода под одной блокировкой
+    ShardedWeakPtrCache<int, int> ints(8);
+    {
+        std::vector<std::shared_ptr<int>> owners;
+        for (int i = 0; i < 10'000; ++i) {
+            owners.push_back(std::make_shared<int>(i));
+            ints.put(i, owners.back());
+        }
+    }
+    size_t calls = 0;
+    while (ints.size() > 0) {
+        ints.sweep(256);
+        ++calls;
+    }
+    std::cout << "10000 истекших записей удалены за " << calls << " вызовов sweep(256)" << std::endl;
+}
+
+/**
+ * @brief Бенчмарк: пропускная способность попаданий при 32 потоках
+ * 
+ * Один шард повторяет схему WeakPtrCache (общий мьютекс); сравниваем
+ * с разным числом шардов на одном и том же наборе горячих ключей.
+ */
+void benchmarkShardedCacheHits() {
+    std::cout << "\n=== Бенчмарк: попадания в кэш, 32 потока ===" << std::endl;
+    
+    constexpr size_t kKeys = 4096;
+    constexpr size_t kThreads = 32;
+    constexpr size_t kLookupsPerThread = 200'000;
+    
+    std::vector<std::string> keys;
+    std::vector<std::shared_ptr<std::vector<uint8_t>>> assets;
+    for (size_t i = 0; i < kKeys; ++i) {
+        keys.push_back("assets/textures/tile_" + std::to_string(i) + ".png");
+        assets.push_back(std::make_shared<std::vector<uint8_t>>(64, static_cast<uint8_t>(i)));
+    }
+    
+    for (size_t shards : {1u, 16u, 64u}) {
+        ShardedWeakPtrCache<std::string, std::vector<uint8_t>> cache(shards);
+        for (size_t i = 0; i < kKeys; ++i) {
+            cache.put(keys[i], assets[i]);
+        }
+        cache.startSweeper(std::chrono::milliseconds(10), 64);  // фоновая очистка, как в проде
+        
+        std::atomic<size_t> hits{0};
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                size_t local = 0;
+                uint64_t x = t * 0x9E3779B97F4A7C15ull + 1;
+                for (size_t i = 0; i < kLookupsPerThread; ++i) {
+                    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                    if (cache.get(keys[x % kKeys])) {
+                        ++local;
+                    }
+                }
+                hits.fetch_add(local, std::memory_order_relaxed);
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Шардов " << shards << ": " << hits.load() / seconds / 1e6 << " млн попаданий/с" << std::endl;
+    }
+}
+
+/**
+ * @brief Демонстрация интрузивного подсчёта ссылок
+ */
+void demonstrateIntrusivePtr() {
+    std::cout << "\n=== Интрузивный подсчёт ссылок ===" << std::endl;
+    
+    using cpp_patterns::BorrowedPtr;
+    using cpp_patterns::IntrusivePtr;
+    
+    // Счётчик - поле самого объекта: одна аллокация, указатель в одно слово
+    struct Texture : cpp_patterns::RefCounted<Texture> {
+        std::string path;
+        explicit Texture(std::string p) : path(std::move(p)) {}
+        ~Texture() { std::cout << "🗑️ Texture уничтожена: " << path << std::endl; }
+    };
+    
+    // Неатомарный вариант для объектов, не покидающих поток
+    struct Scratch : cpp_patterns::RefCounted<Scratch, cpp_patterns::LocalRefCount> {
+        int value = 0;
+    };
+    
+    auto texture = cpp_patterns::makeIntrusive<Texture>("grass.png");
+    IntrusivePtr<Texture> copy = texture;
+    std::cout << "Ссылок на текстуру: " << texture->refCount()
+              << ", sizeof(IntrusivePtr) = " << sizeof(IntrusivePtr<Texture>)
+              << ", sizeof(shared_ptr) = " << sizeof(std::shared_ptr<Texture>) << std::endl;
+    
+    // Невладеющий вид: цепочка вызовов не трогает счётчик
+    auto describe = [](BorrowedPtr<Texture> t) { return t->path + " (ссылок: " + std::to_string(t->refCount()) + ")"; };
+    std::cout << "Через BorrowedPtr: " << describe(texture) << std::endl;
+    
+    auto scratch = cpp_patterns::makeIntrusive<Scratch>();
+    scratch->value = 42;
+    std::cout << "Локальный объект, ссылок: " << scratch->refCount() << std::endl;
+    
+    copy.reset();
+    texture.reset();  // последний владелец удаляет объект
+}
+
 /**
  * @brief Демонстрация пула объектов
  */
@@ -516,7 +914,7 @@ void demonstrateObjectPool() {
 void demonstrateCircularReferences() {
     std::cout << "\n=== Циклические ссылки ===" << std::endl;
     
-    struct Node {
+    struct Node : std::enable_shared_from_this<Node> {
         std::string name_;
         std::shared_ptr<Node> parent_;
         std::vector<std::shared_ptr<Node>> children_;
@@ -556,7 +954,7 @@ void demonstrateCircularReferences() {
     // Решение: использование weak_ptr
     std::cout << "\n--- Решение с weak_ptr ---" << std::endl;
     {
-        struct SafeNode {
+        struct SafeNode : std::enable_shared_from_this<SafeNode> {
             std::string name_;
             std::weak_ptr<SafeNode> parent_;
             std::vector<std::shared_ptr<SafeNode>> children_;
@@ -606,6 +1004,9 @@ int main() {
     
     demonstrateResourceManager();
     demonstrateWeakPtrCache();
+    demonstrateShardedWeakPtrCache();
+    benchmarkShardedCacheHits();
+    demonstrateIntrusivePtr();
     demonstrateObjectPool();
     demonstrateCircularReferences();
     
@@ -613,6 +1014,7 @@ int main() {
     std::cout << "\n🎯 Ключевые выводы:" << std::endl;
     std::cout << "• Менеджеры ресурсов автоматически управляют жизненным циклом" << std::endl;
     std::cout << "• Кэши с weak_ptr предотвращают утечки памяти" << std::endl;
+    std::cout << "• Шардирование и порционная очистка убирают общий мьютекс с горячего пути" << std::endl;
     std::cout << "• Пул объектов повышает производительность за счет переиспользования" << std::endl;
     std::cout << "• weak_ptr решает проблему циклических ссылок" << std::endl;
     std::cout << "• Умные указатели обеспечивают exception safety" << std::endl;
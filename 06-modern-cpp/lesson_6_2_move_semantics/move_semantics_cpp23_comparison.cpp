@@ -5,32 +5,47 @@
 #include <vector>
 #include <memory>
 
-#if __cplusplus >= 202302L
+#include "aligned_buffer.h"
+
+// Наличие expected/mdspan решают макросы библиотеки: GCC 12 с -std=c++23
+// даёт __cplusplus 202100L, хотя std::expected уже есть
+#if __has_include(<version>)
+    #include <version>
+#endif
+
+#ifdef __cpp_lib_expected
     #include <expected>
-    #include <print>
-    #include <mdspan>
     #define HAS_CPP23 1
     using std::expected; using std::unexpected;
 #else
     #define HAS_CPP23 0
-    template<typename T, typename E> struct expected { T v; bool has_value() const { return true; } T& operator*() { return v; } };
+    // Минимальная замена для C++17: значение или ошибка, без исключений
+    template<typename E> struct unexpected { E e; explicit unexpected(E error) : e(error) {} };
+    template<typename T, typename E> struct expected {
+        T v{}; E err{}; bool ok;
+        expected(T value) : v(value), ok(true) {}
+        expected(unexpected<E> error) : err(error.e), ok(false) {}
+        bool has_value() const { return ok; } T& operator*() { return v; } const E& error() const { return err; }
+    };
 #endif
 
+#ifdef __cpp_lib_mdspan
+    #include <mdspan>
+#endif
+
+// Память - AlignedBuffer: выровнена на кэш-линию, перемещение оставляет источник пустым
 namespace cpp17 {
     class Buffer {
-        std::unique_ptr<int[]> data_;
-        size_t size_;
+        cpp_patterns::AlignedBuffer<int> data_;
     public:
-        Buffer(size_t size) : data_(std::make_unique<int[]>(size)), size_(size) {}
+        Buffer(size_t size) : data_(size) {}
         
         // Move constructor
         Buffer(Buffer&& other) noexcept 
-            : data_(std::move(other.data_)), size_(other.size_) {
-            other.size_ = 0;
-        }
+            : data_(std::move(other.data_)) {}
         
-        int* getData() { return data_.get(); }
-        size_t getSize() const { return size_; }
+        int* getData() { return data_.data(); }
+        size_t getSize() const { return data_.size(); }
     };
 }
 
@@ -38,15 +53,13 @@ namespace cpp23 {
     enum class MoveError { AlreadyMoved, InvalidState };
     
     class Buffer {
-        std::unique_ptr<int[]> data_;
-        size_t size_;
+        cpp_patterns::AlignedBuffer<int> data_;
         bool moved_from_ = false;
     public:
-        Buffer(size_t size) : data_(std::make_unique<int[]>(size)), size_(size) {}
+        Buffer(size_t size) : data_(size) {}
         
         Buffer(Buffer&& other) noexcept 
-            : data_(std::move(other.data_)), size_(other.size_) {
-            other.size_ = 0;
+            : data_(std::move(other.data_)) {
             other.moved_from_ = true;  // ✅ Track moved-from state
         }
         
@@ -55,15 +68,13 @@ namespace cpp23 {
             if (moved_from_) {
                 return unexpected(MoveError::AlreadyMoved);
             }
-            return data_.get();
+            return data_.data();
         }
         
-#if HAS_CPP23
-        // ✅ mdspan для multi-dimensional view
+#if HAS_CPP23 && defined(__cpp_lib_mdspan)
+        // ✅ mdspan для multi-dimensional view; форма проверяется против размера буфера
         std::mdspan<int, std::dextents<size_t, 2>> as2D(size_t rows, size_t cols) {
-            return std::mdspan<int, std::dextents<size_t, 2>>(
-                data_.get(), rows, cols
-            );
+            return data_.mdspan(rows, cols);
         }
 #endif
     };
@@ -85,8 +96,12 @@ int main() {
         std::cout << "✅ Correctly detected use-after-move\n";
     }
     
-    std::cout << "✅ C++23: expected для move validation\n";
+    std::cout << (HAS_CPP23 ? "✅ C++23: std::expected" : "✅ C++17: замена expected") << " для move validation\n";
+#ifdef __cpp_lib_mdspan
     std::cout << "✅ C++23: mdspan для multi-dimensional views\n";
+#else
+    std::cout << "ℹ️ std::mdspan недоступен: as2D() не собирается, см. AlignedBuffer::as2D\n";
+#endif
     return 0;
 }
 
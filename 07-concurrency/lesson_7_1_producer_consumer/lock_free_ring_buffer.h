@@ -0,0 +1,63 @@
+/**
+ * @file lock_free_ring_buffer.h
+ * @brief SPSC-кольцо урока Producer-Consumer
+ *
+ * Вынесено из secure_producer_consumer_alternatives.cpp, чтобы бенчмарки
+ * (benchmarks/bench_queues.cpp) сравнивали с очередью под мьютексом именно
+ * это кольцо, а не его упрощённую копию.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Кольцо на N - 1 элементов: один производитель, один потребитель
+template<typename T, size_t N>
+class LockFreeRingBuffer {
+private:
+    std::array<T, N> buffer_;
+    std::atomic<size_t> head_{0};  // Для producer
+    std::atomic<size_t> tail_{0};  // Для consumer
+    
+    // Padding для избежания false sharing
+    char padding_[64];
+    
+public:
+    bool push(const T& item) {
+        size_t current_head = head_.load(std::memory_order_relaxed);
+        size_t next_head = (current_head + 1) % N;
+        
+        if (next_head == tail_.load(std::memory_order_acquire)) {
+            return false;  // Очередь полная
+        }
+        
+        buffer_[current_head] = item;
+        head_.store(next_head, std::memory_order_release);
+        return true;
+    }
+    
+    bool pop(T& item) {
+        size_t current_tail = tail_.load(std::memory_order_relaxed);
+        
+        if (current_tail == head_.load(std::memory_order_acquire)) {
+            return false;  // Очередь пустая
+        }
+        
+        item = buffer_[current_tail];
+        tail_.store((current_tail + 1) % N, std::memory_order_release);
+        return true;
+    }
+    
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == 
+               tail_.load(std::memory_order_acquire);
+    }
+    
+    size_t size() const {
+        size_t h = head_.load(std::memory_order_acquire);
+        size_t t = tail_.load(std::memory_order_acquire);
+        return (h >= t) ? (h - t) : (N + h - t);
+    }
+};
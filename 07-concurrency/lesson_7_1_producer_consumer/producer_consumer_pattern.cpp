@@ -7,6 +7,9 @@
 #include <vector>
 #include <random>
 #include <memory>
+#include <algorithm>
+
+#include "producer_consumer_pattern.h"
 
 /**
  * @file producer_consumer_pattern.cpp
@@ -16,105 +19,6 @@
  * от базовой до продвинутых версий с множественными producer/consumer.
  */
 
-// ============================================================================
-// БАЗОВАЯ ОЧЕРЕДЬ PRODUCER-CONSUMER
-// ============================================================================
-
-/**
- * @brief Базовая thread-safe очередь для Producer-Consumer
- * 
- * Особенности:
- * - Thread-safe операции push/pop
- * - Условные переменные для эффективного ожидания
- * - Поддержка завершения работы
- */
-template<typename T>
-class ProducerConsumerQueue {
-private:
-    std::queue<T> queue_;
-    mutable std::mutex mutex_;
-    std::condition_variable condition_;
-    bool finished_ = false;
-    size_t maxSize_ = 0; // 0 = без ограничений
-    
-public:
-    explicit ProducerConsumerQueue(size_t maxSize = 0) : maxSize_(maxSize) {}
-    
-    /**
-     * @brief Добавляет элемент в очередь
-     * @param item Элемент для добавления
-     * @return true если элемент добавлен, false если очередь полная
-     */
-    bool push(T item) {
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        // Ждем, если очередь полная
-        if (maxSize_ > 0 && queue_.size() >= maxSize_) {
-            condition_.wait(lock, [this] { 
-                return queue_.size() < maxSize_ || finished_; 
-            });
-        }
-        
-        if (finished_) return false;
-        
-        queue_.push(std::move(item));
-        condition_.notify_one(); // Уведомляем consumer
-        return true;
-    }
-    
-    /**
-     * @brief Извлекает элемент из очереди
-     * @param item Ссылка для сохранения извлеченного элемента
-     * @return true если элемент извлечен, false если очередь пустая и завершена
-     */
-    bool pop(T& item) {
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        // Ждем, пока не появится элемент или не завершится работа
-        condition_.wait(lock, [this] { return !queue_.empty() || finished_; });
-        
-        if (queue_.empty()) return false;
-        
-        item = std::move(queue_.front());
-        queue_.pop();
-        condition_.notify_one(); // Уведомляем producer о свободном месте
-        return true;
-    }
-    
-    /**
-     * @brief Завершает работу очереди
-     */
-    void finish() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        finished_ = true;
-        condition_.notify_all(); // Уведомляем все ожидающие потоки
-    }
-    
-    /**
-     * @brief Проверяет, завершена ли работа
-     */
-    bool isFinished() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return finished_;
-    }
-    
-    /**
-     * @brief Возвращает текущий размер очереди
-     */
-    size_t size() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return queue_.size();
-    }
-    
-    /**
-     * @brief Проверяет, пуста ли очередь
-     */
-    bool empty() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return queue_.empty();
-    }
-};
-
 // ============================================================================
 // PRODUCER (ПРОИЗВОДИТЕЛЬ)
 // ============================================================================
@@ -416,6 +320,9 @@ void demonstrateStatisticsProducerConsumer() {
 
 /**
  * @brief Демонстрация производительности
+ *
+ * Один прогон для иллюстрации. Сравнимые цифры (прогрев, повторы,
+ * медиана и p99) даёт цель benchmarks: ./benchmarks --filter='^queue/'
  */
 void demonstratePerformance() {
     std::cout << "\n=== ТЕСТ ПРОИЗВОДИТЕЛЬНОСТИ ===" << std::endl;
@@ -10,6 +10,8 @@
 #include <vector>
 #include <array>
 
+#include "lock_free_ring_buffer.h"
+
 /**
  * @file secure_producer_consumer_alternatives.cpp
  * @brief Безопасные реализации паттерна Producer-Consumer
@@ -122,56 +124,9 @@ void demonstrateSafeBoundedQueue() {
 // БЕЗОПАСНАЯ РЕАЛИЗАЦИЯ 2: LOCK-FREE RING BUFFER (SPSC)
 // Решает: Lock contention, высокая производительность
 // Примечание: Single Producer, Single Consumer
+// Само кольцо - в lock_free_ring_buffer.h
 // ============================================================================
 
-template<typename T, size_t N>
-class LockFreeRingBuffer {
-private:
-    std::array<T, N> buffer_;
-    std::atomic<size_t> head_{0};  // Для producer
-    std::atomic<size_t> tail_{0};  // Для consumer
-    
-    // Padding для избежания false sharing
-    char padding_[64];
-    
-public:
-    bool push(const T& item) {
-        size_t current_head = head_.load(std::memory_order_relaxed);
-        size_t next_head = (current_head + 1) % N;
-        
-        if (next_head == tail_.load(std::memory_order_acquire)) {
-            return false;  // Очередь полная
-        }
-        
-        buffer_[current_head] = item;
-        head_.store(next_head, std::memory_order_release);
-        return true;
-    }
-    
-    bool pop(T& item) {
-        size_t current_tail = tail_.load(std::memory_order_relaxed);
-        
-        if (current_tail == head_.load(std::memory_order_acquire)) {
-            return false;  // Очередь пустая
-        }
-        
-        item = buffer_[current_tail];
-        tail_.store((current_tail + 1) % N, std::memory_order_release);
-        return true;
-    }
-    
-    bool empty() const {
-        return head_.load(std::memory_order_acquire) == 
-               tail_.load(std::memory_order_acquire);
-    }
-    
-    size_t size() const {
-        size_t h = head_.load(std::memory_order_acquire);
-        size_t t = tail_.load(std::memory_order_acquire);
-        return (h >= t) ? (h - t) : (N + h - t);
-    }
-};
-
 void demonstrateLockFreeRingBuffer() {
     std::cout << "\n=== БЕЗОПАСНАЯ РЕАЛИЗАЦИЯ 2: Lock-Free Ring Buffer (SPSC) ===\n";
     
@@ -7,6 +7,9 @@
  * - std::future/std::promise
  * - Work stealing
  * - Динамическое масштабирование
+ * - Продолжения (then, whenAll, whenAny) и графы задач без блокировки воркеров
+ * - Параллельные алгоритмы: parallelFor, transform-reduce, сканы, сортировка
+ * - Закрепление воркеров за CPU (compact/scatter/явный набор) и кража у ближних
  */
 
 #include <iostream>
@@ -22,309 +25,25 @@
 #include <memory>
 #include <algorithm>
 #include <random>
+#include <iterator>
+#include <utility>
 
-// Приоритеты задач
-enum class TaskPriority {
-    LOW = 0,
-    NORMAL = 1,
-    HIGH = 2,
-    CRITICAL = 3
-};
+// std::execution::par в libstdc++ работает через TBB; CMake включает его, если TBB найден
+#ifdef CPP_PATTERNS_HAS_STD_PAR
+#include <execution>
+#endif
+#include <numeric>
+#include <cmath>
+#include <string>
+#include <optional>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
 
-// Структура задачи с приоритетом
-struct Task {
-    std::function<void()> function;
-    TaskPriority priority;
-    std::chrono::system_clock::time_point created_at;
-    
-    Task(std::function<void()> func, TaskPriority prio = TaskPriority::NORMAL)
-        : function(std::move(func)), priority(prio), 
-          created_at(std::chrono::system_clock::now()) {}
-    
-    // Компаратор для приоритетной очереди (высший приоритет первым)
-    bool operator<(const Task& other) const {
-        if (priority != other.priority) {
-            return priority < other.priority; // Обратный порядок для приоритета
-        }
-        return created_at > other.created_at; // FIFO для одинакового приоритета
-    }
-};
-
-// Статистика выполнения
-struct ThreadPoolStats {
-    std::atomic<size_t> tasks_completed{0};
-    std::atomic<size_t> tasks_failed{0};
-    std::atomic<size_t> tasks_pending{0};
-    std::atomic<size_t> active_threads{0};
-    std::chrono::system_clock::time_point start_time;
-    
-    ThreadPoolStats() : start_time(std::chrono::system_clock::now()) {}
-    
-    void printStats() const {
-        auto now = std::chrono::system_clock::now();
-        auto uptime = std::chrono::duration_cast<std::chrono::seconds>(now - start_time);
-        
-        std::cout << "\n=== Thread Pool Statistics ===" << std::endl;
-        std::cout << "Uptime: " << uptime.count() << " seconds" << std::endl;
-        std::cout << "Tasks completed: " << tasks_completed.load() << std::endl;
-        std::cout << "Tasks failed: " << tasks_failed.load() << std::endl;
-        std::cout << "Tasks pending: " << tasks_pending.load() << std::endl;
-        std::cout << "Active threads: " << active_threads.load() << std::endl;
-        
-        if (tasks_completed.load() > 0) {
-            double throughput = static_cast<double>(tasks_completed.load()) / uptime.count();
-            std::cout << "Throughput: " << throughput << " tasks/second" << std::endl;
-        }
-        std::cout << "===============================" << std::endl;
-    }
-};
-
-// Асинхронный Thread Pool с Work Stealing
-class AsyncThreadPool {
-private:
-    std::vector<std::thread> workers_;
-    std::vector<std::priority_queue<Task>> local_queues_; // Локальные очереди для work stealing
-    std::priority_queue<Task> global_queue_; // Глобальная очередь
-    std::mutex global_queue_mutex_;
-    std::vector<std::mutex> local_queue_mutexes_;
-    std::condition_variable condition_;
-    std::atomic<bool> stop_{false};
-    std::atomic<bool> shutdown_{false};
-    ThreadPoolStats stats_;
-    std::atomic<size_t> next_thread_{0};
-    
-public:
-    explicit AsyncThreadPool(size_t num_threads = std::thread::hardware_concurrency()) 
-        : local_queues_(num_threads), local_queue_mutexes_(num_threads) {
-        
-        // Создаем рабочие потоки
-        for (size_t i = 0; i < num_threads; ++i) {
-            workers_.emplace_back([this, i]() {
-                workerLoop(i);
-            });
-        }
-        
-        std::cout << "Async Thread Pool создан с " << num_threads << " потоками" << std::endl;
-    }
-    
-    ~AsyncThreadPool() {
-        shutdown();
-    }
-    
-    // Добавление задачи с возвратом future
-    template<typename F, typename... Args>
-    auto enqueue(F&& f, Args&&... args) 
-        -> std::future<typename std::result_of<F(Args...)>::type> {
-        
-        using return_type = typename std::result_of<F(Args...)>::type;
-        
-        // Создаем packaged_task
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
-        
-        // Получаем future
-        std::future<return_type> result = task->get_future();
-        
-        // Выбираем случайный поток для локальной очереди
-        size_t thread_id = next_thread_.fetch_add(1) % workers_.size();
-        
-        {
-            std::unique_lock<std::mutex> lock(local_queue_mutexes_[thread_id]);
-            
-            if (shutdown_.load()) {
-                throw std::runtime_error("Thread Pool остановлен");
-            }
-            
-            // Добавляем задачу в локальную очередь
-            local_queues_[thread_id].emplace([task]() { (*task)(); }, TaskPriority::NORMAL);
-            stats_.tasks_pending.fetch_add(1);
-        }
-        
-        // Уведомляем поток
-        condition_.notify_one();
-        
-        return result;
-    }
-    
-    // Добавление задачи с приоритетом
-    template<typename F, typename... Args>
-    auto enqueueWithPriority(TaskPriority priority, F&& f, Args&&... args) 
-        -> std::future<typename std::result_of<F(Args...)>::type> {
-        
-        using return_type = typename std::result_of<F(Args...)>::type;
-        
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
-        
-        std::future<return_type> result = task->get_future();
-        
-        {
-            std::unique_lock<std::mutex> lock(global_queue_mutex_);
-            
-            if (shutdown_.load()) {
-                throw std::runtime_error("Thread Pool остановлен");
-            }
-            
-            // Высокоприоритетные задачи идут в глобальную очередь
-            global_queue_.emplace([task]() { (*task)(); }, priority);
-            stats_.tasks_pending.fetch_add(1);
-        }
-        
-        condition_.notify_all();
-        return result;
-    }
-    
-    // Graceful shutdown
-    void shutdown() {
-        if (shutdown_.load()) return;
-        
-        std::cout << "Начинаем graceful shutdown..." << std::endl;
-        
-        shutdown_.store(true);
-        condition_.notify_all();
-        
-        for (auto& worker : workers_) {
-            if (worker.joinable()) {
-                worker.join();
-            }
-        }
-        
-        std::cout << "Async Thread Pool остановлен" << std::endl;
-        stats_.printStats();
-    }
-    
-    // Получение статистики
-    const ThreadPoolStats& getStats() const {
-        return stats_;
-    }
-    
-    // Динамическое масштабирование (упрощенная версия)
-    void scaleUp(size_t additional_threads) {
-        std::cout << "Масштабирование вверх: добавляем " << additional_threads << " потоков" << std::endl;
-        
-        for (size_t i = 0; i < additional_threads; ++i) {
-            size_t thread_id = workers_.size();
-            local_queue_mutexes_.push_back(std::mutex{});
-            local_queues_.push_back(std::priority_queue<Task>{});
-            
-            workers_.emplace_back([this, thread_id]() {
-                workerLoop(thread_id);
-            });
-        }
-    }
-    
-private:
-    void workerLoop(size_t worker_id) {
-        std::cout << "Worker " << worker_id << " запущен" << std::endl;
-        
-        while (!stop_.load()) {
-            Task task([](){}); // Пустая задача по умолчанию
-            bool has_task = false;
-            
-            // 1. Проверяем локальную очередь
-            {
-                std::unique_lock<std::mutex> lock(local_queue_mutexes_[worker_id]);
-                if (!local_queues_[worker_id].empty()) {
-                    task = std::move(const_cast<Task&>(local_queues_[worker_id].top()));
-                    local_queues_[worker_id].pop();
-                    has_task = true;
-                    stats_.tasks_pending.fetch_sub(1);
-                    stats_.active_threads.fetch_add(1);
-                }
-            }
-            
-            // 2. Если локальная очередь пуста, проверяем глобальную
-            if (!has_task) {
-                std::unique_lock<std::mutex> lock(global_queue_mutex_);
-                if (!global_queue_.empty()) {
-                    task = std::move(const_cast<Task&>(global_queue_.top()));
-                    global_queue_.pop();
-                    has_task = true;
-                    stats_.tasks_pending.fetch_sub(1);
-                    stats_.active_threads.fetch_add(1);
-                }
-            }
-            
-            // 3. Work Stealing: если все очереди пусты, пытаемся украсть работу
-            if (!has_task) {
-                has_task = tryStealWork(worker_id, task);
-            }
-            
-            // 4. Если все еще нет работы, ждем
-            if (!has_task) {
-                std::unique_lock<std::mutex> lock(global_queue_mutex_);
-                condition_.wait(lock, [this] {
-                    return !global_queue_.empty() || stop_.load() || shutdown_.load();
-                });
-                continue;
-            }
-            
-            // Выполняем задачу
-            if (has_task) {
-                try {
-                    task.function();
-                    stats_.tasks_completed.fetch_add(1);
-                } catch (const std::exception& e) {
-                    std::cerr << "Ошибка в задаче: " << e.what() << std::endl;
-                    stats_.tasks_failed.fetch_add(1);
-                }
-                
-                stats_.active_threads.fetch_sub(1);
-            }
-            
-            if (shutdown_.load() && !has_task) {
-                break;
-            }
-        }
-        
-        std::cout << "Worker " << worker_id << " завершен" << std::endl;
-    }
-    
-    // Work Stealing: попытка украсть работу у других потоков
-    bool tryStealWork(size_t worker_id, Task& task) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(0, workers_.size() - 1);
-        
-        // Пытаемся украсть работу у случайного потока
-        for (int attempt = 0; attempt < 3; ++attempt) {
-            size_t victim_id = dis(gen);
-            if (victim_id == worker_id) continue;
-            
-            std::unique_lock<std::mutex> lock(local_queue_mutexes_[victim_id], std::try_to_lock);
-            if (lock.owns_lock() && !local_queues_[victim_id].empty()) {
-                // Берем половину задач из жертвы
-                size_t steal_count = local_queues_[victim_id].size() / 2;
-                if (steal_count == 0) steal_count = 1;
-                
-                std::vector<Task> stolen_tasks;
-                for (size_t i = 0; i < steal_count && !local_queues_[victim_id].empty(); ++i) {
-                    stolen_tasks.push_back(std::move(const_cast<Task&>(local_queues_[victim_id].top())));
-                    local_queues_[victim_id].pop();
-                }
-                
-                // Берем первую задачу для выполнения
-                if (!stolen_tasks.empty()) {
-                    task = std::move(stolen_tasks[0]);
-                    stats_.tasks_pending.fetch_sub(1);
-                    stats_.active_threads.fetch_add(1);
-                    
-                    // Остальные задачи добавляем в свою локальную очередь
-                    std::unique_lock<std::mutex> my_lock(local_queue_mutexes_[worker_id]);
-                    for (size_t i = 1; i < stolen_tasks.size(); ++i) {
-                        local_queues_[worker_id].push(std::move(stolen_tasks[i]));
-                    }
-                    
-                    return true;
-                }
-            }
-        }
-        
-        return false;
-    }
-};
+#include "async_thread_pool.h"
+#include "cpu_topology.h"
+#include "tracing.h"
 
 // Примеры использования
 void demonstrateAsyncThreadPool() {
@@ -379,6 +98,7 @@ void demonstrateAsyncThreadPool() {
 void demonstrateWorkStealing() {
     std::cout << "\n=== Демонстрация Work Stealing ===" << std::endl;
     
+    cpp_patterns::TraceSession trace("work_stealing_trace.json", cpp_patterns::traceRequested());
     AsyncThreadPool pool(2);
     
     // Создаем много задач для демонстрации work stealing
@@ -443,6 +163,369 @@ void demonstrateScaling() {
     pool.shutdown();
 }
 
+// Демонстрация продолжений и графа задач
+void demonstrateContinuations() {
+    std::cout << "\n=== Демонстрация продолжений и графа задач ===" << std::endl;
+    
+    AsyncThreadPool pool(4);
+    
+    // Цепочка then: ни один воркер не ждёт предшественника
+    auto doubled = pool.submit([] { return std::string("21"); })
+                       .then([](const std::string& text) { return std::stoi(text); })
+                       .then([](int value) { return value * 2; });
+    
+    std::vector<AsyncResult<int>> parts;
+    for (int i = 0; i < 4; ++i) {
+        parts.push_back(pool.submit([i] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10 * (4 - i)));
+            return i * i;
+        }));
+    }
+    auto total = whenAll(pool, parts).then([](const std::vector<int>& values) {
+        return std::accumulate(values.begin(), values.end(), 0);
+    });
+    auto first = whenAny(pool, parts);
+    
+    // Ошибка проходит по цепочке, не вызывая продолжение
+    auto failed = pool.submit([]() -> int { throw std::runtime_error("ошибка источника"); })
+                      .then([](int value) { return value + 1; });
+    
+    std::cout << "then: " << doubled.get() << std::endl;
+    std::cout << "whenAll: сумма квадратов = " << total.get() << std::endl;
+    std::cout << "whenAny: первой завершилась часть " << first.get().first << std::endl;
+    try {
+        failed.get();
+    } catch (const std::exception& e) {
+        std::cout << "Ошибка в цепочке: " << e.what() << std::endl;
+    }
+    
+    // Ромб: load -> (parse, validate) -> store
+    TaskGraph graph;
+    std::mutex log_mutex;
+    auto step = [&log_mutex](const char* name) {
+        return [&log_mutex, name] {
+            std::lock_guard<std::mutex> lock(log_mutex);
+            std::cout << "  узел " << name << " в потоке " << std::this_thread::get_id() << std::endl;
+        };
+    };
+    auto load = graph.addTask(step("load"));
+    auto parse = graph.addTask(step("parse"));
+    auto validate = graph.addTask(step("validate"));
+    auto store = graph.addTask(step("store"));
+    graph.precede(load, parse);
+    graph.precede(load, validate);
+    graph.precede(parse, store);
+    graph.precede(validate, store);
+    size_t executed = graph.run(pool).get();
+    std::cout << "TaskGraph: выполнено узлов " << executed << std::endl;
+    
+    pool.shutdown();
+}
+
+// Бенчмарк: дерево редукции и волновой DAG - блокирующие future против продолжений
+void benchmarkTaskGraphs() {
+    std::cout << "\n=== Бенчмарк: future.get() в воркерах против графа задач ===" << std::endl;
+    
+    // Минимум 4 воркера: на малом числе ядер блокирующая версия иначе не проявится
+    const size_t workers = std::max<size_t>(4, std::thread::hardware_concurrency());
+    constexpr int kRounds = 3;
+    auto seconds = [](auto start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    
+    AsyncThreadPool pool(workers);
+    
+    // Блокирующие версии идут через глобальную FIFO-очередь: с локальными
+    // очередями и кражей воркер может заснуть в get() на задаче, которая
+    // лежит в его же очереди, и пул взаимно блокируется
+    auto blockingEnqueue = [&pool](auto&& f) {
+        return pool.enqueueWithPriority(TaskPriority::NORMAL, std::forward<decltype(f)>(f)).share();
+    };
+    
+    // 1. Дерево редукции: 1024 листа, попарное сложение до корня
+    constexpr size_t kLeaves = 1024;
+    constexpr size_t kChunk = 4096;
+    std::vector<double> data(kLeaves * kChunk);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<double>(i % 97);
+    }
+    auto sumChunk = [&data](size_t leaf) {
+        double sum = 0.0;
+        for (size_t i = leaf * kChunk; i < (leaf + 1) * kChunk; ++i) {
+            sum += std::sqrt(data[i]);
+        }
+        return sum;
+    };
+    
+    double blocking_best = 1e30, graph_best = 1e30;
+    double blocking_sum = 0.0, graph_sum = 0.0;
+    for (int round = 0; round < kRounds; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::shared_future<double>> level;
+        for (size_t leaf = 0; leaf < kLeaves; ++leaf) {
+            level.push_back(blockingEnqueue([&sumChunk, leaf] { return sumChunk(leaf); }));
+        }
+        while (level.size() > 1) {
+            std::vector<std::shared_future<double>> next;
+            for (size_t i = 0; i + 1 < level.size(); i += 2) {
+                // Воркер блокируется, пока не готовы оба ребёнка
+                next.push_back(blockingEnqueue([a = level[i], b = level[i + 1]] { return a.get() + b.get(); }));
+            }
+            if (level.size() % 2) next.push_back(level.back());
+            level.swap(next);
+        }
+        blocking_sum = level[0].get();
+        blocking_best = std::min(blocking_best, seconds(start));
+        
+        start = std::chrono::steady_clock::now();
+        std::vector<AsyncResult<double>> results;
+        for (size_t leaf = 0; leaf < kLeaves; ++leaf) {
+            results.push_back(pool.submit([&sumChunk, leaf] { return sumChunk(leaf); }));
+        }
+        while (results.size() > 1) {
+            std::vector<AsyncResult<double>> next;
+            for (size_t i = 0; i + 1 < results.size(); i += 2) {
+                next.push_back(whenAll(pool, std::vector<AsyncResult<double>>{results[i], results[i + 1]})
+                                   .then([](const std::vector<double>& pair) { return pair[0] + pair[1]; }));
+            }
+            if (results.size() % 2) next.push_back(results.back());
+            results.swap(next);
+        }
+        graph_sum = results[0].get();
+        graph_best = std::min(graph_best, seconds(start));
+    }
+    std::cout << "Редукция (" << kLeaves << " листов, " << workers << " воркеров): future.get() "
+              << blocking_best * 1000 << " мс, продолжения " << graph_best * 1000 << " мс"
+              << (blocking_sum == graph_sum ? "" : " ❌ суммы различаются") << std::endl;
+    
+    // 2. Волновой DAG: ячейка (i, j) зависит от (i-1, j) и (i, j-1)
+    constexpr size_t kGrid = 64;
+    constexpr int kCellWork = 2000;
+    auto cellValue = [](double up, double left, size_t i, size_t j) {
+        double acc = 0.5 * (up + left);
+        for (int k = 0; k < kCellWork; ++k) {
+            acc = acc * 0.999 + std::sqrt(acc + static_cast<double>(k + i + j));
+        }
+        return acc;
+    };
+    
+    blocking_best = graph_best = 1e30;
+    for (int round = 0; round < kRounds; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::shared_future<double>> cells(kGrid * kGrid);
+        for (size_t i = 0; i < kGrid; ++i) {
+            for (size_t j = 0; j < kGrid; ++j) {
+                std::shared_future<double> up = i ? cells[(i - 1) * kGrid + j] : std::shared_future<double>();
+                std::shared_future<double> left = j ? cells[i * kGrid + j - 1] : std::shared_future<double>();
+                cells[i * kGrid + j] = blockingEnqueue([&cellValue, up, left, i, j] {
+                    return cellValue(up.valid() ? up.get() : 0.0, left.valid() ? left.get() : 0.0, i, j);
+                });
+            }
+        }
+        blocking_sum = cells.back().get();
+        blocking_best = std::min(blocking_best, seconds(start));
+        
+        start = std::chrono::steady_clock::now();
+        std::vector<double> values(kGrid * kGrid);
+        TaskGraph graph;
+        for (size_t i = 0; i < kGrid; ++i) {
+            for (size_t j = 0; j < kGrid; ++j) {
+                auto id = graph.addTask([&values, &cellValue, i, j] {
+                    values[i * kGrid + j] = cellValue(i ? values[(i - 1) * kGrid + j] : 0.0,
+                                                      j ? values[i * kGrid + j - 1] : 0.0, i, j);
+                });
+                if (i) graph.precede(static_cast<TaskGraph::NodeId>((i - 1) * kGrid + j), id);
+                if (j) graph.precede(id - 1, id);
+            }
+        }
+        graph.run(pool).get();
+        graph_sum = values.back();
+        graph_best = std::min(graph_best, seconds(start));
+    }
+    std::cout << "Волновой DAG (" << kGrid << "x" << kGrid << "): future.get() "
+              << blocking_best * 1000 << " мс, TaskGraph " << graph_best * 1000 << " мс"
+              << (blocking_sum == graph_sum ? "" : " ❌ результаты различаются") << std::endl;
+    
+    pool.shutdown();
+}
+
+// Демонстрация параллельных алгоритмов
+void demonstrateParallelAlgorithms() {
+    std::cout << "\n=== Демонстрация параллельных алгоритмов ===" << std::endl;
+    
+    AsyncThreadPool pool(4);
+    ParallelOptions fine_grain;
+    fine_grain.min_grain = 2;  // маленькие данные: делим мелко, чтобы увидеть работу пула
+    
+    std::vector<int> values(16);
+    parallelFor(pool, 0, values.size(), [&values](size_t i) { values[i] = static_cast<int>(i + 1); }, fine_grain);
+    
+    long long squares = parallelTransformReduce(pool, values.begin(), values.end(), 0LL, std::plus<>(),
+                                                [](int v) { return static_cast<long long>(v) * v; }, fine_grain);
+    std::cout << "Сумма квадратов 1..16: " << squares << std::endl;
+    
+    std::vector<int> inclusive(values.size()), exclusive(values.size());
+    parallelInclusiveScan(pool, values.begin(), values.end(), inclusive.begin(), std::plus<>(), fine_grain);
+    parallelExclusiveScan(pool, values.begin(), values.end(), exclusive.begin(), 0, std::plus<>(), fine_grain);
+    std::cout << "inclusive_scan: ";
+    for (int v : inclusive) std::cout << v << " ";
+    std::cout << "\nexclusive_scan: ";
+    for (int v : exclusive) std::cout << v << " ";
+    std::cout << std::endl;
+    
+    std::vector<int> shuffled = values;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+    parallelSort(pool, shuffled.begin(), shuffled.end(), std::greater<>(), fine_grain);
+    std::cout << "parallelSort (по убыванию): ";
+    for (int v : shuffled) std::cout << v << " ";
+    std::cout << std::endl;
+    
+    pool.shutdown();
+}
+
+// Бенчмарк: последовательный STL, пул и std::execution::par
+void benchmarkParallelAlgorithms() {
+    std::cout << "\n=== Бенчмарк параллельных алгоритмов ===" << std::endl;
+    
+    AsyncThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    constexpr size_t kSize = size_t{1} << 22;
+    constexpr int kRounds = 3;
+    
+    auto bestOf = [](auto&& run) {
+        double best = 1e30;
+        for (int round = 0; round < kRounds; ++round) {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    };
+    auto report = [](const char* name, double seq, double ours, double par) {
+        std::cout << name << ": STL " << seq << " мс, пул " << ours << " мс";
+        if (par >= 0) {
+            std::cout << ", std::execution::par " << par << " мс";
+        }
+        std::cout << std::endl;
+    };
+    
+    std::vector<double> data(kSize);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(0.0, 1000.0);
+    for (auto& x : data) x = dist(rng);
+    
+    // Несбалансированный цикл: каждый 64-й элемент в 100 раз дороже
+    std::vector<double> out(kSize);
+    auto heavy = [&](size_t i) {
+        int steps = (i % 64 == 0) ? 200 : 2;
+        double acc = data[i];
+        for (int s = 0; s < steps; ++s) acc = std::sqrt(acc + s);
+        out[i] = acc;
+    };
+    std::vector<size_t> indices(kSize);
+    std::iota(indices.begin(), indices.end(), size_t{0});
+    double seq = bestOf([&] { std::for_each(indices.begin(), indices.end(), heavy); });
+    double ours = bestOf([&] { parallelFor(pool, 0, kSize, heavy); });
+    double par = -1;
+#ifdef CPP_PATTERNS_HAS_STD_PAR
+    par = bestOf([&] { std::for_each(std::execution::par, indices.begin(), indices.end(), heavy); });
+#endif
+    report("for_each (несбалансированный)", seq, ours, par);
+    
+    // transform_reduce
+    auto root = [](double x) { return std::sqrt(x); };
+    double seq_sum = 0, pool_sum = 0;
+    seq = bestOf([&] { seq_sum = std::transform_reduce(data.begin(), data.end(), 0.0, std::plus<>(), root); });
+    ours = bestOf([&] { pool_sum = parallelTransformReduce(pool, data.begin(), data.end(), 0.0, std::plus<>(), root); });
+#ifdef CPP_PATTERNS_HAS_STD_PAR
+    par = bestOf([&] { std::transform_reduce(std::execution::par, data.begin(), data.end(), 0.0, std::plus<>(), root); });
+#endif
+    report("transform_reduce", seq, ours, par);
+    if (std::abs(seq_sum - pool_sum) > 1e-9 * std::abs(seq_sum)) {
+        std::cout << "❌ transform_reduce: результаты различаются" << std::endl;
+    }
+    
+    // inclusive_scan на целых: результат должен совпасть точно
+    std::vector<long long> numbers(kSize), seq_scan(kSize), pool_scan(kSize);
+    for (size_t i = 0; i < kSize; ++i) numbers[i] = static_cast<long long>(rng() % 1000);
+    seq = bestOf([&] { std::inclusive_scan(numbers.begin(), numbers.end(), seq_scan.begin()); });
+    ours = bestOf([&] { parallelInclusiveScan(pool, numbers.begin(), numbers.end(), pool_scan.begin()); });
+#ifdef CPP_PATTERNS_HAS_STD_PAR
+    par = bestOf([&] { std::inclusive_scan(std::execution::par, numbers.begin(), numbers.end(), seq_scan.begin()); });
+#endif
+    report("inclusive_scan", seq, ours, par);
+    if (seq_scan != pool_scan) {
+        std::cout << "❌ inclusive_scan: результаты различаются" << std::endl;
+    }
+    
+    // sort: каждый раунд сортирует свежую копию
+    std::vector<double> sorted;
+    auto sortRound = [&](auto&& sorter) {
+        return bestOf([&] {
+            sorted = data;
+            sorter();
+        });
+    };
+    seq = sortRound([&] { std::sort(sorted.begin(), sorted.end()); });
+    std::vector<double> reference = sorted;
+    ours = sortRound([&] { parallelSort(pool, sorted.begin(), sorted.end()); });
+    bool sort_ok = sorted == reference;
+#ifdef CPP_PATTERNS_HAS_STD_PAR
+    par = sortRound([&] { std::sort(std::execution::par, sorted.begin(), sorted.end()); });
+#endif
+    report("sort (вкл. копирование)", seq, ours, par);
+    if (!sort_ok) {
+        std::cout << "❌ parallelSort: результаты различаются" << std::endl;
+    }
+    
+    std::cout << "Воркеров: " << pool.workerCount() << std::endl;
+    pool.shutdown();
+}
+
+// Бенчмарк размещения: одинаковая нагрузка на пулах без закрепления, compact и scatter
+void benchmarkThreadPlacement() {
+    std::cout << "\n=== Бенчмарк размещения воркеров ===" << std::endl;
+    
+    const cpp_patterns::CpuTopology& topology = cpp_patterns::CpuTopology::system();
+    std::cout << "Топология: " << topology.describe() << std::endl;
+    
+    size_t threads = topology.cpuCount();
+    constexpr size_t kBlock = 8192;        // 64 KB на блок - помещается в L2
+    constexpr size_t kBlocks = 512;        // 32 MB всего - больше типичного L3
+    constexpr int kPasses = 20;
+    
+    std::vector<cpp_patterns::ThreadPlacement> placements = {
+        cpp_patterns::ThreadPlacement::none(),
+        cpp_patterns::ThreadPlacement::compact(),
+        cpp_patterns::ThreadPlacement::scatter(),
+    };
+    
+    for (const auto& placement : placements) {
+        AsyncThreadPool pool(threads, 0, placement);
+        ParallelOptions blocks;
+        blocks.min_grain = 1;
+        
+        // Данные заполняют воркеры: страницы попадают на их узлы (first touch)
+        std::vector<double> data(kBlock * kBlocks);
+        parallelFor(pool, 0, kBlocks, [&data](size_t block) {
+            for (size_t i = 0; i < kBlock; ++i) data[block * kBlock + i] = static_cast<double>(i % 97);
+        }, blocks);
+        
+        double checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < kPasses; ++pass) {
+            checksum += parallelTransformReduce(pool, data.begin(), data.end(), 0.0, std::plus<>(),
+                                                [](double x) { return x * 0.5 + 1.0; });
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double gigabytes = static_cast<double>(kPasses) * static_cast<double>(data.size() * sizeof(double)) / 1e9;
+        
+        std::cout << placement.describe() << ": " << gigabytes / seconds << " ГБ/с, закреплено "
+                  << pool.pinnedWorkers() << "/" << pool.workerCount()
+                  << " (контрольная сумма " << checksum << ")" << std::endl;
+        pool.shutdown();
+    }
+}
+
 int main() {
     std::cout << "=== Async Thread Pool Pattern ===" << std::endl;
     
@@ -450,6 +533,11 @@ int main() {
         demonstrateAsyncThreadPool();
         demonstrateWorkStealing();
         demonstrateScaling();
+        demonstrateContinuations();
+        benchmarkTaskGraphs();
+        demonstrateParallelAlgorithms();
+        benchmarkParallelAlgorithms();
+        benchmarkThreadPlacement();
     } catch (const std::exception& e) {
         std::cerr << "Ошибка: " << e.what() << std::endl;
         return 1;
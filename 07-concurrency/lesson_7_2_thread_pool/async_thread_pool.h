@@ -0,0 +1,1082 @@
+/**
+ * @file async_thread_pool.h
+ * @brief AsyncThreadPool урока: work stealing, продолжения, граф задач, параллельные алгоритмы
+ *
+ * Вынесен из async_thread_pool.cpp, чтобы бенчмарки
+ * (benchmarks/bench_thread_pools.cpp) замеряли этот пул рядом с
+ * AdvancedThreadPool. Флаг verbose отключает вывод о запуске и остановке
+ * воркеров и итоговую статистику.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cpu_topology.h"
+#include "tracing.h"
+
+// Приоритеты задач
+enum class TaskPriority {
+    LOW = 0,
+    NORMAL = 1,
+    HIGH = 2,
+    CRITICAL = 3
+};
+
+// Структура задачи с приоритетом
+struct Task {
+    std::function<void()> function;
+    TaskPriority priority;
+    uint64_t sequence; // Порядок создания: строгий FIFO без обращения к часам
+    
+    Task(std::function<void()> func, TaskPriority prio = TaskPriority::NORMAL)
+        : function(std::move(func)), priority(prio), 
+          sequence(nextSequence().fetch_add(1, std::memory_order_relaxed)) {}
+    
+    // Компаратор для приоритетной очереди (высший приоритет первым)
+    bool operator<(const Task& other) const {
+        if (priority != other.priority) {
+            return priority < other.priority; // Обратный порядок для приоритета
+        }
+        return sequence > other.sequence; // FIFO для одинакового приоритета
+    }
+    
+private:
+    static std::atomic<uint64_t>& nextSequence() {
+        static std::atomic<uint64_t> sequence{0};
+        return sequence;
+    }
+};
+
+template<typename T>
+class AsyncResult;
+
+// Статистика выполнения
+struct ThreadPoolStats {
+    std::atomic<size_t> tasks_completed{0};
+    std::atomic<size_t> tasks_failed{0};
+    std::atomic<size_t> tasks_pending{0};
+    std::atomic<size_t> active_threads{0};
+    std::chrono::system_clock::time_point start_time;
+    
+    ThreadPoolStats() : start_time(std::chrono::system_clock::now()) {}
+    
+    void printStats() const {
+        auto now = std::chrono::system_clock::now();
+        auto uptime = std::chrono::duration_cast<std::chrono::seconds>(now - start_time);
+        
+        std::cout << "\n=== Thread Pool Statistics ===" << std::endl;
+        std::cout << "Uptime: " << uptime.count() << " seconds" << std::endl;
+        std::cout << "Tasks completed: " << tasks_completed.load() << std::endl;
+        std::cout << "Tasks failed: " << tasks_failed.load() << std::endl;
+        std::cout << "Tasks pending: " << tasks_pending.load() << std::endl;
+        std::cout << "Active threads: " << active_threads.load() << std::endl;
+        
+        if (tasks_completed.load() > 0) {
+            double throughput = static_cast<double>(tasks_completed.load()) / uptime.count();
+            std::cout << "Throughput: " << throughput << " tasks/second" << std::endl;
+        }
+        std::cout << "===============================" << std::endl;
+    }
+};
+
+// Асинхронный Thread Pool с Work Stealing
+class AsyncThreadPool {
+private:
+    // Очередь воркера: своя мьютекс-пара, чтобы воркеры не делили один замок
+    struct WorkerQueue {
+        static constexpr size_t kInitialCapacity = 256;
+        
+        std::mutex mutex;
+        std::priority_queue<Task> tasks;
+        
+        // Буфер резервируется сразу: его страницы получит узел воркера (first touch)
+        WorkerQueue() : tasks(std::less<Task>(), reservedStorage()) {}
+        
+        static std::vector<Task> reservedStorage() {
+            std::vector<Task> storage;
+            storage.reserve(kInitialCapacity);
+            return storage;
+        }
+    };
+    
+    std::vector<std::thread> workers_;
+    size_t max_threads_;
+    // Локальные очереди для work stealing; слоты фиксированы, scaleUp не перевыделяет.
+    // Очередь создаёт сам воркер после закрепления - память на его NUMA-узле
+    std::vector<std::unique_ptr<WorkerQueue>> local_queues_;
+    cpp_patterns::ThreadPlacement placement_;
+    std::vector<int> worker_cpus_;                  // CPU слота воркера (-1 - не закреплять)
+    std::vector<std::vector<size_t>> steal_order_;  // жертвы кражи, ближние первыми
+    bool verbose_;                                  // печатать запуск и остановку воркеров и статистику
+    std::atomic<size_t> pinned_workers_{0};
+    std::atomic<size_t> worker_count_{0};
+    std::priority_queue<Task> global_queue_; // Глобальная очередь
+    std::mutex global_queue_mutex_;
+    std::mutex sleep_mutex_;
+    std::condition_variable condition_;
+    std::atomic<size_t> sleeping_{0};
+    std::atomic<bool> shutdown_{false};
+    ThreadPoolStats stats_;
+    std::atomic<size_t> next_thread_{0};
+    
+    // Воркер, выполняющий текущий поток (nullptr - поток не из пула)
+    inline static thread_local AsyncThreadPool* current_pool_ = nullptr;
+    inline static thread_local size_t current_worker_ = 0;
+    
+public:
+    explicit AsyncThreadPool(size_t num_threads = std::thread::hardware_concurrency(), size_t max_threads = 0,
+                             cpp_patterns::ThreadPlacement placement = {}, bool verbose = true)
+        : max_threads_(std::max({num_threads, max_threads, size_t{16}})),
+          local_queues_(max_threads_),
+          placement_(std::move(placement)),
+          worker_cpus_(placement_.assign(max_threads_)),
+          steal_order_(cpp_patterns::buildStealOrder(worker_cpus_)),
+          verbose_(verbose) {
+        
+        // Создаем рабочие потоки
+        for (size_t i = 0; i < num_threads; ++i) {
+            startWorker();
+        }
+        
+        if (verbose_) {
+            std::cout << "Async Thread Pool создан с " << num_threads << " потоками";
+            if (placement_.enabled()) {
+                std::cout << " (размещение: " << placement_.describe() << ", закреплено: "
+                          << pinned_workers_.load() << ")";
+            }
+            std::cout << std::endl;
+        }
+    }
+    
+    ~AsyncThreadPool() {
+        shutdown();
+    }
+    
+    // Добавление задачи с возвратом future
+    template<typename F, typename... Args>
+    auto enqueue(F&& f, Args&&... args) 
+        -> std::future<typename std::result_of<F(Args...)>::type> {
+        
+        using return_type = typename std::result_of<F(Args...)>::type;
+        
+        if (shutdown_.load()) {
+            throw std::runtime_error("Thread Pool остановлен");
+        }
+        
+        // Создаем packaged_task
+        auto task = std::make_shared<std::packaged_task<return_type()>>(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+        );
+        
+        // Получаем future
+        std::future<return_type> result = task->get_future();
+        
+        // Выбираем поток для локальной очереди по кругу
+        size_t thread_id = next_thread_.fetch_add(1) % worker_count_.load(std::memory_order_acquire);
+        pushLocal(thread_id, Task([task]() { (*task)(); }, TaskPriority::NORMAL));
+        
+        return result;
+    }
+    
+    // Добавление задачи с приоритетом
+    template<typename F, typename... Args>
+    auto enqueueWithPriority(TaskPriority priority, F&& f, Args&&... args) 
+        -> std::future<typename std::result_of<F(Args...)>::type> {
+        
+        using return_type = typename std::result_of<F(Args...)>::type;
+        
+        auto task = std::make_shared<std::packaged_task<return_type()>>(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+        );
+        
+        std::future<return_type> result = task->get_future();
+        
+        {
+            std::unique_lock<std::mutex> lock(global_queue_mutex_);
+            
+            if (shutdown_.load()) {
+                throw std::runtime_error("Thread Pool остановлен");
+            }
+            
+            // Высокоприоритетные задачи идут в глобальную очередь
+            global_queue_.emplace([task]() { (*task)(); }, priority);
+            stats_.tasks_pending.fetch_add(1);
+        }
+        
+        wakeWorker();
+        return result;
+    }
+    
+    /**
+     * @brief Запланировать задачу без future (основа продолжений и графов задач)
+     * 
+     * Из воркера этого пула задача попадает в его же локальную очередь:
+     * готовые продолжения выполняются там, где ещё горячи данные
+     * предшественника, а простаивающие воркеры их крадут.
+     */
+    template<typename F>
+    void post(F&& f) {
+        size_t thread_id = current_pool_ == this
+            ? current_worker_
+            : next_thread_.fetch_add(1) % worker_count_.load(std::memory_order_acquire);
+        pushLocal(thread_id, Task(std::forward<F>(f), TaskPriority::NORMAL));
+    }
+    
+    /**
+     * @brief Запустить функцию на пуле и получить AsyncResult для продолжений
+     */
+    template<typename F>
+    auto submit(F&& f) -> AsyncResult<std::invoke_result_t<std::decay_t<F>>>;
+    
+    size_t workerCount() const {
+        return worker_count_.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Сколько воркеров удалось закрепить за CPU (cpuset контейнера может запретить)
+     */
+    size_t pinnedWorkers() const {
+        return pinned_workers_.load();
+    }
+    
+    /**
+     * @brief CPU, назначенный воркеру политикой размещения (-1 - не закреплён)
+     */
+    int workerCpu(size_t worker_id) const {
+        return worker_cpus_.at(worker_id);
+    }
+    
+    /**
+     * @brief Является ли текущий поток воркером этого пула
+     */
+    bool isWorkerThread() const {
+        return current_pool_ == this;
+    }
+    
+    // Graceful shutdown
+    void shutdown() {
+        if (shutdown_.exchange(true)) return;
+        
+        if (verbose_) {
+            std::cout << "Начинаем graceful shutdown..." << std::endl;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+        }
+        condition_.notify_all();
+        
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        
+        if (verbose_) {
+            std::cout << "Async Thread Pool остановлен" << std::endl;
+            stats_.printStats();
+        }
+    }
+    
+    // Получение статистики
+    const ThreadPoolStats& getStats() const {
+        return stats_;
+    }
+    
+    // Динамическое масштабирование (упрощенная версия)
+    void scaleUp(size_t additional_threads) {
+        std::cout << "Масштабирование вверх: добавляем " << additional_threads << " потоков" << std::endl;
+        
+        if (worker_count_.load() + additional_threads > max_threads_) {
+            throw std::length_error("AsyncThreadPool: превышено max_threads");
+        }
+        for (size_t i = 0; i < additional_threads; ++i) {
+            startWorker();
+        }
+    }
+    
+private:
+    void startWorker() {
+        size_t thread_id = workers_.size();
+        std::promise<void> ready;
+        std::future<void> queue_created = ready.get_future();
+        workers_.emplace_back([this, thread_id, ready = std::move(ready)]() mutable {
+            workerLoop(thread_id, ready);
+        });
+        // Ждём, пока воркер закрепится и создаст очередь; затем публикуем его для enqueue и кражи
+        queue_created.wait();
+        worker_count_.store(thread_id + 1, std::memory_order_release);
+    }
+    
+    void pushLocal(size_t thread_id, Task task) {
+        {
+            WorkerQueue& queue = *local_queues_[thread_id];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push(std::move(task));
+        }
+        stats_.tasks_pending.fetch_add(1);
+        wakeWorker();
+    }
+    
+    // tasks_pending увеличен до проверки sleeping_, а воркер увеличивает
+    // sleeping_ до проверки tasks_pending: хотя бы одна сторона увидит другую
+    void wakeWorker() {
+        if (sleeping_.load() > 0) {
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+            }
+            condition_.notify_one();
+        }
+    }
+    
+    bool popFrom(std::mutex& mutex, std::priority_queue<Task>& queue, Task& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) {
+            return false;
+        }
+        task = std::move(const_cast<Task&>(queue.top()));
+        queue.pop();
+        stats_.tasks_pending.fetch_sub(1);
+        return true;
+    }
+    
+    void workerLoop(size_t worker_id, std::promise<void>& ready) {
+        current_pool_ = this;
+        current_worker_ = worker_id;
+        if (worker_cpus_[worker_id] >= 0 && cpp_patterns::pinCurrentThread(worker_cpus_[worker_id])) {
+            pinned_workers_.fetch_add(1);
+        }
+        local_queues_[worker_id] = std::make_unique<WorkerQueue>();
+        WorkerQueue& own = *local_queues_[worker_id];
+        TRACE_THREAD_NAME("async-worker-" + std::to_string(worker_id));
+        ready.set_value();
+        if (verbose_) {
+            std::cout << "Worker " << worker_id << " запущен" << std::endl;
+        }
+        
+        while (true) {
+            Task task([](){}); // Пустая задача по умолчанию
+            
+            // 1. Локальная очередь, 2. глобальная, 3. кража у других воркеров
+            bool has_task = popFrom(own.mutex, own.tasks, task) ||
+                            popFrom(global_queue_mutex_, global_queue_, task) ||
+                            tryStealWork(worker_id, task);
+            
+            if (has_task) {
+                stats_.active_threads.fetch_add(1);
+                try {
+                    TRACE_ZONE_CAT("task", "async_pool");
+                    task.function();
+                    stats_.tasks_completed.fetch_add(1);
+                } catch (const std::exception& e) {
+                    std::cerr << "Ошибка в задаче: " << e.what() << std::endl;
+                    stats_.tasks_failed.fetch_add(1);
+                }
+                stats_.active_threads.fetch_sub(1);
+                continue;
+            }
+            
+            // 4. Если работы нет, ждем; выходим только когда очереди пусты
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleeping_.fetch_add(1);
+            condition_.wait(lock, [this] {
+                return stats_.tasks_pending.load() > 0 || shutdown_.load();
+            });
+            sleeping_.fetch_sub(1);
+            if (shutdown_.load() && stats_.tasks_pending.load() == 0) {
+                break;
+            }
+        }
+        
+        if (verbose_) {
+            std::cout << "Worker " << worker_id << " завершен" << std::endl;
+        }
+    }
+    
+    // Work Stealing: попытка украсть работу у других потоков
+    bool tryStealWork(size_t worker_id, Task& task) {
+        size_t count = worker_count_.load(std::memory_order_acquire);
+        
+        // Обходим всех: сначала SMT-соседей и ядра своего узла, потом удалённые узлы.
+        // Без закрепления порядок кольцевой, начиная с соседа
+        for (size_t victim_id : steal_order_[worker_id]) {
+            if (victim_id >= count) {
+                continue;
+            }
+            WorkerQueue& victim = *local_queues_[victim_id];
+            
+            std::vector<Task> stolen_tasks;
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                // Берем половину задач из жертвы
+                size_t steal_count = std::max<size_t>(1, victim.tasks.size() / 2);
+                for (size_t i = 0; i < steal_count && !victim.tasks.empty(); ++i) {
+                    stolen_tasks.push_back(std::move(const_cast<Task&>(victim.tasks.top())));
+                    victim.tasks.pop();
+                }
+            }
+            
+            // Берем первую задачу для выполнения
+            if (!stolen_tasks.empty()) {
+                task = std::move(stolen_tasks[0]);
+                stats_.tasks_pending.fetch_sub(1);
+                
+                // Остальные задачи добавляем в свою локальную очередь
+                WorkerQueue& own = *local_queues_[worker_id];
+                std::lock_guard<std::mutex> my_lock(own.mutex);
+                for (size_t i = 1; i < stolen_tasks.size(); ++i) {
+                    own.tasks.push(std::move(stolen_tasks[i]));
+                }
+                
+                return true;
+            }
+        }
+        
+        return false;
+    }
+};
+
+// ============================================================================
+// ПРОДОЛЖЕНИЯ И ГРАФЫ ЗАДАЧ БЕЗ БЛОКИРОВКИ ВОРКЕРОВ
+// ============================================================================
+
+/**
+ * @brief Результат асинхронной задачи с продолжениями (аналог future.then)
+ * 
+ * В отличие от std::future, зависимые задачи не ждут результат в .get()
+ * внутри воркера: then() регистрирует продолжение, и его планирует тот
+ * воркер, который завершил предшественника (в свою локальную очередь).
+ * get() блокирует и предназначен только для потоков вне пула.
+ */
+template<typename T>
+class AsyncResult {
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable ready_cv;
+        bool ready = false;
+        std::optional<T> value;
+        std::exception_ptr error;
+        std::vector<std::function<void()>> callbacks;
+        AsyncThreadPool* pool = nullptr;
+    };
+    
+    std::shared_ptr<State> state_;
+    
+    template<typename U>
+    friend class AsyncResult;
+    
+    void complete(std::optional<T> value, std::exception_ptr error) const {
+        std::vector<std::function<void()>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            if (state_->ready) {
+                throw std::logic_error("AsyncResult уже выполнен");
+            }
+            state_->value = std::move(value);
+            state_->error = std::move(error);
+            state_->ready = true;
+            callbacks.swap(state_->callbacks);
+        }
+        state_->ready_cv.notify_all();
+        for (auto& callback : callbacks) {
+            callback();
+        }
+    }
+    
+public:
+    explicit AsyncResult(AsyncThreadPool& pool) : state_(std::make_shared<State>()) {
+        state_->pool = &pool;
+    }
+    
+    AsyncThreadPool& pool() const { return *state_->pool; }
+    
+    void setValue(T value) const { complete(std::move(value), nullptr); }
+    void setError(std::exception_ptr error) const { complete(std::nullopt, std::move(error)); }
+    
+    bool isReady() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->ready;
+    }
+    
+    /**
+     * @brief Значение готового результата без ожидания (например, в onReady)
+     */
+    const T& value() const {
+        if (state_->error) {
+            std::rethrow_exception(state_->error);
+        }
+        return *state_->value;
+    }
+    
+    /**
+     * @brief Дождаться результата (только вне воркеров пула)
+     */
+    const T& get() const {
+        if (state_->pool->isWorkerThread()) {
+            throw std::logic_error("AsyncResult::get() в воркере пула: используйте then()");
+        }
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->ready_cv.wait(lock, [this] { return state_->ready; });
+        if (state_->error) {
+            std::rethrow_exception(state_->error);
+        }
+        return *state_->value;
+    }
+    
+    /**
+     * @brief Вызвать callback в потоке, выполнившем результат (или сразу, если готов)
+     * 
+     * Callback должен быть коротким: он выполняется внутри чужой задачи.
+     * Для пользовательской работы используйте then().
+     */
+    template<typename F>
+    void onReady(F&& callback) const {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            if (!state_->ready) {
+                state_->callbacks.emplace_back(std::forward<F>(callback));
+                return;
+            }
+        }
+        callback();
+    }
+    
+    /**
+     * @brief Продолжение: f(const T&) выполнится на пуле после готовности результата
+     * 
+     * Ошибка предшественника передаётся дальше без вызова f.
+     */
+    template<typename F>
+    auto then(F f) const -> AsyncResult<std::invoke_result_t<F, const T&>> {
+        using R = std::invoke_result_t<F, const T&>;
+        AsyncResult<R> next(*state_->pool);
+        auto state = state_;
+        onReady([state, next, f = std::move(f)]() mutable {
+            if (state->error) {
+                next.setError(state->error);
+                return;
+            }
+            state->pool->post([state, next, f = std::move(f)]() mutable {
+                try {
+                    next.setValue(f(*state->value));
+                } catch (...) {
+                    next.setError(std::current_exception());
+                }
+            });
+        });
+        return next;
+    }
+};
+
+template<typename F>
+auto AsyncThreadPool::submit(F&& f) -> AsyncResult<std::invoke_result_t<std::decay_t<F>>> {
+    if (shutdown_.load()) {
+        throw std::runtime_error("Thread Pool остановлен");
+    }
+    AsyncResult<std::invoke_result_t<std::decay_t<F>>> result(*this);
+    post([result, f = std::forward<F>(f)]() mutable {
+        try {
+            result.setValue(f());
+        } catch (...) {
+            result.setError(std::current_exception());
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Результат готов, когда готовы все входы; первая ошибка завершает его сразу
+ */
+template<typename T>
+AsyncResult<std::vector<T>> whenAll(AsyncThreadPool& pool, const std::vector<AsyncResult<T>>& inputs) {
+    AsyncResult<std::vector<T>> all(pool);
+    if (inputs.empty()) {
+        all.setValue({});
+        return all;
+    }
+    
+    struct Join {
+        std::vector<std::optional<T>> values;
+        std::atomic<size_t> remaining;
+        std::atomic<bool> finished{false};
+        explicit Join(size_t n) : values(n), remaining(n) {}
+    };
+    auto join = std::make_shared<Join>(inputs.size());
+    
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        // Колбэк только сохраняет значение; продолжения all планирует then()
+        inputs[i].onReady([join, all, input = inputs[i], i] {
+            try {
+                join->values[i] = input.value();
+            } catch (...) {
+                if (!join->finished.exchange(true)) {
+                    all.setError(std::current_exception());
+                }
+                return;
+            }
+            if (join->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 && !join->finished.exchange(true)) {
+                std::vector<T> values;
+                values.reserve(join->values.size());
+                for (auto& value : join->values) {
+                    values.push_back(std::move(*value));
+                }
+                all.setValue(std::move(values));
+            }
+        });
+    }
+    return all;
+}
+
+/**
+ * @brief Результат готов по первому завершившемуся входу: (индекс, значение)
+ */
+template<typename T>
+AsyncResult<std::pair<size_t, T>> whenAny(AsyncThreadPool& pool, const std::vector<AsyncResult<T>>& inputs) {
+    if (inputs.empty()) {
+        throw std::invalid_argument("whenAny: пустой список входов");
+    }
+    AsyncResult<std::pair<size_t, T>> any(pool);
+    auto finished = std::make_shared<std::atomic<bool>>(false);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        inputs[i].onReady([finished, any, input = inputs[i], i] {
+            if (finished->exchange(true)) {
+                return;
+            }
+            try {
+                any.setValue({i, input.value()});
+            } catch (...) {
+                any.setError(std::current_exception());
+            }
+        });
+    }
+    return any;
+}
+
+/**
+ * @brief Явно построенный DAG задач
+ * 
+ * Узел запускается, когда завершены все его предшественники; завершивший
+ * воркер сразу кладёт готовых преемников в свою локальную очередь.
+ * Граф должен жить до готовности результата run().
+ */
+class TaskGraph {
+public:
+    using NodeId = uint32_t;
+    
+    NodeId addTask(std::function<void()> work) {
+        if (running_.load()) {
+            throw std::logic_error("TaskGraph: нельзя менять граф во время выполнения");
+        }
+        nodes_.emplace_back();
+        nodes_.back().work = std::move(work);
+        return static_cast<NodeId>(nodes_.size() - 1);
+    }
+    
+    /**
+     * @brief after не начнётся, пока не завершится before
+     */
+    void precede(NodeId before, NodeId after) {
+        if (before >= nodes_.size() || after >= nodes_.size() || before == after) {
+            throw std::invalid_argument("TaskGraph: некорректное ребро");
+        }
+        nodes_[before].successors.push_back(after);
+        ++nodes_[after].dependencies;
+    }
+    
+    size_t size() const { return nodes_.size(); }
+    
+    /**
+     * @brief Запустить граф; результат - число выполненных узлов
+     * 
+     * Исключение узла не останавливает граф: преемники выполняются, а
+     * первая ошибка возвращается в результате.
+     */
+    AsyncResult<size_t> run(AsyncThreadPool& pool) {
+        if (running_.exchange(true)) {
+            throw std::logic_error("TaskGraph уже выполняется");
+        }
+        try {
+            checkAcyclic();
+        } catch (...) {
+            running_.store(false);
+            throw;
+        }
+        
+        run_ = std::make_shared<RunState>(pool, nodes_.size());
+        AsyncResult<size_t> done = run_->done;
+        if (nodes_.empty()) {
+            running_.store(false);
+            done.setValue(0);
+            return done;
+        }
+        
+        std::vector<NodeId> roots;
+        for (NodeId i = 0; i < nodes_.size(); ++i) {
+            nodes_[i].remaining.store(nodes_[i].dependencies, std::memory_order_relaxed);
+            if (nodes_[i].dependencies == 0) {
+                roots.push_back(i);
+            }
+        }
+        for (NodeId root : roots) {
+            pool.post([this, root] { execute(root); });
+        }
+        return done;
+    }
+    
+private:
+    struct Node {
+        std::function<void()> work;
+        std::vector<NodeId> successors;
+        uint32_t dependencies = 0;
+        std::atomic<uint32_t> remaining{0};
+    };
+    
+    struct RunState {
+        AsyncThreadPool& pool;
+        std::atomic<size_t> remaining;
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        AsyncResult<size_t> done;
+        RunState(AsyncThreadPool& p, size_t nodes) : pool(p), remaining(nodes), done(p) {}
+    };
+    
+    std::deque<Node> nodes_;
+    std::shared_ptr<RunState> run_;
+    std::atomic<bool> running_{false};
+    
+    void execute(NodeId id) {
+        Node& node = nodes_[id];
+        RunState& run = *run_;
+        try {
+            node.work();
+        } catch (...) {
+            if (!run.failed.exchange(true)) {
+                run.error = std::current_exception();
+            }
+        }
+        
+        // Готовые преемники - в локальную очередь этого же воркера
+        for (NodeId next : node.successors) {
+            if (nodes_[next].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                run.pool.post([this, next] { execute(next); });
+            }
+        }
+        
+        if (run.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            auto finished = run_;
+            running_.store(false);
+            if (finished->failed.load()) {
+                finished->done.setError(finished->error);
+            } else {
+                finished->done.setValue(nodes_.size());
+            }
+        }
+    }
+    
+    // Алгоритм Кана: цикл означал бы, что run() никогда не завершится
+    void checkAcyclic() const {
+        std::vector<uint32_t> indegree(nodes_.size());
+        std::vector<NodeId> ready;
+        for (NodeId i = 0; i < nodes_.size(); ++i) {
+            indegree[i] = nodes_[i].dependencies;
+            if (indegree[i] == 0) {
+                ready.push_back(i);
+            }
+        }
+        size_t visited = 0;
+        while (!ready.empty()) {
+            NodeId id = ready.back();
+            ready.pop_back();
+            ++visited;
+            for (NodeId next : nodes_[id].successors) {
+                if (--indegree[next] == 0) {
+                    ready.push_back(next);
+                }
+            }
+        }
+        if (visited != nodes_.size()) {
+            throw std::invalid_argument("TaskGraph: граф содержит цикл");
+        }
+    }
+};
+
+// ============================================================================
+// ПАРАЛЛЕЛЬНЫЕ АЛГОРИТМЫ ПОВЕРХ ПУЛА
+// ============================================================================
+
+/**
+ * @brief Параметры разбиения диапазона на куски
+ * 
+ * Разбиение статическое: число кусков вычисляется один раз до запуска
+ * по длине диапазона и числу воркеров и во время работы не меняется.
+ * Неравномерность выравнивает только кража уже нарезанных кусков.
+ */
+struct ParallelOptions {
+    size_t min_grain = 1024;             // меньше не делим: задача пула стоит порядка микросекунды
+    size_t static_chunks_per_worker = 8; // запас кусков, чтобы кража выравнивала неравномерную работу
+};
+
+namespace parallel_detail {
+
+// Счётчик незавершённых кусков; вызывающий поток ждёт его обнуления
+class CompletionLatch {
+private:
+    std::atomic<size_t> remaining_;
+    std::mutex mutex_;
+    std::condition_variable done_;
+    bool done_flag_ = false;  // под mutex_: ожидающий не уничтожит защёлку раньше, чем её отпустит последний кусок
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+    
+public:
+    explicit CompletionLatch(size_t count) : remaining_(count) {}
+    
+    void add(size_t count) { remaining_.fetch_add(count, std::memory_order_relaxed); }
+    
+    void fail(std::exception_ptr error) {
+        if (!failed_.exchange(true)) {
+            error_ = std::move(error);
+        }
+    }
+    
+    void countDown() {
+        if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_flag_ = true;
+            done_.notify_all();
+        }
+    }
+    
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return done_flag_; });
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+};
+
+// Рекурсивное деление: правую половину - в локальную очередь (её могут украсть),
+// с левой продолжаем сами, пока не останется один кусок
+template<typename F>
+void splitChunks(AsyncThreadPool& pool, size_t first, size_t last, const F& fn, CompletionLatch& latch) {
+    while (last - first > 1) {
+        size_t mid = first + (last - first) / 2;
+        latch.add(1);
+        pool.post([&pool, mid, last, &fn, &latch] { splitChunks(pool, mid, last, fn, latch); });
+        last = mid;
+    }
+    try {
+        fn(first);
+    } catch (...) {
+        latch.fail(std::current_exception());
+    }
+    latch.countDown();
+}
+
+inline size_t chunkCount(const AsyncThreadPool& pool, size_t n, const ParallelOptions& options) {
+    size_t max_chunks = std::max<size_t>(1, pool.workerCount() * options.static_chunks_per_worker);
+    return std::clamp<size_t>(n / std::max<size_t>(1, options.min_grain), 1, max_chunks);
+}
+
+// Границы куска c из chunks для диапазона длины n
+inline std::pair<size_t, size_t> chunkBounds(size_t n, size_t chunks, size_t c) {
+    return {n * c / chunks, n * (c + 1) / chunks};
+}
+
+} // namespace parallel_detail
+
+/**
+ * @brief Выполнить fn(chunk) для chunk в [0, chunks) на пуле и дождаться завершения
+ * 
+ * Вызов из воркера того же пула выполняется последовательно: ожидание в
+ * воркере - ровно та блокировка, от которой избавляют продолжения.
+ */
+template<typename F>
+void parallelForChunks(AsyncThreadPool& pool, size_t chunks, const F& fn) {
+    if (chunks == 0) {
+        return;
+    }
+    if (chunks == 1 || pool.isWorkerThread()) {
+        for (size_t c = 0; c < chunks; ++c) {
+            fn(c);
+        }
+        return;
+    }
+    parallel_detail::CompletionLatch latch(1);
+    pool.post([&pool, chunks, &fn, &latch] { parallel_detail::splitChunks(pool, 0, chunks, fn, latch); });
+    latch.wait();
+}
+
+/**
+ * @brief body(i) для i в [begin, end); число кусков фиксируется по числу воркеров
+ */
+template<typename Body>
+void parallelFor(AsyncThreadPool& pool, size_t begin, size_t end, const Body& body, const ParallelOptions& options = {}) {
+    if (begin >= end) {
+        return;
+    }
+    size_t n = end - begin;
+    size_t chunks = parallel_detail::chunkCount(pool, n, options);
+    parallelForChunks(pool, chunks, [&](size_t c) {
+        auto [from, to] = parallel_detail::chunkBounds(n, chunks, c);
+        for (size_t i = begin + from; i < begin + to; ++i) {
+            body(i);
+        }
+    });
+}
+
+/**
+ * @brief reduce(init, transform(x)...) по диапазону; reduce должна быть ассоциативной
+ * 
+ * Частичные результаты сворачиваются по порядку кусков, поэтому результат
+ * детерминирован при одинаковом числе воркеров.
+ */
+template<typename It, typename T, typename Reduce, typename Transform>
+T parallelTransformReduce(AsyncThreadPool& pool, It first, It last, T init, Reduce reduce, Transform transform,
+                          const ParallelOptions& options = {}) {
+    size_t n = static_cast<size_t>(std::distance(first, last));
+    if (n == 0) {
+        return init;
+    }
+    size_t chunks = parallel_detail::chunkCount(pool, n, options);
+    std::vector<std::optional<T>> partials(chunks);
+    parallelForChunks(pool, chunks, [&](size_t c) {
+        auto [from, to] = parallel_detail::chunkBounds(n, chunks, c);
+        T acc = transform(first[from]);
+        for (size_t i = from + 1; i < to; ++i) {
+            acc = reduce(std::move(acc), transform(first[i]));
+        }
+        partials[c] = std::move(acc);
+    });
+    for (auto& partial : partials) {
+        init = reduce(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+namespace parallel_detail {
+
+// Два прохода: суммы кусков, затем скан каждого куска со своим смещением
+template<typename It, typename Out, typename T, typename Op>
+void scan(AsyncThreadPool& pool, It first, It last, Out out, std::optional<T> init, Op op, bool inclusive,
+          const ParallelOptions& options) {
+    size_t n = static_cast<size_t>(std::distance(first, last));
+    if (n == 0) {
+        return;
+    }
+    size_t chunks = chunkCount(pool, n, options);
+    std::vector<T> totals(chunks);
+    parallelForChunks(pool, chunks, [&](size_t c) {
+        auto [from, to] = chunkBounds(n, chunks, c);
+        T acc = first[from];
+        for (size_t i = from + 1; i < to; ++i) {
+            acc = op(std::move(acc), first[i]);
+        }
+        totals[c] = std::move(acc);
+    });
+    
+    // carries[c] - свёртка всего, что левее куска c (nullopt - ничего)
+    std::vector<std::optional<T>> carries(chunks);
+    std::optional<T> running = std::move(init);
+    for (size_t c = 0; c < chunks; ++c) {
+        carries[c] = running;
+        running = running ? op(std::move(*running), totals[c]) : totals[c];
+    }
+    
+    parallelForChunks(pool, chunks, [&](size_t c) {
+        auto [from, to] = chunkBounds(n, chunks, c);
+        std::optional<T> acc = carries[c];
+        for (size_t i = from; i < to; ++i) {
+            T value = first[i];  // копия: out может совпадать с first
+            if (inclusive) {
+                acc = acc ? op(std::move(*acc), value) : value;
+                out[i] = *acc;
+            } else {
+                out[i] = *acc;
+                acc = op(std::move(*acc), value);
+            }
+        }
+    });
+}
+
+} // namespace parallel_detail
+
+template<typename It, typename Out, typename Op = std::plus<>>
+void parallelInclusiveScan(AsyncThreadPool& pool, It first, It last, Out out, Op op = {},
+                           const ParallelOptions& options = {}) {
+    using T = typename std::iterator_traits<It>::value_type;
+    parallel_detail::scan<It, Out, T>(pool, first, last, out, std::nullopt, op, true, options);
+}
+
+template<typename It, typename Out, typename T, typename Op = std::plus<>>
+void parallelExclusiveScan(AsyncThreadPool& pool, It first, It last, Out out, T init, Op op = {},
+                           const ParallelOptions& options = {}) {
+    parallel_detail::scan<It, Out, T>(pool, first, last, out, std::move(init), op, false, options);
+}
+
+/**
+ * @brief Сортировка: куски сортируются параллельно, затем попарно сливаются по раундам
+ */
+template<typename It, typename Compare = std::less<>>
+void parallelSort(AsyncThreadPool& pool, It first, It last, Compare comp = {}, const ParallelOptions& options = {}) {
+    using T = typename std::iterator_traits<It>::value_type;
+    size_t n = static_cast<size_t>(std::distance(first, last));
+    ParallelOptions sort_options = options;
+    sort_options.static_chunks_per_worker = 1;  // больше кусков - больше раундов слияния
+    size_t chunks = parallel_detail::chunkCount(pool, n, sort_options);
+    if (chunks <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+    
+    parallelForChunks(pool, chunks, [&](size_t c) {
+        auto [from, to] = parallel_detail::chunkBounds(n, chunks, c);
+        std::sort(first + from, first + to, comp);
+    });
+    
+    std::vector<T> buffer(n);
+    bool in_buffer = false;
+    for (size_t width = 1; width < chunks; width *= 2) {
+        size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+        parallelForChunks(pool, pairs, [&](size_t p) {
+            size_t lo = parallel_detail::chunkBounds(n, chunks, p * 2 * width).first;
+            size_t mid = parallel_detail::chunkBounds(n, chunks, std::min(chunks, p * 2 * width + width)).first;
+            size_t hi = parallel_detail::chunkBounds(n, chunks, std::min(chunks, p * 2 * width + 2 * width)).first;
+            if (in_buffer) {
+                std::merge(std::make_move_iterator(buffer.begin() + lo), std::make_move_iterator(buffer.begin() + mid),
+                           std::make_move_iterator(buffer.begin() + mid), std::make_move_iterator(buffer.begin() + hi),
+                           first + lo, comp);
+            } else {
+                std::merge(std::make_move_iterator(first + lo), std::make_move_iterator(first + mid),
+                           std::make_move_iterator(first + mid), std::make_move_iterator(first + hi),
+                           buffer.begin() + lo, comp);
+            }
+        });
+        in_buffer = !in_buffer;
+    }
+    if (in_buffer) {
+        parallelFor(pool, 0, n, [&](size_t i) { first[i] = std::move(buffer[i]); }, options);
+    }
+}
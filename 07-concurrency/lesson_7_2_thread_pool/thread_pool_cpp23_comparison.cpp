@@ -18,6 +18,9 @@
 #include <atomic>
 #include <random>
 #include <memory>
+#include <string>
+
+#include "pool_instrumentation.h"
 
 // ============================================================================
 // C++17/20 РЕАЛИЗАЦИЯ (ТЕКУЩАЯ)
@@ -30,7 +33,7 @@ class ThreadPoolCpp20 {
 private:
     std::vector<std::thread> workers_;
     std::queue<std::function<void()>> tasks_;
-    std::mutex queueMutex_;
+    mutable std::mutex queueMutex_;
     std::condition_variable condition_;
     std::atomic<bool> stop_;
     size_t numThreads_;
@@ -175,31 +178,25 @@ private:
     std::vector<std::thread> workers_;
 #endif
     
-    std::queue<std::function<void()>> tasks_;
-    std::mutex queueMutex_;
+    struct QueuedTask {
+        std::function<void()> run;
+        uint64_t enqueuedTicks = 0;  // PoolClock::now() при постановке
+    };
+    
+    std::queue<QueuedTask> tasks_;
+    mutable std::mutex queueMutex_;
     std::condition_variable condition_;
     std::atomic<bool> stop_;
     size_t numThreads_;
     
-    // ✅ C++23: Расширенная статистика
-    std::atomic<size_t> totalTasksSubmitted_{0};
-    std::atomic<size_t> totalTasksCompleted_{0};
-    std::atomic<size_t> totalTasksFailed_{0};
-    std::atomic<size_t> totalExecutionTime_{0};
-    
-    // Статистика по потокам
-    struct WorkerStats {
-        std::atomic<size_t> tasksCompleted{0};
-        std::atomic<size_t> totalExecutionTime{0};
-        std::atomic<bool> isBusy{false};
-        std::string name;
-    };
-    
-    std::vector<WorkerStats> workerStats_;
+    // ✅ Статистика по потокам: счётчики на своих кэш-линиях, гистограммы в наносекундах
+    cpp_patterns::PoolInstrumentation instrumentation_;
+    std::vector<std::string> workerNames_;
+    alignas(cpp_patterns::kCacheLineSize) std::atomic<size_t> totalTasksSubmitted_{0};
     
 public:
     explicit ThreadPoolCpp23(size_t numThreads = std::thread::hardware_concurrency()) 
-        : stop_(false), numThreads_(numThreads), workerStats_(numThreads) {
+        : stop_(false), numThreads_(numThreads), instrumentation_(numThreads), workerNames_(numThreads) {
         
 #ifdef __cpp_lib_print
         std::print("Создаю Thread Pool с {} потоками...\n", numThreads_);
@@ -209,7 +206,7 @@ public:
         
         // Создаем рабочие потоки
         for (size_t i = 0; i < numThreads_; ++i) {
-            workerStats_[i].name = "Worker_" + std::to_string(i);
+            workerNames_[i] = "Worker_" + std::to_string(i);
             
 #ifdef __cpp_lib_jthread
             workers_.emplace_back([this, i](std::stop_token stopToken) {
@@ -231,7 +228,7 @@ public:
                     }
 #endif
                     
-                    std::function<void()> task;
+                    QueuedTask task;
                     
                     {
                         std::unique_lock<std::mutex> lock(queueMutex_);
@@ -246,15 +243,15 @@ public:
                     }
                     
                     // ✅ C++23: Выполнение с детальной статистикой
-                    workerStats_[i].isBusy.store(true);
-                    auto start = std::chrono::high_resolution_clock::now();
+                    auto& counters = instrumentation_.worker(i);
+                    counters.isBusy.store(true, std::memory_order_relaxed);
+                    uint64_t start = cpp_patterns::PoolClock::now();
+                    bool failed = false;
                     
                     try {
-                        task();
-                        totalTasksCompleted_.fetch_add(1);
-                        workerStats_[i].tasksCompleted.fetch_add(1);
+                        task.run();
                     } catch (const std::exception& e) {
-                        totalTasksFailed_.fetch_add(1);
+                        failed = true;
                         
 #ifdef __cpp_lib_stacktrace
                         auto trace = std::stacktrace::current();
@@ -268,12 +265,9 @@ public:
 #endif
                     }
                     
-                    auto end = std::chrono::high_resolution_clock::now();
-                    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-                    
-                    workerStats_[i].totalExecutionTime.fetch_add(duration.count());
-                    workerStats_[i].isBusy.store(false);
-                    totalExecutionTime_.fetch_add(duration.count());
+                    counters.recordTiming(task.enqueuedTicks, start, cpp_patterns::PoolClock::now());
+                    counters.countTask(failed);
+                    counters.isBusy.store(false, std::memory_order_relaxed);
                 }
                 
 #ifdef __cpp_lib_print
@@ -310,7 +304,7 @@ public:
         
         {
             std::unique_lock<std::mutex> lock(queueMutex_);
-            tasks_.emplace([task]() { (*task)(); });
+            tasks_.push({[task]() { (*task)(); }, cpp_patterns::PoolClock::now()});
         }
         
         condition_.notify_one();
@@ -331,7 +325,7 @@ public:
                     break;
                 }
                 
-                task = std::move(tasks_.front());
+                task = std::move(tasks_.front().run);
                 tasks_.pop();
             }
             
@@ -354,26 +348,28 @@ public:
         size_t totalTasksSubmitted;
         size_t totalTasksCompleted;
         size_t totalTasksFailed;
-        size_t totalExecutionTime;
-        double averageExecutionTime;
+        double totalExecutionTime;    // мкс
+        double averageExecutionTime;  // мкс
+        double p99ExecutionTime;      // мкс
+        double p99QueueWait;          // мкс
         double successRate;
         double failureRate;
-        std::vector<WorkerStats> workerStats;
+        cpp_patterns::PoolStatsSnapshot snapshot;  // по воркерам и гистограммы
     };
     
+    /**
+     * @brief Статистика на ходу: воркеры не останавливаются и не блокируются
+     */
     DetailedStatistics getDetailedStatistics() const {
         DetailedStatistics stats;
+        stats.snapshot = instrumentation_.snapshot();
         stats.totalTasksSubmitted = totalTasksSubmitted_.load();
-        stats.totalTasksCompleted = totalTasksCompleted_.load();
-        stats.totalTasksFailed = totalTasksFailed_.load();
-        stats.totalExecutionTime = totalExecutionTime_.load();
-        stats.workerStats = workerStats_;
-        
-        if (stats.totalTasksCompleted > 0) {
-            stats.averageExecutionTime = static_cast<double>(stats.totalExecutionTime) / stats.totalTasksCompleted;
-        } else {
-            stats.averageExecutionTime = 0.0;
-        }
+        stats.totalTasksCompleted = stats.snapshot.tasksCompleted;
+        stats.totalTasksFailed = stats.snapshot.tasksFailed;
+        stats.totalExecutionTime = stats.snapshot.execution.sumNanos / 1000.0;
+        stats.averageExecutionTime = stats.snapshot.execution.meanNanos() / 1000.0;
+        stats.p99ExecutionTime = stats.snapshot.execution.percentileNanos(99) / 1000.0;
+        stats.p99QueueWait = stats.snapshot.queueWait.percentileNanos(99) / 1000.0;
         
         if (stats.totalTasksSubmitted > 0) {
             stats.successRate = static_cast<double>(stats.totalTasksCompleted) / stats.totalTasksSubmitted;
@@ -396,18 +392,19 @@ public:
         std::print("Задач отправлено: {}\n", stats.totalTasksSubmitted);
         std::print("Задач выполнено: {}\n", stats.totalTasksCompleted);
         std::print("Задач неудачных: {}\n", stats.totalTasksFailed);
-        std::print("Общее время выполнения: {} мс\n", stats.totalExecutionTime);
-        std::print("Среднее время выполнения: {:.2f} мс\n", stats.averageExecutionTime);
+        std::print("Общее время выполнения: {:.1f} мкс\n", stats.totalExecutionTime);
+        std::print("Среднее время выполнения: {:.2f} мкс (p99 {:.2f} мкс)\n", stats.averageExecutionTime, stats.p99ExecutionTime);
+        std::print("Ожидание в очереди p99: {:.2f} мкс\n", stats.p99QueueWait);
         std::print("Процент успеха: {:.2f}%\n", stats.successRate * 100);
         std::print("Процент неудач: {:.2f}%\n", stats.failureRate * 100);
         
         std::print("\n=== СТАТИСТИКА ПО ПОТОКАМ ===\n");
-        for (size_t i = 0; i < workerStats_.size(); ++i) {
-            const auto& workerStats = workerStats_[i];
-            std::print("Worker {}: задач={}, время={} мс, занят={}\n",
-                       i, workerStats.tasksCompleted.load(), 
-                       workerStats.totalExecutionTime.load(),
-                       (workerStats.isBusy.load() ? "да" : "нет"));
+        for (size_t i = 0; i < stats.snapshot.workers.size(); ++i) {
+            const auto& workerStats = stats.snapshot.workers[i];
+            std::print("{}: задач={}, время={:.1f} мкс, занят={}\n",
+                       workerNames_[i], workerStats.tasksCompleted,
+                       workerStats.execution.sumNanos / 1000.0,
+                       (workerStats.isBusy ? "да" : "нет"));
         }
         std::print("=====================================\n");
 #else
@@ -417,17 +414,19 @@ public:
         std::cout << "Задач отправлено: " << stats.totalTasksSubmitted << std::endl;
         std::cout << "Задач выполнено: " << stats.totalTasksCompleted << std::endl;
         std::cout << "Задач неудачных: " << stats.totalTasksFailed << std::endl;
-        std::cout << "Общее время выполнения: " << stats.totalExecutionTime << " мс" << std::endl;
-        std::cout << "Среднее время выполнения: " << stats.averageExecutionTime << " мс" << std::endl;
+        std::cout << "Общее время выполнения: " << stats.totalExecutionTime << " мкс" << std::endl;
+        std::cout << "Среднее время выполнения: " << stats.averageExecutionTime
+                  << " мкс (p99 " << stats.p99ExecutionTime << " мкс)" << std::endl;
+        std::cout << "Ожидание в очереди p99: " << stats.p99QueueWait << " мкс" << std::endl;
         std::cout << "Процент успеха: " << (stats.successRate * 100) << "%" << std::endl;
         std::cout << "Процент неудач: " << (stats.failureRate * 100) << "%" << std::endl;
         
         std::cout << "\n=== СТАТИСТИКА ПО ПОТОКАМ ===" << std::endl;
-        for (size_t i = 0; i < workerStats_.size(); ++i) {
-            const auto& workerStats = workerStats_[i];
-            std::cout << "Worker " << i << ": задач=" << workerStats.tasksCompleted.load()
-                      << ", время=" << workerStats.totalExecutionTime.load() << " мс"
-                      << ", занят=" << (workerStats.isBusy.load() ? "да" : "нет") << std::endl;
+        for (size_t i = 0; i < stats.snapshot.workers.size(); ++i) {
+            const auto& workerStats = stats.snapshot.workers[i];
+            std::cout << workerNames_[i] << ": задач=" << workerStats.tasksCompleted
+                      << ", время=" << workerStats.execution.sumNanos / 1000.0 << " мкс"
+                      << ", занят=" << (workerStats.isBusy ? "да" : "нет") << std::endl;
         }
         std::cout << "=====================================" << std::endl;
 #endif
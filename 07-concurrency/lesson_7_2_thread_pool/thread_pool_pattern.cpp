@@ -9,6 +9,13 @@
 #include <chrono>
 #include <atomic>
 #include <random>
+#include <climits>
+
+#include "cpu_topology.h"
+#include "optimization_barrier.h"
+#include "pool_instrumentation.h"
+#include "thread_pool_pattern.h"
+#include "tracing.h"
 
 /**
  * @file thread_pool_pattern.cpp
@@ -18,306 +25,6 @@
  * от базовой до продвинутых версий с мониторингом и балансировкой.
  */
 
-// ============================================================================
-// БАЗОВАЯ РЕАЛИЗАЦИЯ THREAD POOL
-// ============================================================================
-
-/**
- * @brief Базовая реализация Thread Pool
- * 
- * Особенности:
- * - Предварительно созданные рабочие потоки
- * - Thread-safe очередь задач
- * - Поддержка std::future для получения результатов
- * - Graceful shutdown
- */
-class ThreadPool {
-private:
-    std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
-    std::mutex queueMutex_;
-    std::condition_variable condition_;
-    std::atomic<bool> stop_;
-    size_t numThreads_;
-    
-public:
-    explicit ThreadPool(size_t numThreads = std::thread::hardware_concurrency()) 
-        : stop_(false), numThreads_(numThreads) {
-        
-        std::cout << "Создаю Thread Pool с " << numThreads_ << " потоками..." << std::endl;
-        
-        // Создаем рабочие потоки
-        for (size_t i = 0; i < numThreads_; ++i) {
-            workers_.emplace_back([this, i] {
-                std::cout << "Рабочий поток " << i << " запущен (ID: " 
-                          << std::this_thread::get_id() << ")" << std::endl;
-                
-                while (true) {
-                    std::function<void()> task;
-                    
-                    {
-                        std::unique_lock<std::mutex> lock(queueMutex_);
-                        condition_.wait(lock, [this] { return stop_.load() || !tasks_.empty(); });
-                        
-                        if (stop_.load() && tasks_.empty()) {
-                            break;
-                        }
-                        
-                        task = std::move(tasks_.front());
-                        tasks_.pop();
-                    }
-                    
-                    // Выполняем задачу
-                    try {
-                        task();
-                    } catch (const std::exception& e) {
-                        std::cerr << "Ошибка в рабочем потоке: " << e.what() << std::endl;
-                    }
-                }
-                
-                std::cout << "Рабочий поток " << i << " завершен" << std::endl;
-            });
-        }
-    }
-    
-    ~ThreadPool() {
-        shutdown();
-    }
-    
-    /**
-     * @brief Добавляет задачу в очередь
-     */
-    template<typename F, typename... Args>
-    auto enqueue(F&& f, Args&&... args) 
-        -> std::future<typename std::result_of<F(Args...)>::type> {
-        
-        using return_type = typename std::result_of<F(Args...)>::type;
-        
-        if (stop_.load()) {
-            throw std::runtime_error("enqueue на остановленном ThreadPool");
-        }
-        
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
-        
-        std::future<return_type> result = task->get_future();
-        
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
-            tasks_.emplace([task]() { (*task)(); });
-        }
-        
-        condition_.notify_one();
-        return result;
-    }
-    
-    /**
-     * @brief Получает количество потоков
-     */
-    size_t size() const {
-        return numThreads_;
-    }
-    
-    /**
-     * @brief Получает количество задач в очереди
-     */
-    size_t queueSize() const {
-        std::lock_guard<std::mutex> lock(queueMutex_);
-        return tasks_.size();
-    }
-    
-    /**
-     * @brief Останавливает Thread Pool
-     */
-    void shutdown() {
-        if (stop_.load()) {
-            return;
-        }
-        
-        std::cout << "Останавливаю Thread Pool..." << std::endl;
-        
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
-            stop_.store(true);
-        }
-        
-        condition_.notify_all();
-        
-        for (std::thread& worker : workers_) {
-            if (worker.joinable()) {
-                worker.join();
-            }
-        }
-        
-        std::cout << "Thread Pool остановлен" << std::endl;
-    }
-};
-
-// ============================================================================
-// ПРОДВИНУТАЯ РЕАЛИЗАЦИЯ С МОНИТОРИНГОМ
-// ============================================================================
-
-/**
- * @brief Продвинутый Thread Pool с мониторингом
- */
-class AdvancedThreadPool {
-private:
-    struct WorkerStats {
-        std::atomic<size_t> tasksCompleted{0};
-        std::atomic<size_t> totalExecutionTime{0};
-        std::atomic<bool> isBusy{false};
-    };
-    
-    std::vector<std::thread> workers_;
-    std::vector<WorkerStats> workerStats_;
-    std::queue<std::function<void()>> tasks_;
-    std::mutex queueMutex_;
-    std::condition_variable condition_;
-    std::atomic<bool> stop_;
-    size_t numThreads_;
-    
-    // Статистика
-    std::atomic<size_t> totalTasksSubmitted_{0};
-    std::atomic<size_t> totalTasksCompleted_{0};
-    std::atomic<size_t> totalExecutionTime_{0};
-    
-public:
-    explicit AdvancedThreadPool(size_t numThreads = std::thread::hardware_concurrency()) 
-        : stop_(false), numThreads_(numThreads), workerStats_(numThreads) {
-        
-        std::cout << "Создаю Advanced Thread Pool с " << numThreads_ << " потоками..." << std::endl;
-        
-        for (size_t i = 0; i < numThreads_; ++i) {
-            workers_.emplace_back([this, i] {
-                std::cout << "Advanced Worker " << i << " запущен" << std::endl;
-                
-                while (true) {
-                    std::function<void()> task;
-                    
-                    {
-                        std::unique_lock<std::mutex> lock(queueMutex_);
-                        condition_.wait(lock, [this] { return stop_.load() || !tasks_.empty(); });
-                        
-                        if (stop_.load() && tasks_.empty()) {
-                            break;
-                        }
-                        
-                        task = std::move(tasks_.front());
-                        tasks_.pop();
-                    }
-                    
-                    // Выполняем задачу с мониторингом
-                    workerStats_[i].isBusy.store(true);
-                    auto start = std::chrono::high_resolution_clock::now();
-                    
-                    try {
-                        task();
-                    } catch (const std::exception& e) {
-                        std::cerr << "Ошибка в Advanced Worker " << i << ": " << e.what() << std::endl;
-                    }
-                    
-                    auto end = std::chrono::high_resolution_clock::now();
-                    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-                    
-                    // Обновляем статистику
-                    workerStats_[i].tasksCompleted.fetch_add(1);
-                    workerStats_[i].totalExecutionTime.fetch_add(duration.count());
-                    workerStats_[i].isBusy.store(false);
-                    
-                    totalTasksCompleted_.fetch_add(1);
-                    totalExecutionTime_.fetch_add(duration.count());
-                }
-                
-                std::cout << "Advanced Worker " << i << " завершен" << std::endl;
-            });
-        }
-    }
-    
-    ~AdvancedThreadPool() {
-        shutdown();
-    }
-    
-    template<typename F, typename... Args>
-    auto enqueue(F&& f, Args&&... args) 
-        -> std::future<typename std::result_of<F(Args...)>::type> {
-        
-        using return_type = typename std::result_of<F(Args...)>::type;
-        
-        if (stop_.load()) {
-            throw std::runtime_error("enqueue на остановленном AdvancedThreadPool");
-        }
-        
-        totalTasksSubmitted_.fetch_add(1);
-        
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
-        
-        std::future<return_type> result = task->get_future();
-        
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
-            tasks_.emplace([task]() { (*task)(); });
-        }
-        
-        condition_.notify_one();
-        return result;
-    }
-    
-    void printStatistics() const {
-        std::cout << "\n=== СТАТИСТИКА THREAD POOL ===" << std::endl;
-        std::cout << "Всего потоков: " << numThreads_ << std::endl;
-        std::cout << "Задач в очереди: " << queueSize() << std::endl;
-        std::cout << "Задач отправлено: " << totalTasksSubmitted_.load() << std::endl;
-        std::cout << "Задач выполнено: " << totalTasksCompleted_.load() << std::endl;
-        std::cout << "Общее время выполнения: " << totalExecutionTime_.load() << " мс" << std::endl;
-        
-        if (totalTasksCompleted_.load() > 0) {
-            double avgTime = static_cast<double>(totalExecutionTime_.load()) / totalTasksCompleted_.load();
-            std::cout << "Среднее время выполнения: " << avgTime << " мс" << std::endl;
-        }
-        
-        std::cout << "\n=== СТАТИСТИКА ПО ПОТОКАМ ===" << std::endl;
-        for (size_t i = 0; i < workerStats_.size(); ++i) {
-            const auto& stats = workerStats_[i];
-            std::cout << "Worker " << i << ": "
-                      << "задач=" << stats.tasksCompleted.load()
-                      << ", время=" << stats.totalExecutionTime.load() << " мс"
-                      << ", занят=" << (stats.isBusy.load() ? "да" : "нет") << std::endl;
-        }
-        std::cout << "==============================" << std::endl;
-    }
-    
-    size_t size() const { return numThreads_; }
-    
-    size_t queueSize() const {
-        std::lock_guard<std::mutex> lock(queueMutex_);
-        return tasks_.size();
-    }
-    
-    void shutdown() {
-        if (stop_.load()) return;
-        
-        std::cout << "Останавливаю Advanced Thread Pool..." << std::endl;
-        
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
-            stop_.store(true);
-        }
-        
-        condition_.notify_all();
-        
-        for (std::thread& worker : workers_) {
-            if (worker.joinable()) {
-                worker.join();
-            }
-        }
-        
-        printStatistics();
-    }
-};
-
 // ============================================================================
 // ПРИМЕРЫ ИСПОЛЬЗОВАНИЯ
 // ============================================================================
@@ -414,6 +121,8 @@ void demonstrateBasicThreadPool() {
 void demonstrateAdvancedThreadPool() {
     std::cout << "\n=== ПРОДВИНУТЫЙ THREAD POOL ===" << std::endl;
     
+    // Сеанс объявлен до пула: файл пишется после остановки воркеров
+    cpp_patterns::TraceSession trace("thread_pool_trace.json", cpp_patterns::traceRequested());
     AdvancedThreadPool pool(3);
     
     // Добавляем задачи с разной сложностью
@@ -445,7 +154,8 @@ void demonstrateAdvancedThreadPool() {
 void demonstrateParallelComputations() {
     std::cout << "\n=== ПАРАЛЛЕЛЬНЫЕ ВЫЧИСЛЕНИЯ ===" << std::endl;
     
-    ThreadPool pool(std::thread::hardware_concurrency());
+    // CPU-bound задачи: по потоку на ядро, SMT-соседи заняты в последнюю очередь
+    ThreadPool pool(std::thread::hardware_concurrency(), cpp_patterns::ThreadPlacement::scatter());
     
     // Вычисляем числа Фибоначчи параллельно
     std::vector<int> fibonacciNumbers = {30, 35, 40, 45, 50};
@@ -469,6 +179,7 @@ void demonstrateParallelComputations() {
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     
     std::cout << "Все вычисления завершены за " << duration.count() << " мс" << std::endl;
+    std::cout << "Закреплено потоков: " << pool.pinnedThreads() << " из " << pool.size() << std::endl;
     
     // Сравним с последовательным выполнением
     start = std::chrono::high_resolution_clock::now();
@@ -487,6 +198,9 @@ void demonstrateParallelComputations() {
 
 /**
  * @brief Демонстрация производительности
+ *
+ * Один прогон для иллюстрации. Сравнимые цифры (прогрев, повторы,
+ * медиана и p99) даёт цель benchmarks: ./benchmarks --filter='^thread_pool/'
  */
 void demonstratePerformance() {
     std::cout << "\n=== ТЕСТ ПРОИЗВОДИТЕЛЬНОСТИ ===" << std::endl;
@@ -540,6 +254,111 @@ void demonstratePerformance() {
     }
 }
 
+/**
+ * @brief Задача заданной длительности без обращения к часам и планировщику
+ */
+class SpinWork {
+private:
+    uint64_t iterationsPerMicro_;
+    
+public:
+    SpinWork() {
+        // Лучший из нескольких замеров: первый обычно медленнее (частота, кэш)
+        constexpr uint64_t kProbe = 2'000'000;
+        int64_t bestNanos = INT64_MAX;
+        for (int attempt = 0; attempt < 5; ++attempt) {
+            auto start = std::chrono::steady_clock::now();
+            spin(kProbe);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            bestNanos = std::min<int64_t>(bestNanos, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+        iterationsPerMicro_ = std::max<uint64_t>(1, kProbe * 1000 / std::max<int64_t>(1, bestNanos));
+    }
+    
+    static uint64_t spin(uint64_t iterations) {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            sum += i;
+            cpp_patterns::doNotOptimize(sum);  // иначе цикл сворачивается в формулу
+        }
+        return sum;
+    }
+    
+    void runFor(std::chrono::microseconds duration) const {
+        spin(iterationsPerMicro_ * static_cast<uint64_t>(duration.count()));
+    }
+};
+
+/**
+ * @brief Снимок статистики на ходу и гистограммы задержек
+ */
+void demonstratePoolInstrumentation() {
+    std::cout << "\n=== ИНСТРУМЕНТИРОВАНИЕ ПУЛА ===" << std::endl;
+    
+    SpinWork work;
+    AdvancedThreadPool pool(4);
+    
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 2000; ++i) {
+        futures.push_back(pool.enqueue([&work] { work.runFor(std::chrono::microseconds(20)); }));
+    }
+    
+    // Снимок во время работы: воркеры не останавливаются
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    auto midRun = pool.statistics();
+    std::cout << "Снимок на ходу: выполнено " << midRun.tasksCompleted << " из " << futures.size()
+              << ", p50 выполнения " << midRun.execution.percentileNanos(50) / 1000.0 << " мкс" << std::endl;
+    
+    for (auto& future : futures) {
+        future.get();
+    }
+    pool.printStatistics();
+}
+
+/**
+ * @brief Стоимость замеров на задачах по 1 мкс: пул с замерами и без
+ */
+void benchmarkInstrumentationOverhead() {
+    std::cout << "\n=== НАКЛАДНЫЕ РАСХОДЫ ИНСТРУМЕНТИРОВАНИЯ (задачи по 1 мкс) ===" << std::endl;
+    
+    constexpr int kTasks = 200'000;
+    constexpr int kRounds = 5;
+    constexpr int kInFlight = 256;  // окно отправки: ожидание в очереди остаётся реалистичным
+    SpinWork work;
+    std::vector<std::future<void>> futures;
+    futures.reserve(kTasks);
+    
+    auto runRound = [&](AdvancedThreadPool& pool) {
+        futures.clear();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kTasks; ++i) {
+            if (i >= kInFlight) {
+                futures[i - kInFlight].get();
+            }
+            futures.push_back(pool.enqueue([&work] { work.runFor(std::chrono::microseconds(1)); }));
+        }
+        for (int i = std::max(0, kTasks - kInFlight); i < kTasks; ++i) {
+            futures[i].get();
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    
+    double best[2] = {1e30, 1e30};  // [0] - без замеров, [1] - с замерами
+    {
+        AdvancedThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+        for (int round = 0; round < kRounds; ++round) {
+            for (int timed = 0; timed < 2; ++timed) {
+                pool.setTimingEnabled(timed == 1);
+                best[timed] = std::min(best[timed], runRound(pool));
+            }
+        }
+    }
+    
+    std::cout << "Без замеров: " << static_cast<long long>(kTasks / best[0]) << " задач/с" << std::endl;
+    std::cout << "С замерами:  " << static_cast<long long>(kTasks / best[1]) << " задач/с" << std::endl;
+    std::cout << "Накладные расходы: " << (best[1] / best[0] - 1.0) * 100.0 << "%" << std::endl;
+}
+
 // ============================================================================
 // ОСНОВНАЯ ФУНКЦИЯ
 // ============================================================================
@@ -551,6 +370,8 @@ int main() {
     try {
         demonstrateBasicThreadPool();
         demonstrateAdvancedThreadPool();
+        demonstratePoolInstrumentation();
+        benchmarkInstrumentationOverhead();
         demonstrateParallelComputations();
         demonstratePerformance();
         
@@ -0,0 +1,394 @@
+/**
+ * @file thread_pool_pattern.h
+ * @brief Пулы урока Thread Pool: базовый ThreadPool и AdvancedThreadPool с мониторингом
+ *
+ * Вынесены из thread_pool_pattern.cpp, чтобы бенчмарки
+ * (benchmarks/bench_thread_pools.cpp) замеряли пулы урока, а не их копию.
+ * Флаг verbose отключает вывод о запуске и остановке потоков и итоговую
+ * статистику.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cpu_topology.h"
+#include "pool_instrumentation.h"
+#include "tracing.h"
+
+// ============================================================================
+// БАЗОВАЯ РЕАЛИЗАЦИЯ THREAD POOL
+// ============================================================================
+
+/**
+ * @brief Базовая реализация Thread Pool
+ * 
+ * Особенности:
+ * - Предварительно созданные рабочие потоки
+ * - Thread-safe очередь задач
+ * - Поддержка std::future для получения результатов
+ * - Graceful shutdown
+ * - Необязательное закрепление потоков за CPU (ThreadPlacement)
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    mutable std::mutex queueMutex_;
+    std::condition_variable condition_;
+    std::atomic<bool> stop_;
+    size_t numThreads_;
+    std::atomic<size_t> pinnedThreads_{0};
+    bool verbose_;  // Печатать запуск и остановку потоков
+    
+public:
+    explicit ThreadPool(size_t numThreads = std::thread::hardware_concurrency(),
+                        const cpp_patterns::ThreadPlacement& placement = {},
+                        bool verbose = true) 
+        : stop_(false), numThreads_(numThreads), verbose_(verbose) {
+        
+        if (verbose_) {
+            std::cout << "Создаю Thread Pool с " << numThreads_ << " потоками..." << std::endl;
+        }
+        
+        std::vector<int> cpus = placement.assign(numThreads_);
+        
+        // Создаем рабочие потоки
+        for (size_t i = 0; i < numThreads_; ++i) {
+            workers_.emplace_back([this, i, cpu = cpus[i]] {
+                if (cpu >= 0) {
+                    if (cpp_patterns::pinCurrentThread(cpu)) {
+                        pinnedThreads_.fetch_add(1);
+                    } else {
+                        std::cerr << "Рабочий поток " << i << ": не удалось закрепить за CPU " << cpu << std::endl;
+                    }
+                }
+                if (verbose_) {
+                    std::cout << "Рабочий поток " << i << " запущен (ID: " 
+                              << std::this_thread::get_id() << ")" << std::endl;
+                }
+                
+                while (true) {
+                    std::function<void()> task;
+                    
+                    {
+                        std::unique_lock<std::mutex> lock(queueMutex_);
+                        condition_.wait(lock, [this] { return stop_.load() || !tasks_.empty(); });
+                        
+                        if (stop_.load() && tasks_.empty()) {
+                            break;
+                        }
+                        
+                        task = std::move(tasks_.front());
+                        tasks_.pop();
+                    }
+                    
+                    // Выполняем задачу
+                    try {
+                        task();
+                    } catch (const std::exception& e) {
+                        std::cerr << "Ошибка в рабочем потоке: " << e.what() << std::endl;
+                    }
+                }
+                
+                if (verbose_) {
+                    std::cout << "Рабочий поток " << i << " завершен" << std::endl;
+                }
+            });
+        }
+    }
+    
+    ~ThreadPool() {
+        shutdown();
+    }
+    
+    /**
+     * @brief Добавляет задачу в очередь
+     */
+    template<typename F, typename... Args>
+    auto enqueue(F&& f, Args&&... args) 
+        -> std::future<typename std::result_of<F(Args...)>::type> {
+        
+        using return_type = typename std::result_of<F(Args...)>::type;
+        
+        if (stop_.load()) {
+            throw std::runtime_error("enqueue на остановленном ThreadPool");
+        }
+        
+        auto task = std::make_shared<std::packaged_task<return_type()>>(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+        );
+        
+        std::future<return_type> result = task->get_future();
+        
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            tasks_.emplace([task]() { (*task)(); });
+        }
+        
+        condition_.notify_one();
+        return result;
+    }
+    
+    /**
+     * @brief Получает количество потоков
+     */
+    size_t size() const {
+        return numThreads_;
+    }
+    
+    /**
+     * @brief Получает количество потоков, уже закреплённых за своим CPU
+     */
+    size_t pinnedThreads() const {
+        return pinnedThreads_.load();
+    }
+    
+    /**
+     * @brief Получает количество задач в очереди
+     */
+    size_t queueSize() const {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        return tasks_.size();
+    }
+    
+    /**
+     * @brief Останавливает Thread Pool
+     */
+    void shutdown() {
+        if (stop_.load()) {
+            return;
+        }
+        
+        if (verbose_) {
+            std::cout << "Останавливаю Thread Pool..." << std::endl;
+        }
+        
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            stop_.store(true);
+        }
+        
+        condition_.notify_all();
+        
+        for (std::thread& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        
+        if (verbose_) {
+            std::cout << "Thread Pool остановлен" << std::endl;
+        }
+    }
+};
+
+// ============================================================================
+// ПРОДВИНУТАЯ РЕАЛИЗАЦИЯ С МОНИТОРИНГОМ
+// ============================================================================
+
+/**
+ * @brief Продвинутый Thread Pool с мониторингом
+ * 
+ * Статистика по воркерам - в cpp_patterns::PoolInstrumentation: счётчики
+ * каждого воркера на своих кэш-линиях, гистограммы ожидания в очереди и
+ * выполнения в наносекундах. statistics() снимает их без остановки пула.
+ */
+class AdvancedThreadPool {
+private:
+    struct QueuedTask {
+        std::function<void()> run;
+        uint64_t enqueuedTicks;  // PoolClock::now() при постановке; 0 - замер выключен
+    };
+    
+    std::vector<std::thread> workers_;
+    std::queue<QueuedTask> tasks_;
+    mutable std::mutex queueMutex_;
+    std::condition_variable condition_;
+    std::atomic<bool> stop_;
+    size_t numThreads_;
+    bool verbose_;  // Печатать запуск и остановку воркеров и итоговую статистику
+    cpp_patterns::PoolInstrumentation instrumentation_;
+    
+    // Пишут отправители, а не воркеры - держим отдельно от их счётчиков
+    alignas(cpp_patterns::kCacheLineSize) std::atomic<size_t> totalTasksSubmitted_{0};
+    
+public:
+    explicit AdvancedThreadPool(size_t numThreads = std::thread::hardware_concurrency(), bool verbose = true) 
+        : stop_(false), numThreads_(numThreads), verbose_(verbose), instrumentation_(numThreads) {
+        
+        if (verbose_) {
+            std::cout << "Создаю Advanced Thread Pool с " << numThreads_ << " потоками..." << std::endl;
+        }
+        
+        for (size_t i = 0; i < numThreads_; ++i) {
+            workers_.emplace_back([this, i] {
+                if (verbose_) {
+                    std::cout << "Advanced Worker " << i << " запущен" << std::endl;
+                }
+                cpp_patterns::WorkerCounters& counters = instrumentation_.worker(i);
+                TRACE_THREAD_NAME("advanced-worker-" + std::to_string(i));
+                
+                while (true) {
+                    QueuedTask task;
+                    
+                    {
+                        std::unique_lock<std::mutex> lock(queueMutex_);
+                        condition_.wait(lock, [this] { return stop_.load() || !tasks_.empty(); });
+                        
+                        if (stop_.load() && tasks_.empty()) {
+                            break;
+                        }
+                        
+                        task = std::move(tasks_.front());
+                        tasks_.pop();
+                    }
+                    
+                    // Выполняем задачу с мониторингом
+                    counters.isBusy.store(true, std::memory_order_relaxed);
+                    uint64_t start = task.enqueuedTicks ? cpp_patterns::PoolClock::now() : 0;
+                    bool failed = false;
+                    
+                    try {
+                        TRACE_ZONE_CAT("task", "thread_pool");
+                        task.run();
+                    } catch (const std::exception& e) {
+                        failed = true;
+                        std::cerr << "Ошибка в Advanced Worker " << i << ": " << e.what() << std::endl;
+                    }
+                    
+                    // Обновляем статистику: пишет только этот воркер и только в свои линии
+                    if (task.enqueuedTicks) {
+                        counters.recordTiming(task.enqueuedTicks, start, cpp_patterns::PoolClock::now());
+                    }
+                    counters.countTask(failed);
+                    counters.isBusy.store(false, std::memory_order_relaxed);
+                }
+                
+                if (verbose_) {
+                    std::cout << "Advanced Worker " << i << " завершен" << std::endl;
+                }
+            });
+        }
+    }
+    
+    ~AdvancedThreadPool() {
+        shutdown();
+    }
+    
+    template<typename F, typename... Args>
+    auto enqueue(F&& f, Args&&... args) 
+        -> std::future<typename std::result_of<F(Args...)>::type> {
+        
+        using return_type = typename std::result_of<F(Args...)>::type;
+        
+        if (stop_.load()) {
+            throw std::runtime_error("enqueue на остановленном AdvancedThreadPool");
+        }
+        
+        totalTasksSubmitted_.fetch_add(1);
+        
+        auto task = std::make_shared<std::packaged_task<return_type()>>(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+        );
+        
+        std::future<return_type> result = task->get_future();
+        
+        uint64_t enqueuedTicks = instrumentation_.enabled() ? cpp_patterns::PoolClock::now() : 0;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            tasks_.push({[task]() { (*task)(); }, enqueuedTicks});
+        }
+        
+        condition_.notify_one();
+        return result;
+    }
+    
+    /**
+     * @brief Снимок статистики на ходу, без остановки воркеров
+     */
+    cpp_patterns::PoolStatsSnapshot statistics() const {
+        return instrumentation_.snapshot();
+    }
+    
+    /**
+     * @brief Включить/выключить замеры времени (счётчики задач ведутся всегда)
+     */
+    void setTimingEnabled(bool enabled) {
+        instrumentation_.setEnabled(enabled);
+    }
+    
+    void printStatistics() const {
+        auto stats = statistics();
+        auto micros = [](uint64_t nanos) { return static_cast<double>(nanos) / 1000.0; };
+        auto printHistogram = [&](const char* title, const cpp_patterns::HistogramSnapshot& h) {
+            std::cout << title << ": p50=" << micros(h.percentileNanos(50))
+                      << " мкс, p99=" << micros(h.percentileNanos(99))
+                      << " мкс, p99.9=" << micros(h.percentileNanos(99.9))
+                      << " мкс, max=" << micros(h.maxNanos)
+                      << " мкс, среднее=" << micros(static_cast<uint64_t>(h.meanNanos())) << " мкс" << std::endl;
+        };
+        
+        std::cout << "\n=== СТАТИСТИКА THREAD POOL ===" << std::endl;
+        std::cout << "Всего потоков: " << numThreads_ << std::endl;
+        std::cout << "Задач в очереди: " << queueSize() << std::endl;
+        std::cout << "Задач отправлено: " << totalTasksSubmitted_.load() << std::endl;
+        std::cout << "Задач выполнено: " << stats.tasksCompleted << std::endl;
+        std::cout << "Задач с ошибкой: " << stats.tasksFailed << std::endl;
+        printHistogram("Ожидание в очереди", stats.queueWait);
+        printHistogram("Выполнение", stats.execution);
+        
+        std::cout << "\n=== СТАТИСТИКА ПО ПОТОКАМ ===" << std::endl;
+        for (size_t i = 0; i < stats.workers.size(); ++i) {
+            const auto& worker = stats.workers[i];
+            std::cout << "Worker " << i << ": "
+                      << "задач=" << worker.tasksCompleted
+                      << ", время=" << micros(worker.execution.sumNanos) << " мкс"
+                      << ", p99=" << micros(worker.execution.percentileNanos(99)) << " мкс"
+                      << ", занят=" << (worker.isBusy ? "да" : "нет") << std::endl;
+        }
+        std::cout << "==============================" << std::endl;
+    }
+    
+    size_t size() const { return numThreads_; }
+    
+    size_t queueSize() const {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        return tasks_.size();
+    }
+    
+    void shutdown() {
+        if (stop_.load()) return;
+        
+        if (verbose_) {
+            std::cout << "Останавливаю Advanced Thread Pool..." << std::endl;
+        }
+        
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            stop_.store(true);
+        }
+        
+        condition_.notify_all();
+        
+        for (std::thread& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        
+        if (verbose_) {
+            printStatistics();
+        }
+    }
+};
@@ -23,172 +23,18 @@
 #include <exception>
 #include <random>
 #include <future>
+#include <new>
+#include <memory_resource>
+#include <utility>
+#include <cstddef>
 
-// Базовые типы сообщений
-struct Message {
-    virtual ~Message() = default;
-    virtual std::string getType() const = 0;
-};
-
-// Конкретные типы сообщений
-struct PingMessage : public Message {
-    std::string sender;
-    int sequence;
-    
-    PingMessage(const std::string& s, int seq) : sender(s), sequence(seq) {}
-    
-    std::string getType() const override {
-        return "Ping";
-    }
-};
-
-struct PongMessage : public Message {
-    std::string sender;
-    int sequence;
-    
-    PongMessage(const std::string& s, int seq) : sender(s), sequence(seq) {}
-    
-    std::string getType() const override {
-        return "Pong";
-    }
-};
-
-struct WorkMessage : public Message {
-    int work_id;
-    std::string data;
-    
-    WorkMessage(int id, const std::string& d) : work_id(id), data(d) {}
-    
-    std::string getType() const override {
-        return "Work";
-    }
-};
-
-struct ResultMessage : public Message {
-    int work_id;
-    std::string result;
-    
-    ResultMessage(int id, const std::string& r) : work_id(id), result(r) {}
-    
-    std::string getType() const override {
-        return "Result";
-    }
-};
-
-struct ErrorMessage : public Message {
-    std::string error_text;
-    std::string actor_name;
-    
-    ErrorMessage(const std::string& error, const std::string& actor) 
-        : error_text(error), actor_name(actor) {}
-    
-    std::string getType() const override {
-        return "Error";
-    }
-};
+#include "counting_resource.h"
+#include "intrusive_ptr.h"
+#include "message_passing.h"
 
-struct ShutdownMessage : public Message {
-    std::string getType() const override {
-        return "Shutdown";
-    }
-};
-
-// Базовый Actor
-class Actor {
-protected:
-    std::string name_;
-    std::queue<std::shared_ptr<Message>> mailbox_;
-    std::mutex mailbox_mutex_;
-    std::condition_variable condition_;
-    std::atomic<bool> running_{true};
-    std::thread worker_thread_;
-    
-public:
-    explicit Actor(const std::string& name) : name_(name) {
-        worker_thread_ = std::thread([this]() { messageLoop(); });
-        std::cout << "Actor " << name_ << " создан" << std::endl;
-    }
-    
-    virtual ~Actor() {
-        shutdown();
-    }
-    
-    // Отправка сообщения
-    void send(std::shared_ptr<Message> message) {
-        {
-            std::lock_guard<std::mutex> lock(mailbox_mutex_);
-            mailbox_.push(message);
-        }
-        condition_.notify_one();
-    }
-    
-    // Получение имени актора
-    const std::string& getName() const {
-        return name_;
-    }
-    
-    // Graceful shutdown
-    void shutdown() {
-        if (!running_.load()) return;
-        
-        std::cout << "Останавливаем Actor " << name_ << std::endl;
-        
-        // Отправляем сообщение о завершении
-        send(std::make_shared<ShutdownMessage>());
-        
-        running_.store(false);
-        condition_.notify_all();
-        
-        if (worker_thread_.joinable()) {
-            worker_thread_.join();
-        }
-        
-        std::cout << "Actor " << name_ << " остановлен" << std::endl;
-    }
-    
-protected:
-    // Основной цикл обработки сообщений
-    virtual void messageLoop() {
-        std::cout << "Actor " << name_ << " запущен" << std::endl;
-        
-        while (running_.load()) {
-            std::shared_ptr<Message> message;
-            
-            {
-                std::unique_lock<std::mutex> lock(mailbox_mutex_);
-                condition_.wait(lock, [this] { 
-                    return !mailbox_.empty() || !running_.load(); 
-                });
-                
-                if (!running_.load()) break;
-                
-                if (!mailbox_.empty()) {
-                    message = mailbox_.front();
-                    mailbox_.pop();
-                }
-            }
-            
-            if (message) {
-                try {
-                    handleMessage(message);
-                } catch (const std::exception& e) {
-                    std::cerr << "Ошибка в Actor " << name_ << ": " << e.what() << std::endl;
-                    handleError(e);
-                }
-            }
-        }
-        
-        std::cout << "Actor " << name_ << " завершил работу" << std::endl;
-    }
-    
-    // Обработка сообщений (переопределяется в наследниках)
-    virtual void handleMessage(std::shared_ptr<Message> message) = 0;
-    
-    // Обработка ошибок
-    virtual void handleError(const std::exception& e) {
-        std::cerr << "Actor " << name_ << " обработал ошибку: " << e.what() << std::endl;
-    }
-};
+using cpp_patterns::BorrowedPtr;
+using cpp_patterns::IntrusivePtr;
+using cpp_patterns::makeIntrusive;
 
 // Ping-Pong Actor
 class PingPongActor : public Actor {
@@ -209,20 +55,20 @@ public:
     }
     
 protected:
-    void handleMessage(std::shared_ptr<Message> message) override {
-        if (auto ping = std::dynamic_pointer_cast<PingMessage>(message)) {
-            handlePing(ping);
-        } else if (auto pong = std::dynamic_pointer_cast<PongMessage>(message)) {
-            handlePong(pong);
-        } else if (auto shutdown = std::dynamic_pointer_cast<ShutdownMessage>(message)) {
+    void handleMessage(BorrowedPtr<Message> message) override {
+        if (auto ping = dynamic_cast<const PingMessage*>(message.get())) {
+            handlePing(*ping);
+        } else if (auto pong = dynamic_cast<const PongMessage*>(message.get())) {
+            handlePong(*pong);
+        } else if (dynamic_cast<const ShutdownMessage*>(message.get())) {
             handleShutdown();
         }
     }
     
 private:
-    void handlePing(std::shared_ptr<PingMessage> ping) {
-        std::cout << "Actor " << name_ << " получил Ping от " << ping->sender 
-                  << " (seq: " << ping->sequence << ")" << std::endl;
+    void handlePing(const PingMessage& ping) {
+        std::cout << "Actor " << name_ << " получил Ping от " << ping.sender 
+                  << " (seq: " << ping.sequence << ")" << std::endl;
         
         // Отправляем Pong обратно
         if (!target_actor_.empty()) {
@@ -231,9 +77,9 @@ private:
         }
     }
     
-    void handlePong(std::shared_ptr<PongMessage> pong) {
-        std::cout << "Actor " << name_ << " получил Pong от " << pong->sender 
-                  << " (seq: " << pong->sequence << ")" << std::endl;
+    void handlePong(const PongMessage& pong) {
+        std::cout << "Actor " << name_ << " получил Pong от " << pong.sender 
+                  << " (seq: " << pong.sequence << ")" << std::endl;
         
         // Продолжаем ping-pong
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -268,17 +114,17 @@ public:
     }
     
 protected:
-    void handleMessage(std::shared_ptr<Message> message) override {
-        if (auto work = std::dynamic_pointer_cast<WorkMessage>(message)) {
-            handleWork(work);
-        } else if (auto shutdown = std::dynamic_pointer_cast<ShutdownMessage>(message)) {
+    void handleMessage(BorrowedPtr<Message> message) override {
+        if (auto work = dynamic_cast<const WorkMessage*>(message.get())) {
+            handleWork(*work);
+        } else if (dynamic_cast<const ShutdownMessage*>(message.get())) {
             handleShutdown();
         }
     }
     
 private:
-    void handleWork(std::shared_ptr<WorkMessage> work) {
-        std::cout << "Worker " << name_ << " обрабатывает задачу " << work->work_id << std::endl;
+    void handleWork(const WorkMessage& work) {
+        std::cout << "Worker " << name_ << " обрабатывает задачу " << work.work_id << std::endl;
         
         try {
             // Имитация обработки работы
@@ -294,10 +140,10 @@ private:
             }
             
             // Успешная обработка
-            std::string result = "Результат обработки задачи " + std::to_string(work->work_id);
+            std::string result = "Результат обработки задачи " + std::to_string(work.work_id);
             processed_tasks_.fetch_add(1);
             
-            std::cout << "Worker " << name_ << " завершил задачу " << work->work_id << std::endl;
+            std::cout << "Worker " << name_ << " завершил задачу " << work.work_id << std::endl;
             
             // Отправляем результат супервизору
             if (!supervisor_name_.empty()) {
@@ -306,7 +152,7 @@ private:
             
         } catch (const std::exception& e) {
             std::cerr << "Worker " << name_ << " ошибка при обработке задачи " 
-                      << work->work_id << ": " << e.what() << std::endl;
+                      << work.work_id << ": " << e.what() << std::endl;
             
             // Отправляем ошибку супервизору
             if (!supervisor_name_.empty()) {
@@ -361,7 +207,7 @@ public:
             std::uniform_int_distribution<> dis(0, workers_.size() - 1);
             
             int worker_index = dis(gen);
-            auto work_message = std::make_shared<WorkMessage>(task_id, data);
+            auto work_message = makeIntrusive<WorkMessage>(task_id, data);
             
             std::cout << "Supervisor отправляет задачу " << task_id 
                       << " воркеру " << workers_[worker_index]->getName() << std::endl;
@@ -382,26 +228,26 @@ public:
     }
     
 protected:
-    void handleMessage(std::shared_ptr<Message> message) override {
-        if (auto result = std::dynamic_pointer_cast<ResultMessage>(message)) {
-            handleResult(result);
-        } else if (auto error = std::dynamic_pointer_cast<ErrorMessage>(message)) {
-            handleError(error);
-        } else if (auto shutdown = std::dynamic_pointer_cast<ShutdownMessage>(message)) {
+    void handleMessage(BorrowedPtr<Message> message) override {
+        if (auto result = dynamic_cast<const ResultMessage*>(message.get())) {
+            handleResult(*result);
+        } else if (auto error = dynamic_cast<const ErrorMessage*>(message.get())) {
+            handleError(*error);
+        } else if (dynamic_cast<const ShutdownMessage*>(message.get())) {
             handleShutdown();
         }
     }
     
 private:
-    void handleResult(std::shared_ptr<ResultMessage> result) {
+    void handleResult(const ResultMessage& result) {
         completed_tasks_.fetch_add(1);
-        std::cout << "Supervisor получил результат задачи " << result->work_id << std::endl;
+        std::cout << "Supervisor получил результат задачи " << result.work_id << std::endl;
     }
     
-    void handleError(std::shared_ptr<ErrorMessage> error) {
+    void handleError(const ErrorMessage& error) {
         failed_tasks_.fetch_add(1);
-        std::cout << "Supervisor получил ошибку от " << error->actor_name 
-                  << ": " << error->error_text << std::endl;
+        std::cout << "Supervisor получил ошибку от " << error.actor_name 
+                  << ": " << error.error_text << std::endl;
     }
     
     void handleShutdown() {
@@ -414,7 +260,7 @@ private:
 class MessageRouter {
 private:
     std::unordered_map<std::string, std::shared_ptr<Actor>> actors_;
-    std::mutex actors_mutex_;
+    mutable std::mutex actors_mutex_;
     
 public:
     void registerActor(std::shared_ptr<Actor> actor) {
@@ -429,7 +275,7 @@ public:
         std::cout << "Router отменил регистрацию Actor: " << name << std::endl;
     }
     
-    void sendMessage(const std::string& target, std::shared_ptr<Message> message) {
+    void sendMessage(const std::string& target, MessagePtr message) {
         std::lock_guard<std::mutex> lock(actors_mutex_);
         
         auto it = actors_.find(target);
@@ -442,7 +288,7 @@ public:
         }
     }
     
-    void broadcast(std::shared_ptr<Message> message) {
+    void broadcast(const MessagePtr& message) {
         std::lock_guard<std::mutex> lock(actors_mutex_);
         
         std::cout << "Router рассылает сообщение " << message->getType() 
@@ -481,7 +327,7 @@ void demonstrateBasicMessagePassing() {
     std::cout << "Начинаем ping-pong между акторами..." << std::endl;
     
     // Отправляем первое сообщение
-    auto ping = std::make_shared<PingMessage>("Actor1", 1);
+    auto ping = makeIntrusive<PingMessage>("Actor1", 1);
     router.sendMessage("Actor2", ping);
     
     // Даем время на обработку
@@ -554,7 +400,7 @@ void demonstrateBroadcast() {
     }
     
     // Рассылаем сообщение всем
-    auto shutdown_msg = std::make_shared<ShutdownMessage>();
+    MessagePtr shutdown_msg = makeIntrusive<ShutdownMessage>();
     router.broadcast(shutdown_msg);
     
     // Даем время на обработку
@@ -566,6 +412,108 @@ void demonstrateBroadcast() {
     }
 }
 
+// Путь сообщения через почтовый ящик: отправитель создаёт сообщение,
+// поток актора забирает его и диспетчеризует по типу. До миграции -
+// shared_ptr + dynamic_pointer_cast с копией в обработчик, после -
+// IntrusivePtr в очереди и невладеющий вид в обработчике.
+//
+// Аллокации считает CountingResource этого прогона: через него идут
+// сообщения, управляющие блоки shared_ptr и сегменты очереди ящика.
+template<typename Ptr, typename Make, typename Dispatch>
+void runMailboxBenchmark(const char* label, size_t count, Make make, Dispatch dispatch) {
+    using Mailbox = std::queue<Ptr, std::pmr::deque<Ptr>>;
+    cpp_patterns::CountingResource memory;
+    MessageMemoryScope scope(&memory);
+    
+    Mailbox mailbox{std::pmr::deque<Ptr>(&memory)};
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool done = false;
+    long long checksum = 0;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    std::thread consumer([&] {
+        Mailbox batch{std::pmr::deque<Ptr>(&memory)};
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [&] { return !mailbox.empty() || done; });
+                if (mailbox.empty() && done) break;
+                std::swap(batch, mailbox);
+            }
+            while (!batch.empty()) {
+                checksum += dispatch(batch.front());
+                batch.pop();
+            }
+        }
+    });
+    
+    for (size_t i = 0; i < count; ++i) {
+        Ptr message = make(static_cast<int>(i), &memory);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            mailbox.push(std::move(message));
+        }
+        if ((i & 255) == 0) ready.notify_one();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    ready.notify_one();
+    consumer.join();
+    
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    cpp_patterns::AllocationStats stats = memory.stats();
+    std::cout << label << ": " << ns / count << " нс/сообщение, аллокаций на сообщение: "
+              << static_cast<double>(stats.allocations) / count << " (checksum " << checksum << ")" << std::endl;
+}
+
+// Бенчмарк: shared_ptr против интрузивного счётчика на пути сообщения
+void benchmarkMessagePointers() {
+    std::cout << "\n=== Бенчмарк: shared_ptr vs IntrusivePtr в почтовом ящике ===" << std::endl;
+    constexpr size_t kMessages = 1'000'000;
+    
+    auto handlePingShared = [](std::shared_ptr<PingMessage> ping) { return ping->sequence; };
+    auto handleWorkShared = [](std::shared_ptr<WorkMessage> work) { return work->work_id; };
+    runMailboxBenchmark<std::shared_ptr<Message>>("shared_ptr(new T)   ", kMessages,
+        [](int i, std::pmr::memory_resource* memory) -> std::shared_ptr<Message> {
+            // Отдельный управляющий блок - вторая аллокация
+            std::pmr::polymorphic_allocator<Message> controlBlock(memory);
+            if (i & 1) return std::shared_ptr<Message>(new WorkMessage(i, "job"), std::default_delete<Message>(), controlBlock);
+            return std::shared_ptr<Message>(new PingMessage("bench", i), std::default_delete<Message>(), controlBlock);
+        },
+        [&](const std::shared_ptr<Message>& message) -> long long {
+            if (auto ping = std::dynamic_pointer_cast<PingMessage>(message)) return handlePingShared(ping);
+            if (auto work = std::dynamic_pointer_cast<WorkMessage>(message)) return handleWorkShared(work);
+            return 0;
+        });
+    runMailboxBenchmark<std::shared_ptr<Message>>("allocate_shared      ", kMessages,
+        [](int i, std::pmr::memory_resource* memory) -> std::shared_ptr<Message> {
+            if (i & 1) return std::allocate_shared<WorkMessage>(std::pmr::polymorphic_allocator<WorkMessage>(memory), i, "job");
+            return std::allocate_shared<PingMessage>(std::pmr::polymorphic_allocator<PingMessage>(memory), "bench", i);
+        },
+        [&](const std::shared_ptr<Message>& message) -> long long {
+            if (auto ping = std::dynamic_pointer_cast<PingMessage>(message)) return handlePingShared(ping);
+            if (auto work = std::dynamic_pointer_cast<WorkMessage>(message)) return handleWorkShared(work);
+            return 0;
+        });
+    runMailboxBenchmark<MessagePtr>("IntrusivePtr + view  ", kMessages,
+        [](int i, std::pmr::memory_resource*) -> MessagePtr {
+            if (i & 1) return makeIntrusive<WorkMessage>(i, "job");
+            return makeIntrusive<PingMessage>("bench", i);
+        },
+        [](const MessagePtr& owner) -> long long {
+            BorrowedPtr<Message> message = owner.borrow();
+            if (auto ping = dynamic_cast<const PingMessage*>(message.get())) return ping->sequence;
+            if (auto work = dynamic_cast<const WorkMessage*>(message.get())) return work->work_id;
+            return 0;
+        });
+    std::cout << "sizeof(shared_ptr<Message>) = " << sizeof(std::shared_ptr<Message>)
+              << ", sizeof(MessagePtr) = " << sizeof(MessagePtr) << std::endl;
+}
+
 int main() {
     std::cout << "=== Actor Model: Продвинутая передача сообщений ===" << std::endl;
     
@@ -574,6 +522,7 @@ int main() {
         demonstrateSupervisorWorker();
         demonstrateFaultTolerance();
         demonstrateBroadcast();
+        benchmarkMessagePointers();
     } catch (const std::exception& e) {
         std::cerr << "Ошибка: " << e.what() << std::endl;
         return 1;
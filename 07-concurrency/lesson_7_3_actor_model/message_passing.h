@@ -0,0 +1,251 @@
+/**
+ * @file message_passing.h
+ * @brief Сообщения с интрузивным счётчиком и базовый Actor урока Actor Model
+ *
+ * Вынесены из message_passing.cpp, чтобы бенчмарки
+ * (benchmarks/bench_actors.cpp) замеряли почтовый ящик урока, а не его копию.
+ * Флаг verbose у Actor отключает вывод о запуске и остановке актора.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <memory_resource>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "intrusive_ptr.h"
+
+// Базовые типы сообщений
+// Счётчик ссылок живёт в самом сообщении: одна аллокация на сообщение,
+// указатель в почтовом ящике - одно слово, а обработчики получают
+// невладеющий вид и не трогают счётчик вовсе.
+//
+// Память сообщения берётся из memory_resource потока-отправителя (по
+// умолчанию new/delete). Ресурс запоминается в заголовке блока, поэтому
+// освободить сообщение можно из любого потока.
+struct Message : public cpp_patterns::RefCounted<Message> {
+    virtual ~Message() = default;
+    virtual std::string getType() const = 0;
+    
+    static void* operator new(std::size_t size) {
+        std::pmr::memory_resource* memory = senderMemory();
+        void* block = memory->allocate(size + kHeader, alignof(std::max_align_t));
+        *static_cast<std::pmr::memory_resource**>(block) = memory;
+        return static_cast<std::byte*>(block) + kHeader;
+    }
+    
+    static void operator delete(void* p, std::size_t size) {
+        void* block = static_cast<std::byte*>(p) - kHeader;
+        (*static_cast<std::pmr::memory_resource**>(block))->deallocate(block, size + kHeader, alignof(std::max_align_t));
+    }
+    
+    static std::pmr::memory_resource*& senderMemory() {
+        thread_local std::pmr::memory_resource* memory = std::pmr::new_delete_resource();
+        return memory;
+    }
+    
+private:
+    static constexpr std::size_t kHeader = alignof(std::max_align_t);
+};
+
+// Направить сообщения, создаваемые этим потоком, в ресурс memory
+class MessageMemoryScope {
+public:
+    explicit MessageMemoryScope(std::pmr::memory_resource* memory)
+        : previous_(std::exchange(Message::senderMemory(), memory)) {}
+    ~MessageMemoryScope() { Message::senderMemory() = previous_; }
+    
+    MessageMemoryScope(const MessageMemoryScope&) = delete;
+    MessageMemoryScope& operator=(const MessageMemoryScope&) = delete;
+    
+private:
+    std::pmr::memory_resource* previous_;
+};
+
+using MessagePtr = cpp_patterns::IntrusivePtr<Message>;
+
+// Конкретные типы сообщений
+struct PingMessage : public Message {
+    std::string sender;
+    int sequence;
+    
+    PingMessage(const std::string& s, int seq) : sender(s), sequence(seq) {}
+    
+    std::string getType() const override {
+        return "Ping";
+    }
+};
+
+struct PongMessage : public Message {
+    std::string sender;
+    int sequence;
+    
+    PongMessage(const std::string& s, int seq) : sender(s), sequence(seq) {}
+    
+    std::string getType() const override {
+        return "Pong";
+    }
+};
+
+struct WorkMessage : public Message {
+    int work_id;
+    std::string data;
+    
+    WorkMessage(int id, const std::string& d) : work_id(id), data(d) {}
+    
+    std::string getType() const override {
+        return "Work";
+    }
+};
+
+struct ResultMessage : public Message {
+    int work_id;
+    std::string result;
+    
+    ResultMessage(int id, const std::string& r) : work_id(id), result(r) {}
+    
+    std::string getType() const override {
+        return "Result";
+    }
+};
+
+struct ErrorMessage : public Message {
+    std::string error_text;
+    std::string actor_name;
+    
+    ErrorMessage(const std::string& error, const std::string& actor) 
+        : error_text(error), actor_name(actor) {}
+    
+    std::string getType() const override {
+        return "Error";
+    }
+};
+
+struct ShutdownMessage : public Message {
+    std::string getType() const override {
+        return "Shutdown";
+    }
+};
+
+// Базовый Actor
+class Actor {
+protected:
+    std::string name_;
+    std::queue<MessagePtr> mailbox_;
+    std::mutex mailbox_mutex_;
+    std::condition_variable condition_;
+    std::atomic<bool> running_{true};
+    bool verbose_;  // Печатать запуск и остановку актора
+    std::thread worker_thread_;
+    
+public:
+    explicit Actor(const std::string& name, bool verbose = true) : name_(name), verbose_(verbose) {
+        worker_thread_ = std::thread([this]() { messageLoop(); });
+        if (verbose_) {
+            std::cout << "Actor " << name_ << " создан" << std::endl;
+        }
+    }
+    
+    virtual ~Actor() {
+        shutdown();
+    }
+    
+    // Отправка сообщения
+    void send(MessagePtr message) {
+        {
+            std::lock_guard<std::mutex> lock(mailbox_mutex_);
+            mailbox_.push(std::move(message));
+        }
+        condition_.notify_one();
+    }
+    
+    // Получение имени актора
+    const std::string& getName() const {
+        return name_;
+    }
+    
+    // Graceful shutdown
+    void shutdown() {
+        if (!running_.load()) {
+            // Актор мог остановиться сам по ShutdownMessage: поток всё равно нужно дождаться
+            if (worker_thread_.joinable()) {
+                worker_thread_.join();
+            }
+            return;
+        }
+        
+        if (verbose_) {
+            std::cout << "Останавливаем Actor " << name_ << std::endl;
+        }
+        
+        // Отправляем сообщение о завершении
+        send(cpp_patterns::makeIntrusive<ShutdownMessage>());
+        
+        running_.store(false);
+        condition_.notify_all();
+        
+        if (worker_thread_.joinable()) {
+            worker_thread_.join();
+        }
+        
+        if (verbose_) {
+            std::cout << "Actor " << name_ << " остановлен" << std::endl;
+        }
+    }
+    
+protected:
+    // Основной цикл обработки сообщений. Не виртуальный: поток стартует в
+    // конструкторе Actor, пока конструктор наследника ещё пишет vptr
+    void messageLoop() {
+        if (verbose_) {
+            std::cout << "Actor " << name_ << " запущен" << std::endl;
+        }
+        
+        while (running_.load()) {
+            MessagePtr message;
+            
+            {
+                std::unique_lock<std::mutex> lock(mailbox_mutex_);
+                condition_.wait(lock, [this] { 
+                    return !mailbox_.empty() || !running_.load(); 
+                });
+                
+                if (!running_.load()) break;
+                
+                if (!mailbox_.empty()) {
+                    message = std::move(mailbox_.front());
+                    mailbox_.pop();
+                }
+            }
+            
+            if (message) {
+                try {
+                    handleMessage(message.borrow());
+                } catch (const std::exception& e) {
+                    std::cerr << "Ошибка в Actor " << name_ << ": " << e.what() << std::endl;
+                    handleError(e);
+                }
+            }
+        }
+        
+        if (verbose_) {
+            std::cout << "Actor " << name_ << " завершил работу" << std::endl;
+        }
+    }
+    
+    // Обработка сообщений (переопределяется в наследниках)
+    virtual void handleMessage(cpp_patterns::BorrowedPtr<Message> message) = 0;
+    
+    // Обработка ошибок
+    virtual void handleError(const std::exception& e) {
+        std::cerr << "Actor " << name_ << " обработал ошибку: " << e.what() << std::endl;
+    }
+};
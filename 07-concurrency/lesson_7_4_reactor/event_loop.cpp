@@ -4,9 +4,10 @@
  * 
  * Реализован Event Loop с поддержкой:
  * - Основной цикл обработки событий
- * - Интеграция с epoll/select
+ * - Интеграция с epoll (eventfd для пробуждения из других потоков)
  * - Обработка таймеров
  * - Управление жизненным циклом
+ * - Корутины C++20: co_await socket.read/write, loop.sleepFor, loop.post
  */
 
 #include <iostream>
@@ -21,12 +22,25 @@
 #include <atomic>
 #include <chrono>
 #include <set>
-#include <sys/select.h>
+#include <unordered_set>
+#include <array>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
 
+#include "buffer_chain.h"
+
 // Типы событий
 enum class EventType {
     READ,
@@ -55,12 +69,12 @@ struct Event {
 
 // Timer событие
 struct TimerEvent {
-    std::chrono::system_clock::time_point when;
+    std::chrono::steady_clock::time_point when;
     std::function<void()> callback;
     bool repeat;
     std::chrono::milliseconds interval;
     
-    TimerEvent(std::chrono::system_clock::time_point time, 
+    TimerEvent(std::chrono::steady_clock::time_point time, 
                std::function<void()> cb, 
                bool is_repeat = false,
                std::chrono::milliseconds repeat_interval = std::chrono::milliseconds(0))
@@ -71,13 +85,125 @@ struct TimerEvent {
     }
 };
 
-// Event Loop
+// Корутины (C++20): при сборке как C++17 файл работает без них
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define CPP_PATTERNS_HAS_COROUTINES 1
+#endif
+
+#ifdef CPP_PATTERNS_HAS_COROUTINES
+/**
+ * @brief Переиспользуемые блоки для кадров корутин
+ *
+ * Каждая корутина - кадр в куче, а сессия на соединение создаёт и уничтожает
+ * их постоянно. Блоки не возвращаются в malloc, а копятся в списках свободных
+ * блоков по классам размера (шаг 64 байта). Списки thread_local: кадры
+ * создаёт и освобождает поток цикла, блокировки не нужны.
+ */
+class FramePool {
+public:
+    static constexpr size_t kGranularity = 64;
+    static constexpr size_t kClasses = 128;  // кадры до 8 KB
+    static constexpr size_t kMaxCachedPerClass = 1024;
+    
+    static void* allocate(size_t size) {
+        size_t size_class = classFor(size);
+        if (size_class < kClasses) {
+            Cache& cache = threadCache();
+            if (FreeBlock* block = cache.heads[size_class]) {
+                cache.heads[size_class] = block->next;
+                --cache.counts[size_class];
+                return block;
+            }
+            heap_allocations_.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new((size_class + 1) * kGranularity);
+        }
+        heap_allocations_.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+    
+    static void deallocate(void* frame, size_t size) noexcept {
+        size_t size_class = classFor(size);
+        if (size_class < kClasses) {
+            Cache& cache = threadCache();
+            if (cache.counts[size_class] < kMaxCachedPerClass) {
+                auto* block = static_cast<FreeBlock*>(frame);
+                block->next = cache.heads[size_class];
+                cache.heads[size_class] = block;
+                ++cache.counts[size_class];
+                return;
+            }
+        }
+        ::operator delete(frame);
+    }
+    
+    // Сколько кадров пришлось взять из кучи (остальные - из списков свободных)
+    static uint64_t heapAllocations() {
+        return heap_allocations_.load(std::memory_order_relaxed);
+    }
+    
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    
+    struct Cache {
+        std::array<FreeBlock*, kClasses> heads{};
+        std::array<size_t, kClasses> counts{};
+        
+        ~Cache() {
+            for (FreeBlock* head : heads) {
+                while (head) {
+                    FreeBlock* next = head->next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        }
+    };
+    
+    static size_t classFor(size_t size) {
+        return size == 0 ? 0 : (size - 1) / kGranularity;
+    }
+    
+    static Cache& threadCache() {
+        thread_local Cache cache;
+        return cache;
+    }
+    
+    inline static std::atomic<uint64_t> heap_allocations_{0};
+};
+
+/**
+ * @brief Корутина, ожидающая готовности fd или таймера
+ *
+ * attempt() вызывается циклом при готовности и повторяет операцию:
+ * true - операция завершена (успешно или с ошибкой), корутину можно будить;
+ * false - снова EAGAIN, ждём следующего события.
+ */
+struct IoWaiter {
+    std::coroutine_handle<> handle;
+    bool (*attempt)(IoWaiter&) = nullptr;
+    bool cancelled = false;
+};
+
+class IoTask;
+class PostAwaiter;
+class SleepAwaiter;
+#endif
+
+// Event Loop на epoll: таймеры, I/O по готовности, кастомные события и корутины
 class EventLoop {
 private:
     std::atomic<bool> running_{false};
     std::thread loop_thread_;
+    std::atomic<std::thread::id> loop_thread_id_{};
+    
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;                       // eventfd: будит epoll_wait при post/таймере из другого потока
+    std::atomic<bool> wake_pending_{false};  // не писать в eventfd, пока прошлое пробуждение не обработано
     
-    // I/O события
+    // I/O события (level-triggered, регистрируются из любого потока)
     std::unordered_map<int, std::shared_ptr<Event>> io_events_;
     std::mutex io_events_mutex_;
     
@@ -88,7 +214,17 @@ private:
     // Кастомные события
     std::queue<std::function<void()>> custom_events_;
     std::mutex custom_events_mutex_;
-    std::condition_variable custom_events_condition_;
+    bool accepting_posts_ = true;  // под custom_events_mutex_; false после завершения цикла
+    
+#ifdef CPP_PATTERNS_HAS_COROUTINES
+    // fd корутин (edge-triggered) и спящие корутины; трогает только поток цикла
+    struct CoroutineFd {
+        IoWaiter* reader = nullptr;
+        IoWaiter* writer = nullptr;
+    };
+    std::unordered_map<int, CoroutineFd> coroutine_fds_;
+    std::unordered_set<IoWaiter*> sleepers_;
+#endif
     
     // Статистика
     std::atomic<size_t> events_processed_{0};
@@ -98,11 +234,27 @@ private:
     
 public:
     EventLoop() {
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd_ < 0) {
+            throw std::runtime_error("Не удалось создать epoll");
+        }
+        wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wake_fd_ < 0) {
+            close(epoll_fd_);
+            throw std::runtime_error("Не удалось создать eventfd");
+        }
+        epoll_event wake_event{};
+        wake_event.events = EPOLLIN;
+        wake_event.data.fd = wake_fd_;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &wake_event);
+        
         std::cout << "Event Loop создан" << std::endl;
     }
     
     ~EventLoop() {
         stop();
+        close(wake_fd_);
+        close(epoll_fd_);
     }
     
     // Запуск event loop
@@ -112,6 +264,10 @@ public:
             return;
         }
         
+        {
+            std::lock_guard<std::mutex> lock(custom_events_mutex_);
+            accepting_posts_ = true;
+        }
         running_.store(true);
         loop_thread_ = std::thread([this]() { runLoop(); });
         std::cout << "Event Loop запущен" << std::endl;
@@ -123,9 +279,7 @@ public:
         
         std::cout << "Останавливаем Event Loop..." << std::endl;
         running_.store(false);
-        
-        // Уведомляем о кастомных событиях
-        custom_events_condition_.notify_all();
+        wake();
         
         if (loop_thread_.joinable()) {
             loop_thread_.join();
@@ -135,13 +289,26 @@ public:
         std::cout << "Event Loop остановлен" << std::endl;
     }
     
-    // Регистрация I/O события
+    bool isLoopThread() const {
+        return std::this_thread::get_id() == loop_thread_id_.load();
+    }
+    
+    // Регистрация I/O события: READ - ждём EPOLLIN, WRITE - EPOLLOUT (одно событие на fd)
     void registerIOEvent(int fd, EventType type, std::function<void()> callback) {
         std::lock_guard<std::mutex> lock(io_events_mutex_);
         
         auto event = std::make_shared<Event>(fd, type, std::move(callback));
+        bool known = io_events_.count(fd) > 0;
         io_events_[fd] = event;
         
+        epoll_event interest{};
+        interest.events = type == EventType::WRITE ? EPOLLOUT : EPOLLIN;
+        interest.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, known ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &interest) < 0) {
+            io_events_.erase(fd);
+            throw std::runtime_error("epoll_ctl: не удалось зарегистрировать fd=" + std::to_string(fd));
+        }
+        
         std::cout << "Зарегистрировано I/O событие для fd=" << fd 
                   << ", тип=" << static_cast<int>(type) << std::endl;
     }
@@ -153,6 +320,7 @@ public:
         auto it = io_events_.find(fd);
         if (it != io_events_.end()) {
             io_events_.erase(it);
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
             std::cout << "Отменено I/O событие для fd=" << fd << std::endl;
         }
     }
@@ -161,25 +329,82 @@ public:
     void addTimerEvent(std::chrono::milliseconds delay, 
                       std::function<void()> callback,
                       bool repeat = false) {
-        auto when = std::chrono::system_clock::now() + delay;
-        
-        std::lock_guard<std::mutex> lock(timer_mutex_);
-        timer_queue_.emplace(when, std::move(callback), repeat, delay);
-        
+        scheduleTimer(delay, std::move(callback), repeat);
         std::cout << "Добавлено timer событие через " << delay.count() << " мс" << std::endl;
     }
     
     // Добавление кастомного события
     void postCustomEvent(std::function<void()> callback) {
-        {
-            std::lock_guard<std::mutex> lock(custom_events_mutex_);
-            custom_events_.push(std::move(callback));
-        }
-        custom_events_condition_.notify_one();
-        
+        enqueue(std::move(callback));
         std::cout << "Добавлено кастомное событие" << std::endl;
     }
     
+#ifdef CPP_PATTERNS_HAS_COROUTINES
+    /**
+     * @brief co_await loop.post() - продолжить корутину на потоке цикла
+     */
+    PostAwaiter post();
+    
+    /**
+     * @brief co_await loop.sleepFor(d) - таймер без блокировки потока; false при остановке цикла
+     */
+    SleepAwaiter sleepFor(std::chrono::milliseconds delay);
+    
+    /**
+     * @brief Запустить корутину на потоке цикла; кадр освобождается по её завершении
+     */
+    void spawn(IoTask task);
+    
+    // Низкоуровневый интерфейс для awaitable-объектов (только поток цикла)
+    void attach(int fd) {
+        if (!isLoopThread()) {
+            throw std::logic_error("EventLoop::attach: вызов не из потока цикла");
+        }
+        epoll_event interest{};
+        interest.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        interest.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &interest) < 0) {
+            throw std::runtime_error("epoll_ctl: не удалось подключить fd=" + std::to_string(fd));
+        }
+        coroutine_fds_[fd] = CoroutineFd{};
+    }
+    
+    void detach(int fd) {
+        coroutine_fds_.erase(fd);
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    }
+    
+    // Усыпить корутину до готовности fd; false - цикл останавливается, операция отменена
+    bool park(int fd, bool for_write, IoWaiter& waiter) {
+        auto it = coroutine_fds_.find(fd);
+        if (!running_.load() || it == coroutine_fds_.end()) {
+            waiter.cancelled = true;
+            return false;
+        }
+        (for_write ? it->second.writer : it->second.reader) = &waiter;
+        return true;
+    }
+    
+    bool parkTimer(std::chrono::milliseconds delay, IoWaiter& waiter) {
+        if (!running_.load()) {
+            waiter.cancelled = true;
+            return false;
+        }
+        sleepers_.insert(&waiter);
+        scheduleTimer(delay, [this, &waiter]() {
+            if (sleepers_.erase(&waiter)) {
+                waiter.handle.resume();
+            }
+        }, false);
+        return true;
+    }
+    
+    // Продолжить корутину на потоке цикла; false - цикл уже завершён
+    bool schedule(std::coroutine_handle<> handle) {
+        return enqueue([handle]() { handle.resume(); });
+    }
+#endif
+    
     // Получение статистики
     void printStats() const {
         std::cout << "\n=== Event Loop Statistics ===" << std::endl;
@@ -191,40 +416,85 @@ public:
     }
     
 private:
+    bool enqueue(std::function<void()> callback) {
+        {
+            std::lock_guard<std::mutex> lock(custom_events_mutex_);
+            if (!accepting_posts_) {
+                return false;
+            }
+            custom_events_.push(std::move(callback));
+        }
+        if (!isLoopThread()) {
+            wake();
+        }
+        return true;
+    }
+    
+    void scheduleTimer(std::chrono::milliseconds delay, std::function<void()> callback, bool repeat) {
+        auto when = std::chrono::steady_clock::now() + delay;
+        {
+            std::lock_guard<std::mutex> lock(timer_mutex_);
+            timer_queue_.emplace(when, std::move(callback), repeat, delay);
+        }
+        if (!isLoopThread()) {
+            wake();
+        }
+    }
+    
+    void wake() {
+        if (!wake_pending_.exchange(true)) {
+            uint64_t one = 1;
+            ssize_t written = write(wake_fd_, &one, sizeof(one));
+            (void)written;
+        }
+    }
+    
     void runLoop() {
+        loop_thread_id_.store(std::this_thread::get_id());
         std::cout << "Event Loop начал работу" << std::endl;
         
+        std::array<epoll_event, 128> ready;
         while (running_.load()) {
             try {
-                // 1. Обрабатываем timer события
-                processTimerEvents();
-                
-                // 2. Обрабатываем I/O события
-                processIOEvents();
+                // 1. Обрабатываем timer события; узнаём, сколько можно спать
+                int timeout_ms = processTimerEvents();
                 
-                // 3. Обрабатываем кастомные события
-                processCustomEvents();
+                // 2. Обрабатываем кастомные события
+                if (processCustomEvents()) {
+                    timeout_ms = 0;  // во время обработки добавились новые
+                }
                 
-                // Небольшая пауза для предотвращения busy waiting
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                // 3. Ждём I/O до ближайшего таймера (или пробуждения через eventfd)
+                int count = epoll_wait(epoll_fd_, ready.data(), static_cast<int>(ready.size()), timeout_ms);
+                if (count < 0) {
+                    if (errno == EINTR) continue;
+                    throw std::runtime_error(std::string("epoll_wait: ") + strerror(errno));
+                }
+                processIOEvents(ready.data(), static_cast<size_t>(count));
                 
             } catch (const std::exception& e) {
                 std::cerr << "Ошибка в Event Loop: " << e.what() << std::endl;
             }
         }
         
+        finishLoop();
         std::cout << "Event Loop завершил работу" << std::endl;
     }
     
-    void processTimerEvents() {
-        std::lock_guard<std::mutex> lock(timer_mutex_);
-        
-        auto now = std::chrono::system_clock::now();
+    // Возвращает таймаут epoll_wait в мс до следующего таймера (-1 - таймеров нет)
+    int processTimerEvents() {
+        auto now = std::chrono::steady_clock::now();
+        std::vector<TimerEvent> due;
+        {
+            std::lock_guard<std::mutex> lock(timer_mutex_);
+            while (!timer_queue_.empty() && timer_queue_.top().when <= now) {
+                due.push_back(timer_queue_.top());
+                timer_queue_.pop();
+            }
+        }
         
-        while (!timer_queue_.empty() && timer_queue_.top().when <= now) {
-            auto timer_event = timer_queue_.top();
-            timer_queue_.pop();
-            
+        // Колбэки выполняются без блокировки: они могут добавлять таймеры
+        for (auto& timer_event : due) {
             try {
                 timer_event.callback();
                 timer_events_processed_.fetch_add(1);
@@ -232,32 +502,56 @@ private:
                 
                 // Если повторяющийся timer, добавляем обратно
                 if (timer_event.repeat) {
-                    auto next_time = now + timer_event.interval;
-                    timer_queue_.emplace(next_time, timer_event.callback, 
-                                       timer_event.repeat, timer_event.interval);
+                    std::lock_guard<std::mutex> lock(timer_mutex_);
+                    timer_queue_.emplace(now + timer_event.interval, std::move(timer_event.callback),
+                                         timer_event.repeat, timer_event.interval);
                 }
                 
             } catch (const std::exception& e) {
                 std::cerr << "Ошибка в timer событии: " << e.what() << std::endl;
             }
         }
+        
+        std::lock_guard<std::mutex> lock(timer_mutex_);
+        if (timer_queue_.empty()) {
+            return -1;
+        }
+        auto wait = std::chrono::ceil<std::chrono::milliseconds>(timer_queue_.top().when - std::chrono::steady_clock::now());
+        return static_cast<int>(std::max<std::chrono::milliseconds::rep>(0, wait.count()));
     }
     
-    void processIOEvents() {
-        std::lock_guard<std::mutex> lock(io_events_mutex_);
-        
-        if (io_events_.empty()) return;
-        
-        // Простая имитация select() для демонстрации
-        for (auto& pair : io_events_) {
-            auto& event = pair.second;
+    void processIOEvents(const epoll_event* ready, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            int fd = ready[i].data.fd;
+            uint32_t flags = ready[i].events;
             
-            // Имитируем готовность к чтению/записи
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            static std::uniform_int_distribution<> dis(1, 100);
+            if (fd == wake_fd_) {
+                uint64_t value;
+                ssize_t drained = read(wake_fd_, &value, sizeof(value));
+                (void)drained;
+                wake_pending_.store(false);
+                continue;
+            }
+            
+#ifdef CPP_PATTERNS_HAS_COROUTINES
+            auto coroutine = coroutine_fds_.find(fd);
+            if (coroutine != coroutine_fds_.end()) {
+                resumeReady(coroutine->second, flags);
+                continue;
+            }
+#endif
+            
+            std::shared_ptr<Event> event;
+            {
+                std::lock_guard<std::mutex> lock(io_events_mutex_);
+                auto it = io_events_.find(fd);
+                if (it != io_events_.end()) {
+                    event = it->second;
+                }
+            }
             
-            if (dis(gen) <= 5) { // 5% вероятность готовности
+            // Колбэк вызывается без блокировки: он может перерегистрировать или удалить fd
+            if (event) {
                 try {
                     event->callback();
                     io_events_processed_.fetch_add(1);
@@ -269,43 +563,397 @@ private:
         }
     }
     
-    void processCustomEvents() {
-        std::unique_lock<std::mutex> lock(custom_events_mutex_);
+    // true - в очереди остались события, добавленные во время обработки
+    bool processCustomEvents() {
+        std::queue<std::function<void()>> batch;
+        {
+            std::lock_guard<std::mutex> lock(custom_events_mutex_);
+            std::swap(batch, custom_events_);
+        }
         
-        // Ждем события с таймаутом
-        if (custom_events_condition_.wait_for(lock, std::chrono::milliseconds(10),
-            [this] { return !custom_events_.empty() || !running_.load(); })) {
+        while (!batch.empty()) {
+            auto callback = std::move(batch.front());
+            batch.pop();
             
-            while (!custom_events_.empty()) {
-                auto callback = custom_events_.front();
-                custom_events_.pop();
-                
-                lock.unlock();
-                
-                try {
-                    callback();
-                    custom_events_processed_.fetch_add(1);
-                    events_processed_.fetch_add(1);
-                } catch (const std::exception& e) {
-                    std::cerr << "Ошибка в кастомном событии: " << e.what() << std::endl;
+            try {
+                callback();
+                custom_events_processed_.fetch_add(1);
+                events_processed_.fetch_add(1);
+            } catch (const std::exception& e) {
+                std::cerr << "Ошибка в кастомном событии: " << e.what() << std::endl;
+            }
+        }
+        
+        std::lock_guard<std::mutex> lock(custom_events_mutex_);
+        return !custom_events_.empty();
+    }
+    
+#ifdef CPP_PATTERNS_HAS_COROUTINES
+    void resumeReady(CoroutineFd& entry, uint32_t flags) {
+        std::array<IoWaiter*, 2> ready{};
+        size_t count = 0;
+        
+        constexpr uint32_t kFailure = EPOLLERR | EPOLLHUP;
+        if (entry.reader && (flags & (EPOLLIN | EPOLLRDHUP | kFailure)) && entry.reader->attempt(*entry.reader)) {
+            ready[count++] = std::exchange(entry.reader, nullptr);
+        }
+        if (entry.writer && (flags & (EPOLLOUT | kFailure)) && entry.writer->attempt(*entry.writer)) {
+            ready[count++] = std::exchange(entry.writer, nullptr);
+        }
+        
+        // entry может исчезнуть после resume (корутина закрыла сокет) - больше его не трогаем
+        for (size_t i = 0; i < count; ++i) {
+            io_events_processed_.fetch_add(1);
+            events_processed_.fetch_add(1);
+            ready[i]->handle.resume();
+        }
+    }
+#endif
+    
+    // Остановка: выполняем оставшиеся события, ожидающие корутины будим с отменой
+    void finishLoop() {
+        bool progress = true;
+        while (progress) {
+            processCustomEvents();
+            progress = false;
+#ifdef CPP_PATTERNS_HAS_COROUTINES
+            IoWaiter* waiter = nullptr;
+            for (auto& [fd, entry] : coroutine_fds_) {
+                if (entry.reader || entry.writer) {
+                    waiter = entry.reader ? std::exchange(entry.reader, nullptr) : std::exchange(entry.writer, nullptr);
+                    break;
                 }
-                
-                lock.lock();
             }
+            if (!waiter && !sleepers_.empty()) {
+                waiter = *sleepers_.begin();
+                sleepers_.erase(sleepers_.begin());
+            }
+            if (waiter) {
+                waiter->cancelled = true;
+                waiter->handle.resume();
+                progress = true;
+            }
+#endif
+            std::lock_guard<std::mutex> lock(custom_events_mutex_);
+            if (!custom_events_.empty()) {
+                progress = true;
+            } else if (!progress) {
+                accepting_posts_ = false;
+            }
+        }
+    }
+};
+
+#ifdef CPP_PATTERNS_HAS_COROUTINES
+// ============================================================================
+// КОРУТИНЫ ПОВЕРХ EVENT LOOP
+// ============================================================================
+
+/**
+ * @brief Корутина без результата для кода на Event Loop
+ *
+ * Ленивая: стартует при co_await (вложенный вызов, исключение пробрасывается
+ * ожидающему) или через EventLoop::spawn (отсоединённая, кадр освобождается
+ * сам по завершении). Кадры берутся из FramePool.
+ */
+class IoTask {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+    
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle finished) noexcept;
+        void await_resume() const noexcept {}
+    };
+    
+    struct promise_type {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr error;
+        bool detached = false;
+        
+        IoTask get_return_object() { return IoTask(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+        
+        static void* operator new(size_t size) { return FramePool::allocate(size); }
+        static void operator delete(void* frame, size_t size) noexcept { FramePool::deallocate(frame, size); }
+    };
+    
+    IoTask(IoTask&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    IoTask& operator=(IoTask&&) = delete;
+    
+    ~IoTask() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+    
+    // co_await task: симметричная передача управления в дочернюю корутину и обратно
+    bool await_ready() const noexcept { return false; }
+    
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle_.promise().continuation = awaiting;
+        return handle_;
+    }
+    
+    void await_resume() const {
+        if (handle_.promise().error) {
+            std::rethrow_exception(handle_.promise().error);
         }
     }
+    
+    Handle release() noexcept {
+        return std::exchange(handle_, {});
+    }
+    
+private:
+    explicit IoTask(Handle handle) : handle_(handle) {}
+    
+    Handle handle_;
 };
 
+inline std::coroutine_handle<> IoTask::FinalAwaiter::await_suspend(Handle finished) noexcept {
+    promise_type& promise = finished.promise();
+    if (promise.continuation) {
+        return promise.continuation;
+    }
+    if (promise.detached) {
+        if (promise.error) {
+            try {
+                std::rethrow_exception(promise.error);
+            } catch (const std::exception& e) {
+                std::cerr << "Ошибка в корутине: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "Неизвестная ошибка в корутине" << std::endl;
+            }
+        }
+        finished.destroy();
+    }
+    return std::noop_coroutine();
+}
+
+// Результат операций сокета: >= 0 - байты (или fd для accept), < 0 - -errno
+// (-ECANCELED, если цикл остановлен во время ожидания)
+
+// co_await socket.read(buf, n): сразу пробуем read(), засыпаем только при EAGAIN
+class ReadAwaiter : public IoWaiter {
+public:
+    ReadAwaiter(EventLoop& loop, int fd, void* buffer, size_t size)
+        : loop_(loop), fd_(fd), buffer_(buffer), size_(size) {
+        attempt = &tryRead;
+    }
+    
+    bool await_ready() { return tryRead(*this); }
+    
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        handle = awaiting;
+        return loop_.park(fd_, false, *this);
+    }
+    
+    ssize_t await_resume() const { return cancelled ? -ECANCELED : result_; }
+    
+private:
+    static bool tryRead(IoWaiter& waiter) {
+        auto& self = static_cast<ReadAwaiter&>(waiter);
+        ssize_t received;
+        do {
+            received = ::read(self.fd_, self.buffer_, self.size_);
+        } while (received < 0 && errno == EINTR);
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return false;
+        }
+        self.result_ = received < 0 ? -errno : received;
+        return true;
+    }
+    
+    EventLoop& loop_;
+    int fd_;
+    void* buffer_;
+    size_t size_;
+    ssize_t result_ = 0;
+};
+
+// co_await socket.write(data, n): отправляет всё, засыпая при заполненном буфере сокета
+class WriteAwaiter : public IoWaiter {
+public:
+    WriteAwaiter(EventLoop& loop, int fd, const void* data, size_t size)
+        : loop_(loop), fd_(fd), data_(static_cast<const char*>(data)), size_(size) {
+        attempt = &tryWrite;
+    }
+    
+    bool await_ready() { return tryWrite(*this); }
+    
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        handle = awaiting;
+        return loop_.park(fd_, true, *this);
+    }
+    
+    ssize_t await_resume() const { return cancelled ? -ECANCELED : result_; }
+    
+private:
+    static bool tryWrite(IoWaiter& waiter) {
+        auto& self = static_cast<WriteAwaiter&>(waiter);
+        while (self.written_ < self.size_) {
+            // MSG_NOSIGNAL: закрытый клиент даёт EPIPE, а не SIGPIPE
+            ssize_t sent = ::send(self.fd_, self.data_ + self.written_, self.size_ - self.written_, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+                self.result_ = -errno;
+                return true;
+            }
+            self.written_ += static_cast<size_t>(sent);
+        }
+        self.result_ = static_cast<ssize_t>(self.written_);
+        return true;
+    }
+    
+    EventLoop& loop_;
+    int fd_;
+    const char* data_;
+    size_t size_;
+    size_t written_ = 0;
+    ssize_t result_ = 0;
+};
+
+// co_await listener.accept(): новый неблокирующий fd
+class AcceptAwaiter : public IoWaiter {
+public:
+    AcceptAwaiter(EventLoop& loop, int fd) : loop_(loop), fd_(fd) {
+        attempt = &tryAccept;
+    }
+    
+    bool await_ready() { return tryAccept(*this); }
+    
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        handle = awaiting;
+        return loop_.park(fd_, false, *this);
+    }
+    
+    int await_resume() const { return cancelled ? -ECANCELED : result_; }
+    
+private:
+    static bool tryAccept(IoWaiter& waiter) {
+        auto& self = static_cast<AcceptAwaiter&>(waiter);
+        int client;
+        do {
+            client = accept4(self.fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        } while (client < 0 && (errno == EINTR || errno == ECONNABORTED));
+        if (client < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return false;
+        }
+        self.result_ = client < 0 ? -errno : client;
+        return true;
+    }
+    
+    EventLoop& loop_;
+    int fd_;
+    int result_ = -1;
+};
+
+class PostAwaiter {
+public:
+    explicit PostAwaiter(EventLoop& loop) : loop_(loop) {}
+    
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> awaiting) { return loop_.schedule(awaiting); }
+    void await_resume() const noexcept {}
+    
+private:
+    EventLoop& loop_;
+};
+
+class SleepAwaiter : public IoWaiter {
+public:
+    SleepAwaiter(EventLoop& loop, std::chrono::milliseconds delay) : loop_(loop), delay_(delay) {}
+    
+    bool await_ready() const noexcept { return delay_.count() <= 0; }
+    
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        handle = awaiting;
+        return loop_.parkTimer(delay_, *this);
+    }
+    
+    bool await_resume() const noexcept { return !cancelled; }
+    
+private:
+    EventLoop& loop_;
+    std::chrono::milliseconds delay_;
+};
+
+/**
+ * @brief Неблокирующий сокет, которым владеет корутина
+ *
+ * Создаётся и используется на потоке цикла; fd регистрируется в epoll один
+ * раз (edge-triggered), поэтому ожидание не стоит лишних epoll_ctl.
+ */
+class CoSocket {
+public:
+    CoSocket(EventLoop& loop, int fd) : loop_(loop), fd_(fd) {
+        try {
+            loop_.attach(fd_);
+        } catch (...) {
+            ::close(fd_);
+            throw;
+        }
+    }
+    
+    ~CoSocket() {
+        loop_.detach(fd_);
+        ::close(fd_);
+    }
+    
+    CoSocket(const CoSocket&) = delete;
+    CoSocket& operator=(const CoSocket&) = delete;
+    
+    ReadAwaiter read(void* buffer, size_t size) { return ReadAwaiter(loop_, fd_, buffer, size); }
+    WriteAwaiter write(const void* data, size_t size) { return WriteAwaiter(loop_, fd_, data, size); }
+    AcceptAwaiter accept() { return AcceptAwaiter(loop_, fd_); }
+    
+    int fd() const { return fd_; }
+    
+private:
+    EventLoop& loop_;
+    int fd_;
+};
+
+inline PostAwaiter EventLoop::post() {
+    return PostAwaiter(*this);
+}
+
+inline SleepAwaiter EventLoop::sleepFor(std::chrono::milliseconds delay) {
+    return SleepAwaiter(*this, delay);
+}
+
+inline void EventLoop::spawn(IoTask task) {
+    IoTask::Handle handle = task.release();
+    handle.promise().detached = true;
+    if (!schedule(handle)) {
+        handle.destroy();  // цикл завершён - корутина так и не стартует
+    }
+}
+#endif
+
 // Простой TCP сервер для демонстрации
 class TCPServer {
 private:
+    // Буферы соединения из слабов пула; доступ только из потока цикла
+    struct Connection {
+        cpp_patterns::ReadBuffer input;
+        cpp_patterns::BufferChain output;
+    };
+    
     int server_fd_;
     int port_;
     EventLoop& event_loop_;
     std::atomic<bool> running_{false};
+    std::unordered_map<int, Connection> connections_;
     
 public:
-    TCPServer(int port, EventLoop& loop) : port_(port), event_loop_(loop), server_fd_(-1) {}
+    TCPServer(int port, EventLoop& loop) : server_fd_(-1), port_(port), event_loop_(loop) {}
     
     ~TCPServer() {
         stop();
@@ -348,6 +996,7 @@ public:
         std::cout << "TCP сервер запущен на порту " << port_ << std::endl;
     }
     
+    // Вызывать после остановки цикла: соединения меняет только его поток
     void stop() {
         if (!running_.load()) return;
         
@@ -358,6 +1007,11 @@ public:
             close(server_fd_);
             server_fd_ = -1;
         }
+        for (auto& [fd, connection] : connections_) {
+            event_loop_.unregisterIOEvent(fd);
+            close(fd);
+        }
+        connections_.clear();
         
         std::cout << "TCP сервер остановлен" << std::endl;
     }
@@ -376,32 +1030,75 @@ private:
             int flags = fcntl(client_fd, F_GETFL, 0);
             fcntl(client_fd, F_SETFL, flags | O_NONBLOCK);
             
-            // Регистрируем событие чтения для клиента
-            event_loop_.registerIOEvent(client_fd, EventType::READ,
-                [this, client_fd]() { handleClientData(client_fd); });
+            connections_[client_fd];
+            watchRead(client_fd);
         }
     }
     
+    // Ответ один на все соединения: в цепочку попадает ссылка, а не копия
+    static const cpp_patterns::IntrusivePtr<cpp_patterns::SharedPayload>& response() {
+        static const auto payload = cpp_patterns::makeIntrusive<cpp_patterns::SharedPayload>(
+            "HTTP/1.1 200 OK\r\n\r\nHello from Event Loop!");
+        return payload;
+    }
+    
+    void watchRead(int client_fd) {
+        event_loop_.registerIOEvent(client_fd, EventType::READ,
+            [this, client_fd]() { handleClientData(client_fd); });
+    }
+    
     void handleClientData(int client_fd) {
-        char buffer[1024];
-        ssize_t bytes_read = read(client_fd, buffer, sizeof(buffer) - 1);
+        Connection& connection = connections_[client_fd];
+        cpp_patterns::BufferSlice request;
+        ssize_t bytes_read = connection.input.readFrom(client_fd, request);
         
         if (bytes_read > 0) {
-            buffer[bytes_read] = '\0';
             std::cout << "Получены данные от клиента " << client_fd 
-                      << ": " << buffer << std::endl;
+                      << ": " << request.view() << std::endl;
             
             // Отправляем ответ
-            std::string response = "HTTP/1.1 200 OK\r\n\r\nHello from Event Loop!";
-            write(client_fd, response.c_str(), response.length());
+            connection.output.append(response());
+            flush(client_fd, connection);
             
-        } else if (bytes_read == 0) {
+        } else if (bytes_read == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
             // Соединение закрыто клиентом
             std::cout << "Клиент " << client_fd << " отключился" << std::endl;
-            event_loop_.unregisterIOEvent(client_fd);
-            close(client_fd);
+            closeConnection(client_fd);
+        }
+    }
+    
+    // writev всей цепочки; неотправленный хвост ждёт готовности на запись
+    void flush(int client_fd, Connection& connection) {
+        while (!connection.output.empty()) {
+            ssize_t sent = connection.output.sendTo(client_fd);
+            if (sent < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    closeConnection(client_fd);
+                    return;
+                }
+                event_loop_.registerIOEvent(client_fd, EventType::WRITE,
+                    [this, client_fd]() { handleClientWrite(client_fd); });
+                return;
+            }
         }
     }
+    
+    void handleClientWrite(int client_fd) {
+        auto it = connections_.find(client_fd);
+        if (it == connections_.end()) return;
+        flush(client_fd, it->second);
+        // flush мог закрыть соединение: ищем заново
+        it = connections_.find(client_fd);
+        if (it != connections_.end() && it->second.output.empty()) {
+            watchRead(client_fd);
+        }
+    }
+    
+    void closeConnection(int client_fd) {
+        event_loop_.unregisterIOEvent(client_fd);
+        connections_.erase(client_fd);
+        close(client_fd);
+    }
 };
 
 // Демонстрация базового Event Loop
@@ -452,6 +1149,8 @@ void demonstrateTCPServer() {
         // Работаем 5 секунд
         std::this_thread::sleep_for(std::chrono::seconds(5));
         
+        // Соединения принадлежат потоку цикла: сначала останавливаем его
+        loop.stop();
         server.stop();
     } catch (const std::exception& e) {
         std::cerr << "Ошибка сервера: " << e.what() << std::endl;
@@ -467,25 +1166,317 @@ void demonstrateCombinedEvents() {
     EventLoop loop;
     loop.start();
     
-    int counter = 0;
+    std::atomic<int> counter{0};  // читается из main, пока цикл работает
     
     // Timer, который добавляет кастомные события
     loop.addTimerEvent(std::chrono::milliseconds(1000), [&loop, &counter]() {
         std::cout << "Timer добавляет кастомное событие" << std::endl;
         
         loop.postCustomEvent([&counter]() {
-            counter++;
-            std::cout << "Кастомное событие выполнено, счетчик: " << counter << std::endl;
+            int value = ++counter;
+            std::cout << "Кастомное событие выполнено, счетчик: " << value << std::endl;
         });
     }, true);
     
     // Работаем 3 секунды
     std::this_thread::sleep_for(std::chrono::seconds(3));
     
-    std::cout << "Итоговый счетчик: " << counter << std::endl;
+    std::cout << "Итоговый счетчик: " << counter.load() << std::endl;
     loop.stop();
 }
 
+// ============================================================================
+// ECHO-СЕРВЕРЫ: КОЛБЭКИ ПРОТИВ КОРУТИН
+// ============================================================================
+
+// Неблокирующий слушающий сокет на 127.0.0.1 (port = 0 - любой свободный)
+int createListener(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Не удалось создать сокет");
+    }
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(fd, 128) < 0) {
+        close(fd);
+        throw std::runtime_error("Не удалось привязать сокет");
+    }
+    return fd;
+}
+
+uint16_t localPort(int fd) {
+    sockaddr_in address{};
+    socklen_t length = sizeof(address);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+    return ntohs(address.sin_port);
+}
+
+// Echo на колбэках: состояние соединения живёт между handleRead/handleWrite
+class CallbackEchoServer {
+private:
+    struct Connection {
+        std::string pending;  // не отправленный из-за EAGAIN хвост
+        size_t offset = 0;
+    };
+    
+    EventLoop& loop_;
+    int listen_fd_;
+    std::unordered_map<int, Connection> connections_;  // только поток цикла
+    
+public:
+    CallbackEchoServer(EventLoop& loop, int listen_fd) : loop_(loop), listen_fd_(listen_fd) {
+        loop_.registerIOEvent(listen_fd_, EventType::READ, [this]() { acceptAll(); });
+    }
+    
+    // Вызывать после остановки цикла
+    ~CallbackEchoServer() {
+        for (auto& [fd, connection] : connections_) {
+            close(fd);
+        }
+        close(listen_fd_);
+    }
+    
+private:
+    void acceptAll() {
+        int fd;
+        while ((fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+            connections_[fd];
+            watchRead(fd);
+        }
+    }
+    
+    void watchRead(int fd) {
+        loop_.registerIOEvent(fd, EventType::READ, [this, fd]() { handleRead(fd); });
+    }
+    
+    void handleRead(int fd) {
+        char buffer[4096];
+        ssize_t received = read(fd, buffer, sizeof(buffer));
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (received <= 0) {
+            closeConnection(fd);
+            return;
+        }
+        
+        ssize_t sent = send(fd, buffer, static_cast<size_t>(received), MSG_NOSIGNAL);
+        if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            closeConnection(fd);
+            return;
+        }
+        size_t done = sent < 0 ? 0 : static_cast<size_t>(sent);
+        if (done < static_cast<size_t>(received)) {
+            // Хвост ждёт готовности на запись: меняем интерес с READ на WRITE
+            Connection& connection = connections_[fd];
+            connection.pending.assign(buffer + done, static_cast<size_t>(received) - done);
+            connection.offset = 0;
+            loop_.registerIOEvent(fd, EventType::WRITE, [this, fd]() { handleWrite(fd); });
+        }
+    }
+    
+    void handleWrite(int fd) {
+        Connection& connection = connections_[fd];
+        while (connection.offset < connection.pending.size()) {
+            ssize_t sent = send(fd, connection.pending.data() + connection.offset,
+                                connection.pending.size() - connection.offset, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+                closeConnection(fd);
+                return;
+            }
+            connection.offset += static_cast<size_t>(sent);
+        }
+        connection.pending.clear();
+        watchRead(fd);
+    }
+    
+    void closeConnection(int fd) {
+        loop_.unregisterIOEvent(fd);
+        connections_.erase(fd);
+        close(fd);
+    }
+};
+
+#ifdef CPP_PATTERNS_HAS_COROUTINES
+// Echo на корутинах: та же логика - прямой код, состояние в локальных переменных
+IoTask echoSession(EventLoop& loop, int fd) {
+    CoSocket socket(loop, fd);
+    char buffer[4096];
+    
+    while (true) {
+        ssize_t received = co_await socket.read(buffer, sizeof(buffer));
+        if (received <= 0) {
+            co_return;  // клиент закрыл соединение, ошибка или остановка цикла
+        }
+        if (co_await socket.write(buffer, static_cast<size_t>(received)) < 0) {
+            co_return;
+        }
+    }
+}
+
+IoTask acceptLoop(EventLoop& loop, int listen_fd) {
+    CoSocket listener(loop, listen_fd);
+    
+    while (true) {
+        int client = co_await listener.accept();
+        if (client < 0) {
+            co_return;
+        }
+        loop.spawn(echoSession(loop, client));
+    }
+}
+#endif
+
+// Нагрузка: clients потоков, у каждого своё соединение и requests запросов «запрос-ответ»
+double runEchoClients(uint16_t port, size_t clients, size_t requests, size_t message_size) {
+    std::atomic<size_t> failures{0};
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    
+    for (size_t c = 0; c < clients; ++c) {
+        threads.emplace_back([&]() {
+            int fd = socket(AF_INET, SOCK_STREAM, 0);
+            int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons(port);
+            if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+                failures.fetch_add(1);
+                close(fd);
+                return;
+            }
+            
+            std::string message(message_size, 'x');
+            std::string reply(message_size, '\0');
+            for (size_t r = 0; r < requests; ++r) {
+                if (send(fd, message.data(), message.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(message.size())) {
+                    failures.fetch_add(1);
+                    break;
+                }
+                size_t got = 0;
+                while (got < message_size) {
+                    ssize_t n = recv(fd, reply.data() + got, message_size - got, 0);
+                    if (n <= 0) break;
+                    got += static_cast<size_t>(n);
+                }
+                if (got != message_size) {
+                    failures.fetch_add(1);
+                    break;
+                }
+            }
+            close(fd);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (failures.load() > 0) {
+        std::cout << "❌ Ошибок у клиентов: " << failures.load() << std::endl;
+    }
+    return static_cast<double>(clients * requests) / seconds;
+}
+
+#ifdef CPP_PATTERNS_HAS_COROUTINES
+// Демонстрация корутин: sleepFor, post и echo без колбэков
+void demonstrateCoroutines() {
+    std::cout << "\n=== Демонстрация корутин на Event Loop ===" << std::endl;
+    
+    EventLoop loop;
+    loop.start();
+    
+    std::atomic<bool> finished{false};
+    auto ticker = [](EventLoop& loop, std::atomic<bool>& finished) -> IoTask {
+        co_await loop.post();
+        std::cout << "Корутина на потоке цикла: " << std::boolalpha << loop.isLoopThread() << std::endl;
+        for (int i = 1; i <= 3; ++i) {
+            co_await loop.sleepFor(std::chrono::milliseconds(100));
+            std::cout << "Тик корутины " << i << std::endl;
+        }
+        finished.store(true);
+    };
+    loop.spawn(ticker(loop, finished));
+    
+    int listen_fd = createListener(0);
+    uint16_t port = localPort(listen_fd);
+    loop.spawn(acceptLoop(loop, listen_fd));
+    
+    // Клиент: одно сообщение через echo-сессию
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+        const std::string message = "ping через co_await";
+        send(client, message.data(), message.size(), MSG_NOSIGNAL);
+        std::string reply(message.size(), '\0');
+        size_t got = 0;
+        while (got < reply.size()) {
+            ssize_t n = recv(client, reply.data() + got, reply.size() - got, 0);
+            if (n <= 0) break;
+            got += static_cast<size_t>(n);
+        }
+        std::cout << "Echo-ответ: " << reply.substr(0, got) << std::endl;
+    }
+    close(client);
+    
+    while (!finished.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    loop.stop();  // acceptLoop получит -ECANCELED и завершится, закрыв слушающий сокет
+}
+
+// Бенчмарк: echo на колбэках и на корутинах поверх одного и того же цикла
+void benchmarkCoroutineEcho() {
+    std::cout << "\n=== Бенчмарк echo: колбэки vs корутины ===" << std::endl;
+    
+    constexpr size_t kClients = 4;
+    constexpr size_t kRequests = 20000;
+    constexpr size_t kMessageSize = 64;
+    
+    double callback_rate = 0;
+    {
+        EventLoop loop;
+        loop.start();
+        int listen_fd = createListener(0);
+        CallbackEchoServer server(loop, listen_fd);
+        callback_rate = runEchoClients(localPort(listen_fd), kClients, kRequests, kMessageSize);
+        loop.stop();
+    }
+    
+    double coroutine_rate = 0;
+    uint64_t heap_before = FramePool::heapAllocations();
+    {
+        EventLoop loop;
+        loop.start();
+        int listen_fd = createListener(0);
+        uint16_t port = localPort(listen_fd);
+        loop.spawn(acceptLoop(loop, listen_fd));
+        
+        // Прогревочный раунд: кадры сессий второго раунда берутся из списков свободных блоков
+        runEchoClients(port, kClients, kRequests / 10, kMessageSize);
+        coroutine_rate = runEchoClients(port, kClients, kRequests, kMessageSize);
+        loop.stop();
+    }
+    
+    std::cout << "Колбэки: " << callback_rate << " запросов/с" << std::endl;
+    std::cout << "Корутины: " << coroutine_rate << " запросов/с ("
+              << 100.0 * coroutine_rate / callback_rate << "% от колбэков)" << std::endl;
+    std::cout << "Кадров корутин из кучи: " << FramePool::heapAllocations() - heap_before
+              << " на " << 2 * kClients << " сессий" << std::endl;
+}
+#endif
+
 int main() {
     std::cout << "=== Event Loop для Reactor Pattern ===" << std::endl;
     
@@ -493,6 +1484,10 @@ int main() {
         demonstrateBasicEventLoop();
         demonstrateTCPServer();
         demonstrateCombinedEvents();
+#ifdef CPP_PATTERNS_HAS_COROUTINES
+        demonstrateCoroutines();
+        benchmarkCoroutineEcho();
+#endif
     } catch (const std::exception& e) {
         std::cerr << "Ошибка: " << e.what() << std::endl;
         return 1;
@@ -1,495 +1,23 @@
 /**
  * @file reactor_pattern.cpp
  * @brief Демонстрация Reactor Pattern
- * 
+ *
  * Реализован Reactor Pattern с поддержкой:
- * - Event Loop с epoll/select
+ * - Event Loop с двумя backend'ами: epoll (готовность) и io_uring (завершение)
  * - Event Handlers для различных типов событий
  * - HTTP сервер на Reactor
  * - TCP клиент/сервер
+ * - Бенчмарк: системные вызовы на запрос для epoll и io_uring
+ * - Multi-reactor: цикл на ядро, SO_REUSEPORT и lock-free post между циклами
+ * - Буферы соединений из слабов: цепочки срезов и векторная запись
  */
 
+#include <iomanip>
 #include <iostream>
 #include <thread>
 #include <vector>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
-#include <memory>
-#include <unordered_map>
-#include <functional>
-#include <atomic>
-#include <chrono>
-#include <set>
-#include <sys/select.h>
-#include <sys/socket.h>
-#include <netinet/in.h>
-#include <unistd.h>
-#include <fcntl.h>
-#include <errno.h>
-
-// Типы событий для Reactor
-enum class ReactorEventType {
-    READ,
-    WRITE,
-    ERROR,
-    TIMEOUT
-};
-
-// Обработчик событий
-class EventHandler {
-public:
-    virtual ~EventHandler() = default;
-    virtual void handleEvent(ReactorEventType event_type) = 0;
-    virtual int getFileDescriptor() const = 0;
-    virtual std::string getName() const = 0;
-};
-
-// Reactor - основной класс для демультиплексирования событий
-class Reactor {
-private:
-    std::atomic<bool> running_{false};
-    std::thread reactor_thread_;
-    
-    // Обработчики событий
-    std::unordered_map<int, std::shared_ptr<EventHandler>> handlers_;
-    std::mutex handlers_mutex_;
-    
-    // Статистика
-    std::atomic<size_t> events_processed_{0};
-    std::atomic<size_t> read_events_{0};
-    std::atomic<size_t> write_events_{0};
-    std::atomic<size_t> error_events_{0};
-    
-    // Таймаут для select
-    struct timeval timeout_;
-    
-public:
-    Reactor() {
-        timeout_.tv_sec = 1;
-        timeout_.tv_usec = 0;
-        std::cout << "Reactor создан" << std::endl;
-    }
-    
-    ~Reactor() {
-        stop();
-    }
-    
-    // Запуск Reactor
-    void start() {
-        if (running_.load()) {
-            std::cout << "Reactor уже запущен" << std::endl;
-            return;
-        }
-        
-        running_.store(true);
-        reactor_thread_ = std::thread([this]() { runReactor(); });
-        std::cout << "Reactor запущен" << std::endl;
-    }
-    
-    // Остановка Reactor
-    void stop() {
-        if (!running_.load()) return;
-        
-        std::cout << "Останавливаем Reactor..." << std::endl;
-        running_.store(false);
-        
-        if (reactor_thread_.joinable()) {
-            reactor_thread_.join();
-        }
-        
-        printStats();
-        std::cout << "Reactor остановлен" << std::endl;
-    }
-    
-    // Регистрация обработчика событий
-    void registerHandler(std::shared_ptr<EventHandler> handler) {
-        std::lock_guard<std::mutex> lock(handlers_mutex_);
-        
-        int fd = handler->getFileDescriptor();
-        handlers_[fd] = handler;
-        
-        std::cout << "Зарегистрирован обработчик " << handler->getName() 
-                  << " для fd=" << fd << std::endl;
-    }
-    
-    // Отмена регистрации обработчика
-    void unregisterHandler(int fd) {
-        std::lock_guard<std::mutex> lock(handlers_mutex_);
-        
-        auto it = handlers_.find(fd);
-        if (it != handlers_.end()) {
-            std::cout << "Отменена регистрация обработчика для fd=" << fd << std::endl;
-            handlers_.erase(it);
-        }
-    }
-    
-    // Получение статистики
-    void printStats() const {
-        std::cout << "\n=== Reactor Statistics ===" << std::endl;
-        std::cout << "Всего событий обработано: " << events_processed_.load() << std::endl;
-        std::cout << "Read событий: " << read_events_.load() << std::endl;
-        std::cout << "Write событий: " << write_events_.load() << std::endl;
-        std::cout << "Error событий: " << error_events_.load() << std::endl;
-        std::cout << "=========================" << std::endl;
-    }
-    
-private:
-    void runReactor() {
-        std::cout << "Reactor начал работу" << std::endl;
-        
-        while (running_.load()) {
-            try {
-                // Подготавливаем наборы файловых дескрипторов
-                fd_set read_fds, write_fds, error_fds;
-                FD_ZERO(&read_fds);
-                FD_ZERO(&write_fds);
-                FD_ZERO(&error_fds);
-                
-                int max_fd = 0;
-                
-                // Добавляем файловые дескрипторы в наборы
-                {
-                    std::lock_guard<std::mutex> lock(handlers_mutex_);
-                    
-                    for (const auto& pair : handlers_) {
-                        int fd = pair.first;
-                        FD_SET(fd, &read_fds);
-                        FD_SET(fd, &write_fds);
-                        FD_SET(fd, &error_fds);
-                        
-                        if (fd > max_fd) {
-                            max_fd = fd;
-                        }
-                    }
-                }
-                
-                // Если нет обработчиков, ждем немного
-                if (max_fd == 0) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                    continue;
-                }
-                
-                // Вызываем select для демультиплексирования событий
-                int result = select(max_fd + 1, &read_fds, &write_fds, &error_fds, &timeout_);
-                
-                if (result < 0) {
-                    if (errno == EINTR) {
-                        continue; // Перехвачен сигнал, продолжаем
-                    }
-                    std::cerr << "Ошибка select: " << strerror(errno) << std::endl;
-                    break;
-                }
-                
-                if (result == 0) {
-                    // Таймаут - продолжаем работу
-                    continue;
-                }
-                
-                // Обрабатываем готовые события
-                processEvents(read_fds, write_fds, error_fds);
-                
-            } catch (const std::exception& e) {
-                std::cerr << "Ошибка в Reactor: " << e.what() << std::endl;
-            }
-        }
-        
-        std::cout << "Reactor завершил работу" << std::endl;
-    }
-    
-    void processEvents(const fd_set& read_fds, const fd_set& write_fds, const fd_set& error_fds) {
-        std::lock_guard<std::mutex> lock(handlers_mutex_);
-        
-        for (const auto& pair : handlers_) {
-            int fd = pair.first;
-            auto handler = pair.second;
-            
-            try {
-                if (FD_ISSET(fd, &error_fds)) {
-                    handler->handleEvent(ReactorEventType::ERROR);
-                    error_events_.fetch_add(1);
-                    events_processed_.fetch_add(1);
-                } else if (FD_ISSET(fd, &read_fds)) {
-                    handler->handleEvent(ReactorEventType::READ);
-                    read_events_.fetch_add(1);
-                    events_processed_.fetch_add(1);
-                } else if (FD_ISSET(fd, &write_fds)) {
-                    handler->handleEvent(ReactorEventType::WRITE);
-                    write_events_.fetch_add(1);
-                    events_processed_.fetch_add(1);
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "Ошибка в обработчике " << handler->getName() 
-                          << ": " << e.what() << std::endl;
-            }
-        }
-    }
-};
-
-// Обработчик для TCP сервера
-class TCPServerHandler : public EventHandler {
-private:
-    int server_fd_;
-    int port_;
-    Reactor& reactor_;
-    std::atomic<int> connection_count_{0};
-    
-public:
-    TCPServerHandler(int port, Reactor& reactor) 
-        : port_(port), reactor_(reactor), server_fd_(-1) {}
-    
-    ~TCPServerHandler() {
-        if (server_fd_ >= 0) {
-            close(server_fd_);
-        }
-    }
-    
-    void start() {
-        // Создаем сокет
-        server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
-        if (server_fd_ < 0) {
-            throw std::runtime_error("Не удалось создать сокет");
-        }
-        
-        // Настраиваем адрес
-        struct sockaddr_in address;
-        address.sin_family = AF_INET;
-        address.sin_addr.s_addr = INADDR_ANY;
-        address.sin_port = htons(port_);
-        
-        // Привязываем сокет
-        if (bind(server_fd_, (struct sockaddr*)&address, sizeof(address)) < 0) {
-            close(server_fd_);
-            throw std::runtime_error("Не удалось привязать сокет");
-        }
-        
-        // Слушаем соединения
-        if (listen(server_fd_, 5) < 0) {
-            close(server_fd_);
-            throw std::runtime_error("Не удалось начать прослушивание");
-        }
-        
-        // Делаем сокет неблокирующим
-        int flags = fcntl(server_fd_, F_GETFL, 0);
-        fcntl(server_fd_, F_SETFL, flags | O_NONBLOCK);
-        
-        std::cout << "TCP сервер запущен на порту " << port_ << std::endl;
-    }
-    
-    void handleEvent(ReactorEventType event_type) override {
-        switch (event_type) {
-            case ReactorEventType::READ:
-                handleNewConnection();
-                break;
-            case ReactorEventType::ERROR:
-                std::cerr << "Ошибка в серверном сокете" << std::endl;
-                break;
-            default:
-                break;
-        }
-    }
-    
-    int getFileDescriptor() const override {
-        return server_fd_;
-    }
-    
-    std::string getName() const override {
-        return "TCPServerHandler";
-    }
-    
-    int getConnectionCount() const {
-        return connection_count_.load();
-    }
-    
-private:
-    void handleNewConnection() {
-        struct sockaddr_in client_address;
-        socklen_t client_len = sizeof(client_address);
-        
-        int client_fd = accept(server_fd_, (struct sockaddr*)&client_address, &client_len);
-        
-        if (client_fd >= 0) {
-            connection_count_.fetch_add(1);
-            std::cout << "Новое соединение принято, fd=" << client_fd 
-                      << " (всего: " << connection_count_.load() << ")" << std::endl;
-            
-            // Делаем клиентский сокет неблокирующим
-            int flags = fcntl(client_fd, F_GETFL, 0);
-            fcntl(client_fd, F_SETFL, flags | O_NONBLOCK);
-            
-            // Создаем обработчик для клиента
-            auto client_handler = std::make_shared<TCPClientHandler>(client_fd, reactor_);
-            reactor_.registerHandler(client_handler);
-        }
-    }
-};
-
-// Обработчик для TCP клиента
-class TCPClientHandler : public EventHandler {
-private:
-    int client_fd_;
-    Reactor& reactor_;
-    std::string buffer_;
-    bool connection_closed_{false};
-    
-public:
-    TCPClientHandler(int fd, Reactor& reactor) 
-        : client_fd_(fd), reactor_(reactor) {}
-    
-    ~TCPClientHandler() {
-        if (client_fd_ >= 0) {
-            close(client_fd_);
-        }
-    }
-    
-    void handleEvent(ReactorEventType event_type) override {
-        switch (event_type) {
-            case ReactorEventType::READ:
-                handleRead();
-                break;
-            case ReactorEventType::WRITE:
-                handleWrite();
-                break;
-            case ReactorEventType::ERROR:
-                handleError();
-                break;
-            default:
-                break;
-        }
-    }
-    
-    int getFileDescriptor() const override {
-        return client_fd_;
-    }
-    
-    std::string getName() const override {
-        return "TCPClientHandler_" + std::to_string(client_fd_);
-    }
-    
-private:
-    void handleRead() {
-        char buffer[1024];
-        ssize_t bytes_read = read(client_fd_, buffer, sizeof(buffer) - 1);
-        
-        if (bytes_read > 0) {
-            buffer[bytes_read] = '\0';
-            std::cout << "Получены данные от клиента " << client_fd_ 
-                      << ": " << buffer << std::endl;
-            
-            // Подготавливаем ответ
-            buffer_ = "HTTP/1.1 200 OK\r\n\r\nHello from Reactor Pattern!";
-            
-        } else if (bytes_read == 0) {
-            // Соединение закрыто клиентом
-            std::cout << "Клиент " << client_fd_ << " отключился" << std::endl;
-            connection_closed_ = true;
-            reactor_.unregisterHandler(client_fd_);
-        } else {
-            if (errno != EAGAIN && errno != EWOULDBLOCK) {
-                std::cerr << "Ошибка чтения от клиента " << client_fd_ 
-                          << ": " << strerror(errno) << std::endl;
-                connection_closed_ = true;
-                reactor_.unregisterHandler(client_fd_);
-            }
-        }
-    }
-    
-    void handleWrite() {
-        if (!buffer_.empty()) {
-            ssize_t bytes_written = write(client_fd_, buffer_.c_str(), buffer_.length());
-            
-            if (bytes_written > 0) {
-                buffer_.erase(0, bytes_written);
-                std::cout << "Отправлен ответ клиенту " << client_fd_ << std::endl;
-            } else if (bytes_written < 0) {
-                if (errno != EAGAIN && errno != EWOULDBLOCK) {
-                    std::cerr << "Ошибка записи клиенту " << client_fd_ 
-                              << ": " << strerror(errno) << std::endl;
-                    connection_closed_ = true;
-                    reactor_.unregisterHandler(client_fd_);
-                }
-            }
-        }
-    }
-    
-    void handleError() {
-        std::cerr << "Ошибка в клиентском соединении " << client_fd_ << std::endl;
-        connection_closed_ = true;
-        reactor_.unregisterHandler(client_fd_);
-    }
-};
-
-// Обработчик для таймера
-class TimerHandler : public EventHandler {
-private:
-    int timer_fd_;
-    Reactor& reactor_;
-    std::chrono::milliseconds interval_;
-    std::function<void()> callback_;
-    std::atomic<int> tick_count_{0};
-    
-public:
-    TimerHandler(std::chrono::milliseconds interval, 
-                 std::function<void()> callback,
-                 Reactor& reactor) 
-        : interval_(interval), callback_(std::move(callback)), reactor_(reactor), timer_fd_(-1) {}
-    
-    ~TimerHandler() {
-        if (timer_fd_ >= 0) {
-            close(timer_fd_);
-        }
-    }
-    
-    void start() {
-        // Создаем timerfd (Linux-специфичный)
-        timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
-        if (timer_fd_ < 0) {
-            throw std::runtime_error("Не удалось создать timer");
-        }
-        
-        // Настраиваем таймер
-        struct itimerspec timer_spec;
-        timer_spec.it_value.tv_sec = interval_.count() / 1000;
-        timer_spec.it_value.tv_nsec = (interval_.count() % 1000) * 1000000;
-        timer_spec.it_interval.tv_sec = interval_.count() / 1000;
-        timer_spec.it_interval.tv_nsec = (interval_.count() % 1000) * 1000000;
-        
-        if (timerfd_settime(timer_fd_, 0, &timer_spec, nullptr) < 0) {
-            close(timer_fd_);
-            throw std::runtime_error("Не удалось настроить таймер");
-        }
-        
-        std::cout << "Timer запущен с интервалом " << interval_.count() << " мс" << std::endl;
-    }
-    
-    void handleEvent(ReactorEventType event_type) override {
-        if (event_type == ReactorEventType::READ) {
-            uint64_t expirations;
-            ssize_t bytes_read = read(timer_fd_, &expirations, sizeof(expirations));
-            
-            if (bytes_read > 0) {
-                tick_count_.fetch_add(expirations);
-                std::cout << "Timer сработал (тик " << tick_count_.load() << ")" << std::endl;
-                
-                if (callback_) {
-                    callback_();
-                }
-            }
-        }
-    }
-    
-    int getFileDescriptor() const override {
-        return timer_fd_;
-    }
-    
-    std::string getName() const override {
-        return "TimerHandler";
-    }
-    
-    int getTickCount() const {
-        return tick_count_.load();
-    }
-};
+
+#include "reactor_pattern.h"
 
 // Демонстрация базового Reactor
 void demonstrateBasicReactor() {
@@ -576,6 +104,336 @@ void demonstrateCombinedEvents() {
     reactor.stop();
 }
 
+// Клиенты нагрузки: каждый поток шлёт запрос и ждёт полный ответ
+// reply_size = 0: ответ той же длины, что и запрос (echo)
+double runReactorClients(int port, size_t clients, size_t requests, size_t message_size, size_t reply_size = 0) {
+    if (reply_size == 0) {
+        reply_size = message_size;
+    }
+    std::atomic<size_t> failures{0};
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t c = 0; c < clients; ++c) {
+        threads.emplace_back([&]() {
+            int fd = socket(AF_INET, SOCK_STREAM, 0);
+            int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons(static_cast<uint16_t>(port));
+            if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+                failures.fetch_add(1);
+                close(fd);
+                return;
+            }
+
+            std::string message(message_size, 'x');
+            std::string reply(reply_size, '\0');
+            for (size_t r = 0; r < requests; ++r) {
+                if (send(fd, message.data(), message.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(message.size())) {
+                    failures.fetch_add(1);
+                    break;
+                }
+                size_t got = 0;
+                while (got < reply_size) {
+                    ssize_t n = recv(fd, &reply[got], reply_size - got, 0);
+                    if (n <= 0) break;
+                    got += static_cast<size_t>(n);
+                }
+                if (got != reply_size) {
+                    failures.fetch_add(1);
+                    break;
+                }
+            }
+            close(fd);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (failures.load() > 0) {
+        std::cout << "❌ Ошибок у клиентов: " << failures.load() << std::endl;
+    }
+    return static_cast<double>(clients * requests) / seconds;
+}
+
+// Бенчмарк: echo на одном и том же обработчике, readiness (epoll) против completion (io_uring)
+void benchmarkReactorBackends() {
+    std::cout << "\n=== Бенчмарк: epoll vs io_uring ===" << std::endl;
+
+    const size_t clients = 4;
+    const size_t requests = 20000;
+    const size_t message_size = 64;
+
+    struct Result {
+        ReactorBackend backend;
+        double requests_per_second;
+        double syscalls_per_request;
+    };
+    std::vector<Result> results;
+
+    for (ReactorBackend backend : {ReactorBackend::Epoll, ReactorBackend::IoUring}) {
+        try {
+            Reactor reactor(backend);
+            auto server_handler = std::make_shared<TCPServerHandler>(
+                0, reactor,
+                [](const cpp_patterns::BufferSlice& request, cpp_patterns::BufferChain& response) {
+                    response.append(request);
+                });
+            server_handler->start();
+            reactor.registerHandler(server_handler);
+            reactor.start();
+
+            runReactorClients(server_handler->getPort(), clients, requests / 10, message_size);  // прогрев
+            // Соединения прогрева закрываются асинхронно: ждём, пока цикл их снимет
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+            size_t syscalls_before = reactor.getSyscallCount();
+            double rate = runReactorClients(server_handler->getPort(), clients, requests, message_size);
+            size_t syscalls = reactor.getSyscallCount() - syscalls_before;
+
+            reactor.stop();
+            results.push_back({backend, rate,
+                               static_cast<double>(syscalls) / static_cast<double>(clients * requests)});
+        } catch (const std::exception& e) {
+            std::cout << "Backend " << reactorBackendName(backend) << " пропущен: " << e.what() << std::endl;
+        }
+    }
+
+    std::cout << "\n" << clients << " клиентов x " << requests << " запросов по "
+              << message_size << " байт" << std::endl;
+    for (const auto& result : results) {
+        std::cout << "  " << reactorBackendName(result.backend) << ": "
+                  << static_cast<size_t>(result.requests_per_second) << " req/s, "
+                  << result.syscalls_per_request << " syscall/запрос (сервер)" << std::endl;
+    }
+}
+
+// Бенчмарк буферов вывода: std::string + erase против BufferChain, ответы 1 КиБ..1 МиБ
+void benchmarkBufferChains() {
+    std::cout << "\n=== Бенчмарк: цепочки буферов и writev ===" << std::endl;
+
+    const std::vector<size_t> sizes = {1024, 16 * 1024, 256 * 1024, 1024 * 1024};
+    const size_t socket_chunk = 16 * 1024;  // столько "принимает сокет" за один вызов
+
+    // 1. Без сети: частичные записи по 16 КиБ, считаем только работу с буфером
+    std::cout << "\nЧастичные записи по " << socket_chunk / 1024 << " КиБ (мкс на ответ):" << std::endl;
+    for (size_t size : sizes) {
+        const std::string body(size, 'x');
+        auto payload = cpp_patterns::makeIntrusive<cpp_patterns::SharedPayload>(body);
+        const size_t rounds = std::max<size_t>(4, (64u << 20) / size);
+        size_t checksum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            std::string buffer = body;  // ответ копируется в буфер соединения
+            while (!buffer.empty()) {
+                checksum += static_cast<unsigned char>(buffer[0]);
+                buffer.erase(0, std::min(socket_chunk, buffer.size()));  // сдвиг хвоста
+            }
+        }
+        double string_us = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count() / static_cast<double>(rounds);
+
+        start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            cpp_patterns::BufferChain chain;
+            chain.append(payload);  // ссылка на общий ответ
+            iovec iovecs[cpp_patterns::BufferChain::kMaxIovecs];
+            while (!chain.empty()) {
+                chain.fillIovecs(iovecs, cpp_patterns::BufferChain::kMaxIovecs);
+                checksum += static_cast<unsigned char>(*static_cast<char*>(iovecs[0].iov_base));
+                chain.consume(socket_chunk);  // только сдвиг смещения
+            }
+        }
+        double chain_us = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count() / static_cast<double>(rounds);
+
+        std::cout << "  " << std::setw(5) << size / 1024 << " КиБ: string+erase "
+                  << std::fixed << std::setprecision(2) << string_us << ", BufferChain "
+                  << chain_us << std::defaultfloat << " (контрольная сумма " << checksum << ")" << std::endl;
+    }
+
+    // 2. Loopback: запрос 16 байт, ответ size байт - общий payload против копии в слабы
+    const size_t clients = 4;
+    std::cout << "\nLoopback, " << clients << " клиента, epoll (МБ/с ответов):" << std::endl;
+    for (size_t size : sizes) {
+        auto payload = cpp_patterns::makeIntrusive<cpp_patterns::SharedPayload>(std::string(size, 'y'));
+        const size_t requests = std::max<size_t>(20, (32u << 20) / size / clients);
+        double shared_rate = 0.0;
+        double copied_rate = 0.0;
+
+        for (bool shared : {true, false}) {
+            Reactor reactor(ReactorBackend::Epoll);
+            auto server_handler = std::make_shared<TCPServerHandler>(
+                0, reactor,
+                [payload, shared](const cpp_patterns::BufferSlice&, cpp_patterns::BufferChain& response) {
+                    if (shared) {
+                        response.append(payload);
+                    } else {
+                        response.append(std::string_view(payload->data(), payload->size()));
+                    }
+                });
+            server_handler->start();
+            reactor.registerHandler(server_handler);
+            reactor.start();
+
+            double rate = runReactorClients(server_handler->getPort(), clients, requests, 16, size);
+            reactor.stop();
+            (shared ? shared_rate : copied_rate) = rate * static_cast<double>(size) / (1024.0 * 1024.0);
+        }
+
+        std::cout << "  " << std::setw(5) << size / 1024 << " КиБ: общий payload "
+                  << static_cast<size_t>(shared_rate) << ", копия в слабы "
+                  << static_cast<size_t>(copied_rate) << std::endl;
+    }
+    std::cout << "Слабов взято из кучи за всё время: " << cpp_patterns::Slab::heapAllocations()
+              << " (остальные - из кэша потока)" << std::endl;
+}
+
+// Короткие соединения: connect, один запрос-ответ, close (RST без TIME_WAIT)
+double runConnectionClients(int port, size_t clients, size_t connections, size_t message_size) {
+    std::atomic<size_t> failures{0};
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t c = 0; c < clients; ++c) {
+        threads.emplace_back([&]() {
+            std::string message(message_size, 'x');
+            std::string reply(message_size, '\0');
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons(static_cast<uint16_t>(port));
+
+            for (size_t i = 0; i < connections; ++i) {
+                int fd = socket(AF_INET, SOCK_STREAM, 0);
+                int enable = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+                linger no_time_wait{1, 0};
+                setsockopt(fd, SOL_SOCKET, SO_LINGER, &no_time_wait, sizeof(no_time_wait));
+                if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+                    send(fd, message.data(), message.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(message.size())) {
+                    failures.fetch_add(1);
+                    close(fd);
+                    continue;
+                }
+                size_t got = 0;
+                while (got < message_size) {
+                    ssize_t n = recv(fd, &reply[got], message_size - got, 0);
+                    if (n <= 0) break;
+                    got += static_cast<size_t>(n);
+                }
+                if (got != message_size) {
+                    failures.fetch_add(1);
+                }
+                close(fd);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (failures.load() > 0) {
+        std::cout << "❌ Ошибок у клиентов: " << failures.load() << std::endl;
+    }
+    return static_cast<double>(clients * connections) / seconds;
+}
+
+// Демонстрация multi-reactor: шардирование по SO_REUSEPORT и post между циклами
+void demonstrateMultiReactor() {
+    std::cout << "\n=== Демонстрация Multi-Reactor ===" << std::endl;
+
+    cpp_patterns::TraceSession trace("multi_reactor_trace.json", cpp_patterns::traceRequested());
+    auto echo = [](const cpp_patterns::BufferSlice& request, cpp_patterns::BufferChain& response) {
+        response.append(request);
+    };
+    MultiReactorServer server(2, 0, echo);
+    server.start();
+    std::cout << "Циклов: " << server.loopCount() << ", CPU: " << server.describePlacement()
+              << ", порт " << server.getPort() << std::endl;
+
+    runConnectionClients(server.getPort(), 4, 50, 64);
+    auto counts = server.getConnectionCounts();
+    for (size_t i = 0; i < counts.size(); ++i) {
+        std::cout << "Цикл " << i << " принял соединений: " << counts[i] << std::endl;
+    }
+
+    // Цикл 0 передаёт задачу циклу 1: ни одного мьютекса на пути
+    std::promise<bool> delivered;
+    server.loop(0).post([&server, &delivered]() {
+        bool on_first = server.loop(0).isInLoopThread();
+        server.loop(1).post([&server, &delivered, on_first]() {
+            delivered.set_value(on_first && server.loop(1).isInLoopThread());
+        });
+    });
+    std::cout << "post 0 -> 1 выполнен на потоке цикла 1: "
+              << (delivered.get_future().get() ? "да" : "нет") << std::endl;
+
+    server.stop();
+}
+
+// Бенчмарк: как connections/s и requests/s растут с числом циклов
+void benchmarkMultiReactor() {
+    std::cout << "\n=== Бенчмарк: Multi-Reactor ===" << std::endl;
+
+    const size_t clients = 8;
+    const size_t connections = 400;
+    const size_t requests = 4000;
+    const size_t message_size = 64;
+    const size_t cpu_count = cpp_patterns::CpuTopology::system().cpuCount();
+
+    struct Result {
+        size_t loops;
+        ShardingMode mode;
+        double connections_per_second;
+        double requests_per_second;
+    };
+    std::vector<Result> results;
+    auto echo = [](const cpp_patterns::BufferSlice& request, cpp_patterns::BufferChain& response) {
+        response.append(request);
+    };
+
+    auto measure = [&](size_t loops, ShardingMode mode) {
+        MultiReactorServer server(loops, 0, echo, mode);
+        server.start();
+        runConnectionClients(server.getPort(), clients, connections / 10, message_size);  // прогрев
+        double connection_rate = runConnectionClients(server.getPort(), clients, connections, message_size);
+        double request_rate = runReactorClients(server.getPort(), clients, requests, message_size);
+        server.stop();
+        results.push_back({loops, mode, connection_rate, request_rate});
+    };
+
+    // На машине с одним CPU показываем и переподписку: циклов больше, чем ядер
+    size_t max_loops = std::max<size_t>(2, cpu_count);
+    // Степени двойки до max_loops и сам max_loops (6 CPU -> 1, 2, 4, 6),
+    // чтобы режим acceptor было с чем сравнить при том же числе циклов
+    for (size_t loops = 1; loops < max_loops; loops *= 2) {
+        measure(loops, ShardingMode::ReusePort);
+    }
+    measure(max_loops, ShardingMode::ReusePort);
+    measure(max_loops, ShardingMode::Acceptor);
+
+    std::cout << "\nCPU: " << cpu_count << ", клиентов: " << clients
+              << " (в том же процессе, делят те же ядра)" << std::endl;
+    for (const auto& result : results) {
+        std::cout << "  " << result.loops << " цикл(а), "
+                  << (result.mode == ShardingMode::ReusePort ? "SO_REUSEPORT" : "acceptor + post") << ": "
+                  << static_cast<size_t>(result.connections_per_second) << " conn/s, "
+                  << static_cast<size_t>(result.requests_per_second) << " req/s";
+        if (result.loops > cpu_count) {
+            std::cout << " (циклов больше, чем CPU)";
+        }
+        std::cout << std::endl;
+    }
+}
+
 int main() {
     std::cout << "=== Reactor Pattern ===" << std::endl;
     
@@ -583,6 +441,10 @@ int main() {
         demonstrateBasicReactor();
         demonstrateTCPServerReactor();
         demonstrateCombinedEvents();
+        benchmarkReactorBackends();
+        benchmarkBufferChains();
+        demonstrateMultiReactor();
+        benchmarkMultiReactor();
     } catch (const std::exception& e) {
         std::cerr << "Ошибка: " << e.what() << std::endl;
         return 1;
@@ -0,0 +1,1683 @@
+/**
+ * @file reactor_pattern.h
+ * @brief Классы урока Reactor: циклы epoll/io_uring, TCP-обработчики, multi-reactor
+ *
+ * Вынесены из reactor_pattern.cpp, чтобы нагрузочные сценарии
+ * (loadtest/scenario_reactor.cpp) гоняли MultiReactorServer урока,
+ * а не его упрощённую копию.
+ */
+
+#pragma once
+
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <queue>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <unordered_map>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdio>
+#include <stdexcept>
+#include <system_error>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include "buffer_chain.h"
+#include "cpu_topology.h"
+#include "tracing.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define CPP_PATTERNS_HAS_IO_URING 1
+#endif
+
+// Типы событий для Reactor
+enum class ReactorEventType {
+    READ,
+    WRITE,
+    ERROR,
+    TIMEOUT
+};
+
+// Механизм демультиплексирования событий
+enum class ReactorBackend {
+    Auto,     // io_uring, если ядро его поддерживает, иначе epoll
+    Epoll,    // готовность: ядро сообщает «можно читать», read/write делает обработчик
+    IoUring   // завершение: ядро само выполняет accept/recv/send и отдаёт результат
+};
+
+inline const char* reactorBackendName(ReactorBackend backend) {
+    switch (backend) {
+        case ReactorBackend::Auto: return "auto";
+        case ReactorBackend::Epoll: return "epoll";
+        case ReactorBackend::IoUring: return "io_uring";
+    }
+    return "unknown";
+}
+
+// Как обработчик хочет получать события в completion-режиме (io_uring)
+enum class HandlerKind {
+    Readiness,  // только уведомления о готовности (handleEvent), например timerfd
+    Acceptor,   // слушающий сокет: готовые соединения приходят в handleAccepted
+    Stream      // соединение: принятые байты приходят в handleReceived
+};
+
+// Обработчик событий
+class EventHandler {
+public:
+    virtual ~EventHandler() = default;
+    virtual void handleEvent(ReactorEventType event_type) = 0;
+    virtual int getFileDescriptor() const = 0;
+    virtual std::string getName() const = 0;
+
+    // Completion-модель. В режиме epoll эти методы не вызываются:
+    // обработчик сам делает accept/read в handleEvent.
+    virtual HandlerKind getKind() const { return HandlerKind::Readiness; }
+    virtual void handleAccepted(int /*client_fd*/) {}
+    // data указывает в буфер кольца и действительна только на время вызова
+    virtual void handleReceived(const char* /*data*/, size_t /*size*/) {}
+    virtual void handleClosed() {}
+};
+
+#ifdef CPP_PATTERNS_HAS_IO_URING
+// Проверка версии ядра: multishot recv появился в 6.0
+inline bool kernelAtLeast(int major, int minor) {
+    utsname info;
+    if (uname(&info) != 0) return false;
+    int kernel_major = 0;
+    int kernel_minor = 0;
+    if (std::sscanf(info.release, "%d.%d", &kernel_major, &kernel_minor) != 2) return false;
+    return kernel_major > major || (kernel_major == major && kernel_minor >= minor);
+}
+
+/**
+ * @brief Минимальная обёртка над io_uring без liburing
+ *
+ * Очереди SQ/CQ отображены в память процесса: SQE заполняются без
+ * системных вызовов, а один io_uring_enter отправляет всю накопленную
+ * пачку и забирает готовые completion'ы.
+ */
+class IoUring {
+private:
+    int ring_fd_ = -1;
+    void* sq_ring_ = MAP_FAILED;
+    void* cq_ring_ = MAP_FAILED;
+    size_t sq_ring_size_ = 0;
+    size_t cq_ring_size_ = 0;
+    io_uring_sqe* sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqes_size_ = 0;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned sq_local_tail_ = 0;
+
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+
+public:
+    explicit IoUring(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        // COOP_TASKRUN: не прерывать поток цикла IPI ради завершений (5.19+)
+        params.flags = IORING_SETUP_COOP_TASKRUN;
+        ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_fd_ < 0 && errno == EINVAL) {
+            std::memset(&params, 0, sizeof(params));
+            ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        }
+        if (ring_fd_ < 0) {
+            throw std::system_error(errno, std::system_category(), "io_uring_setup");
+        }
+
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+        }
+
+        sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ring_fd_, IORING_OFF_SQ_RING);
+        if (sq_ring_ == MAP_FAILED) {
+            fail("mmap SQ");
+        }
+        cq_ring_ = single_mmap ? sq_ring_
+                               : mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                      ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED) {
+            fail("mmap CQ");
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                                                MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES));
+        if (sqes_ == MAP_FAILED) {
+            fail("mmap SQEs");
+        }
+
+        char* sq = static_cast<char*>(sq_ring_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_entries_ = params.sq_entries;
+        sq_local_tail_ = *sq_tail_;
+        // Индексы SQE совпадают с позициями в кольце: массив заполняется один раз
+        unsigned* sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        for (unsigned i = 0; i < sq_entries_; ++i) {
+            sq_array[i] = i;
+        }
+
+        char* cq = static_cast<char*>(cq_ring_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    }
+
+    ~IoUring() {
+        release();
+    }
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    int fd() const { return ring_fd_; }
+
+    // Свободный SQE или nullptr, если очередь заполнена (нужен enter)
+    io_uring_sqe* getSqe() {
+        unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (sq_local_tail_ - head >= sq_entries_) {
+            return nullptr;
+        }
+        io_uring_sqe* sqe = &sqes_[sq_local_tail_ & sq_mask_];
+        ++sq_local_tail_;
+        std::memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    // Отправить накопленные SQE и дождаться wait_for завершений; -errno при ошибке
+    int enter(unsigned wait_for) {
+        __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+        unsigned pending = sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        unsigned flags = wait_for > 0 ? IORING_ENTER_GETEVENTS : 0;
+        long result = syscall(__NR_io_uring_enter, ring_fd_, pending, wait_for, flags, nullptr, 0);
+        return result < 0 ? -errno : static_cast<int>(result);
+    }
+
+    // Обработать все готовые CQE; head сдвигается одной записью в конце
+    template<typename Callback>
+    unsigned drainCompletions(Callback&& callback) {
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        unsigned count = 0;
+        for (; head != tail; ++head, ++count) {
+            io_uring_cqe cqe = cqes_[head & cq_mask_];
+            callback(cqe);
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    int registerOp(unsigned opcode, void* arg, unsigned count) {
+        long result = syscall(__NR_io_uring_register, ring_fd_, opcode, arg, count);
+        return result < 0 ? -errno : static_cast<int>(result);
+    }
+
+private:
+    [[noreturn]] void fail(const char* what) {
+        int error = errno;
+        release();
+        throw std::system_error(error, std::system_category(), what);
+    }
+
+    void release() {
+        if (sqes_ != MAP_FAILED) munmap(sqes_, sqes_size_);
+        if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+        if (sq_ring_ != MAP_FAILED) munmap(sq_ring_, sq_ring_size_);
+        if (ring_fd_ >= 0) close(ring_fd_);
+        sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+        cq_ring_ = sq_ring_ = MAP_FAILED;
+        ring_fd_ = -1;
+    }
+};
+
+/**
+ * @brief Кольцо предоставленных буферов (provided buffer ring, 5.19+)
+ *
+ * Ядро само выбирает свободный буфер для multishot recv и сообщает его id
+ * в CQE: обработчик читает байты прямо из буфера, а после вызова буфер
+ * возвращается в кольцо одной записью tail - без копирования и без SQE.
+ */
+class ProvidedBufferRing {
+public:
+    static constexpr unsigned kEntries = 256;
+    static constexpr size_t kBufferSize = 4096;
+    static constexpr uint16_t kGroupId = 1;
+
+private:
+    void* ring_memory_ = MAP_FAILED;
+    void* buffers_ = MAP_FAILED;
+    io_uring_buf_ring* ring_ = nullptr;
+
+public:
+    ProvidedBufferRing() {
+        ring_memory_ = mmap(nullptr, kEntries * sizeof(io_uring_buf), PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        buffers_ = mmap(nullptr, kEntries * kBufferSize, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ring_memory_ == MAP_FAILED || buffers_ == MAP_FAILED) {
+            int error = errno;
+            unmap();
+            throw std::system_error(error, std::system_category(), "mmap buffer ring");
+        }
+        ring_ = static_cast<io_uring_buf_ring*>(ring_memory_);
+        for (unsigned bid = 0; bid < kEntries; ++bid) {
+            fill(entry(bid), static_cast<uint16_t>(bid));
+        }
+        __atomic_store_n(&ring_->tail, static_cast<uint16_t>(kEntries), __ATOMIC_RELEASE);
+    }
+
+    ~ProvidedBufferRing() {
+        unmap();
+    }
+
+    ProvidedBufferRing(const ProvidedBufferRing&) = delete;
+    ProvidedBufferRing& operator=(const ProvidedBufferRing&) = delete;
+
+    void registerWith(IoUring& ring) {
+        io_uring_buf_reg reg;
+        std::memset(&reg, 0, sizeof(reg));
+        reg.ring_addr = reinterpret_cast<uint64_t>(ring_memory_);
+        reg.ring_entries = kEntries;
+        reg.bgid = kGroupId;
+        int result = ring.registerOp(IORING_REGISTER_PBUF_RING, &reg, 1);
+        if (result < 0) {
+            throw std::system_error(-result, std::system_category(), "IORING_REGISTER_PBUF_RING");
+        }
+    }
+
+    char* data(uint16_t bid) const {
+        return static_cast<char*>(buffers_) + static_cast<size_t>(bid) * kBufferSize;
+    }
+
+    // Вернуть буфер ядру (вызывает только поток цикла)
+    void recycle(uint16_t bid) {
+        uint16_t tail = ring_->tail;
+        fill(entry(tail & (kEntries - 1)), bid);
+        __atomic_store_n(&ring_->tail, static_cast<uint16_t>(tail + 1), __ATOMIC_RELEASE);
+    }
+
+private:
+    // Не ring_->bufs: в C++ __DECLARE_FLEX_ARRAY из заголовков до 6.5 сдвигает
+    // массив на 8 байт (пустая структура имеет размер 1), а ядро ждёт его с нуля
+    io_uring_buf& entry(unsigned index) {
+        return static_cast<io_uring_buf*>(ring_memory_)[index];
+    }
+
+    void fill(io_uring_buf& slot, uint16_t bid) {
+        slot.addr = reinterpret_cast<uint64_t>(data(bid));
+        slot.len = kBufferSize;
+        slot.bid = bid;
+    }
+
+    void unmap() {
+        if (buffers_ != MAP_FAILED) munmap(buffers_, kEntries * kBufferSize);
+        if (ring_memory_ != MAP_FAILED) munmap(ring_memory_, kEntries * sizeof(io_uring_buf));
+    }
+};
+
+// Буфер исходящих данных: слот зарегистрированной арены или куча
+struct SendBuffer {
+    char* data = nullptr;
+    size_t capacity = 0;
+    size_t size = 0;
+    size_t offset = 0;
+    int fixed_index = -1;        // индекс в IORING_REGISTER_BUFFERS или -1
+    unsigned notifications = 0;  // незакрытые уведомления zero-copy send
+    bool finished = false;
+    int fd = -1;
+    uint32_t generation = 0;
+    std::unique_ptr<char[]> heap;
+};
+
+/**
+ * @brief Пул буферов отправки
+ *
+ * Первые kFixedSlots слотов лежат в одной арене, зарегистрированной через
+ * IORING_REGISTER_BUFFERS: ядро закрепляет страницы один раз, а не на каждую
+ * операцию. Полные слоты уходят через SEND_ZC с IORING_RECVSEND_FIXED_BUF.
+ * Когда зарегистрированные слоты закончились, берётся буфер из кучи.
+ */
+class SendBufferPool {
+public:
+    static constexpr size_t kSlotSize = 16 * 1024;
+    static constexpr unsigned kFixedSlots = 64;
+
+private:
+    void* arena_ = MAP_FAILED;
+    std::deque<SendBuffer> buffers_;  // deque: ссылки стабильны при росте
+    std::vector<uint32_t> free_fixed_;
+    std::vector<uint32_t> free_heap_;
+    bool registered_ = false;
+
+public:
+    SendBufferPool() {
+        arena_ = mmap(nullptr, kFixedSlots * kSlotSize, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (arena_ == MAP_FAILED) {
+            throw std::system_error(errno, std::system_category(), "mmap send arena");
+        }
+        for (unsigned i = 0; i < kFixedSlots; ++i) {
+            SendBuffer buffer;
+            buffer.data = static_cast<char*>(arena_) + i * kSlotSize;
+            buffer.capacity = kSlotSize;
+            buffer.fixed_index = static_cast<int>(i);
+            buffers_.push_back(std::move(buffer));
+            free_fixed_.push_back(kFixedSlots - 1 - i);
+        }
+    }
+
+    ~SendBufferPool() {
+        if (arena_ != MAP_FAILED) munmap(arena_, kFixedSlots * kSlotSize);
+    }
+
+    SendBufferPool(const SendBufferPool&) = delete;
+    SendBufferPool& operator=(const SendBufferPool&) = delete;
+
+    // Без регистрации (RLIMIT_MEMLOCK) слоты работают как обычная память
+    void registerWith(IoUring& ring) {
+        std::vector<iovec> slots(kFixedSlots);
+        for (unsigned i = 0; i < kFixedSlots; ++i) {
+            slots[i].iov_base = static_cast<char*>(arena_) + i * kSlotSize;
+            slots[i].iov_len = kSlotSize;
+        }
+        registered_ = ring.registerOp(IORING_REGISTER_BUFFERS, slots.data(), kFixedSlots) == 0;
+    }
+
+    bool registered() const { return registered_; }
+
+    uint32_t acquire(size_t wanted) {
+        uint32_t index;
+        if (!free_fixed_.empty()) {
+            index = free_fixed_.back();
+            free_fixed_.pop_back();
+        } else {
+            if (!free_heap_.empty()) {
+                index = free_heap_.back();
+                free_heap_.pop_back();
+            } else {
+                index = static_cast<uint32_t>(buffers_.size());
+                buffers_.emplace_back();
+            }
+            SendBuffer& buffer = buffers_[index];
+            if (buffer.capacity < wanted) {
+                buffer.heap = std::make_unique<char[]>(wanted);
+                buffer.data = buffer.heap.get();
+                buffer.capacity = wanted;
+            }
+        }
+        SendBuffer& buffer = buffers_[index];
+        buffer.size = buffer.offset = 0;
+        buffer.notifications = 0;
+        buffer.finished = false;
+        return index;
+    }
+
+    void release(uint32_t index) {
+        (buffers_[index].fixed_index >= 0 ? free_fixed_ : free_heap_).push_back(index);
+    }
+
+    SendBuffer& operator[](uint32_t index) { return buffers_[index]; }
+};
+#endif
+
+/**
+ * @brief Входящая очередь задач цикла: lock-free MPSC
+ *
+ * Производители добавляют узел в стек Трайбера одним CAS, поток цикла
+ * забирает весь стек одним exchange и разворачивает его в порядок постановки.
+ * ABA невозможна: потребитель никогда не снимает отдельные узлы.
+ */
+class ReactorInbox {
+private:
+    struct Node {
+        std::function<void()> task;
+        Node* next;
+    };
+
+    std::atomic<Node*> head_{nullptr};
+
+public:
+    ReactorInbox() = default;
+    ReactorInbox(const ReactorInbox&) = delete;
+    ReactorInbox& operator=(const ReactorInbox&) = delete;
+
+    ~ReactorInbox() {
+        Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+        while (node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    // true, если очередь была пуста: будить цикл нужно только в этом случае
+    bool push(std::function<void()> task) {
+        Node* node = new Node{std::move(task), nullptr};
+        Node* expected = head_.load(std::memory_order_relaxed);
+        do {
+            node->next = expected;
+        } while (!head_.compare_exchange_weak(expected, node,
+                                              std::memory_order_release, std::memory_order_relaxed));
+        // node->next после CAS не читаем: узел уже мог забрать поток цикла
+        return expected == nullptr;
+    }
+
+    // Выполнить все накопленные задачи (только поток цикла); возвращает их число
+    template<typename Run>
+    size_t drain(Run&& run) {
+        Node* stack = head_.exchange(nullptr, std::memory_order_acquire);
+        Node* ordered = nullptr;
+        while (stack) {
+            Node* next = stack->next;
+            stack->next = ordered;
+            ordered = stack;
+            stack = next;
+        }
+        size_t count = 0;
+        while (ordered) {
+            std::unique_ptr<Node> node(ordered);
+            ordered = ordered->next;
+            run(node->task);
+            ++count;
+        }
+        return count;
+    }
+};
+
+// Reactor - основной класс для демультиплексирования событий
+class Reactor {
+private:
+    std::atomic<bool> running_{false};
+    std::thread reactor_thread_;
+    std::atomic<std::thread::id> loop_thread_id_{};
+    ReactorBackend backend_ = ReactorBackend::Epoll;
+    int cpu_ = -1;
+    bool log_handlers_ = true;
+
+    // Задачи из других потоков и циклов (post)
+    ReactorInbox inbox_;
+    std::atomic<size_t> posted_tasks_{0};
+
+    // Обработчики событий
+    std::unordered_map<int, std::shared_ptr<EventHandler>> handlers_;
+    std::mutex handlers_mutex_;
+
+    // Статистика
+    std::atomic<size_t> events_processed_{0};
+    std::atomic<size_t> read_events_{0};
+    std::atomic<size_t> write_events_{0};
+    std::atomic<size_t> error_events_{0};
+    std::atomic<size_t> syscalls_{0};
+
+    // Пробуждение цикла из других потоков (stop, регистрация)
+    int wake_fd_ = -1;
+    int epoll_fd_ = -1;
+
+#ifdef CPP_PATTERNS_HAS_IO_URING
+    enum class UringOp : uint8_t { Wake = 1, Accept, Receive, Poll, Send, Cancel };
+
+    // Состояние соединения в completion-режиме (только поток цикла)
+    struct UringConnection {
+        std::shared_ptr<EventHandler> handler;
+        uint32_t generation = 0;
+        uint64_t armed = 0;           // user_data multishot-операции
+        std::deque<uint32_t> sends;   // голова очереди уже в ядре
+        bool send_in_flight = false;
+    };
+
+    // Порядок членов важен: кольцо закрывается раньше, чем освобождаются буферы
+    struct UringState {
+        ProvidedBufferRing receive_buffers;
+        SendBufferPool send_buffers;
+        IoUring ring;
+        bool zero_copy = true;
+        uint32_t next_generation = 1;
+        std::unordered_map<int, UringConnection> connections;
+
+        UringState() : ring(256) {
+            receive_buffers.registerWith(ring);
+            send_buffers.registerWith(ring);
+        }
+    };
+
+    std::unique_ptr<UringState> uring_;
+    // Регистрации из чужих потоков: nullptr означает отмену для fd
+    std::vector<std::pair<int, std::shared_ptr<EventHandler>>> pending_;
+#endif
+
+public:
+    explicit Reactor(ReactorBackend backend = ReactorBackend::Auto) {
+        wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wake_fd_ < 0) {
+            throw std::system_error(errno, std::system_category(), "eventfd");
+        }
+
+        if (backend != ReactorBackend::Epoll) {
+            try {
+                setupUring();
+                backend_ = ReactorBackend::IoUring;
+            } catch (const std::exception& e) {
+                if (backend == ReactorBackend::IoUring) {
+                    close(wake_fd_);
+                    throw;
+                }
+                std::cout << "io_uring недоступен (" << e.what() << "), используется epoll" << std::endl;
+            }
+        }
+        if (backend_ == ReactorBackend::Epoll) {
+            setupEpoll();
+        }
+        std::cout << "Reactor создан (backend: " << reactorBackendName(backend_) << ")" << std::endl;
+    }
+
+    ~Reactor() {
+        stop();
+        if (epoll_fd_ >= 0) close(epoll_fd_);
+#ifdef CPP_PATTERNS_HAS_IO_URING
+        uring_.reset();
+#endif
+        close(wake_fd_);
+    }
+
+    // Запуск Reactor; cpu >= 0 - закрепить поток цикла за этим CPU
+    void start(int cpu = -1) {
+        if (running_.load()) {
+            std::cout << "Reactor уже запущен" << std::endl;
+            return;
+        }
+
+        cpu_ = cpu;
+        running_.store(true);
+        reactor_thread_ = std::thread([this]() { runReactor(); });
+        std::cout << "Reactor запущен" << std::endl;
+    }
+
+    // Остановка Reactor
+    void stop() {
+        if (!running_.load()) return;
+
+        std::cout << "Останавливаем Reactor..." << std::endl;
+        running_.store(false);
+        wake();
+
+        if (reactor_thread_.joinable()) {
+            reactor_thread_.join();
+        }
+
+        printStats();
+        std::cout << "Reactor остановлен" << std::endl;
+    }
+
+    ReactorBackend backend() const { return backend_; }
+
+    int getCpu() const { return cpu_; }
+
+    // Сообщения о (де)регистрации обработчиков; в бенчмарках их тысячи
+    void setHandlerLogging(bool enabled) { log_handlers_ = enabled; }
+
+    /**
+     * @brief Выполнить задачу на потоке этого цикла
+     *
+     * Можно вызывать из любого потока, в том числе из другого Reactor:
+     * так соединение передаётся циклу, который будет владеть им до конца.
+     * Цикл будится только если очередь была пуста.
+     */
+    void post(std::function<void()> task) {
+        if (inbox_.push(std::move(task))) {
+            wake();
+        }
+    }
+
+    bool isInLoopThread() const {
+        return onLoopThread();
+    }
+
+    // Регистрация обработчика событий
+    void registerHandler(std::shared_ptr<EventHandler> handler) {
+        int fd = handler->getFileDescriptor();
+        {
+            std::lock_guard<std::mutex> lock(handlers_mutex_);
+            handlers_[fd] = handler;
+        }
+
+        if (log_handlers_) {
+            std::cout << "Зарегистрирован обработчик " << handler->getName()
+                      << " для fd=" << fd << std::endl;
+        }
+
+        if (backend_ == ReactorBackend::Epoll) {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+            recordSyscalls(1);
+            return;
+        }
+#ifdef CPP_PATTERNS_HAS_IO_URING
+        if (onLoopThread()) {
+            addConnection(std::move(handler));
+        } else {
+            {
+                std::lock_guard<std::mutex> lock(handlers_mutex_);
+                pending_.emplace_back(fd, std::move(handler));
+            }
+            wake();
+        }
+#endif
+    }
+
+    // Отмена регистрации обработчика (можно вызывать из самого обработчика)
+    void unregisterHandler(int fd) {
+        std::shared_ptr<EventHandler> removed;
+        {
+            std::lock_guard<std::mutex> lock(handlers_mutex_);
+            auto it = handlers_.find(fd);
+            if (it == handlers_.end()) return;
+            removed = std::move(it->second);
+            handlers_.erase(it);
+        }
+
+        if (log_handlers_) {
+            std::cout << "Отменена регистрация обработчика для fd=" << fd << std::endl;
+        }
+
+        if (backend_ == ReactorBackend::Epoll) {
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+            recordSyscalls(1);
+            return;
+        }
+#ifdef CPP_PATTERNS_HAS_IO_URING
+        if (onLoopThread()) {
+            removeConnection(fd);
+        } else {
+            {
+                std::lock_guard<std::mutex> lock(handlers_mutex_);
+                pending_.emplace_back(fd, nullptr);
+            }
+            wake();
+        }
+#endif
+    }
+
+    // epoll: подписка на EPOLLOUT только пока есть неотправленные данные
+    void setWriteInterest(int fd, bool enabled) {
+        if (backend_ != ReactorBackend::Epoll) return;
+        epoll_event event{};
+        event.events = EPOLLIN | (enabled ? EPOLLOUT : 0u);
+        event.data.fd = fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event);
+        recordSyscalls(1);
+    }
+
+    // io_uring: поставить данные в очередь отправки соединения (поток цикла).
+    // Данные копируются в слоты пула; send'ы одного fd идут строго по очереди.
+    void send(int fd, const char* data, size_t size) {
+#ifdef CPP_PATTERNS_HAS_IO_URING
+        if (backend_ != ReactorBackend::IoUring || !onLoopThread()) {
+            throw std::logic_error("Reactor::send доступен только обработчикам в режиме io_uring");
+        }
+        auto it = uring_->connections.find(fd);
+        if (it == uring_->connections.end()) return;
+        UringConnection& connection = it->second;
+
+        while (size > 0) {
+            uint32_t index = uring_->send_buffers.acquire(size);
+            SendBuffer& buffer = uring_->send_buffers[index];
+            size_t chunk = std::min(size, buffer.capacity);
+            std::memcpy(buffer.data, data, chunk);
+            buffer.size = chunk;
+            buffer.fd = fd;
+            buffer.generation = connection.generation;
+            connection.sends.push_back(index);
+            data += chunk;
+            size -= chunk;
+        }
+        flushSends(connection);
+#else
+        (void)fd;
+        (void)data;
+        (void)size;
+        throw std::logic_error("Reactor::send доступен только обработчикам в режиме io_uring");
+#endif
+    }
+
+    // Учёт системных вызовов, сделанных обработчиками в режиме epoll
+    void recordSyscalls(size_t count) {
+        syscalls_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    size_t getSyscallCount() const {
+        return syscalls_.load(std::memory_order_relaxed);
+    }
+
+    // Получение статистики
+    void printStats() const {
+        std::cout << "\n=== Reactor Statistics ===" << std::endl;
+        std::cout << "Backend: " << reactorBackendName(backend_) << std::endl;
+        std::cout << "Всего событий обработано: " << events_processed_.load() << std::endl;
+        std::cout << "Read событий: " << read_events_.load() << std::endl;
+        std::cout << "Write событий: " << write_events_.load() << std::endl;
+        std::cout << "Error событий: " << error_events_.load() << std::endl;
+        std::cout << "Системных вызовов: " << syscalls_.load() << std::endl;
+        std::cout << "Задач через post: " << posted_tasks_.load() << std::endl;
+        std::cout << "=========================" << std::endl;
+    }
+
+private:
+    bool onLoopThread() const {
+        return loop_thread_id_.load(std::memory_order_acquire) == std::this_thread::get_id();
+    }
+
+    void wake() {
+        uint64_t one = 1;
+        ssize_t written = write(wake_fd_, &one, sizeof(one));
+        (void)written;
+    }
+
+    void runPosted() {
+        TRACE_ZONE_CAT("posted", "reactor");
+        size_t count = inbox_.drain([](std::function<void()>& task) {
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "Ошибка в задаче post: " << e.what() << std::endl;
+            }
+        });
+        posted_tasks_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    std::shared_ptr<EventHandler> findHandler(int fd) {
+        std::lock_guard<std::mutex> lock(handlers_mutex_);
+        auto it = handlers_.find(fd);
+        return it != handlers_.end() ? it->second : nullptr;
+    }
+
+    // Вызов обработчика вне handlers_mutex_: он может (от)регистрировать других
+    template<typename Call>
+    void dispatch(const std::shared_ptr<EventHandler>& handler, std::atomic<size_t>& counter, Call&& call) {
+        try {
+            TRACE_ZONE_CAT("dispatch", "reactor");
+            call();
+        } catch (const std::exception& e) {
+            std::cerr << "Ошибка в обработчике " << handler->getName()
+                      << ": " << e.what() << std::endl;
+        }
+        counter.fetch_add(1, std::memory_order_relaxed);
+        events_processed_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void setupEpoll() {
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd_ < 0) {
+            throw std::system_error(errno, std::system_category(), "epoll_create1");
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = wake_fd_;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+    }
+
+    void runReactor() {
+        std::cout << "Reactor начал работу" << std::endl;
+        loop_thread_id_.store(std::this_thread::get_id(), std::memory_order_release);
+        TRACE_THREAD_NAME(cpu_ >= 0 ? "reactor-cpu" + std::to_string(cpu_) : std::string("reactor"));
+        if (cpu_ >= 0 && !cpp_patterns::pinCurrentThread(cpu_)) {
+            std::cerr << "Не удалось закрепить Reactor за CPU " << cpu_ << std::endl;
+        }
+        runPosted();
+
+#ifdef CPP_PATTERNS_HAS_IO_URING
+        if (backend_ == ReactorBackend::IoUring) {
+            runUringLoop();
+        } else {
+            runEpollLoop();
+        }
+#else
+        runEpollLoop();
+#endif
+
+        loop_thread_id_.store(std::thread::id(), std::memory_order_release);
+        std::cout << "Reactor завершил работу" << std::endl;
+    }
+
+    // Readiness: epoll сообщает о готовности, read/write делают обработчики
+    void runEpollLoop() {
+        std::array<epoll_event, 64> events;
+
+        while (running_.load()) {
+            int ready = epoll_wait(epoll_fd_, events.data(), static_cast<int>(events.size()), -1);
+            recordSyscalls(1);
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue; // Перехвачен сигнал, продолжаем
+                }
+                std::cerr << "Ошибка epoll_wait: " << strerror(errno) << std::endl;
+                break;
+            }
+
+            for (int i = 0; i < ready; ++i) {
+                int fd = events[i].data.fd;
+                uint32_t mask = events[i].events;
+                if (fd == wake_fd_) {
+                    uint64_t value;
+                    ssize_t drained = read(wake_fd_, &value, sizeof(value));
+                    (void)drained;
+                    recordSyscalls(1);
+                    runPosted();
+                    continue;
+                }
+
+                auto handler = findHandler(fd);
+                if (!handler) continue;
+
+                if ((mask & EPOLLERR) || ((mask & EPOLLHUP) && !(mask & EPOLLIN))) {
+                    dispatch(handler, error_events_, [&] { handler->handleEvent(ReactorEventType::ERROR); });
+                    continue;
+                }
+                if (mask & EPOLLIN) {
+                    dispatch(handler, read_events_, [&] { handler->handleEvent(ReactorEventType::READ); });
+                }
+                if (mask & EPOLLOUT) {
+                    dispatch(handler, write_events_, [&] { handler->handleEvent(ReactorEventType::WRITE); });
+                }
+            }
+        }
+    }
+
+#ifdef CPP_PATTERNS_HAS_IO_URING
+    static uint64_t makeUserData(UringOp op, uint32_t generation, uint32_t index) {
+        return (static_cast<uint64_t>(op) << 56) |
+               (static_cast<uint64_t>(generation & 0xFFFFFF) << 32) | index;
+    }
+
+    void setupUring() {
+        // multishot recv и провайдер-кольца буферов - ядро 6.0+
+        if (!kernelAtLeast(6, 0)) {
+            throw std::runtime_error("нужно ядро 6.0+ для multishot recv");
+        }
+        uring_ = std::make_unique<UringState>();
+        armWake();
+    }
+
+    io_uring_sqe* nextSqe() {
+        io_uring_sqe* sqe = uring_->ring.getSqe();
+        if (!sqe) {
+            // SQ заполнена: отправить пачку без ожидания и взять SQE снова
+            uring_->ring.enter(0);
+            recordSyscalls(1);
+            sqe = uring_->ring.getSqe();
+            if (!sqe) {
+                throw std::runtime_error("очередь отправки io_uring переполнена");
+            }
+        }
+        return sqe;
+    }
+
+    // Пробуждение: multishot poll на eventfd, один CQE на каждый wake()
+    void armWake() {
+        io_uring_sqe* sqe = nextSqe();
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = wake_fd_;
+        sqe->poll32_events = POLLIN;
+        sqe->len = IORING_POLL_ADD_MULTI;
+        sqe->user_data = makeUserData(UringOp::Wake, 0, 0);
+    }
+
+    // Completion: одна io_uring_enter отправляет пачку SQE и ждёт результатов
+    void runUringLoop() {
+        applyPending();
+
+        while (running_.load()) {
+            int result = uring_->ring.enter(1);
+            recordSyscalls(1);
+            if (result < 0 && result != -EINTR && result != -EAGAIN && result != -EBUSY) {
+                std::cerr << "Ошибка io_uring_enter: " << strerror(-result) << std::endl;
+                break;
+            }
+            uring_->ring.drainCompletions([this](const io_uring_cqe& cqe) { handleCompletion(cqe); });
+        }
+    }
+
+    void applyPending() {
+        std::vector<std::pair<int, std::shared_ptr<EventHandler>>> pending;
+        {
+            std::lock_guard<std::mutex> lock(handlers_mutex_);
+            pending.swap(pending_);
+        }
+        for (auto& [fd, handler] : pending) {
+            if (handler) {
+                addConnection(std::move(handler));
+            } else {
+                removeConnection(fd);
+            }
+        }
+    }
+
+    void addConnection(std::shared_ptr<EventHandler> handler) {
+        int fd = handler->getFileDescriptor();
+        removeConnection(fd);
+        UringConnection& connection = uring_->connections[fd];
+        connection.handler = std::move(handler);
+        connection.generation = uring_->next_generation++ & 0xFFFFFF;
+        armConnection(fd, connection);
+    }
+
+    // Отменить multishot-операцию; отправка в полёте завершится сама
+    void removeConnection(int fd) {
+        auto it = uring_->connections.find(fd);
+        if (it == uring_->connections.end()) return;
+        UringConnection& connection = it->second;
+
+        io_uring_sqe* sqe = nextSqe();
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = connection.armed;
+        sqe->user_data = makeUserData(UringOp::Cancel, 0, 0);
+
+        for (size_t i = connection.send_in_flight ? 1 : 0; i < connection.sends.size(); ++i) {
+            uring_->send_buffers.release(connection.sends[i]);
+        }
+        uring_->connections.erase(it);
+    }
+
+    UringConnection* findConnection(int fd, uint32_t generation) {
+        auto it = uring_->connections.find(fd);
+        if (it == uring_->connections.end() || it->second.generation != generation) {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    void armConnection(int fd, UringConnection& connection) {
+        io_uring_sqe* sqe = nextSqe();
+        sqe->fd = fd;
+        UringOp op = UringOp::Poll;
+        switch (connection.handler->getKind()) {
+            case HandlerKind::Acceptor:
+                op = UringOp::Accept;
+                sqe->opcode = IORING_OP_ACCEPT;
+                sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+                sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+                break;
+            case HandlerKind::Stream:
+                op = UringOp::Receive;
+                sqe->opcode = IORING_OP_RECV;
+                sqe->ioprio = IORING_RECV_MULTISHOT;
+                sqe->flags = IOSQE_BUFFER_SELECT;
+                sqe->buf_group = ProvidedBufferRing::kGroupId;
+                break;
+            case HandlerKind::Readiness:
+                sqe->opcode = IORING_OP_POLL_ADD;
+                sqe->poll32_events = POLLIN;
+                sqe->len = IORING_POLL_ADD_MULTI;
+                break;
+        }
+        connection.armed = makeUserData(op, connection.generation, static_cast<uint32_t>(fd));
+        sqe->user_data = connection.armed;
+    }
+
+    void handleCompletion(const io_uring_cqe& cqe) {
+        auto op = static_cast<UringOp>(cqe.user_data >> 56);
+        uint32_t generation = static_cast<uint32_t>(cqe.user_data >> 32) & 0xFFFFFF;
+        uint32_t index = static_cast<uint32_t>(cqe.user_data);
+        bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+
+        switch (op) {
+            case UringOp::Wake: {
+                uint64_t value;
+                ssize_t drained = read(wake_fd_, &value, sizeof(value));
+                (void)drained;
+                recordSyscalls(1);
+                applyPending();
+                runPosted();
+                if (!more) armWake();
+                break;
+            }
+            case UringOp::Accept:
+            case UringOp::Poll:
+            case UringOp::Receive:
+                handleMultishot(op, static_cast<int>(index), generation, cqe);
+                break;
+            case UringOp::Send:
+                handleSendCompletion(index, cqe);
+                break;
+            case UringOp::Cancel:
+                break;
+        }
+    }
+
+    void handleMultishot(UringOp op, int fd, uint32_t generation, const io_uring_cqe& cqe) {
+        bool has_buffer = (cqe.flags & IORING_CQE_F_BUFFER) != 0;
+        auto bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        UringConnection* connection = findConnection(fd, generation);
+
+        if (!connection) {
+            // Соединение уже снято: вернуть буфер и, если accept успел, закрыть fd
+            if (has_buffer) uring_->receive_buffers.recycle(bid);
+            if (op == UringOp::Accept && cqe.res >= 0) close(cqe.res);
+            return;
+        }
+
+        std::shared_ptr<EventHandler> handler = connection->handler;
+        bool closed = false;
+        if (op == UringOp::Accept) {
+            if (cqe.res >= 0) {
+                dispatch(handler, read_events_, [&] { handler->handleAccepted(cqe.res); });
+            } else if (cqe.res != -ECANCELED) {
+                error_events_.fetch_add(1, std::memory_order_relaxed);
+            }
+        } else if (op == UringOp::Poll) {
+            if (cqe.res >= 0) {
+                auto type = (cqe.res & (POLLERR | POLLHUP)) ? ReactorEventType::ERROR : ReactorEventType::READ;
+                dispatch(handler, type == ReactorEventType::READ ? read_events_ : error_events_,
+                         [&] { handler->handleEvent(type); });
+            }
+        } else if (cqe.res > 0 && has_buffer) {
+            const char* data = uring_->receive_buffers.data(bid);
+            dispatch(handler, read_events_, [&] { handler->handleReceived(data, static_cast<size_t>(cqe.res)); });
+        } else if (cqe.res != -ENOBUFS) {
+            // 0 - клиент закрыл соединение, < 0 - ошибка
+            closed = true;
+        }
+        if (has_buffer) {
+            uring_->receive_buffers.recycle(bid);
+        }
+
+        if (closed) {
+            dispatch(handler, error_events_, [&] { handler->handleClosed(); });
+            return;
+        }
+        // Обработчик мог снять себя; иначе перевооружить завершившийся multishot
+        connection = findConnection(fd, generation);
+        if (connection && !(cqe.flags & IORING_CQE_F_MORE)) {
+            armConnection(fd, *connection);
+        }
+    }
+
+    void flushSends(UringConnection& connection) {
+        if (connection.send_in_flight || connection.sends.empty()) return;
+        connection.send_in_flight = true;
+        submitSend(connection.sends.front());
+    }
+
+    void submitSend(uint32_t index) {
+        SendBuffer& buffer = uring_->send_buffers[index];
+        io_uring_sqe* sqe = nextSqe();
+        sqe->fd = buffer.fd;
+        sqe->addr = reinterpret_cast<uint64_t>(buffer.data + buffer.offset);
+        sqe->len = static_cast<uint32_t>(buffer.size - buffer.offset);
+        sqe->msg_flags = MSG_NOSIGNAL;
+        sqe->user_data = makeUserData(UringOp::Send, 0, index);
+
+        // Полный зарегистрированный слот - zero-copy без закрепления страниц
+        bool zero_copy = uring_->zero_copy && uring_->send_buffers.registered() &&
+                         buffer.fixed_index >= 0 && buffer.size == SendBufferPool::kSlotSize;
+        if (zero_copy) {
+            sqe->opcode = IORING_OP_SEND_ZC;
+            sqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+            sqe->buf_index = static_cast<uint16_t>(buffer.fixed_index);
+        } else {
+            sqe->opcode = IORING_OP_SEND;
+        }
+    }
+
+    void finishSendBuffer(uint32_t index) {
+        SendBuffer& buffer = uring_->send_buffers[index];
+        buffer.finished = true;
+        if (buffer.notifications == 0) {
+            uring_->send_buffers.release(index);
+        }
+    }
+
+    void handleSendCompletion(uint32_t index, const io_uring_cqe& cqe) {
+        SendBuffer& buffer = uring_->send_buffers[index];
+        if (cqe.flags & IORING_CQE_F_NOTIF) {
+            // Ядро отпустило страницы zero-copy send: слот можно переиспользовать
+            if (--buffer.notifications == 0 && buffer.finished) {
+                uring_->send_buffers.release(index);
+            }
+            return;
+        }
+        if (cqe.flags & IORING_CQE_F_MORE) {
+            ++buffer.notifications;
+        }
+
+        int fd = buffer.fd;
+        UringConnection* connection = findConnection(fd, buffer.generation);
+        if (!connection) {
+            finishSendBuffer(index);
+            return;
+        }
+        if ((cqe.res == -EOPNOTSUPP || cqe.res == -EINVAL) && uring_->zero_copy) {
+            uring_->zero_copy = false;  // сокет без поддержки SEND_ZC
+            submitSend(index);
+            return;
+        }
+        if (cqe.res > 0) {
+            buffer.offset += static_cast<size_t>(cqe.res);
+            if (buffer.offset < buffer.size) {
+                submitSend(index);  // частичная отправка: дослать остаток
+                return;
+            }
+        }
+
+        finishSendBuffer(index);
+        connection->sends.pop_front();
+        connection->send_in_flight = false;
+        if (cqe.res < 0) {
+            std::shared_ptr<EventHandler> handler = connection->handler;
+            dispatch(handler, error_events_, [&] { handler->handleClosed(); });
+            return;
+        }
+        write_events_.fetch_add(1, std::memory_order_relaxed);
+        events_processed_.fetch_add(1, std::memory_order_relaxed);
+        flushSends(*connection);
+    }
+#endif
+};
+
+// Обработка запроса: по принятым байтам дописать ответ в response.
+// request - срез слаба: response.append(request) ссылается на него без копии.
+using RequestCallback = std::function<void(const cpp_patterns::BufferSlice& request,
+                                           cpp_patterns::BufferChain& response)>;
+
+// Ответ демо-сервера: один экземпляр на все соединения, в цепочку без копирования
+inline const cpp_patterns::IntrusivePtr<cpp_patterns::SharedPayload>& helloResponse() {
+    static const auto payload = cpp_patterns::makeIntrusive<cpp_patterns::SharedPayload>(
+        "HTTP/1.1 200 OK\r\n\r\nHello from Reactor Pattern!");
+    return payload;
+}
+
+// Обработчик для TCP клиента
+class TCPClientHandler : public EventHandler {
+private:
+    int client_fd_;
+    Reactor& reactor_;
+    RequestCallback on_request_;
+    cpp_patterns::ReadBuffer input_;
+    cpp_patterns::BufferChain output_;
+    bool connection_closed_{false};
+    bool write_interest_{false};
+
+public:
+    TCPClientHandler(int fd, Reactor& reactor, RequestCallback on_request = {})
+        : client_fd_(fd), reactor_(reactor), on_request_(std::move(on_request)) {}
+
+    ~TCPClientHandler() {
+        if (client_fd_ >= 0) {
+            close(client_fd_);
+        }
+    }
+
+    void handleEvent(ReactorEventType event_type) override {
+        switch (event_type) {
+            case ReactorEventType::READ:
+                handleRead();
+                break;
+            case ReactorEventType::WRITE:
+                handleWrite();
+                break;
+            case ReactorEventType::ERROR:
+                handleError();
+                break;
+            default:
+                break;
+        }
+    }
+
+    int getFileDescriptor() const override {
+        return client_fd_;
+    }
+
+    std::string getName() const override {
+        return "TCPClientHandler_" + std::to_string(client_fd_);
+    }
+
+    HandlerKind getKind() const override {
+        return HandlerKind::Stream;
+    }
+
+    // io_uring: байты уже прочитаны ядром в буфер кольца, ответ уходит через send.
+    // Буфер кольца вернётся ядру после вызова, поэтому срез заимствованный.
+    void handleReceived(const char* data, size_t size) override {
+        respond(cpp_patterns::BufferSlice::borrowed(data, size));
+        output_.forEachSegment([this](const char* segment, size_t length) {
+            reactor_.send(client_fd_, segment, length);
+        });
+        output_.clear();
+    }
+
+    void handleClosed() override {
+        if (connection_closed_) return;
+        if (!on_request_) {
+            std::cout << "Клиент " << client_fd_ << " отключился" << std::endl;
+        }
+        connection_closed_ = true;
+        reactor_.unregisterHandler(client_fd_);
+    }
+
+private:
+    void respond(const cpp_patterns::BufferSlice& request) {
+        if (on_request_) {
+            on_request_(request, output_);
+            return;
+        }
+        std::cout << "Получены данные от клиента " << client_fd_
+                  << ": " << request.view() << std::endl;
+
+        // Подготавливаем ответ
+        output_.append(helloResponse());
+    }
+
+    void handleRead() {
+        cpp_patterns::BufferSlice request;
+        ssize_t bytes_read = input_.readFrom(client_fd_, request);
+        reactor_.recordSyscalls(1);
+
+        if (bytes_read > 0) {
+            respond(request);
+            // Сокет почти всегда готов к записи: пишем сразу, без круга через epoll
+            handleWrite();
+        } else if (bytes_read == 0) {
+            // Соединение закрыто клиентом
+            handleClosed();
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "Ошибка чтения от клиента " << client_fd_
+                          << ": " << strerror(errno) << std::endl;
+                connection_closed_ = true;
+                reactor_.unregisterHandler(client_fd_);
+            }
+        }
+    }
+
+    // Векторная запись всей цепочки; частичная запись только сдвигает смещение
+    void handleWrite() {
+        while (!output_.empty() && !connection_closed_) {
+            ssize_t bytes_written = output_.sendTo(client_fd_);
+            reactor_.recordSyscalls(1);
+
+            if (bytes_written > 0) {
+                if (!on_request_ && output_.empty()) {
+                    std::cout << "Отправлен ответ клиенту " << client_fd_ << std::endl;
+                }
+            } else if (bytes_written < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                std::cerr << "Ошибка записи клиенту " << client_fd_
+                          << ": " << strerror(errno) << std::endl;
+                connection_closed_ = true;
+                reactor_.unregisterHandler(client_fd_);
+                return;
+            }
+        }
+        // EPOLLOUT нужен только пока в буфере остались данные
+        bool want_write = !output_.empty() && !connection_closed_;
+        if (want_write != write_interest_) {
+            write_interest_ = want_write;
+            reactor_.setWriteInterest(client_fd_, want_write);
+        }
+    }
+
+    void handleError() {
+        std::cerr << "Ошибка в клиентском соединении " << client_fd_ << std::endl;
+        connection_closed_ = true;
+        reactor_.unregisterHandler(client_fd_);
+    }
+};
+
+// Обработчик для TCP сервера
+class TCPServerHandler : public EventHandler {
+private:
+    int server_fd_;
+    int port_;
+    Reactor& reactor_;
+    RequestCallback on_request_;
+    std::atomic<int> connection_count_{0};
+    bool reuse_port_{false};
+    std::function<void(int)> dispatcher_;
+
+public:
+    TCPServerHandler(int port, Reactor& reactor, RequestCallback on_request = {})
+        : server_fd_(-1), port_(port), reactor_(reactor), on_request_(std::move(on_request)) {}
+
+    // SO_REUSEPORT: несколько слушающих сокетов на одном порту, по одному на цикл
+    void setReusePort(bool enabled) {
+        reuse_port_ = enabled;
+    }
+
+    // Передавать принятые fd другим циклам вместо регистрации в своём
+    void setConnectionDispatcher(std::function<void(int)> dispatcher) {
+        dispatcher_ = std::move(dispatcher);
+    }
+
+    ~TCPServerHandler() {
+        if (server_fd_ >= 0) {
+            close(server_fd_);
+        }
+    }
+
+    void start() {
+        // Создаем сокет
+        server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        if (server_fd_ < 0) {
+            throw std::runtime_error("Не удалось создать сокет");
+        }
+        int enable = 1;
+        setsockopt(server_fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        if (reuse_port_) {
+            setsockopt(server_fd_, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+        }
+
+        // Настраиваем адрес
+        struct sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = INADDR_ANY;
+        address.sin_port = htons(port_);
+
+        // Привязываем сокет
+        if (bind(server_fd_, (struct sockaddr*)&address, sizeof(address)) < 0) {
+            close(server_fd_);
+            server_fd_ = -1;
+            throw std::runtime_error("Не удалось привязать сокет");
+        }
+
+        // Слушаем соединения
+        if (listen(server_fd_, SOMAXCONN) < 0) {
+            close(server_fd_);
+            server_fd_ = -1;
+            throw std::runtime_error("Не удалось начать прослушивание");
+        }
+
+        // Делаем сокет неблокирующим
+        int flags = fcntl(server_fd_, F_GETFL, 0);
+        fcntl(server_fd_, F_SETFL, flags | O_NONBLOCK);
+
+        // Порт 0: ядро выбрало свободный порт
+        socklen_t length = sizeof(address);
+        getsockname(server_fd_, (struct sockaddr*)&address, &length);
+        port_ = ntohs(address.sin_port);
+
+        if (!on_request_) {
+            std::cout << "TCP сервер запущен на порту " << port_ << std::endl;
+        }
+    }
+
+    void handleEvent(ReactorEventType event_type) override {
+        switch (event_type) {
+            case ReactorEventType::READ:
+                handleNewConnection();
+                break;
+            case ReactorEventType::ERROR:
+                std::cerr << "Ошибка в серверном сокете" << std::endl;
+                break;
+            default:
+                break;
+        }
+    }
+
+    int getFileDescriptor() const override {
+        return server_fd_;
+    }
+
+    std::string getName() const override {
+        return "TCPServerHandler";
+    }
+
+    HandlerKind getKind() const override {
+        return HandlerKind::Acceptor;
+    }
+
+    // Готовое соединение: из accept в режиме epoll или из multishot accept в io_uring
+    void handleAccepted(int client_fd) override {
+        connection_count_.fetch_add(1);
+        if (!on_request_) {
+            std::cout << "Новое соединение принято, fd=" << client_fd
+                      << " (всего: " << connection_count_.load() << ")" << std::endl;
+        }
+        if (dispatcher_) {
+            dispatcher_(client_fd);
+            return;
+        }
+
+        // Создаем обработчик для клиента
+        auto client_handler = std::make_shared<TCPClientHandler>(client_fd, reactor_, on_request_);
+        reactor_.registerHandler(client_handler);
+    }
+
+    int getPort() const {
+        return port_;
+    }
+
+    int getConnectionCount() const {
+        return connection_count_.load();
+    }
+
+private:
+    void handleNewConnection() {
+        struct sockaddr_in client_address;
+        socklen_t client_len = sizeof(client_address);
+
+        // Клиентский сокет сразу неблокирующий
+        int client_fd = accept4(server_fd_, (struct sockaddr*)&client_address, &client_len, SOCK_NONBLOCK);
+        reactor_.recordSyscalls(1);
+
+        if (client_fd >= 0) {
+            handleAccepted(client_fd);
+        }
+    }
+};
+
+// Как соединения распределяются между циклами
+enum class ShardingMode {
+    ReusePort,  // у каждого цикла свой слушающий сокет, ядро делит соединения по хешу
+    Acceptor    // цикл 0 принимает соединения и передаёт их остальным через post
+};
+
+/**
+ * @brief Multi-reactor: N циклов событий, каждый закреплён за своим ядром
+ *
+ * Соединение обслуживается одним циклом от accept до close, поэтому его
+ * обработчик не нуждается в блокировках, а данные остаются в кэше одного
+ * ядра. Общение между циклами - только через Reactor::post.
+ */
+class MultiReactorServer {
+private:
+    std::vector<std::unique_ptr<Reactor>> reactors_;
+    std::vector<std::shared_ptr<TCPServerHandler>> listeners_;
+    std::vector<int> cpus_;
+    ShardingMode mode_;
+    std::atomic<size_t> next_loop_{0};
+    int port_ = 0;
+
+public:
+    MultiReactorServer(size_t loops, int port, RequestCallback on_request,
+                       ShardingMode mode = ShardingMode::ReusePort,
+                       ReactorBackend backend = ReactorBackend::Auto,
+                       cpp_patterns::ThreadPlacement placement = cpp_patterns::ThreadPlacement::compact())
+        : mode_(mode), port_(port) {
+        if (loops == 0) {
+            throw std::invalid_argument("MultiReactorServer: нужен хотя бы один цикл");
+        }
+        cpus_ = placement.assign(loops);
+        for (size_t i = 0; i < loops; ++i) {
+            reactors_.push_back(std::make_unique<Reactor>(backend));
+            reactors_.back()->setHandlerLogging(false);
+        }
+
+        size_t listener_count = mode_ == ShardingMode::ReusePort ? loops : 1;
+        for (size_t i = 0; i < listener_count; ++i) {
+            auto listener = std::make_shared<TCPServerHandler>(port_, *reactors_[i], on_request);
+            listener->setReusePort(mode_ == ShardingMode::ReusePort);
+            if (mode_ == ShardingMode::Acceptor) {
+                listener->setConnectionDispatcher(
+                    [this, on_request](int client_fd) { dispatch(client_fd, on_request); });
+            }
+            listener->start();
+            port_ = listener->getPort();  // порт 0: остальные слушают выбранный ядром
+            listeners_.push_back(std::move(listener));
+        }
+    }
+
+    ~MultiReactorServer() {
+        stop();
+    }
+
+    void start() {
+        for (size_t i = 0; i < reactors_.size(); ++i) {
+            reactors_[i]->start(cpus_[i]);
+        }
+        for (size_t i = 0; i < listeners_.size(); ++i) {
+            reactors_[i]->registerHandler(listeners_[i]);
+        }
+    }
+
+    void stop() {
+        for (auto& reactor : reactors_) {
+            reactor->stop();
+        }
+    }
+
+    int getPort() const { return port_; }
+    size_t loopCount() const { return reactors_.size(); }
+    Reactor& loop(size_t index) { return *reactors_[index]; }
+
+    // Соединения, принятые каждым слушающим сокетом
+    std::vector<int> getConnectionCounts() const {
+        std::vector<int> counts;
+        for (const auto& listener : listeners_) {
+            counts.push_back(listener->getConnectionCount());
+        }
+        return counts;
+    }
+
+    std::string describePlacement() const {
+        std::string text;
+        for (size_t i = 0; i < cpus_.size(); ++i) {
+            text += (i ? "," : "") + (cpus_[i] >= 0 ? std::to_string(cpus_[i]) : std::string("-"));
+        }
+        return text;
+    }
+
+private:
+    // Acceptor-режим: fd уходит следующему циклу по кругу и регистрируется уже на его потоке
+    void dispatch(int client_fd, const RequestCallback& on_request) {
+        Reactor& target = *reactors_[next_loop_.fetch_add(1, std::memory_order_relaxed) % reactors_.size()];
+        target.post([&target, client_fd, on_request]() {
+            target.registerHandler(std::make_shared<TCPClientHandler>(client_fd, target, on_request));
+        });
+    }
+};
+
+// Обработчик для таймера
+class TimerHandler : public EventHandler {
+private:
+    int timer_fd_;
+    Reactor& reactor_;
+    std::chrono::milliseconds interval_;
+    std::function<void()> callback_;
+    std::atomic<int> tick_count_{0};
+    
+public:
+    TimerHandler(std::chrono::milliseconds interval, 
+                 std::function<void()> callback,
+                 Reactor& reactor) 
+        : timer_fd_(-1), reactor_(reactor), interval_(interval), callback_(std::move(callback)) {}
+    
+    ~TimerHandler() {
+        if (timer_fd_ >= 0) {
+            close(timer_fd_);
+        }
+    }
+    
+    void start() {
+        // Создаем timerfd (Linux-специфичный)
+        timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+        if (timer_fd_ < 0) {
+            throw std::runtime_error("Не удалось создать timer");
+        }
+        
+        // Настраиваем таймер
+        struct itimerspec timer_spec;
+        timer_spec.it_value.tv_sec = interval_.count() / 1000;
+        timer_spec.it_value.tv_nsec = (interval_.count() % 1000) * 1000000;
+        timer_spec.it_interval.tv_sec = interval_.count() / 1000;
+        timer_spec.it_interval.tv_nsec = (interval_.count() % 1000) * 1000000;
+        
+        if (timerfd_settime(timer_fd_, 0, &timer_spec, nullptr) < 0) {
+            close(timer_fd_);
+            throw std::runtime_error("Не удалось настроить таймер");
+        }
+        
+        std::cout << "Timer запущен с интервалом " << interval_.count() << " мс" << std::endl;
+    }
+    
+    void handleEvent(ReactorEventType event_type) override {
+        if (event_type == ReactorEventType::READ) {
+            uint64_t expirations;
+            ssize_t bytes_read = read(timer_fd_, &expirations, sizeof(expirations));
+            
+            if (bytes_read > 0) {
+                tick_count_.fetch_add(expirations);
+                std::cout << "Timer сработал (тик " << tick_count_.load() << ")" << std::endl;
+                
+                if (callback_) {
+                    callback_();
+                }
+            }
+        }
+    }
+    
+    int getFileDescriptor() const override {
+        return timer_fd_;
+    }
+    
+    std::string getName() const override {
+        return "TimerHandler";
+    }
+    
+    int getTickCount() const {
+        return tick_count_.load();
+    }
+};
@@ -0,0 +1,417 @@
+/**
+ * @file cache_aside_pattern.h
+ * @brief Кэши урока Cache-Aside: LRU и LFU с TTL, многоуровневый L1/L2
+ *
+ * Вынесены из cache_aside_pattern.cpp, чтобы бенчмарки (benchmarks/bench_caches.cpp)
+ * и нагрузочный сценарий (loadtest/scenario_cache_aside.cpp) замеряли те же
+ * классы, что показывает урок, а не их упрощённые копии.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "tracing.h"
+
+// Базовый интерфейс для кэша
+template<typename Key, typename Value>
+class CacheInterface {
+public:
+    virtual ~CacheInterface() = default;
+    virtual bool get(const Key& key, Value& value) = 0;
+    virtual void put(const Key& key, const Value& value) = 0;
+    virtual void remove(const Key& key) = 0;
+    virtual void clear() = 0;
+    virtual size_t size() const = 0;
+    virtual bool contains(const Key& key) const = 0;
+    virtual void printStats() const = 0;
+};
+
+// Элемент кэша с временными метками
+template<typename Value>
+struct CacheEntry {
+    Value value;
+    std::chrono::steady_clock::time_point created_at;
+    std::chrono::steady_clock::time_point last_accessed;
+    std::chrono::milliseconds ttl;
+    
+    // «Без TTL»: наибольший срок, который ещё переводится в тики steady_clock
+    // без переполнения (milliseconds::max() в наносекундах не помещается)
+    static constexpr std::chrono::milliseconds kNoTtl =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::duration::max());
+    
+    // Нужен operator[] контейнера; запись без TTL
+    CacheEntry() : CacheEntry(Value{}, kNoTtl) {}
+    
+    CacheEntry(const Value& val, std::chrono::milliseconds ttl_duration)
+        : value(val), ttl(ttl_duration) {
+        auto now = std::chrono::steady_clock::now();
+        created_at = now;
+        last_accessed = now;
+    }
+    
+    bool isExpired() const {
+        if (ttl == kNoTtl) {
+            return false;
+        }
+        auto now = std::chrono::steady_clock::now();
+        return (now - created_at) > ttl;
+    }
+    
+    void updateAccess() {
+        last_accessed = std::chrono::steady_clock::now();
+    }
+};
+
+// LRU кэш с TTL
+template<typename Key, typename Value>
+class LRUCache : public CacheInterface<Key, Value> {
+private:
+    size_t capacity_;
+    std::list<std::pair<Key, Value>> items_;
+    std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator> cache_map_;
+    mutable std::mutex mutex_;
+    
+    // TTL поддержка
+    std::unordered_map<Key, CacheEntry<Value>> ttl_entries_;
+    
+public:
+    LRUCache(size_t capacity) : capacity_(capacity) {
+        std::cout << "LRU Cache создан с емкостью " << capacity << std::endl;
+    }
+    
+    bool get(const Key& key, Value& value) override {
+        TRACE_ZONE_CAT("lru.get", "cache");
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        auto it = cache_map_.find(key);
+        if (it == cache_map_.end()) {
+            return false;
+        }
+        
+        // Проверяем TTL
+        auto ttl_it = ttl_entries_.find(key);
+        if (ttl_it != ttl_entries_.end() && ttl_it->second.isExpired()) {
+            // Элемент истек, удаляем
+            items_.erase(it->second);
+            cache_map_.erase(it);
+            ttl_entries_.erase(ttl_it);
+            return false;
+        }
+        
+        // Обновляем время доступа
+        if (ttl_it != ttl_entries_.end()) {
+            ttl_it->second.updateAccess();
+        }
+        
+        // Перемещаем в начало списка (самый недавно использованный)
+        items_.splice(items_.begin(), items_, it->second);
+        value = it->second->second;
+        
+        return true;
+    }
+    
+    void put(const Key& key, const Value& value) override {
+        TRACE_ZONE_CAT("lru.put", "cache");
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        auto it = cache_map_.find(key);
+        if (it != cache_map_.end()) {
+            // Обновляем существующий элемент
+            it->second->second = value;
+            items_.splice(items_.begin(), items_, it->second);
+            ttl_entries_[key].updateAccess();
+            return;
+        }
+        
+        // Проверяем емкость
+        if (items_.size() >= capacity_) {
+            // Удаляем самый старый элемент
+            auto last = items_.back();
+            cache_map_.erase(last.first);
+            ttl_entries_.erase(last.first);
+            items_.pop_back();
+        }
+        
+        // Добавляем новый элемент
+        items_.emplace_front(key, value);
+        cache_map_[key] = items_.begin();
+        ttl_entries_[key] = CacheEntry<Value>(value, std::chrono::minutes(5)); // TTL 5 минут
+    }
+    
+    void remove(const Key& key) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        auto it = cache_map_.find(key);
+        if (it != cache_map_.end()) {
+            items_.erase(it->second);
+            cache_map_.erase(it);
+            ttl_entries_.erase(key);
+        }
+    }
+    
+    void clear() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        items_.clear();
+        cache_map_.clear();
+        ttl_entries_.clear();
+    }
+    
+    size_t size() const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+    
+    bool contains(const Key& key) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cache_map_.find(key) != cache_map_.end();
+    }
+    
+    void printStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::cout << "LRU Cache: размер=" << items_.size() 
+                  << ", емкость=" << capacity_ << std::endl;
+    }
+};
+
+// LFU кэш с TTL
+template<typename Key, typename Value>
+class LFUCache : public CacheInterface<Key, Value> {
+private:
+    size_t capacity_;
+    std::unordered_map<Key, Value> cache_;
+    std::unordered_map<Key, int> frequencies_;
+    std::unordered_map<int, std::list<Key>> frequency_lists_;
+    std::unordered_map<Key, typename std::list<Key>::iterator> key_iterators_;
+    mutable std::mutex mutex_;
+    
+    // TTL поддержка
+    std::unordered_map<Key, CacheEntry<Value>> ttl_entries_;
+    
+    int min_frequency_;
+    
+public:
+    LFUCache(size_t capacity) : capacity_(capacity), min_frequency_(0) {
+        std::cout << "LFU Cache создан с емкостью " << capacity << std::endl;
+    }
+    
+    bool get(const Key& key, Value& value) override {
+        TRACE_ZONE_CAT("lfu.get", "cache");
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        auto it = cache_.find(key);
+        if (it == cache_.end()) {
+            return false;
+        }
+        
+        // Проверяем TTL
+        auto ttl_it = ttl_entries_.find(key);
+        if (ttl_it != ttl_entries_.end() && ttl_it->second.isExpired()) {
+            removeKey(key);
+            return false;
+        }
+        
+        // Обновляем частоту использования
+        updateFrequency(key);
+        value = it->second;
+        
+        return true;
+    }
+    
+    void put(const Key& key, const Value& value) override {
+        TRACE_ZONE_CAT("lfu.put", "cache");
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        if (cache_.find(key) != cache_.end()) {
+            // Обновляем существующий элемент
+            cache_[key] = value;
+            updateFrequency(key);
+            ttl_entries_[key].updateAccess();
+            return;
+        }
+        
+        // Проверяем емкость
+        if (cache_.size() >= capacity_) {
+            evictLFU();
+        }
+        
+        // Добавляем новый элемент
+        cache_[key] = value;
+        frequencies_[key] = 1;
+        frequency_lists_[1].push_back(key);
+        key_iterators_[key] = --frequency_lists_[1].end();
+        min_frequency_ = 1;
+        ttl_entries_[key] = CacheEntry<Value>(value, std::chrono::minutes(5));
+    }
+    
+    void remove(const Key& key) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        removeKey(key);
+    }
+    
+    void clear() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.clear();
+        frequencies_.clear();
+        frequency_lists_.clear();
+        key_iterators_.clear();
+        ttl_entries_.clear();
+        min_frequency_ = 0;
+    }
+    
+    size_t size() const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cache_.size();
+    }
+    
+    bool contains(const Key& key) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cache_.find(key) != cache_.end();
+    }
+    
+    void printStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::cout << "LFU Cache: размер=" << cache_.size() 
+                  << ", емкость=" << capacity_ << std::endl;
+    }
+    
+private:
+    void updateFrequency(const Key& key) {
+        int freq = frequencies_[key];
+        frequencies_[key]++;
+        
+        // Удаляем из старого списка частот
+        frequency_lists_[freq].erase(key_iterators_[key]);
+        
+        // Добавляем в новый список частот
+        frequency_lists_[freq + 1].push_back(key);
+        key_iterators_[key] = --frequency_lists_[freq + 1].end();
+        
+        // Обновляем минимальную частоту
+        if (frequency_lists_[min_frequency_].empty()) {
+            min_frequency_++;
+        }
+    }
+    
+    void evictLFU() {
+        // removeKey сам убирает ключ из списка частот по сохранённому итератору
+        Key key_to_remove = frequency_lists_[min_frequency_].front();
+        removeKey(key_to_remove);
+    }
+    
+    void removeKey(const Key& key) {
+        auto it = cache_.find(key);
+        if (it != cache_.end()) {
+            int freq = frequencies_[key];
+            frequency_lists_[freq].erase(key_iterators_[key]);
+            
+            cache_.erase(it);
+            frequencies_.erase(key);
+            key_iterators_.erase(key);
+            ttl_entries_.erase(key);
+        }
+    }
+};
+
+// Многоуровневый кэш (L1 + L2)
+template<typename Key, typename Value>
+class MultiLevelCache : public CacheInterface<Key, Value> {
+private:
+    std::unique_ptr<CacheInterface<Key, Value>> l1_cache_;  // Быстрый, маленький
+    std::unique_ptr<CacheInterface<Key, Value>> l2_cache_; // Медленный, большой
+    mutable std::mutex mutex_;
+    
+    // Статистика
+    std::atomic<size_t> l1_hits_{0};
+    std::atomic<size_t> l2_hits_{0};
+    std::atomic<size_t> misses_{0};
+    
+public:
+    MultiLevelCache(size_t l1_capacity, size_t l2_capacity) {
+        l1_cache_ = std::make_unique<LRUCache<Key, Value>>(l1_capacity);
+        l2_cache_ = std::make_unique<LFUCache<Key, Value>>(l2_capacity);
+        
+        std::cout << "MultiLevel Cache создан: L1=" << l1_capacity 
+                  << ", L2=" << l2_capacity << std::endl;
+    }
+    
+    bool get(const Key& key, Value& value) override {
+        TRACE_ZONE_CAT("multilevel.get", "cache");
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        // Проверяем L1 кэш
+        if (l1_cache_->get(key, value)) {
+            l1_hits_.fetch_add(1);
+            return true;
+        }
+        
+        // Проверяем L2 кэш
+        if (l2_cache_->get(key, value)) {
+            l2_hits_.fetch_add(1);
+            // Продвигаем в L1 кэш
+            l1_cache_->put(key, value);
+            return true;
+        }
+        
+        misses_.fetch_add(1);
+        return false;
+    }
+    
+    void put(const Key& key, const Value& value) override {
+        TRACE_ZONE_CAT("multilevel.put", "cache");
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        // Записываем в оба кэша
+        l1_cache_->put(key, value);
+        l2_cache_->put(key, value);
+    }
+    
+    void remove(const Key& key) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        l1_cache_->remove(key);
+        l2_cache_->remove(key);
+    }
+    
+    void clear() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        l1_cache_->clear();
+        l2_cache_->clear();
+    }
+    
+    size_t size() const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return l1_cache_->size() + l2_cache_->size();
+    }
+    
+    bool contains(const Key& key) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return l1_cache_->contains(key) || l2_cache_->contains(key);
+    }
+    
+    size_t getL1Hits() const { return l1_hits_.load(); }
+    size_t getL2Hits() const { return l2_hits_.load(); }
+    size_t getMisses() const { return misses_.load(); }
+    
+    void printStats() const {
+        std::cout << "\n=== MultiLevel Cache Statistics ===" << std::endl;
+        std::cout << "L1 Hits: " << l1_hits_.load() << std::endl;
+        std::cout << "L2 Hits: " << l2_hits_.load() << std::endl;
+        std::cout << "Misses: " << misses_.load() << std::endl;
+        
+        size_t total_requests = l1_hits_.load() + l2_hits_.load() + misses_.load();
+        if (total_requests > 0) {
+            double hit_rate = (double)(l1_hits_.load() + l2_hits_.load()) / total_requests * 100;
+            std::cout << "Hit Rate: " << hit_rate << "%" << std::endl;
+        }
+        
+        l1_cache_->printStats();
+        l2_cache_->printStats();
+        std::cout << "================================" << std::endl;
+    }
+};
@@ -16,338 +16,10 @@
 #include <chrono>
 #include <atomic>
 #include <thread>
-#include <queue>
 #include <functional>
-#include <random>
 #include <optional>
 
-// Состояния Circuit Breaker
-enum class CircuitState {
-    CLOSED,       // Нормальная работа
-    OPEN,         // Отказ, запросы блокируются
-    HALF_OPEN     // Восстановление, пробные запросы
-};
-
-// Конфигурация Circuit Breaker
-struct CircuitBreakerConfig {
-    size_t failure_threshold;           // Порог ошибок для открытия
-    size_t success_threshold;           // Порог успехов для закрытия
-    std::chrono::milliseconds timeout;  // Таймаут в открытом состоянии
-    std::chrono::milliseconds request_timeout;  // Таймаут запроса
-    
-    CircuitBreakerConfig(
-        size_t fail_threshold = 5,
-        size_t success_threshold = 2,
-        std::chrono::milliseconds circuit_timeout = std::chrono::seconds(10),
-        std::chrono::milliseconds req_timeout = std::chrono::seconds(5))
-        : failure_threshold(fail_threshold),
-          success_threshold(success_threshold),
-          timeout(circuit_timeout),
-          request_timeout(req_timeout) {}
-};
-
-// Circuit Breaker с метриками
-class CircuitBreaker {
-private:
-    std::string name_;
-    CircuitBreakerConfig config_;
-    
-    std::atomic<CircuitState> state_{CircuitState::CLOSED};
-    std::atomic<size_t> failure_count_{0};
-    std::atomic<size_t> success_count_{0};
-    std::chrono::system_clock::time_point last_failure_time_;
-    
-    mutable std::mutex mutex_;
-    
-    // Статистика
-    std::atomic<size_t> total_requests_{0};
-    std::atomic<size_t> successful_requests_{0};
-    std::atomic<size_t> failed_requests_{0};
-    std::atomic<size_t> rejected_requests_{0};
-    
-public:
-    explicit CircuitBreaker(const std::string& name, 
-                           const CircuitBreakerConfig& config = CircuitBreakerConfig())
-        : name_(name), config_(config) {
-        last_failure_time_ = std::chrono::system_clock::now();
-        std::cout << "Circuit Breaker '" << name_ << "' создан" << std::endl;
-    }
-    
-    // Выполнение операции через Circuit Breaker
-    template<typename F>
-    auto execute(F&& func) -> decltype(func()) {
-        total_requests_.fetch_add(1);
-        
-        // Проверяем состояние
-        if (state_.load() == CircuitState::OPEN) {
-            // Проверяем, не пора ли перейти в HALF_OPEN
-            if (shouldAttemptReset()) {
-                std::cout << "[" << name_ << "] Переход OPEN -> HALF_OPEN" << std::endl;
-                state_.store(CircuitState::HALF_OPEN);
-            } else {
-                rejected_requests_.fetch_add(1);
-                throw std::runtime_error("Circuit Breaker OPEN: запрос отклонен");
-            }
-        }
-        
-        try {
-            // Выполняем операцию
-            auto result = func();
-            
-            // Успех
-            onSuccess();
-            return result;
-            
-        } catch (const std::exception& e) {
-            // Неудача
-            onFailure();
-            throw;
-        }
-    }
-    
-    // Получение текущего состояния
-    CircuitState getState() const {
-        return state_.load();
-    }
-    
-    std::string getStateName() const {
-        switch (state_.load()) {
-            case CircuitState::CLOSED: return "CLOSED";
-            case CircuitState::OPEN: return "OPEN";
-            case CircuitState::HALF_OPEN: return "HALF_OPEN";
-            default: return "UNKNOWN";
-        }
-    }
-    
-    // Статистика
-    void printStats() const {
-        double success_rate = total_requests_.load() > 0 
-            ? (100.0 * successful_requests_.load() / total_requests_.load()) 
-            : 0.0;
-        
-        std::cout << "\n=== Circuit Breaker '" << name_ << "' Statistics ===" << std::endl;
-        std::cout << "Состояние: " << getStateName() << std::endl;
-        std::cout << "Всего запросов: " << total_requests_.load() << std::endl;
-        std::cout << "Успешных: " << successful_requests_.load() << std::endl;
-        std::cout << "Неудачных: " << failed_requests_.load() << std::endl;
-        std::cout << "Отклоненных: " << rejected_requests_.load() << std::endl;
-        std::cout << "Success Rate: " << success_rate << "%" << std::endl;
-        std::cout << "Текущий счетчик ошибок: " << failure_count_.load() << std::endl;
-        std::cout << "Текущий счетчик успехов: " << success_count_.load() << std::endl;
-        std::cout << "================================================" << std::endl;
-    }
-    
-    // Ручной сброс
-    void reset() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        state_.store(CircuitState::CLOSED);
-        failure_count_.store(0);
-        success_count_.store(0);
-        std::cout << "[" << name_ << "] Ручной сброс Circuit Breaker" << std::endl;
-    }
-    
-private:
-    void onSuccess() {
-        successful_requests_.fetch_add(1);
-        
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        CircuitState current_state = state_.load();
-        
-        if (current_state == CircuitState::HALF_OPEN) {
-            size_t successes = success_count_.fetch_add(1) + 1;
-            
-            std::cout << "[" << name_ << "] HALF_OPEN успех " << successes 
-                      << "/" << config_.success_threshold << std::endl;
-            
-            if (successes >= config_.success_threshold) {
-                std::cout << "[" << name_ << "] Переход HALF_OPEN -> CLOSED" << std::endl;
-                state_.store(CircuitState::CLOSED);
-                failure_count_.store(0);
-                success_count_.store(0);
-            }
-        } else if (current_state == CircuitState::CLOSED) {
-            // В закрытом состоянии сбрасываем счетчик ошибок при успехе
-            failure_count_.store(0);
-        }
-    }
-    
-    void onFailure() {
-        failed_requests_.fetch_add(1);
-        
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        last_failure_time_ = std::chrono::system_clock::now();
-        
-        CircuitState current_state = state_.load();
-        
-        if (current_state == CircuitState::HALF_OPEN) {
-            std::cout << "[" << name_ << "] HALF_OPEN неудача, переход -> OPEN" << std::endl;
-            state_.store(CircuitState::OPEN);
-            success_count_.store(0);
-        } else if (current_state == CircuitState::CLOSED) {
-            size_t failures = failure_count_.fetch_add(1) + 1;
-            
-            std::cout << "[" << name_ << "] CLOSED неудача " << failures 
-                      << "/" << config_.failure_threshold << std::endl;
-            
-            if (failures >= config_.failure_threshold) {
-                std::cout << "[" << name_ << "] Переход CLOSED -> OPEN" << std::endl;
-                state_.store(CircuitState::OPEN);
-            }
-        }
-    }
-    
-    bool shouldAttemptReset() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto now = std::chrono::system_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - last_failure_time_);
-        
-        return elapsed >= config_.timeout;
-    }
-};
-
-// Retry политика
-struct RetryPolicy {
-    size_t max_attempts;
-    std::chrono::milliseconds initial_delay;
-    double backoff_multiplier;
-    
-    RetryPolicy(size_t attempts = 3, 
-                std::chrono::milliseconds delay = std::chrono::milliseconds(100),
-                double multiplier = 2.0)
-        : max_attempts(attempts), 
-          initial_delay(delay), 
-          backoff_multiplier(multiplier) {}
-};
-
-// Утилита для Retry с экспоненциальной задержкой
-template<typename F>
-auto retryWithBackoff(F&& func, const RetryPolicy& policy) -> decltype(func()) {
-    std::chrono::milliseconds delay = policy.initial_delay;
-    
-    for (size_t attempt = 1; attempt <= policy.max_attempts; ++attempt) {
-        try {
-            return func();
-        } catch (const std::exception& e) {
-            if (attempt == policy.max_attempts) {
-                std::cerr << "Все попытки retry исчерпаны: " << e.what() << std::endl;
-                throw;
-            }
-            
-            std::cout << "Попытка " << attempt << " неудачна, retry через " 
-                      << delay.count() << " ms" << std::endl;
-            
-            std::this_thread::sleep_for(delay);
-            delay = std::chrono::milliseconds(
-                static_cast<long>(delay.count() * policy.backoff_multiplier));
-        }
-    }
-    
-    throw std::runtime_error("Retry logic failed");
-}
-
-// Имитация HTTP сервиса
-class HTTPService {
-private:
-    std::string name_;
-    std::atomic<bool> healthy_{true};
-    double failure_rate_;
-    std::atomic<size_t> request_count_{0};
-    
-public:
-    HTTPService(const std::string& name, double failure_rate = 0.0) 
-        : name_(name), failure_rate_(failure_rate) {
-        std::cout << "HTTP Service '" << name_ << "' создан (failure rate: " 
-                  << (failure_rate * 100) << "%)" << std::endl;
-    }
-    
-    std::string request(const std::string& endpoint) {
-        request_count_.fetch_add(1);
-        
-        // Имитация сетевой задержки
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-        
-        // Симуляция ошибок
-        if (!healthy_.load()) {
-            throw std::runtime_error("Service unavailable");
-        }
-        
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_real_distribution<> dis(0.0, 1.0);
-        
-        if (dis(gen) < failure_rate_) {
-            throw std::runtime_error("Request failed (simulated)");
-        }
-        
-        return "Response from " + name_ + " for " + endpoint;
-    }
-    
-    void setHealthy(bool healthy) {
-        healthy_.store(healthy);
-        std::cout << "Service '" << name_ << "' установлен " 
-                  << (healthy ? "healthy" : "unhealthy") << std::endl;
-    }
-    
-    size_t getRequestCount() const {
-        return request_count_.load();
-    }
-};
-
-// Устойчивый HTTP клиент
-class ResilientHTTPClient {
-private:
-    std::shared_ptr<HTTPService> service_;
-    std::shared_ptr<CircuitBreaker> circuit_breaker_;
-    RetryPolicy retry_policy_;
-    
-    // Fallback данные
-    std::function<std::string(const std::string&)> fallback_;
-    
-public:
-    ResilientHTTPClient(std::shared_ptr<HTTPService> service,
-                       const std::string& cb_name = "HTTPClient",
-                       RetryPolicy retry = RetryPolicy())
-        : service_(std::move(service)),
-          circuit_breaker_(std::make_shared<CircuitBreaker>(cb_name)),
-          retry_policy_(retry) {}
-    
-    // Установка fallback функции
-    void setFallback(std::function<std::string(const std::string&)> fallback) {
-        fallback_ = std::move(fallback);
-    }
-    
-    // Выполнение запроса с защитой
-    std::string request(const std::string& endpoint) {
-        try {
-            // Пытаемся выполнить через Circuit Breaker
-            return circuit_breaker_->execute([&]() {
-                // С retry логикой
-                return retryWithBackoff([&]() {
-                    return service_->request(endpoint);
-                }, retry_policy_);
-            });
-            
-        } catch (const std::exception& e) {
-            std::cerr << "Запрос не удался: " << e.what() << std::endl;
-            
-            // Fallback
-            if (fallback_) {
-                std::cout << "Использование fallback для " << endpoint << std::endl;
-                return fallback_(endpoint);
-            }
-            
-            throw;
-        }
-    }
-    
-    std::shared_ptr<CircuitBreaker> getCircuitBreaker() {
-        return circuit_breaker_;
-    }
-};
+#include "resilient_client.h"
 
 // База данных
 class Database {
@@ -7,6 +7,7 @@
  * - Изоляция памяти
  * - Изоляция I/O ресурсов
  * - Мониторинг изоляции
+ * - Изоляция по ядрам: закрепление потоков сервиса за своим набором CPU
  */
 
 #include <iostream>
@@ -22,6 +23,9 @@
 #include <functional>
 #include <unordered_map>
 #include <optional>
+#include <numeric>
+
+#include "cpu_topology.h"
 
 // Лимиты ресурсов для изолированного сервиса
 struct ResourceLimits {
@@ -230,12 +234,15 @@ private:
     // Рабочие потоки
     std::vector<std::thread> workers_;
     std::queue<std::function<void()>> task_queue_;
-    std::mutex queue_mutex_;
+    mutable std::mutex queue_mutex_;
     std::condition_variable condition_;
     
     std::atomic<size_t> tasks_executed_{0};
     std::atomic<size_t> tasks_failed_{0};
     
+    cpp_patterns::ThreadPlacement placement_;
+    std::atomic<size_t> pinned_threads_{0};
+    
 public:
     IsolatedService(const std::string& name, const ResourceLimits& limits)
         : name_(name),
@@ -248,9 +255,18 @@ public:
         shutdown();
     }
     
-    // Запуск сервиса
-    bool start(size_t num_threads) {
-        std::cout << "[" << name_ << "] Запуск с " << num_threads << " потоками..." << std::endl;
+    /**
+     * @brief Запуск сервиса
+     * @param placement размещение потоков; явный набор CPU отделяет сервис
+     *        от соседей по ядрам и кэшам, а не только по лимитам
+     * @throws std::invalid_argument если явный CPU недоступен процессу
+     */
+    bool start(size_t num_threads, cpp_patterns::ThreadPlacement placement = {}) {
+        std::cout << "[" << name_ << "] Запуск с " << num_threads << " потоками (размещение: "
+                  << placement.describe() << ")..." << std::endl;
+        
+        placement_ = std::move(placement);
+        std::vector<int> cpus = placement_.assign(num_threads);
         
         for (size_t i = 0; i < num_threads; ++i) {
             if (!tracker_->createThread()) {
@@ -258,7 +274,10 @@ public:
                 return false;
             }
             
-            workers_.emplace_back([this, i]() {
+            workers_.emplace_back([this, i, cpu = cpus[i]]() {
+                if (cpu >= 0 && cpp_patterns::pinCurrentThread(cpu)) {
+                    pinned_threads_.fetch_add(1);
+                }
                 workerThread(i);
             });
         }
@@ -336,6 +355,8 @@ public:
         std::cout << "\n=== Isolated Service '" << name_ << "' Statistics ===" << std::endl;
         std::cout << "Задач выполнено: " << tasks_executed_.load() << std::endl;
         std::cout << "Задач не удалось: " << tasks_failed_.load() << std::endl;
+        std::cout << "Размещение: " << placement_.describe() << " (закреплено потоков: "
+                  << pinned_threads_.load() << ")" << std::endl;
         
         tracker_->printStats();
     }
@@ -381,7 +402,7 @@ private:
 class ResourceIsolationManager {
 private:
     std::unordered_map<std::string, std::shared_ptr<IsolatedService>> services_;
-    std::mutex mutex_;
+    mutable std::mutex mutex_;
     
 public:
     ResourceIsolationManager() {
@@ -391,12 +412,13 @@ public:
     // Создание изолированного сервиса
     bool createService(const std::string& name, 
                       const ResourceLimits& limits,
-                      size_t num_threads) {
+                      size_t num_threads,
+                      cpp_patterns::ThreadPlacement placement = {}) {
         std::lock_guard<std::mutex> lock(mutex_);
         
         auto service = std::make_shared<IsolatedService>(name, limits);
         
-        if (!service->start(num_threads)) {
+        if (!service->start(num_threads, std::move(placement))) {
             std::cerr << "Не удалось запустить сервис " << name << std::endl;
             return false;
         }
@@ -566,6 +588,116 @@ void demonstrateFileDescriptorIsolation() {
     manager.shutdownAll();
 }
 
+// Делит доступные CPU на два непересекающихся набора (на одном CPU - общий)
+std::pair<std::vector<int>, std::vector<int>> splitCpuSets(const cpp_patterns::CpuTopology& topology) {
+    std::vector<int> order = cpp_patterns::ThreadPlacement::compact().assign(topology.cpuCount(), topology);
+    if (order.size() < 2) {
+        return {order, order};
+    }
+    size_t half = order.size() / 2;
+    return {std::vector<int>(order.begin(), order.begin() + half),
+            std::vector<int>(order.begin() + half, order.end())};
+}
+
+// Демонстрация изоляции по ядрам: у каждого сервиса свой набор CPU
+void demonstrateCpuPlacement() {
+    std::cout << "\n=== Демонстрация изоляции по ядрам ===" << std::endl;
+    
+    const cpp_patterns::CpuTopology& topology = cpp_patterns::CpuTopology::system();
+    std::cout << "Топология: " << topology.describe() << std::endl;
+    auto [critical_cpus, batch_cpus] = splitCpuSets(topology);
+    
+    ResourceIsolationManager manager;
+    manager.createService("CriticalService", ResourceLimits(50, 4, 10, 100), 2,
+                          cpp_patterns::ThreadPlacement::explicitCpus(critical_cpus));
+    manager.createService("BatchService", ResourceLimits(50, 4, 10, 100), 2,
+                          cpp_patterns::ThreadPlacement::explicitCpus(batch_cpus));
+    
+    std::mutex output_mutex;
+    for (const char* name : {"CriticalService", "BatchService"}) {
+        auto service = manager.getService(name);
+        for (int i = 0; i < 4; ++i) {
+            service->execute([name, i, &output_mutex]() {
+                std::lock_guard<std::mutex> lock(output_mutex);
+                std::cout << name << " задача " << i << " выполняется на CPU "
+                          << cpp_patterns::currentCpu() << std::endl;
+            });
+        }
+    }
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    manager.printAllStats();
+    manager.shutdownAll();
+}
+
+// Бенчмарк: пропускная способность критического сервиса рядом с «шумным» batch-соседом
+void benchmarkCpuPlacement() {
+    std::cout << "\n=== Бенчмарк изоляции по ядрам ===" << std::endl;
+    
+    const cpp_patterns::CpuTopology& topology = cpp_patterns::CpuTopology::system();
+    std::cout << "Топология: " << topology.describe() << std::endl;
+    auto [critical_cpus, batch_cpus] = splitCpuSets(topology);
+    if (critical_cpus == batch_cpus) {
+        std::cout << "Доступен один CPU: наборы совпадают, ожидаем только цену закрепления" << std::endl;
+    }
+    
+    constexpr size_t kCriticalTasks = 4000;
+    constexpr size_t kBatchTasks = 64;
+    std::vector<double> hot(8 * 1024, 1.0);               // 64 KB: рабочее множество критических задач
+    std::vector<double> cold(4 * 1024 * 1024, 2.0);       // 32 MB: batch-сосед вымывает кэш
+    
+    struct Mode {
+        const char* name;
+        cpp_patterns::ThreadPlacement critical;
+        cpp_patterns::ThreadPlacement batch;
+    };
+    std::vector<Mode> modes = {
+        {"без закрепления", cpp_patterns::ThreadPlacement::none(), cpp_patterns::ThreadPlacement::none()},
+        {"раздельные наборы CPU", cpp_patterns::ThreadPlacement::explicitCpus(critical_cpus),
+                                  cpp_patterns::ThreadPlacement::explicitCpus(batch_cpus)},
+    };
+    
+    for (const Mode& mode : modes) {
+        size_t critical_threads = std::max<size_t>(1, critical_cpus.size());
+        size_t batch_threads = std::max<size_t>(1, batch_cpus.size());
+        IsolatedService critical("Critical", ResourceLimits(100, critical_threads));
+        IsolatedService batch("Batch", ResourceLimits(100, batch_threads));
+        critical.start(critical_threads, mode.critical);
+        batch.start(batch_threads, mode.batch);
+        
+        std::atomic<size_t> batch_done{0};
+        std::atomic<double> batch_sink{0};
+        for (size_t i = 0; i < kBatchTasks; ++i) {
+            batch.execute([&]() {
+                batch_sink.store(std::accumulate(cold.begin(), cold.end(), 0.0), std::memory_order_relaxed);
+                batch_done.fetch_add(1);
+            });
+        }
+        
+        std::atomic<size_t> critical_done{0};
+        std::atomic<double> critical_sink{0};
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < kCriticalTasks; ++i) {
+            critical.execute([&]() {
+                critical_sink.store(std::accumulate(hot.begin(), hot.end(), 0.0), std::memory_order_relaxed);
+                critical_done.fetch_add(1);
+            });
+        }
+        while (critical_done.load() < kCriticalTasks) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        while (batch_done.load() < kBatchTasks) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        
+        critical.shutdown();
+        batch.shutdown();
+        std::cout << "  " << mode.name << ": критический сервис "
+                  << static_cast<double>(kCriticalTasks) / seconds << " задач/с" << std::endl;
+    }
+}
+
 int main() {
     std::cout << "=== Resource Isolation Pattern ===" << std::endl;
     
@@ -573,6 +705,8 @@ int main() {
         demonstrateCPUMemoryIsolation();
         demonstrateConnectionIsolation();
         demonstrateFileDescriptorIsolation();
+        demonstrateCpuPlacement();
+        benchmarkCpuPlacement();
     } catch (const std::exception& e) {
         std::cerr << "Ошибка: " << e.what() << std::endl;
         return 1;
@@ -10,6 +10,8 @@
 #include <random>
 #include <unordered_set>
 
+#include "object_pool_pattern.h"
+
 /**
  * @file object_pool_pattern.cpp
  * @brief Демонстрация Object Pool Pattern
@@ -18,262 +20,6 @@
  * примерами использования для оптимизации производительности.
  */
 
-// ============================================================================
-// БАЗОВАЯ РЕАЛИЗАЦИЯ OBJECT POOL
-// ============================================================================
-
-/**
- * @brief Универсальный Object Pool
- */
-template<typename T>
-class ObjectPool {
-private:
-    std::queue<std::unique_ptr<T>> pool_;
-    std::mutex mutex_;
-    std::function<std::unique_ptr<T>()> factory_;
-    std::atomic<size_t> maxSize_;
-    std::atomic<size_t> currentSize_{0};
-    std::atomic<size_t> createdCount_{0};
-    std::atomic<size_t> borrowedCount_{0};
-    std::atomic<size_t> returnedCount_{0};
-    
-    // Отслеживание выданных объектов для отладки
-    std::unordered_set<T*> borrowedObjects_;
-    std::mutex borrowedMutex_;
-    
-public:
-    explicit ObjectPool(size_t maxSize = 100, 
-                       std::function<std::unique_ptr<T>()> factory = []() { 
-                           return std::make_unique<T>(); 
-                       })
-        : maxSize_(maxSize), factory_(factory) {
-        
-        std::cout << "🏊 ObjectPool создан: maxSize=" << maxSize_ << std::endl;
-        
-        // Предварительно создаем половину объектов
-        size_t initialSize = maxSize_ / 2;
-        for (size_t i = 0; i < initialSize; ++i) {
-            pool_.push(factory_());
-            currentSize_.fetch_add(1);
-            createdCount_.fetch_add(1);
-        }
-        
-        std::cout << "🏊 Предварительно создано " << initialSize << " объектов" << std::endl;
-    }
-    
-    // Получение объекта из пула
-    std::unique_ptr<T> acquire() {
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        if (!pool_.empty()) {
-            auto obj = std::move(pool_.front());
-            pool_.pop();
-            
-            // Отслеживаем выданный объект
-            {
-                std::lock_guard<std::mutex> borrowedLock(borrowedMutex_);
-                borrowedObjects_.insert(obj.get());
-            }
-            
-            borrowedCount_.fetch_add(1);
-            
-            std::cout << "🏊 Выдан объект из пула (доступно: " << pool_.size() 
-                      << ", всего: " << currentSize_.load() << ")" << std::endl;
-            
-            return obj;
-        }
-        
-        // Если пул пуст, создаем новый объект (если не превышен лимит)
-        if (currentSize_.load() < maxSize_.load()) {
-            currentSize_.fetch_add(1);
-            createdCount_.fetch_add(1);
-            
-            auto obj = factory_();
-            
-            // Отслеживаем выданный объект
-            {
-                std::lock_guard<std::mutex> borrowedLock(borrowedMutex_);
-                borrowedObjects_.insert(obj.get());
-            }
-            
-            borrowedCount_.fetch_add(1);
-            
-            std::cout << "🏊 Создан новый объект (доступно: " << pool_.size() 
-                      << ", всего: " << currentSize_.load() << ")" << std::endl;
-            
-            return obj;
-        }
-        
-        std::cout << "🏊 Пул переполнен, объект не выдан" << std::endl;
-        return nullptr;
-    }
-    
-    // Возврат объекта в пул
-    void release(std::unique_ptr<T> obj) {
-        if (!obj) return;
-        
-        // Сбрасываем состояние объекта
-        if constexpr (std::is_base_of_v<Resettable, T>) {
-            obj->reset();
-        }
-        
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        // Удаляем из отслеживания
-        {
-            std::lock_guard<std::mutex> borrowedLock(borrowedMutex_);
-            borrowedObjects_.erase(obj.get());
-        }
-        
-        pool_.push(std::move(obj));
-        returnedCount_.fetch_add(1);
-        
-        std::cout << "🏊 Объект возвращен в пул (доступно: " << pool_.size() 
-                  << ", всего: " << currentSize_.load() << ")" << std::endl;
-    }
-    
-    // Статистика
-    struct Statistics {
-        size_t maxSize;
-        size_t currentSize;
-        size_t available;
-        size_t borrowed;
-        size_t createdCount;
-        size_t borrowedCount;
-        size_t returnedCount;
-        double utilizationRate;
-    };
-    
-    Statistics getStatistics() const {
-        Statistics stats;
-        stats.maxSize = maxSize_.load();
-        stats.currentSize = currentSize_.load();
-        
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            stats.available = pool_.size();
-        }
-        
-        {
-            std::lock_guard<std::mutex> lock(borrowedMutex_);
-            stats.borrowed = borrowedObjects_.size();
-        }
-        
-        stats.createdCount = createdCount_.load();
-        stats.borrowedCount = borrowedCount_.load();
-        stats.returnedCount = returnedCount_.load();
-        
-        if (stats.createdCount > 0) {
-            stats.utilizationRate = static_cast<double>(stats.borrowedCount) / stats.createdCount;
-        } else {
-            stats.utilizationRate = 0.0;
-        }
-        
-        return stats;
-    }
-    
-    void printStatistics() const {
-        auto stats = getStatistics();
-        std::cout << "\n=== СТАТИСТИКА OBJECT POOL ===" << std::endl;
-        std::cout << "Максимальный размер: " << stats.maxSize << std::endl;
-        std::cout << "Текущий размер: " << stats.currentSize << std::endl;
-        std::cout << "Доступно: " << stats.available << std::endl;
-        std::cout << "Выдано: " << stats.borrowed << std::endl;
-        std::cout << "Создано всего: " << stats.createdCount << std::endl;
-        std::cout << "Выдано всего: " << stats.borrowedCount << std::endl;
-        std::cout << "Возвращено всего: " << stats.returnedCount << std::endl;
-        std::cout << "Коэффициент использования: " << (stats.utilizationRate * 100) << "%" << std::endl;
-        std::cout << "===============================" << std::endl;
-    }
-    
-    // Проверка состояния пула
-    size_t available() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return pool_.size();
-    }
-    
-    size_t total() const {
-        return currentSize_.load();
-    }
-    
-    size_t borrowed() const {
-        std::lock_guard<std::mutex> lock(borrowedMutex_);
-        return borrowedObjects_.size();
-    }
-    
-    bool isEmpty() const {
-        return available() == 0;
-    }
-    
-    bool isFull() const {
-        return currentSize_.load() >= maxSize_.load();
-    }
-};
-
-// ============================================================================
-// RAII ОБЕРТКА ДЛЯ АВТОМАТИЧЕСКОГО ВОЗВРАТА
-// ============================================================================
-
-/**
- * @brief RAII обертка для автоматического возврата объекта в пул
- */
-template<typename T>
-class PooledObject {
-private:
-    ObjectPool<T>& pool_;
-    std::unique_ptr<T> object_;
-    
-public:
-    explicit PooledObject(ObjectPool<T>& pool) : pool_(pool), object_(pool.acquire()) {
-        if (!object_) {
-            throw std::runtime_error("Не удалось получить объект из пула");
-        }
-    }
-    
-    ~PooledObject() {
-        if (object_) {
-            pool_.release(std::move(object_));
-        }
-    }
-    
-    // Запрещаем копирование
-    PooledObject(const PooledObject&) = delete;
-    PooledObject& operator=(const PooledObject&) = delete;
-    
-    // Разрешаем перемещение
-    PooledObject(PooledObject&& other) noexcept 
-        : pool_(other.pool_), object_(std::move(other.object_)) {}
-    
-    PooledObject& operator=(PooledObject&& other) noexcept {
-        if (this != &other) {
-            if (object_) {
-                pool_.release(std::move(object_));
-            }
-            object_ = std::move(other.object_);
-        }
-        return *this;
-    }
-    
-    T* get() const { return object_.get(); }
-    T* operator->() const { return object_.get(); }
-    T& operator*() const { return *object_; }
-    
-    explicit operator bool() const { return object_ != nullptr; }
-};
-
-// ============================================================================
-// ИНТЕРФЕЙС ДЛЯ СБРОСА СОСТОЯНИЯ
-// ============================================================================
-
-/**
- * @brief Интерфейс для объектов, которые могут сбрасывать свое состояние
- */
-class Resettable {
-public:
-    virtual ~Resettable() = default;
-    virtual void reset() = 0;
-};
-
 // ============================================================================
 // ПРИМЕРЫ ОБЪЕКТОВ ДЛЯ ПУЛА
 // ============================================================================
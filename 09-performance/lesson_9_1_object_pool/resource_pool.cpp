@@ -22,8 +22,15 @@
 #include <functional>
 #include <random>
 
+#include "intrusive_ptr.h"
+
+using cpp_patterns::IntrusivePtr;
+using cpp_patterns::makeIntrusive;
+
 // Базовый интерфейс для ресурсов
-class Resource {
+// Счётчик ссылок встроен в ресурс: выдача из пула и возврат не требуют
+// отдельного control block, а хэндл весит один указатель.
+class Resource : public cpp_patterns::RefCounted<Resource> {
 public:
     virtual ~Resource() = default;
     virtual bool isValid() const = 0;
@@ -312,9 +319,10 @@ struct PoolStats {
 template<typename T>
 class ResourcePool {
 private:
-    std::queue<std::shared_ptr<T>> available_resources_;
-    std::unordered_map<std::string, std::shared_ptr<T>> active_resources_;
-    std::mutex pool_mutex_;
+    std::queue<IntrusivePtr<T>> available_resources_;
+    // Ключ - адрес ресурса: getId() строит строку на каждый вызов
+    std::unordered_map<const T*, IntrusivePtr<T>> active_resources_;
+    mutable std::mutex pool_mutex_;
     std::condition_variable pool_condition_;
     
     size_t min_size_;
@@ -324,20 +332,19 @@ private:
     PoolStats stats_;
     std::atomic<bool> shutdown_{false};
     
-    std::function<std::shared_ptr<T>()> resource_factory_;
+    std::function<IntrusivePtr<T>()> resource_factory_;
     
 public:
     ResourcePool(size_t min_size, size_t max_size, 
                  std::chrono::milliseconds max_idle_time,
-                 std::function<std::shared_ptr<T>()> factory)
+                 std::function<IntrusivePtr<T>()> factory)
         : min_size_(min_size), max_size_(max_size), max_idle_time_(max_idle_time), resource_factory_(factory) {
         
         std::cout << "Создан пул ресурсов: min=" << min_size_ << ", max=" << max_size_ << std::endl;
         
         // Создаем минимальное количество ресурсов
         for (size_t i = 0; i < min_size_; ++i) {
-            auto resource = resource_factory_();
-            available_resources_.push(resource);
+            available_resources_.push(resource_factory_());
             stats_.total_created_.fetch_add(1);
             stats_.current_idle_.fetch_add(1);
         }
@@ -359,7 +366,7 @@ public:
         active_resources_.clear();
     }
     
-    std::shared_ptr<T> acquire(std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+    IntrusivePtr<T> acquire(std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
         stats_.total_requests_.fetch_add(1);
         
         std::unique_lock<std::mutex> lock(pool_mutex_);
@@ -379,11 +386,11 @@ public:
         }
         
         // Получаем ресурс из пула
-        auto resource = available_resources_.front();
+        auto resource = std::move(available_resources_.front());
         available_resources_.pop();
         
         // Перемещаем в активные
-        active_resources_[resource->getId()] = resource;
+        active_resources_[resource.get()] = resource;
         
         stats_.current_idle_.fetch_sub(1);
         stats_.current_active_.fetch_add(1);
@@ -393,13 +400,13 @@ public:
         return resource;
     }
     
-    void release(std::shared_ptr<T> resource) {
+    void release(IntrusivePtr<T> resource) {
         if (!resource) return;
         
         std::lock_guard<std::mutex> lock(pool_mutex_);
         
         // Удаляем из активных
-        auto it = active_resources_.find(resource->getId());
+        auto it = active_resources_.find(resource.get());
         if (it != active_resources_.end()) {
             active_resources_.erase(it);
         }
@@ -407,13 +414,13 @@ public:
         // Сбрасываем состояние ресурса
         resource->reset();
         
+        std::cout << "Освобожден ресурс: " << resource->getId() << std::endl;
+        
         // Возвращаем в пул
-        available_resources_.push(resource);
+        available_resources_.push(std::move(resource));
         
         stats_.current_active_.fetch_sub(1);
         stats_.current_idle_.fetch_add(1);
-        
-        std::cout << "Освобожден ресурс: " << resource->getId() << std::endl;
         pool_condition_.notify_one();
     }
     
@@ -439,9 +446,9 @@ private:
             std::lock_guard<std::mutex> lock(pool_mutex_);
             
             // Проверяем неиспользуемые ресурсы
-            std::queue<std::shared_ptr<T>> temp_queue;
+            std::queue<IntrusivePtr<T>> temp_queue;
             while (!available_resources_.empty()) {
-                auto resource = available_resources_.front();
+                auto resource = std::move(available_resources_.front());
                 available_resources_.pop();
                 
                 // Проверяем время неиспользования
@@ -452,7 +459,7 @@ private:
                     stats_.current_idle_.fetch_sub(1);
                     std::cout << "Удален неиспользуемый ресурс: " << resource->getId() << std::endl;
                 } else {
-                    temp_queue.push(resource);
+                    temp_queue.push(std::move(resource));
                 }
             }
             
@@ -466,8 +473,8 @@ void demonstrateDatabasePool() {
     std::cout << "\n=== Демонстрация пула соединений с БД ===" << std::endl;
     
     int connection_counter = 0;
-    auto db_factory = [&connection_counter]() -> std::shared_ptr<DatabaseConnection> {
-        return std::make_shared<DatabaseConnection>(
+    auto db_factory = [&connection_counter]() -> IntrusivePtr<DatabaseConnection> {
+        return makeIntrusive<DatabaseConnection>(
             "db_conn_" + std::to_string(++connection_counter),
             "localhost:5432/mydb"
         );
@@ -476,7 +483,7 @@ void demonstrateDatabasePool() {
     ResourcePool<DatabaseConnection> db_pool(2, 5, std::chrono::minutes(5), db_factory);
     
     // Получаем несколько соединений
-    std::vector<std::shared_ptr<DatabaseConnection>> connections;
+    std::vector<IntrusivePtr<DatabaseConnection>> connections;
     
     for (int i = 0; i < 3; ++i) {
         auto conn = db_pool.acquire();
@@ -503,8 +510,8 @@ void demonstrateSocketPool() {
     std::cout << "\n=== Демонстрация пула сетевых сокетов ===" << std::endl;
     
     int socket_counter = 0;
-    auto socket_factory = [&socket_counter]() -> std::shared_ptr<NetworkSocket> {
-        return std::make_shared<NetworkSocket>(
+    auto socket_factory = [&socket_counter]() -> IntrusivePtr<NetworkSocket> {
+        return makeIntrusive<NetworkSocket>(
             "socket_" + std::to_string(++socket_counter),
             "example.com",
             8080
@@ -514,7 +521,7 @@ void demonstrateSocketPool() {
     ResourcePool<NetworkSocket> socket_pool(1, 3, std::chrono::minutes(2), socket_factory);
     
     // Получаем сокеты и выполняем операции
-    std::vector<std::shared_ptr<NetworkSocket>> sockets;
+    std::vector<IntrusivePtr<NetworkSocket>> sockets;
     
     for (int i = 0; i < 2; ++i) {
         auto socket = socket_pool.acquire();
@@ -542,8 +549,8 @@ void demonstrateBufferPool() {
     std::cout << "\n=== Демонстрация пула буферов ===" << std::endl;
     
     int buffer_counter = 0;
-    auto buffer_factory = [&buffer_counter]() -> std::shared_ptr<DataBuffer> {
-        return std::make_shared<DataBuffer>(
+    auto buffer_factory = [&buffer_counter]() -> IntrusivePtr<DataBuffer> {
+        return makeIntrusive<DataBuffer>(
             "buffer_" + std::to_string(++buffer_counter),
             1024
         );
@@ -552,7 +559,7 @@ void demonstrateBufferPool() {
     ResourcePool<DataBuffer> buffer_pool(3, 10, std::chrono::minutes(1), buffer_factory);
     
     // Получаем буферы и работаем с данными
-    std::vector<std::shared_ptr<DataBuffer>> buffers;
+    std::vector<IntrusivePtr<DataBuffer>> buffers;
     
     for (int i = 0; i < 4; ++i) {
         auto buffer = buffer_pool.acquire();
@@ -579,8 +586,8 @@ void demonstratePoolPerformance() {
     std::cout << "\n=== Демонстрация производительности пула ===" << std::endl;
     
     int resource_counter = 0;
-    auto resource_factory = [&resource_counter]() -> std::shared_ptr<DatabaseConnection> {
-        return std::make_shared<DatabaseConnection>(
+    auto resource_factory = [&resource_counter]() -> IntrusivePtr<DatabaseConnection> {
+        return makeIntrusive<DatabaseConnection>(
             "perf_conn_" + std::to_string(++resource_counter),
             "localhost:5432/testdb"
         );
@@ -591,7 +598,7 @@ void demonstratePoolPerformance() {
     // Тестируем производительность
     auto start = std::chrono::high_resolution_clock::now();
     
-    std::vector<std::shared_ptr<DatabaseConnection>> resources;
+    std::vector<IntrusivePtr<DatabaseConnection>> resources;
     
     // Получаем ресурсы
     for (int i = 0; i < 100; ++i) {
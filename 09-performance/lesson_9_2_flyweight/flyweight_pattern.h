@@ -0,0 +1,243 @@
+/**
+ * @file flyweight_pattern.h
+ * @brief Классы урока Flyweight: приспособленцы, фабрика и контексты с внешним состоянием
+ *
+ * Вынесены из flyweight_pattern.cpp, чтобы бенчмарки
+ * (benchmarks/bench_flyweight.cpp) замеряли фабрику урока, а не её копию.
+ * Флаг verbose отключает вывод о создании каждого flyweight.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Базовый интерфейс для Flyweight
+class Flyweight {
+public:
+    virtual ~Flyweight() = default;
+    virtual void render(int x, int y, const std::string& extrinsic_data) = 0;
+    virtual std::string getIntrinsicState() const = 0;
+};
+
+// Конкретный Flyweight для символов
+class CharacterFlyweight : public Flyweight {
+private:
+    char character_;
+    std::string font_;
+    int size_;
+    std::string color_;
+    
+public:
+    CharacterFlyweight(char c, const std::string& font, int size, const std::string& color, bool verbose = true)
+        : character_(c), font_(font), size_(size), color_(color) {
+        if (verbose) {
+            std::cout << "Создан CharacterFlyweight для символа '" << character_ << "'" << std::endl;
+        }
+    }
+    
+    void render(int x, int y, const std::string& extrinsic_data) override {
+        std::cout << "Рендерим символ '" << character_ 
+                  << "' в позиции (" << x << ", " << y << ")"
+                  << " с данными: " << extrinsic_data << std::endl;
+    }
+    
+    std::string getIntrinsicState() const override {
+        return std::string(1, character_) + "_" + font_ + "_" + std::to_string(size_) + "_" + color_;
+    }
+    
+    char getCharacter() const { return character_; }
+    const std::string& getFont() const { return font_; }
+    int getSize() const { return size_; }
+    const std::string& getColor() const { return color_; }
+};
+
+// Конкретный Flyweight для деревьев в игре
+class TreeFlyweight : public Flyweight {
+private:
+    std::string tree_type_;
+    std::string texture_;
+    int height_;
+    std::string season_;
+    
+public:
+    TreeFlyweight(const std::string& type, const std::string& texture, int height, const std::string& season,
+                  bool verbose = true)
+        : tree_type_(type), texture_(texture), height_(height), season_(season) {
+        if (verbose) {
+            std::cout << "Создан TreeFlyweight для типа '" << tree_type_ << "'" << std::endl;
+        }
+    }
+    
+    void render(int x, int y, const std::string& extrinsic_data) override {
+        std::cout << "Рендерим дерево типа '" << tree_type_ 
+                  << "' в позиции (" << x << ", " << y << ")"
+                  << " с данными: " << extrinsic_data << std::endl;
+    }
+    
+    std::string getIntrinsicState() const override {
+        return tree_type_ + "_" + texture_ + "_" + std::to_string(height_) + "_" + season_;
+    }
+    
+    const std::string& getTreeType() const { return tree_type_; }
+    const std::string& getTexture() const { return texture_; }
+    int getHeight() const { return height_; }
+    const std::string& getSeason() const { return season_; }
+};
+
+// Конкретный Flyweight для кнопок GUI
+class ButtonFlyweight : public Flyweight {
+private:
+    std::string button_type_;
+    std::string style_;
+    int width_;
+    int height_;
+    std::string color_scheme_;
+    
+public:
+    ButtonFlyweight(const std::string& type, const std::string& style, int width, int height, const std::string& color,
+                    bool verbose = true)
+        : button_type_(type), style_(style), width_(width), height_(height), color_scheme_(color) {
+        if (verbose) {
+            std::cout << "Создан ButtonFlyweight для типа '" << button_type_ << "'" << std::endl;
+        }
+    }
+    
+    void render(int x, int y, const std::string& extrinsic_data) override {
+        std::cout << "Рендерим кнопку типа '" << button_type_ 
+                  << "' в позиции (" << x << ", " << y << ")"
+                  << " с данными: " << extrinsic_data << std::endl;
+    }
+    
+    std::string getIntrinsicState() const override {
+        return button_type_ + "_" + style_ + "_" + std::to_string(width_) + "x" + std::to_string(height_) + "_" + color_scheme_;
+    }
+    
+    const std::string& getButtonType() const { return button_type_; }
+    const std::string& getStyle() const { return style_; }
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    const std::string& getColorScheme() const { return color_scheme_; }
+};
+
+// Фабрика Flyweight объектов
+class FlyweightFactory {
+private:
+    std::unordered_map<std::string, std::shared_ptr<Flyweight>> flyweights_;
+    bool verbose_;  // Передаётся новым flyweight: печатать их создание
+    
+public:
+    explicit FlyweightFactory(bool verbose = true) : verbose_(verbose) {}
+    
+    // Получение или создание CharacterFlyweight
+    std::shared_ptr<CharacterFlyweight> getCharacter(char c, const std::string& font, int size, const std::string& color) {
+        std::string key = std::string(1, c) + "_" + font + "_" + std::to_string(size) + "_" + color;
+        
+        auto it = flyweights_.find(key);
+        if (it != flyweights_.end()) {
+            return std::dynamic_pointer_cast<CharacterFlyweight>(it->second);
+        }
+        
+        auto flyweight = std::make_shared<CharacterFlyweight>(c, font, size, color, verbose_);
+        flyweights_[key] = flyweight;
+        return flyweight;
+    }
+    
+    // Получение или создание TreeFlyweight
+    std::shared_ptr<TreeFlyweight> getTree(const std::string& type, const std::string& texture, int height, const std::string& season) {
+        std::string key = type + "_" + texture + "_" + std::to_string(height) + "_" + season;
+        
+        auto it = flyweights_.find(key);
+        if (it != flyweights_.end()) {
+            return std::dynamic_pointer_cast<TreeFlyweight>(it->second);
+        }
+        
+        auto flyweight = std::make_shared<TreeFlyweight>(type, texture, height, season, verbose_);
+        flyweights_[key] = flyweight;
+        return flyweight;
+    }
+    
+    // Получение или создание ButtonFlyweight
+    std::shared_ptr<ButtonFlyweight> getButton(const std::string& type, const std::string& style, int width, int height, const std::string& color) {
+        std::string key = type + "_" + style + "_" + std::to_string(width) + "x" + std::to_string(height) + "_" + color;
+        
+        auto it = flyweights_.find(key);
+        if (it != flyweights_.end()) {
+            return std::dynamic_pointer_cast<ButtonFlyweight>(it->second);
+        }
+        
+        auto flyweight = std::make_shared<ButtonFlyweight>(type, style, width, height, color, verbose_);
+        flyweights_[key] = flyweight;
+        return flyweight;
+    }
+    
+    size_t getFlyweightCount() const {
+        return flyweights_.size();
+    }
+    
+    void printStats() const {
+        std::cout << "FlyweightFactory: создано " << flyweights_.size() << " уникальных flyweight объектов" << std::endl;
+    }
+};
+
+// Контекст для использования Flyweight
+class TextContext {
+private:
+    std::shared_ptr<CharacterFlyweight> character_;
+    int x_, y_;
+    std::string additional_data_;
+    
+public:
+    TextContext(std::shared_ptr<CharacterFlyweight> ch, int x, int y, const std::string& data)
+        : character_(ch), x_(x), y_(y), additional_data_(data) {}
+    
+    void render() const {
+        character_->render(x_, y_, additional_data_);
+    }
+    
+    int getX() const { return x_; }
+    int getY() const { return y_; }
+    const std::string& getAdditionalData() const { return additional_data_; }
+};
+
+// Контекст для деревьев в игре
+class TreeContext {
+private:
+    std::shared_ptr<TreeFlyweight> tree_;
+    int x_, y_;
+    std::string additional_data_;
+    
+public:
+    TreeContext(std::shared_ptr<TreeFlyweight> t, int x, int y, const std::string& data)
+        : tree_(t), x_(x), y_(y), additional_data_(data) {}
+    
+    void render() const {
+        tree_->render(x_, y_, additional_data_);
+    }
+    
+    int getX() const { return x_; }
+    int getY() const { return y_; }
+    const std::string& getAdditionalData() const { return additional_data_; }
+};
+
+// Контекст для кнопок GUI
+class ButtonContext {
+private:
+    std::shared_ptr<ButtonFlyweight> button_;
+    int x_, y_;
+    std::string additional_data_;
+    
+public:
+    ButtonContext(std::shared_ptr<ButtonFlyweight> b, int x, int y, const std::string& data)
+        : button_(b), x_(x), y_(y), additional_data_(data) {}
+    
+    void render() const {
+        button_->render(x_, y_, additional_data_);
+    }
+    
+    int getX() const { return x_; }
+    int getY() const { return y_; }
+    const std::string& getAdditionalData() const { return additional_data_; }
+};
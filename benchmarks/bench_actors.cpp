@@ -0,0 +1,108 @@
+/**
+ * @file bench_actors.cpp
+ * @brief Обмен сообщениями между акторами урока 7.3
+ *
+ * Actor из message_passing.h: почтовый ящик - std::queue<MessagePtr> под
+ * мьютексом с условной переменной, обработчик работает в своём потоке,
+ * сообщение - IntrusivePtr на типизированное сообщение с атомарным
+ * счётчиком. Вариант actor_model_pattern.cpp (строковый тип + std::any)
+ * не замеряется: его Message и Actor совпадают по именам с message_passing.h,
+ * а сам файл урока не собирается.
+ */
+
+#include "benchmark_harness.h"
+#include "07-concurrency/lesson_7_3_actor_model/message_passing.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace {
+
+using namespace cpp_patterns::bench;
+
+constexpr size_t kMessagesPerIteration = 256;
+
+// Считает Ping; если задан адресат, отвечает ему Pong
+class CountingActor : public Actor {
+public:
+    CountingActor(std::atomic<size_t>& processed, Actor* replyTo = nullptr)
+        : Actor("bench", false), processed_(processed), replyTo_(replyTo) {}
+
+    // Поток актора вызывает handleMessage(): его нужно остановить, пока наследник жив
+    ~CountingActor() override { shutdown(); }
+
+protected:
+    void handleMessage(cpp_patterns::BorrowedPtr<Message> message) override {
+        auto ping = dynamic_cast<const PingMessage*>(message.get());
+        if (ping == nullptr) {
+            return;
+        }
+        if (replyTo_ != nullptr) {
+            replyTo_->send(cpp_patterns::makeIntrusive<PongMessage>(name_, ping->sequence));
+        }
+        processed_.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    std::atomic<size_t>& processed_;
+    Actor* replyTo_;
+};
+
+// Принимает Pong и считает ответы
+class ReplyCounter : public Actor {
+public:
+    explicit ReplyCounter(std::atomic<size_t>& replies) : Actor("replies", false), replies_(replies) {}
+    ~ReplyCounter() override { shutdown(); }
+
+protected:
+    void handleMessage(cpp_patterns::BorrowedPtr<Message> message) override {
+        if (dynamic_cast<const PongMessage*>(message.get()) != nullptr) {
+            replies_.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+private:
+    std::atomic<size_t>& replies_;
+};
+
+void waitFor(const std::atomic<size_t>& counter, size_t expected) {
+    while (counter.load(std::memory_order_acquire) < expected) {
+        std::this_thread::yield();
+    }
+}
+
+void benchMessageThroughput(BenchmarkState& state) {
+    std::atomic<size_t> processed{0};
+    CountingActor actor(processed);
+    size_t expected = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < kMessagesPerIteration; ++i) {
+            actor.send(cpp_patterns::makeIntrusive<PingMessage>("bench", static_cast<int>(i)));
+        }
+        expected += kMessagesPerIteration;
+        waitFor(processed, expected);
+    }
+    state.setItemsPerIteration(kMessagesPerIteration);
+}
+
+// Запрос-ответ: задержка одного обхода между двумя почтовыми ящиками
+void benchPingPong(BenchmarkState& state) {
+    std::atomic<size_t> pings{0};
+    std::atomic<size_t> pongs{0};
+    ReplyCounter replier(pongs);
+    CountingActor responder(pings, &replier);
+    size_t expected = 0;
+    for (auto _ : state) {
+        responder.send(cpp_patterns::makeIntrusive<PingMessage>("bench", 1));
+        waitFor(pongs, ++expected);
+    }
+}
+
+const bool kRegistered = [] {
+    registerBenchmark("actor/intrusive_message_throughput", benchMessageThroughput);
+    registerBenchmark("actor/ping_pong_round_trip", benchPingPong);
+    return true;
+}();
+
+} // namespace
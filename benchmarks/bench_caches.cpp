@@ -0,0 +1,129 @@
+/**
+ * @file bench_caches.cpp
+ * @brief Кэши (урок 8.1)
+ *
+ * Замеряются классы урока из cache_aside_pattern.h: LRUCache и LFUCache
+ * (мьютекс, TTL на каждую запись, выключенные зоны трассировки) и
+ * MultiLevelCache поверх них. ShardedLruCache делит ключи на 16
+ * независимых LRUCache урока. Ключи равномерно распределены по
+ * пространству вдвое больше ёмкости, поэтому примерно половина
+ * обращений - промахи с вытеснением.
+ */
+
+#include "benchmark_harness.h"
+#include "08-high-load/lesson_8_1_cache_aside/cache_aside_pattern.h"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace cpp_patterns::bench;
+
+using LessonLru = LRUCache<uint64_t, uint64_t>;
+using LessonLfu = LFUCache<uint64_t, uint64_t>;
+
+// L1 в 8 раз меньше L2, как в demonstrateMultiLevelCache
+class LessonMultiLevel : public MultiLevelCache<uint64_t, uint64_t> {
+public:
+    explicit LessonMultiLevel(size_t capacity) : MultiLevelCache(capacity / 8 + 1, capacity) {}
+};
+
+class ShardedLruCache {
+public:
+    static constexpr size_t kShards = 16;
+
+    explicit ShardedLruCache(size_t capacity) {
+        for (auto& shard : shards_) {
+            shard = std::make_unique<LessonLru>(capacity / kShards + 1);
+        }
+    }
+
+    bool get(uint64_t key, uint64_t& value) { return shard(key).get(key, value); }
+    void put(uint64_t key, uint64_t value) { shard(key).put(key, value); }
+
+private:
+    LessonLru& shard(uint64_t key) { return *shards_[(key * 0x9E3779B97F4A7C15ull) >> 60]; }
+
+    std::array<std::unique_ptr<LessonLru>, kShards> shards_;
+};
+
+// Конструкторы классов урока печатают ёмкость: в таблице результатов это лишнее
+class SilenceStdout {
+public:
+    SilenceStdout() : saved_(std::cout.rdbuf(nullptr)) {}
+    ~SilenceStdout() { std::cout.rdbuf(saved_); }
+
+    SilenceStdout(const SilenceStdout&) = delete;
+    SilenceStdout& operator=(const SilenceStdout&) = delete;
+
+private:
+    std::streambuf* saved_;
+};
+
+template<typename Cache>
+std::unique_ptr<Cache> makeCache(size_t capacity) {
+    SilenceStdout silence;
+    return std::make_unique<Cache>(capacity);
+}
+
+std::vector<uint64_t> makeKeys(size_t capacity) {
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<uint64_t> distribution(0, capacity * 2 - 1);
+    std::vector<uint64_t> keys(1 << 16);
+    for (auto& key : keys) key = distribution(generator);
+    return keys;
+}
+
+// Cache-aside: get, при промахе - put
+template<typename Cache>
+void benchCacheAside(BenchmarkState& state) {
+    size_t capacity = static_cast<size_t>(state.arg());
+    std::unique_ptr<Cache> cache = makeCache<Cache>(capacity);
+    std::vector<uint64_t> keys = makeKeys(capacity);
+    for (size_t i = 0; i < capacity; ++i) cache->put(keys[i % keys.size()], i);
+
+    size_t next = 0;
+    uint64_t hits = 0;
+    for (auto _ : state) {
+        uint64_t key = keys[next++ & (keys.size() - 1)];
+        uint64_t value = 0;
+        if (cache->get(key, value)) {
+            hits += value != 0;
+        } else {
+            cache->put(key, key);
+        }
+    }
+    doNotOptimize(hits);
+}
+
+// Нижняя граница: поиск в unordered_map без LRU и блокировок
+void benchPlainMap(BenchmarkState& state) {
+    size_t capacity = static_cast<size_t>(state.arg());
+    std::unordered_map<uint64_t, uint64_t> map;
+    std::vector<uint64_t> keys = makeKeys(capacity);
+    for (size_t i = 0; i < capacity * 2; i += 2) map[i] = i;
+
+    size_t next = 0;
+    uint64_t hits = 0;
+    for (auto _ : state) {
+        hits += map.count(keys[next++ & (keys.size() - 1)]);
+    }
+    doNotOptimize(hits);
+}
+
+const bool kRegistered = [] {
+    registerBenchmark("cache/lru_get_or_put", benchCacheAside<LessonLru>).arg(1024).arg(65536);
+    registerBenchmark("cache/lfu_get_or_put", benchCacheAside<LessonLfu>).arg(1024).arg(65536);
+    registerBenchmark("cache/multilevel_get_or_put", benchCacheAside<LessonMultiLevel>).arg(1024).arg(65536);
+    registerBenchmark("cache/sharded_lru_get_or_put", benchCacheAside<ShardedLruCache>).arg(1024).arg(65536);
+    registerBenchmark("cache/unordered_map_lookup", benchPlainMap).arg(1024).arg(65536);
+    return true;
+}();
+
+} // namespace
@@ -0,0 +1,62 @@
+/**
+ * @file bench_command_batching.cpp
+ * @brief Очередь команд и батчинг урока 9.3
+ *
+ * Одна итерация - одна команда от submit() до выполнения в BatchProcessor
+ * урока. Флаш запускается по размеру: processBatch() вызывается, когда в
+ * очереди набралось max_batch команд, и группирует их по getBatchKey().
+ * Параметр - max_batch; при 1 каждая команда выполняется отдельным флашем.
+ */
+
+#include "benchmark_harness.h"
+#include "09-performance/lesson_9_3_command_queue/batch_processing.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace cpp_patterns::bench;
+
+const std::vector<std::string> kTables = {"users", "orders", "products", "inventory", "logs"};
+
+// Дешёвая команда: цена замера - очередь и группировка, а не работа команды
+class WriteCommand : public BatchableCommand {
+public:
+    WriteCommand(const std::string& table, long& target) : table_(table), target_(target) {}
+
+    void execute() override { target_ += 1; }
+    std::string getName() const override { return "Write(" + table_ + ")"; }
+    std::string getBatchKey() const override { return table_; }
+
+private:
+    const std::string& table_;
+    long& target_;
+};
+
+void benchProcessorFlush(BenchmarkState& state) {
+    size_t batchSize = static_cast<size_t>(state.arg());
+    // Интервал заведомо больше замера: флаш только по размеру очереди
+    BatchProcessor processor(batchSize, std::chrono::hours(1), false);
+    long total = 0;
+    size_t next = 0;
+    size_t pending = 0;
+    for (auto _ : state) {
+        processor.submit(std::make_shared<WriteCommand>(kTables[next++ % kTables.size()], total));
+        if (++pending >= batchSize) {
+            processor.processBatch();
+            pending = 0;
+        }
+    }
+    processor.forceFlush();
+    doNotOptimize(total);
+}
+
+const bool kRegistered = [] {
+    registerBenchmark("command_batch/processor_flush", benchProcessorFlush).arg(1).arg(16).arg(256);
+    return true;
+}();
+
+} // namespace
@@ -0,0 +1,84 @@
+/**
+ * @file bench_flyweight.cpp
+ * @brief Фабрика приспособленцев урока 9.2
+ *
+ * FlyweightFactory::getCharacter() на каждый вызов собирает строковый ключ
+ * "c_font_size_color" и ищет его в unordered_map<string, shared_ptr<Flyweight>>
+ * (без мьютекса - фабрика урока однопоточная). Сравнивается с заранее
+ * интернированным индексом и с созданием объекта на каждый символ.
+ */
+
+#include "benchmark_harness.h"
+#include "09-performance/lesson_9_2_flyweight/flyweight_pattern.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace cpp_patterns::bench;
+
+// Символ текста: номер различного начертания из [0, distinct)
+std::vector<size_t> makeText(size_t distinct) {
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<size_t> distribution(0, distinct - 1);
+    std::vector<size_t> text(4096);
+    for (auto& glyph : text) glyph = distribution(generator);
+    return text;
+}
+
+char symbolOf(size_t glyph) { return static_cast<char>('a' + glyph % 26); }
+int sizeOf(size_t glyph) { return 8 + static_cast<int>(glyph / 26); }
+
+void benchStringKey(BenchmarkState& state) {
+    FlyweightFactory factory(false);
+    std::vector<size_t> text = makeText(static_cast<size_t>(state.arg()));
+    size_t next = 0;
+    for (auto _ : state) {
+        size_t glyph = text[next++ & (text.size() - 1)];
+        std::shared_ptr<CharacterFlyweight> flyweight =
+            factory.getCharacter(symbolOf(glyph), "Arial", sizeOf(glyph), "black");
+        doNotOptimize(flyweight->getCharacter());
+    }
+}
+
+// Ключ переведён в индекс один раз, на горячем пути - обращение к вектору
+void benchInternedId(BenchmarkState& state) {
+    FlyweightFactory factory(false);
+    std::vector<size_t> text = makeText(static_cast<size_t>(state.arg()));
+    std::unordered_map<size_t, uint32_t> ids;
+    std::vector<std::shared_ptr<CharacterFlyweight>> table;
+    std::vector<uint32_t> interned;
+    for (size_t glyph : text) {
+        auto [it, inserted] = ids.emplace(glyph, static_cast<uint32_t>(table.size()));
+        if (inserted) table.push_back(factory.getCharacter(symbolOf(glyph), "Arial", sizeOf(glyph), "black"));
+        interned.push_back(it->second);
+    }
+    size_t next = 0;
+    for (auto _ : state) {
+        const CharacterFlyweight& flyweight = *table[interned[next++ & (interned.size() - 1)]];
+        doNotOptimize(flyweight.getCharacter());
+    }
+}
+
+void benchNoSharing(BenchmarkState& state) {
+    std::vector<size_t> text = makeText(static_cast<size_t>(state.arg()));
+    size_t next = 0;
+    for (auto _ : state) {
+        size_t glyph = text[next++ & (text.size() - 1)];
+        auto flyweight = std::make_shared<CharacterFlyweight>(symbolOf(glyph), "Arial", sizeOf(glyph), "black", false);
+        doNotOptimize(flyweight->getCharacter());
+    }
+}
+
+const bool kRegistered = [] {
+    registerBenchmark("flyweight/string_key_lookup", benchStringKey).arg(16).arg(4096);
+    registerBenchmark("flyweight/interned_id", benchInternedId).arg(16).arg(4096);
+    registerBenchmark("flyweight/no_sharing", benchNoSharing).arg(16).arg(4096);
+    return true;
+}();
+
+} // namespace
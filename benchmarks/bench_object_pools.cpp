@@ -0,0 +1,84 @@
+/**
+ * @file bench_object_pools.cpp
+ * @brief Пулы объектов урока 9.1
+ *
+ * Сравниваются new/delete, ObjectPool урока (очередь unique_ptr под мьютексом
+ * и учёт выданных объектов) и PooledObject - RAII-обёртка, возвращающая
+ * объект в тот же пул. Размер объекта задаётся параметром шаблона Block.
+ */
+
+#include "benchmark_harness.h"
+#include "09-performance/lesson_9_1_object_pool/object_pool_pattern.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+using namespace cpp_patterns::bench;
+
+constexpr size_t kLiveObjects = 64;  // сколько объектов одновременно на руках
+
+template<size_t Size>
+struct Block {
+    char bytes[Size];
+};
+
+// Одна итерация - взять объект, записать в него, вернуть самый старый
+template<typename Acquire, typename Release, typename Handle>
+void churn(BenchmarkState& state, Acquire&& acquire, Release&& release, std::vector<Handle>& live) {
+    size_t next = 0;
+    for (auto _ : state) {
+        Handle handle = acquire();
+        *static_cast<volatile char*>(handle->bytes) = 1;
+        release(live[next]);
+        live[next] = std::move(handle);
+        next = (next + 1) % live.size();
+    }
+}
+
+template<size_t Size>
+void benchNewDelete(BenchmarkState& state) {
+    std::vector<std::unique_ptr<Block<Size>>> live(kLiveObjects);
+    for (auto& block : live) block = std::make_unique<Block<Size>>();
+    churn(state, [] { return std::make_unique<Block<Size>>(); },
+          [](std::unique_ptr<Block<Size>>& block) { block.reset(); }, live);
+}
+
+template<size_t Size>
+void benchObjectPool(BenchmarkState& state) {
+    ObjectPool<Block<Size>> pool(kLiveObjects * 2, [] { return std::make_unique<Block<Size>>(); }, false);
+    std::vector<std::unique_ptr<Block<Size>>> live(kLiveObjects);
+    for (auto& block : live) block = pool.acquire();
+    churn(state, [&pool] { return pool.acquire(); },
+          [&pool](std::unique_ptr<Block<Size>>& block) { pool.release(std::move(block)); }, live);
+    for (auto& block : live) pool.release(std::move(block));
+}
+
+// Присваивание перемещением возвращает в пул объект, который держала обёртка
+template<size_t Size>
+void benchPooledObject(BenchmarkState& state) {
+    ObjectPool<Block<Size>> pool(kLiveObjects * 2, [] { return std::make_unique<Block<Size>>(); }, false);
+    std::vector<PooledObject<Block<Size>>> live;
+    live.reserve(kLiveObjects);
+    for (size_t i = 0; i < kLiveObjects; ++i) live.emplace_back(pool);
+    size_t next = 0;
+    for (auto _ : state) {
+        PooledObject<Block<Size>> handle(pool);
+        *static_cast<volatile char*>(handle->bytes) = 1;
+        live[next] = std::move(handle);
+        next = (next + 1) % live.size();
+    }
+}
+
+const bool kRegistered = [] {
+    registerBenchmark("object_pool/new_delete/64", benchNewDelete<64>);
+    registerBenchmark("object_pool/new_delete/4096", benchNewDelete<4096>);
+    registerBenchmark("object_pool/object_pool/64", benchObjectPool<64>);
+    registerBenchmark("object_pool/object_pool/4096", benchObjectPool<4096>);
+    registerBenchmark("object_pool/pooled_object/64", benchPooledObject<64>);
+    registerBenchmark("object_pool/pooled_object/4096", benchPooledObject<4096>);
+    return true;
+}();
+
+} // namespace
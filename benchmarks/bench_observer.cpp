@@ -0,0 +1,99 @@
+/**
+ * @file bench_observer.cpp
+ * @brief Рассылка уведомлений наблюдателям урока 5.1
+ *
+ * Одна итерация - одно уведомление всем N наблюдателям. Базовая линия -
+ * сырые указатели на Observer урока с виртуальным вызовом. Дальше субъекты
+ * урока: NotificationSystem (weak_ptr, lock() на каждом вызове),
+ * ModernSubject (std::function) и ThreadSafeSubject (копия списка
+ * std::function под мьютексом, вызовы вне его).
+ */
+
+#include "benchmark_harness.h"
+#include "05-behavioral/lesson_5_1_observer/observer_pattern.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace cpp_patterns::bench;
+
+class CountingObserver : public Observer {
+public:
+    void update(const std::string& message) override { total_ += message.size(); }
+    std::string getName() const override { return "CountingObserver"; }
+    size_t total() const { return total_; }
+
+private:
+    size_t total_ = 0;
+};
+
+const std::string kMessage = "event";
+
+std::vector<std::shared_ptr<CountingObserver>> makeObservers(size_t count) {
+    std::vector<std::shared_ptr<CountingObserver>> observers;
+    for (size_t i = 0; i < count; ++i) observers.push_back(std::make_shared<CountingObserver>());
+    return observers;
+}
+
+void benchVirtual(BenchmarkState& state) {
+    auto owners = makeObservers(static_cast<size_t>(state.arg()));
+    std::vector<Observer*> observers;
+    for (auto& owner : owners) observers.push_back(owner.get());
+    for (auto _ : state) {
+        for (Observer* observer : observers) observer->update(kMessage);
+    }
+    doNotOptimize(owners.front()->total());
+    state.setItemsPerIteration(static_cast<double>(observers.size()));
+}
+
+void benchWeakPtr(BenchmarkState& state) {
+    auto owners = makeObservers(static_cast<size_t>(state.arg()));
+    NotificationSystem subject("bench", false);
+    for (auto& owner : owners) subject.attach(owner);
+    for (auto _ : state) {
+        subject.notify(kMessage);
+    }
+    doNotOptimize(owners.front()->total());
+    state.setItemsPerIteration(static_cast<double>(owners.size()));
+}
+
+void benchFunction(BenchmarkState& state) {
+    auto owners = makeObservers(static_cast<size_t>(state.arg()));
+    ModernSubject subject("bench", false);
+    for (auto& owner : owners) {
+        CountingObserver* observer = owner.get();
+        subject.attach([observer](const std::string& message) { observer->update(message); });
+    }
+    for (auto _ : state) {
+        subject.notify(kMessage);
+    }
+    doNotOptimize(owners.front()->total());
+    state.setItemsPerIteration(static_cast<double>(owners.size()));
+}
+
+void benchSnapshot(BenchmarkState& state) {
+    auto owners = makeObservers(static_cast<size_t>(state.arg()));
+    ThreadSafeSubject subject("bench", false);
+    for (auto& owner : owners) {
+        CountingObserver* observer = owner.get();
+        subject.attach([observer](const std::string& message) { observer->update(message); });
+    }
+    for (auto _ : state) {
+        subject.notify(kMessage);
+    }
+    doNotOptimize(owners.front()->total());
+    state.setItemsPerIteration(static_cast<double>(owners.size()));
+}
+
+const bool kRegistered = [] {
+    registerBenchmark("observer/virtual_raw", benchVirtual).arg(1).arg(16).arg(256);
+    registerBenchmark("observer/weak_ptr_lock", benchWeakPtr).arg(1).arg(16).arg(256);
+    registerBenchmark("observer/std_function", benchFunction).arg(1).arg(16).arg(256);
+    registerBenchmark("observer/mutex_snapshot", benchSnapshot).arg(1).arg(16).arg(256);
+    return true;
+}();
+
+} // namespace
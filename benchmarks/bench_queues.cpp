@@ -0,0 +1,86 @@
+/**
+ * @file bench_queues.cpp
+ * @brief Очереди производитель-потребитель урока 7.1
+ *
+ * ProducerConsumerQueue - очередь урока: std::queue, мьютекс и одна
+ * условная переменная на обе стороны. LockFreeRingBuffer - SPSC-кольцо
+ * из безопасных альтернатив урока; размер задаётся параметром шаблона.
+ */
+
+#include "benchmark_harness.h"
+#include "07-concurrency/lesson_7_1_producer_consumer/lock_free_ring_buffer.h"
+#include "07-concurrency/lesson_7_1_producer_consumer/producer_consumer_pattern.h"
+
+#include <thread>
+
+namespace {
+
+using namespace cpp_patterns::bench;
+
+// Цена блокировки без ожидания: push и pop в одном потоке
+void benchMutexUncontended(BenchmarkState& state) {
+    ProducerConsumerQueue<uint64_t> queue(1024);
+    uint64_t sum = 0;
+    uint64_t item = 0;
+    for (auto _ : state) {
+        queue.push(1);
+        queue.pop(item);
+        sum += item;
+    }
+    doNotOptimize(sum);
+}
+
+// Передача между потоками: производитель в отдельном потоке, потребитель - цикл замера
+void benchMutexHandoff(BenchmarkState& state) {
+    ProducerConsumerQueue<uint64_t> queue(static_cast<size_t>(state.arg()));
+    size_t count = state.iterations();
+    std::thread producer([&queue, count] {
+        for (size_t i = 0; i < count; ++i) {
+            queue.push(i);
+        }
+    });
+    uint64_t sum = 0;
+    uint64_t item = 0;
+    for (auto _ : state) {
+        queue.pop(item);
+        sum += item;
+    }
+    producer.join();
+    doNotOptimize(sum);
+    state.setItemsPerIteration(1);
+}
+
+// Кольцо не блокирует: полная и пустая очередь - повтор с yield, как в уроке
+template<size_t Capacity>
+void benchRingHandoff(BenchmarkState& state) {
+    LockFreeRingBuffer<uint64_t, Capacity> ring;
+    size_t count = state.iterations();
+    std::thread producer([&ring, count] {
+        for (size_t i = 0; i < count; ++i) {
+            while (!ring.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint64_t sum = 0;
+    uint64_t item = 0;
+    for (auto _ : state) {
+        while (!ring.pop(item)) {
+            std::this_thread::yield();
+        }
+        sum += item;
+    }
+    producer.join();
+    doNotOptimize(sum);
+    state.setItemsPerIteration(1);
+}
+
+const bool kRegistered = [] {
+    registerBenchmark("queue/mutex_uncontended", benchMutexUncontended);
+    registerBenchmark("queue/mutex_handoff", benchMutexHandoff).arg(64).arg(1024);
+    registerBenchmark("queue/spsc_handoff/64", benchRingHandoff<64>);
+    registerBenchmark("queue/spsc_handoff/1024", benchRingHandoff<1024>);
+    return true;
+}();
+
+} // namespace
@@ -0,0 +1,239 @@
+/**
+ * @file bench_simd_buffers.cpp
+ * @brief Выровненный буфер и SIMD-ядра против циклов IntArray (урок 1.2)
+ *
+ * IntArray урока выделял new int[], обнулял его скалярным циклом и
+ * проверял индекс в operator[]. Сравниваются:
+ * - checked_loop - проверка индекса на каждом элементе, как в IntArray::operator[];
+ * - no_vectorize - тот же цикл без проверки, векторизация запрещена;
+ * - scalar - простой цикл; при -O2 компилятор может векторизовать его сам;
+ * - sse2/avx2/avx512 - ядра simd_kernels.h, только доступные процессору.
+ * Размеры: 4096 элементов (16 КиБ, в L1) и 1M (4 МиБ, упирается в память).
+ */
+
+#include "aligned_buffer.h"
+#include "benchmark_harness.h"
+#include "simd_kernels.h"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using namespace cpp_patterns::bench;
+using cpp_patterns::AlignedBuffer;
+using cpp_patterns::kUninitialized;
+namespace simd = cpp_patterns::simd;
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define BENCH_NO_VECTORIZE __attribute__((noinline, optimize("no-tree-vectorize")))
+#else
+#define BENCH_NO_VECTORIZE __attribute__((noinline))
+#endif
+
+// Массив урока 1.2 до перехода на AlignedBuffer
+class LegacyIntArray {
+public:
+    explicit LegacyIntArray(size_t size) : data_(std::make_unique<int[]>(size)), size_(size) {}
+
+    int& operator[](size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Индекс вне диапазона");
+        }
+        return data_[index];
+    }
+
+    size_t size() const { return size_; }
+
+private:
+    std::unique_ptr<int[]> data_;
+    size_t size_;
+};
+
+size_t elements(const BenchmarkState& state) {
+    return static_cast<size_t>(state.arg());
+}
+
+BENCH_NO_VECTORIZE void plainFill(int32_t* dst, size_t count, int32_t value) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = value;
+    }
+}
+
+BENCH_NO_VECTORIZE void plainCopy(int32_t* dst, const int32_t* src, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+BENCH_NO_VECTORIZE void plainTransform(float* dst, const float* src, size_t count, float scale, float offset) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = src[i] * scale + offset;
+    }
+}
+
+// ---- fill -----------------------------------------------------------------
+
+void benchFillChecked(BenchmarkState& state) {
+    LegacyIntArray array(elements(state));
+    int value = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < array.size(); ++i) {
+            array[i] = value;
+        }
+        ++value;
+        clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(array.size()));
+}
+
+void benchFillNoVectorize(BenchmarkState& state) {
+    AlignedBuffer<int32_t> buffer(elements(state));
+    int32_t value = 0;
+    for (auto _ : state) {
+        plainFill(buffer.data(), buffer.size(), value++);
+        clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(buffer.size()));
+}
+
+void benchFillKernel(BenchmarkState& state, simd::SimdLevel level) {
+    const simd::Kernels& kernels = simd::kernelsFor(level);
+    AlignedBuffer<int32_t> buffer(elements(state));
+    int32_t value = 0;
+    for (auto _ : state) {
+        kernels.fillI32(buffer.data(), buffer.size(), value++);
+        clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(buffer.size()));
+}
+
+// ---- copy -----------------------------------------------------------------
+
+void benchCopyChecked(BenchmarkState& state) {
+    LegacyIntArray source(elements(state));
+    LegacyIntArray target(elements(state));
+    for (auto _ : state) {
+        for (size_t i = 0; i < source.size(); ++i) {
+            target[i] = source[i];
+        }
+        clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(source.size()));
+}
+
+void benchCopyNoVectorize(BenchmarkState& state) {
+    AlignedBuffer<int32_t> source(elements(state), 1);
+    AlignedBuffer<int32_t> target(elements(state), kUninitialized);
+    for (auto _ : state) {
+        plainCopy(target.data(), source.data(), source.size());
+        clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(source.size()));
+}
+
+void benchCopyKernel(BenchmarkState& state, simd::SimdLevel level) {
+    const simd::Kernels& kernels = simd::kernelsFor(level);
+    AlignedBuffer<int32_t> source(elements(state), 1);
+    AlignedBuffer<int32_t> target(elements(state), kUninitialized);
+    for (auto _ : state) {
+        kernels.copyBytes(target.data(), source.data(), source.sizeBytes());
+        clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(source.size()));
+}
+
+// ---- transform: dst = src * 1.0001 + 0.5 ----------------------------------
+
+void benchTransformChecked(BenchmarkState& state) {
+    AlignedBuffer<float> source(elements(state), 1.0f);
+    AlignedBuffer<float> target(elements(state), kUninitialized);
+    for (auto _ : state) {
+        for (size_t i = 0; i < source.size(); ++i) {
+            target.at(i) = source.at(i) * 1.0001f + 0.5f;
+        }
+        clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(source.size()));
+}
+
+void benchTransformNoVectorize(BenchmarkState& state) {
+    AlignedBuffer<float> source(elements(state), 1.0f);
+    AlignedBuffer<float> target(elements(state), kUninitialized);
+    for (auto _ : state) {
+        plainTransform(target.data(), source.data(), source.size(), 1.0001f, 0.5f);
+        clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(source.size()));
+}
+
+void benchTransformKernel(BenchmarkState& state, simd::SimdLevel level) {
+    const simd::Kernels& kernels = simd::kernelsFor(level);
+    AlignedBuffer<float> source(elements(state), 1.0f);
+    AlignedBuffer<float> target(elements(state), kUninitialized);
+    for (auto _ : state) {
+        kernels.transformF32(target.data(), source.data(), source.size(), 1.0001f, 0.5f);
+        clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(source.size()));
+}
+
+// ---- Выделение: обнуление против kUninitialized -------------------------
+
+void benchAllocZeroedNew(BenchmarkState& state) {
+    for (auto _ : state) {
+        auto data = std::make_unique<int[]>(elements(state));
+        doNotOptimize(data.get());
+    }
+}
+
+void benchAllocAlignedZeroed(BenchmarkState& state) {
+    for (auto _ : state) {
+        AlignedBuffer<int32_t> buffer(elements(state));
+        doNotOptimize(buffer.data());
+    }
+}
+
+void benchAllocAlignedUninitialized(BenchmarkState& state) {
+    for (auto _ : state) {
+        AlignedBuffer<int32_t> buffer(elements(state), kUninitialized);
+        doNotOptimize(buffer.data());
+    }
+}
+
+const bool kRegistered = [] {
+    const int64_t small = 4096;
+    const int64_t large = int64_t{1} << 20;
+
+    struct Operation {
+        const char* name;
+        BenchmarkFunction checked;
+        BenchmarkFunction noVectorize;
+        void (*kernel)(BenchmarkState&, simd::SimdLevel);
+    };
+    const Operation operations[] = {
+        {"fill", benchFillChecked, benchFillNoVectorize, benchFillKernel},
+        {"copy", benchCopyChecked, benchCopyNoVectorize, benchCopyKernel},
+        {"transform", benchTransformChecked, benchTransformNoVectorize, benchTransformKernel},
+    };
+    for (const Operation& operation : operations) {
+        std::string prefix = std::string("simd_buffer/") + operation.name + "/";
+        registerBenchmark(prefix + "checked_loop", operation.checked).arg(small).arg(large);
+        registerBenchmark(prefix + "no_vectorize", operation.noVectorize).arg(small).arg(large);
+        for (simd::SimdLevel level : simd::supportedLevels()) {
+            auto kernel = operation.kernel;
+            registerBenchmark(prefix + simd::simdLevelName(level), [kernel, level](BenchmarkState& state) {
+                kernel(state, level);
+            }).arg(small).arg(large);
+        }
+    }
+
+    registerBenchmark("simd_buffer/alloc/new_zeroed", benchAllocZeroedNew).arg(small).arg(large);
+    registerBenchmark("simd_buffer/alloc/aligned_zeroed", benchAllocAlignedZeroed).arg(small).arg(large);
+    registerBenchmark("simd_buffer/alloc/aligned_uninitialized", benchAllocAlignedUninitialized).arg(small).arg(large);
+    return true;
+}();
+
+} // namespace
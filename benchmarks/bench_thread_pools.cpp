@@ -0,0 +1,109 @@
+/**
+ * @file bench_thread_pools.cpp
+ * @brief Пулы потоков урока 7.2
+ *
+ * ThreadPool и AdvancedThreadPool - общая очередь задач под мьютексом
+ * (thread_pool_pattern.h), AsyncThreadPool - локальные очереди с кражей
+ * работы (async_thread_pool.h). Сравниваются enqueue() с packaged_task/future
+ * у всех трёх пулов, post() без future у AsyncThreadPool и поток на каждую задачу.
+ */
+
+#include "benchmark_harness.h"
+#include "07-concurrency/lesson_7_2_thread_pool/async_thread_pool.h"
+#include "07-concurrency/lesson_7_2_thread_pool/thread_pool_pattern.h"
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace cpp_patterns::bench;
+
+constexpr size_t kTasksPerIteration = 256;
+
+// Пачка задач через enqueue() и ожидание всех future - одинаково для всех пулов
+template<typename Pool>
+void runEnqueueBatches(BenchmarkState& state, Pool& pool) {
+    std::vector<std::future<void>> futures;
+    futures.reserve(kTasksPerIteration);
+    size_t executed = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < kTasksPerIteration; ++i) {
+            futures.push_back(pool.enqueue([&executed] { doNotOptimize(executed); }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+        futures.clear();
+    }
+    state.setItemsPerIteration(kTasksPerIteration);
+}
+
+void benchBasicEnqueue(BenchmarkState& state) {
+    ThreadPool pool(static_cast<size_t>(state.arg()), {}, false);
+    runEnqueueBatches(state, pool);
+}
+
+void benchAdvancedEnqueue(BenchmarkState& state) {
+    AdvancedThreadPool pool(static_cast<size_t>(state.arg()), false);
+    runEnqueueBatches(state, pool);
+}
+
+void benchAsyncEnqueue(BenchmarkState& state) {
+    size_t threads = static_cast<size_t>(state.arg());
+    AsyncThreadPool pool(threads, threads, {}, false);
+    runEnqueueBatches(state, pool);
+}
+
+void waitFor(const std::atomic<size_t>& counter, size_t expected) {
+    while (counter.load(std::memory_order_acquire) < expected) {
+        std::this_thread::yield();
+    }
+}
+
+// post() не создаёт packaged_task и future: цена самой очереди с кражей
+void benchAsyncPost(BenchmarkState& state) {
+    size_t threads = static_cast<size_t>(state.arg());
+    AsyncThreadPool pool(threads, threads, {}, false);
+    std::atomic<size_t> done{0};
+    size_t expected = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < kTasksPerIteration; ++i) {
+            pool.post([&done] { done.fetch_add(1, std::memory_order_release); });
+        }
+        expected += kTasksPerIteration;
+        waitFor(done, expected);
+    }
+    state.setItemsPerIteration(kTasksPerIteration);
+}
+
+// Для сравнения: без пула каждая задача платит за создание потока
+void benchThreadPerTask(BenchmarkState& state) {
+    constexpr size_t kThreads = 16;
+    std::atomic<size_t> done{0};
+    std::vector<std::thread> threads;
+    threads.reserve(kThreads);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kThreads; ++i) {
+            threads.emplace_back([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+    }
+    state.setItemsPerIteration(kThreads);
+}
+
+const bool kRegistered = [] {
+    registerBenchmark("thread_pool/basic_enqueue", benchBasicEnqueue).arg(1).arg(2).arg(4);
+    registerBenchmark("thread_pool/advanced_enqueue", benchAdvancedEnqueue).arg(1).arg(2).arg(4);
+    registerBenchmark("thread_pool/async_enqueue", benchAsyncEnqueue).arg(1).arg(2).arg(4);
+    registerBenchmark("thread_pool/async_post", benchAsyncPost).arg(1).arg(2).arg(4);
+    registerBenchmark("thread_pool/thread_per_task", benchThreadPerTask);
+    return true;
+}();
+
+} // namespace
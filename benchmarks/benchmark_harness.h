@@ -0,0 +1,506 @@
+/**
+ * @file benchmark_harness.h
+ * @brief Каркас микробенчмарков: регистрация, прогрев, повторы, статистика, JSON
+ *
+ * demonstratePerformance() в уроках делает один замер high_resolution_clock
+ * и печатает число: сравнить две реализации или две версии кода по нему
+ * нельзя. Здесь каждый бенчмарк:
+ * - подбирает число итераций так, чтобы один замер длился не меньше min-time;
+ * - делает warmup прогонов без учёта и repetitions замеров;
+ * - считает медиану, p99, среднее и стандартное отклонение нс на итерацию;
+ * - пишет результаты в JSON, а compareResults() ищет регрессии между файлами.
+ *
+ * Тело бенчмарка - цикл `for (auto _ : state)`: подготовка до цикла в замер
+ * не входит, время идёт от begin() до выхода из цикла.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include "optimization_barrier.h"
+#include "pool_instrumentation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cpp_patterns::bench {
+
+// Барьеры общие с демонстрациями уроков
+using cpp_patterns::clobberMemory;
+using cpp_patterns::doNotOptimize;
+
+/**
+ * @brief Состояние одного прогона: число итераций, параметры, таймер
+ */
+class BenchmarkState {
+public:
+    BenchmarkState(size_t iterations, std::vector<int64_t> args)
+        : iterations_(iterations), args_(std::move(args)) {}
+
+    size_t iterations() const noexcept { return iterations_; }
+
+    int64_t arg(size_t index = 0) const {
+        if (index >= args_.size()) {
+            throw std::out_of_range("BenchmarkState::arg: нет параметра " + std::to_string(index));
+        }
+        return args_[index];
+    }
+
+    /**
+     * @brief Сколько единиц работы в одной итерации (для items/s)
+     */
+    void setItemsPerIteration(double items) noexcept { itemsPerIteration_ = items; }
+    double itemsPerIteration() const noexcept { return itemsPerIteration_; }
+
+    /**
+     * @brief Исключить участок внутри цикла из замера
+     */
+    void pauseTiming() noexcept {
+        pausedTicks_ = PoolClock::now();
+    }
+
+    void resumeTiming() noexcept {
+        startTicks_ += PoolClock::now() - pausedTicks_;
+    }
+
+    // maybe_unused на типе: переменная цикла for (auto _ : state) не вызывает предупреждений
+    struct [[maybe_unused]] Value {};
+
+    class Iterator {
+    public:
+        Iterator(size_t remaining, BenchmarkState* state) : remaining_(remaining), state_(state) {}
+
+        Value operator*() const noexcept { return {}; }
+
+        Iterator& operator++() noexcept {
+            --remaining_;
+            return *this;
+        }
+
+        bool operator!=(const Iterator&) noexcept {
+            if (remaining_ != 0) {
+                return true;
+            }
+            state_->finish();
+            return false;
+        }
+
+    private:
+        size_t remaining_;
+        BenchmarkState* state_;
+    };
+
+    Iterator begin() {
+        started_ = true;
+        startTicks_ = PoolClock::now();
+        return Iterator(iterations_, this);
+    }
+
+    Iterator end() { return Iterator(0, this); }
+
+    double elapsedNanos() const {
+        if (!finished_) {
+            throw std::logic_error("бенчмарк не прошёл цикл for (auto _ : state)");
+        }
+        return static_cast<double>(endTicks_ - startTicks_) * PoolClock::nanosPerTick();
+    }
+
+private:
+    void finish() noexcept {
+        endTicks_ = PoolClock::now();
+        finished_ = started_;
+    }
+
+    size_t iterations_;
+    std::vector<int64_t> args_;
+    double itemsPerIteration_ = 0.0;
+    uint64_t startTicks_ = 0;
+    uint64_t pausedTicks_ = 0;
+    uint64_t endTicks_ = 0;
+    bool started_ = false;
+    bool finished_ = false;
+};
+
+using BenchmarkFunction = std::function<void(BenchmarkState&)>;
+
+/**
+ * @brief Зарегистрированный бенчмарк; args() добавляет набор параметров
+ */
+class Benchmark {
+public:
+    Benchmark(std::string name, BenchmarkFunction function)
+        : name_(std::move(name)), function_(std::move(function)) {}
+
+    Benchmark& arg(int64_t value) { return args({value}); }
+
+    Benchmark& args(std::vector<int64_t> values) {
+        argSets_.push_back(std::move(values));
+        return *this;
+    }
+
+    /**
+     * @brief Имя с параметрами: "queue/mutex/64"
+     */
+    std::vector<std::pair<std::string, std::vector<int64_t>>> instances() const {
+        if (argSets_.empty()) {
+            return {{name_, {}}};
+        }
+        std::vector<std::pair<std::string, std::vector<int64_t>>> result;
+        for (const auto& values : argSets_) {
+            std::string name = name_;
+            for (int64_t value : values) {
+                name += "/" + std::to_string(value);
+            }
+            result.emplace_back(std::move(name), values);
+        }
+        return result;
+    }
+
+    const BenchmarkFunction& function() const noexcept { return function_; }
+
+private:
+    std::string name_;
+    BenchmarkFunction function_;
+    std::vector<std::vector<int64_t>> argSets_;
+};
+
+/**
+ * @brief Реестр: бенчмарки регистрируются при статической инициализации
+ */
+inline std::vector<std::unique_ptr<Benchmark>>& benchmarkRegistry() {
+    static std::vector<std::unique_ptr<Benchmark>> registry;
+    return registry;
+}
+
+inline Benchmark& registerBenchmark(std::string name, BenchmarkFunction function) {
+    benchmarkRegistry().push_back(std::make_unique<Benchmark>(std::move(name), std::move(function)));
+    return *benchmarkRegistry().back();
+}
+
+struct RunOptions {
+    std::string filter = ".*";
+    int repetitions = 10;
+    int warmup = 2;
+    double minSampleMillis = 20.0;
+    size_t maxIterations = size_t{1} << 30;
+};
+
+/**
+ * @brief Статистика по замерам (нс на итерацию)
+ */
+struct SampleStats {
+    double mean = 0.0;
+    double median = 0.0;
+    double p99 = 0.0;
+    double stddev = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+};
+
+inline SampleStats computeStats(std::vector<double> samples) {
+    SampleStats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t count = samples.size();
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    stats.mean = sum / static_cast<double>(count);
+    stats.median = count % 2 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2.0;
+    // p99 по ближайшему рангу; при десятке замеров это максимум
+    size_t rank = static_cast<size_t>(std::ceil(0.99 * static_cast<double>(count)));
+    stats.p99 = samples[std::max<size_t>(rank, 1) - 1];
+    double squares = 0.0;
+    for (double sample : samples) {
+        squares += (sample - stats.mean) * (sample - stats.mean);
+    }
+    stats.stddev = count > 1 ? std::sqrt(squares / static_cast<double>(count - 1)) : 0.0;
+    stats.min = samples.front();
+    stats.max = samples.back();
+    return stats;
+}
+
+struct BenchmarkResult {
+    std::string name;
+    size_t iterations = 0;
+    size_t repetitions = 0;
+    SampleStats nanosPerIteration;
+    double itemsPerSecond = 0.0;
+};
+
+/**
+ * @brief Прогнать один экземпляр бенчмарка
+ */
+inline BenchmarkResult runBenchmark(const std::string& name, const BenchmarkFunction& function,
+                                    const std::vector<int64_t>& args, const RunOptions& options) {
+    auto sample = [&](size_t iterations, double& itemsPerIteration) {
+        BenchmarkState state(iterations, args);
+        function(state);
+        itemsPerIteration = state.itemsPerIteration();
+        return state.elapsedNanos();
+    };
+
+    // Подбор итераций: растим, пока замер не станет длиннее minSampleMillis
+    double itemsPerIteration = 0.0;
+    double targetNanos = options.minSampleMillis * 1e6;
+    size_t iterations = 1;
+    while (true) {
+        double elapsed = sample(iterations, itemsPerIteration);
+        if (elapsed >= targetNanos || iterations >= options.maxIterations) {
+            break;
+        }
+        double scale = elapsed > 0.0 ? targetNanos * 1.2 / elapsed : 10.0;
+        scale = std::min(10.0, std::max(2.0, scale));
+        iterations = std::min(options.maxIterations, static_cast<size_t>(static_cast<double>(iterations) * scale));
+    }
+
+    for (int i = 0; i < options.warmup; ++i) {
+        sample(iterations, itemsPerIteration);
+    }
+
+    std::vector<double> samples;
+    for (int i = 0; i < std::max(1, options.repetitions); ++i) {
+        samples.push_back(sample(iterations, itemsPerIteration) / static_cast<double>(iterations));
+    }
+
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.repetitions = samples.size();
+    result.nanosPerIteration = computeStats(std::move(samples));
+    if (itemsPerIteration > 0.0 && result.nanosPerIteration.median > 0.0) {
+        result.itemsPerSecond = itemsPerIteration * 1e9 / result.nanosPerIteration.median;
+    }
+    return result;
+}
+
+namespace detail {
+
+// setw считает байты, а заголовки в UTF-8: выравниваем по числу символов
+inline void writeCell(std::ostream& out, const std::string& text, size_t width, bool alignLeft) {
+    size_t symbols = static_cast<size_t>(std::count_if(text.begin(), text.end(), [](char c) {
+        return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+    }));
+    std::string padding(width > symbols ? width - symbols : 0, ' ');
+    out << (alignLeft ? text + padding : padding + text);
+}
+
+} // namespace detail
+
+inline void printResultHeader(std::ostream& out) {
+    detail::writeCell(out, "Бенчмарк", 44, true);
+    detail::writeCell(out, "итераций", 12, false);
+    detail::writeCell(out, "медиана нс", 14, false);
+    detail::writeCell(out, "p99 нс", 14, false);
+    detail::writeCell(out, "σ %", 10, false);
+    detail::writeCell(out, "единиц/с", 16, false);
+    out << "\n";
+}
+
+inline void printResult(std::ostream& out, const BenchmarkResult& result) {
+    const SampleStats& stats = result.nanosPerIteration;
+    double relative = stats.mean > 0.0 ? stats.stddev / stats.mean * 100.0 : 0.0;
+    out << std::left << std::setw(44) << result.name << std::right << std::fixed
+        << std::setw(12) << result.iterations
+        << std::setw(14) << std::setprecision(2) << stats.median
+        << std::setw(14) << stats.p99
+        << std::setw(10) << std::setprecision(1) << relative;
+    if (result.itemsPerSecond > 0.0) {
+        out << std::setw(16) << std::setprecision(0) << result.itemsPerSecond;
+    }
+    out << std::defaultfloat << std::endl;
+}
+
+/**
+ * @brief Прогнать все бенчмарки, имя которых подходит под options.filter
+ */
+inline std::vector<BenchmarkResult> runBenchmarks(const RunOptions& options, std::ostream& out) {
+    std::regex filter(options.filter);
+    std::vector<BenchmarkResult> results;
+    printResultHeader(out);
+    for (const auto& benchmark : benchmarkRegistry()) {
+        for (const auto& [name, args] : benchmark->instances()) {
+            if (!std::regex_search(name, filter)) {
+                continue;
+            }
+            results.push_back(runBenchmark(name, benchmark->function(), args, options));
+            printResult(out, results.back());
+        }
+    }
+    return results;
+}
+
+// ----------------------------------------------------------------------------
+// JSON: один бенчмарк на строку, чтобы файл читался без полного парсера
+// ----------------------------------------------------------------------------
+
+inline void writeJson(std::ostream& out, const std::vector<BenchmarkResult>& results, const RunOptions& options) {
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n\"context\": {\"date\": \"" << date << "\""
+        << ", \"cpus\": " << std::thread::hardware_concurrency()
+        << ", \"ns_per_tick\": " << std::setprecision(6) << PoolClock::nanosPerTick()
+#ifdef __VERSION__
+        << ", \"compiler\": \"" << __VERSION__ << "\""
+#endif
+#ifdef NDEBUG
+        << ", \"assertions\": false"
+#else
+        << ", \"assertions\": true"
+#endif
+        << ", \"repetitions\": " << options.repetitions
+        << ", \"warmup\": " << options.warmup
+        << ", \"min_time_ms\": " << options.minSampleMillis << "},\n\"benchmarks\": [\n";
+
+    out << std::setprecision(10);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& result = results[i];
+        const SampleStats& stats = result.nanosPerIteration;
+        out << "{\"name\": \"" << result.name << "\""
+            << ", \"iterations\": " << result.iterations
+            << ", \"repetitions\": " << result.repetitions
+            << ", \"median_ns\": " << stats.median
+            << ", \"mean_ns\": " << stats.mean
+            << ", \"p99_ns\": " << stats.p99
+            << ", \"stddev_ns\": " << stats.stddev
+            << ", \"min_ns\": " << stats.min
+            << ", \"max_ns\": " << stats.max
+            << ", \"items_per_second\": " << result.itemsPerSecond << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]\n}\n";
+}
+
+namespace detail {
+
+inline bool extractString(const std::string& line, const std::string& key, std::string& value) {
+    std::string pattern = "\"" + key + "\": \"";
+    size_t start = line.find(pattern);
+    if (start == std::string::npos) return false;
+    start += pattern.size();
+    size_t end = line.find('"', start);
+    if (end == std::string::npos) return false;
+    value = line.substr(start, end - start);
+    return true;
+}
+
+inline double extractNumber(const std::string& line, const std::string& key) {
+    std::string pattern = "\"" + key + "\": ";
+    size_t start = line.find(pattern);
+    if (start == std::string::npos) {
+        throw std::runtime_error("в строке результата нет поля " + key);
+    }
+    return std::stod(line.substr(start + pattern.size()));
+}
+
+} // namespace detail
+
+/**
+ * @brief Прочитать файл, записанный writeJson()
+ * @throws std::runtime_error если файл не открывается или строка повреждена
+ */
+inline std::vector<BenchmarkResult> readJson(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Не удалось открыть файл результатов: " + path);
+    }
+    std::vector<BenchmarkResult> results;
+    std::string line;
+    while (std::getline(in, line)) {
+        BenchmarkResult result;
+        if (!detail::extractString(line, "name", result.name)) {
+            continue;
+        }
+        result.iterations = static_cast<size_t>(detail::extractNumber(line, "iterations"));
+        result.repetitions = static_cast<size_t>(detail::extractNumber(line, "repetitions"));
+        result.nanosPerIteration.median = detail::extractNumber(line, "median_ns");
+        result.nanosPerIteration.mean = detail::extractNumber(line, "mean_ns");
+        result.nanosPerIteration.p99 = detail::extractNumber(line, "p99_ns");
+        result.nanosPerIteration.stddev = detail::extractNumber(line, "stddev_ns");
+        result.nanosPerIteration.min = detail::extractNumber(line, "min_ns");
+        result.nanosPerIteration.max = detail::extractNumber(line, "max_ns");
+        result.itemsPerSecond = detail::extractNumber(line, "items_per_second");
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+/**
+ * @brief Сравнить медианы двух прогонов
+ *
+ * Регрессия - медиана выросла больше чем на thresholdPercent и разница
+ * больше трёх стандартных ошибок (иначе это шум между запусками).
+ * @return число регрессий
+ */
+inline size_t compareResults(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current,
+                             double thresholdPercent, std::ostream& out) {
+    auto standardError = [](const BenchmarkResult& result) {
+        double count = static_cast<double>(std::max<size_t>(result.repetitions, 1));
+        return result.nanosPerIteration.stddev / std::sqrt(count);
+    };
+
+    detail::writeCell(out, "Бенчмарк", 44, true);
+    detail::writeCell(out, "было нс", 14, false);
+    detail::writeCell(out, "стало нс", 14, false);
+    detail::writeCell(out, "Δ %", 10, false);
+    out << "  итог\n";
+
+    size_t regressions = 0;
+    for (const BenchmarkResult& now : current) {
+        auto it = std::find_if(baseline.begin(), baseline.end(),
+                               [&](const BenchmarkResult& base) { return base.name == now.name; });
+        out << std::left << std::setw(44) << now.name << std::right << std::fixed << std::setprecision(2);
+        if (it == baseline.end()) {
+            out << std::setw(14) << "-" << std::setw(14) << now.nanosPerIteration.median << std::setw(10) << "-"
+                << "  новый" << std::defaultfloat << "\n";
+            continue;
+        }
+        double before = it->nanosPerIteration.median;
+        double after = now.nanosPerIteration.median;
+        double delta = before > 0.0 ? (after - before) / before * 100.0 : 0.0;
+        double noise = 3.0 * std::sqrt(std::pow(standardError(*it), 2) + std::pow(standardError(now), 2));
+        const char* verdict = "  в пределах шума";
+        if (std::abs(delta) > thresholdPercent && std::abs(after - before) > noise) {
+            if (delta > 0) {
+                verdict = "  РЕГРЕССИЯ";
+                ++regressions;
+            } else {
+                verdict = "  улучшение";
+            }
+        }
+        out << std::setw(14) << before << std::setw(14) << after << std::setw(10) << std::setprecision(1) << delta
+            << verdict << std::defaultfloat << "\n";
+    }
+    for (const BenchmarkResult& base : baseline) {
+        bool present = std::any_of(current.begin(), current.end(),
+                                   [&](const BenchmarkResult& now) { return now.name == base.name; });
+        if (!present) {
+            out << std::left << std::setw(44) << base.name << "  нет в новом прогоне" << "\n";
+        }
+    }
+    return regressions;
+}
+
+} // namespace cpp_patterns::bench
@@ -0,0 +1,119 @@
+/**
+ * @file benchmarks_main.cpp
+ * @brief Точка входа набора бенчмарков: прогон, JSON и сравнение двух прогонов
+ *
+ * Запуск:
+ *   benchmarks [--filter=REGEX] [--repetitions=N] [--warmup=N] [--min-time-ms=N] [--json=FILE]
+ *   benchmarks --list
+ *   benchmarks --compare BASE.json NEW.json [--threshold=PERCENT]
+ *
+ * Код возврата: 0 - успех, 1 - есть регрессии (--compare), 2 - ошибка.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#include "benchmark_harness.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace cpp_patterns::bench;
+
+void printUsage() {
+    std::cout << "Использование:\n"
+              << "  benchmarks [--filter=REGEX] [--repetitions=N] [--warmup=N] [--min-time-ms=N] [--json=FILE]\n"
+              << "  benchmarks --list\n"
+              << "  benchmarks --compare BASE.json NEW.json [--threshold=PERCENT]\n";
+}
+
+bool readOption(const std::string& argument, const std::string& name, std::string& value) {
+    std::string prefix = "--" + name + "=";
+    if (argument.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    value = argument.substr(prefix.size());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        RunOptions options;
+        std::string jsonPath;
+        std::vector<std::string> compareFiles;
+        double threshold = 5.0;
+        bool compare = false;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            std::string value;
+            if (argument == "--help" || argument == "-h") {
+                printUsage();
+                return 0;
+            } else if (argument == "--list") {
+                for (const auto& benchmark : benchmarkRegistry()) {
+                    for (const auto& instance : benchmark->instances()) {
+                        std::cout << instance.first << "\n";
+                    }
+                }
+                return 0;
+            } else if (argument == "--compare") {
+                compare = true;
+            } else if (readOption(argument, "filter", value)) {
+                options.filter = value;
+            } else if (readOption(argument, "repetitions", value)) {
+                options.repetitions = std::stoi(value);
+            } else if (readOption(argument, "warmup", value)) {
+                options.warmup = std::stoi(value);
+            } else if (readOption(argument, "min-time-ms", value)) {
+                options.minSampleMillis = std::stod(value);
+            } else if (readOption(argument, "json", value)) {
+                jsonPath = value;
+            } else if (readOption(argument, "threshold", value)) {
+                threshold = std::stod(value);
+            } else if (compare && argument.rfind("--", 0) != 0) {
+                compareFiles.push_back(argument);
+            } else {
+                std::cerr << "Неизвестный аргумент: " << argument << "\n";
+                printUsage();
+                return 2;
+            }
+        }
+
+        if (compare) {
+            if (compareFiles.size() != 2) {
+                printUsage();
+                return 2;
+            }
+            size_t regressions = compareResults(readJson(compareFiles[0]), readJson(compareFiles[1]),
+                                                threshold, std::cout);
+            std::cout << "\nРегрессий (порог " << threshold << "%): " << regressions << std::endl;
+            return regressions > 0 ? 1 : 0;
+        }
+
+#ifndef NDEBUG
+        std::cout << "Внимание: сборка с assert'ами, цифры не сравнимы с Release\n";
+#endif
+        std::vector<BenchmarkResult> results = runBenchmarks(options, std::cout);
+        if (!jsonPath.empty()) {
+            std::ofstream out(jsonPath, std::ios::trunc);
+            if (!out) {
+                throw std::runtime_error("Не удалось записать " + jsonPath);
+            }
+            writeJson(out, results, options);
+            std::cout << "Результаты: " << jsonPath << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: " << e.what() << std::endl;
+        return 2;
+    }
+}
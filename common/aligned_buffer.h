@@ -0,0 +1,314 @@
+/**
+ * @file aligned_buffer.h
+ * @brief Владеющий буфер с заданным выравниванием для численных ядер
+ *
+ * IntArray из урока 1.2 делает new int[size], обнуляет память скалярным
+ * циклом и проверяет индекс в operator[]: исключение в теле цикла мешает
+ * компилятору векторизовать код поверх массива. Здесь:
+ * - выравнивание - параметр шаблона: 64 байта (кэш-линия, ни одна загрузка
+ *   AVX-512 не пересекает границу линии) или 2 МиБ (huge pages);
+ * - конструктор с kUninitialized только выделяет память - для буферов,
+ *   которые тут же целиком перезапишут;
+ * - operator[] без проверки (assert в отладочной сборке), at() с проверкой;
+ * - span()/as2D()/mdspan() - представления без копирования.
+ *
+ * SIMD-ядра fill/copy/transform над такими буферами - в simd_kernels.h.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<span>) && __cplusplus >= 202002L
+#include <span>
+#endif
+#if __has_include(<mdspan>) && __cplusplus > 202002L
+#include <mdspan>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace cpp_patterns {
+
+constexpr size_t kBufferCacheLine = 64;
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+/**
+ * @brief Метка конструктора без инициализации элементов
+ */
+struct UninitializedTag {
+    explicit UninitializedTag() = default;
+};
+
+inline constexpr UninitializedTag kUninitialized{};
+
+/**
+ * @brief Двумерное представление строк подряд (row-major) поверх чужой памяти
+ *
+ * Замена std::mdspan для C++17; view действителен, пока жив владелец памяти.
+ */
+template<typename T>
+class MatrixView {
+public:
+    MatrixView(T* data, size_t rows, size_t cols) noexcept : data_(data), rows_(rows), cols_(cols) {}
+
+    T& operator()(size_t row, size_t col) const noexcept {
+        assert(row < rows_ && col < cols_);
+        return data_[row * cols_ + col];
+    }
+
+    T* row(size_t index) const noexcept { return data_ + index * cols_; }
+    T* data() const noexcept { return data_; }
+    size_t rows() const noexcept { return rows_; }
+    size_t cols() const noexcept { return cols_; }
+
+private:
+    T* data_;
+    size_t rows_;
+    size_t cols_;
+};
+
+/**
+ * @brief Буфер из size элементов T по адресу, кратному Alignment
+ *
+ * T - тривиальный тип (числа, POD-структуры): память не конструируется
+ * поэлементно и не разрушается. Буфер только перемещается; копия - clone().
+ * Выравнивание от 2 МиБ на Linux берётся у mmap с подсказкой MADV_HUGEPAGE:
+ * такие страницы приходят от ядра нулевыми, и обнуление их не трогает.
+ */
+template<typename T, size_t Alignment = kBufferCacheLine>
+class AlignedBuffer {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "AlignedBuffer хранит только тривиальные типы");
+    static_assert((Alignment & (Alignment - 1)) == 0 && Alignment >= alignof(T),
+                  "Выравнивание - степень двойки не меньше alignof(T)");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_t alignment = Alignment;
+
+    AlignedBuffer() noexcept = default;
+
+    /**
+     * @brief size нулевых элементов
+     * @throws std::bad_alloc если память не выделена
+     */
+    explicit AlignedBuffer(size_t size) : AlignedBuffer(size, kUninitialized) {
+        if (!mapped_ && size_ > 0) {
+            std::memset(static_cast<void*>(data_), 0, size_ * sizeof(T));
+        }
+    }
+
+    AlignedBuffer(size_t size, const T& value) : AlignedBuffer(size, kUninitialized) {
+        std::fill_n(data_, size_, value);
+    }
+
+    /**
+     * @brief size элементов с неопределёнными значениями: только выделение
+     */
+    AlignedBuffer(size_t size, UninitializedTag) : size_(size) {
+        allocate();
+    }
+
+    ~AlignedBuffer() { release(); }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          mapped_(std::exchange(other.mapped_, false)),
+          hugePages_(std::exchange(other.hugePages_, false)) {}
+
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            mapped_ = std::exchange(other.mapped_, false);
+            hugePages_ = std::exchange(other.hugePages_, false);
+        }
+        return *this;
+    }
+
+    AlignedBuffer clone() const {
+        AlignedBuffer copy(size_, kUninitialized);
+        if (size_ > 0) {
+            std::memcpy(static_cast<void*>(copy.data_), data_, size_ * sizeof(T));
+        }
+        return copy;
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    /**
+     * @throws std::out_of_range если index >= size()
+     */
+    T& at(size_t index) {
+        checkIndex(index);
+        return data_[index];
+    }
+
+    const T& at(size_t index) const {
+        checkIndex(index);
+        return data_[index];
+    }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    size_t sizeBytes() const noexcept { return size_ * sizeof(T); }
+    bool empty() const noexcept { return size_ == 0; }
+
+    // Ядро подтвердило MADV_HUGEPAGE; страницы всё равно может выдать по 4 КиБ
+    bool hugePagesRequested() const noexcept { return hugePages_; }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    /**
+     * @brief Представление rows x cols над началом буфера
+     * @throws std::invalid_argument если rows * cols больше size()
+     */
+    MatrixView<T> as2D(size_t rows, size_t cols) {
+        checkShape(rows, cols);
+        return MatrixView<T>(data_, rows, cols);
+    }
+
+    MatrixView<const T> as2D(size_t rows, size_t cols) const {
+        checkShape(rows, cols);
+        return MatrixView<const T>(data_, rows, cols);
+    }
+
+#ifdef __cpp_lib_span
+    std::span<T> span() noexcept { return {data_, size_}; }
+    std::span<const T> span() const noexcept { return {data_, size_}; }
+#endif
+
+#ifdef __cpp_lib_mdspan
+    std::mdspan<T, std::dextents<size_t, 2>> mdspan(size_t rows, size_t cols) {
+        checkShape(rows, cols);
+        return std::mdspan<T, std::dextents<size_t, 2>>(data_, rows, cols);
+    }
+#endif
+
+private:
+    static constexpr bool kUseMmap =
+#if defined(__linux__)
+        Alignment >= kHugePageSize;
+#else
+        false;
+#endif
+
+    size_t allocationBytes() const noexcept {
+        size_t bytes = size_ * sizeof(T);
+        return (bytes + Alignment - 1) & ~(Alignment - 1);
+    }
+
+    void allocate() {
+        if (size_ == 0) {
+            return;
+        }
+        if (size_ > (SIZE_MAX - Alignment) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+#if defined(__linux__)
+        if constexpr (kUseMmap) {
+            // Резервируем лишние Alignment байт и обрезаем края до выровненного окна
+            size_t bytes = allocationBytes();
+            size_t reserve = bytes + Alignment;
+            void* region = mmap(nullptr, reserve, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (region == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            uintptr_t start = reinterpret_cast<uintptr_t>(region);
+            uintptr_t aligned = (start + Alignment - 1) & ~(uintptr_t{Alignment} - 1);
+            if (aligned > start) {
+                munmap(region, aligned - start);
+            }
+            if (start + reserve > aligned + bytes) {
+                munmap(reinterpret_cast<void*>(aligned + bytes), start + reserve - aligned - bytes);
+            }
+#ifdef MADV_HUGEPAGE
+            hugePages_ = madvise(reinterpret_cast<void*>(aligned), bytes, MADV_HUGEPAGE) == 0;
+#endif
+            data_ = reinterpret_cast<T*>(aligned);
+            mapped_ = true;
+            return;
+        }
+#endif
+        data_ = static_cast<T*>(::operator new(allocationBytes(), std::align_val_t{Alignment}));
+    }
+
+    void release() noexcept {
+        if (!data_) {
+            return;
+        }
+#if defined(__linux__)
+        if (mapped_) {
+            munmap(static_cast<void*>(data_), allocationBytes());
+            data_ = nullptr;
+            return;
+        }
+#endif
+        ::operator delete(static_cast<void*>(data_), std::align_val_t{Alignment});
+        data_ = nullptr;
+    }
+
+    void checkIndex(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Индекс " + std::to_string(index) + " вне диапазона [0, " +
+                                    std::to_string(size_) + ")");
+        }
+    }
+
+    void checkShape(size_t rows, size_t cols) const {
+        if (cols != 0 && rows > size_ / cols) {
+            throw std::invalid_argument("Форма " + std::to_string(rows) + "x" + std::to_string(cols) +
+                                        " больше буфера из " + std::to_string(size_) + " элементов");
+        }
+    }
+
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    bool hugePages_ = false;
+};
+
+/**
+ * @brief Буфер на huge pages: меньше промахов TLB при проходе по сотням мегабайт
+ */
+template<typename T>
+using HugePageBuffer = AlignedBuffer<T, kHugePageSize>;
+
+} // namespace cpp_patterns
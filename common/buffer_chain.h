@@ -0,0 +1,382 @@
+/**
+ * @file buffer_chain.h
+ * @brief Буферы соединений: пул слабов, цепочки срезов и writev
+ *
+ * Типичный буфер вывода - std::string, из начала которого после каждой
+ * частичной записи делают erase(0, n): большой ответ копируется заново
+ * на каждой итерации, и стоимость растёт квадратично. Здесь:
+ * - Slab - блок фиксированного размера из пула потока, дописывается только
+ *   в конец, поэтому на уже записанные байты можно безопасно ссылаться;
+ * - SharedPayload - неизменяемые данные с атомарным счётчиком (например,
+ *   статический ответ), один экземпляр на все соединения и потоки;
+ * - BufferChain - очередь срезов слабов и payload'ов; отправляется через
+ *   writev, частичная запись только сдвигает смещение;
+ * - ReadBuffer - чтение из сокета сразу в свободное место слаба.
+ *
+ * Слабы используют неатомарный счётчик: цепочка и её слабы принадлежат
+ * одному потоку (циклу событий). Между потоками передаётся только SharedPayload.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include "intrusive_ptr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace cpp_patterns {
+
+/**
+ * @brief Блок памяти фиксированного размера; пишется только в конец
+ *
+ * Память слаба берётся из кэша свободных блоков текущего потока
+ * (operator new/delete класса), поэтому в установившемся режиме
+ * соединения не обращаются к malloc.
+ */
+class Slab : public RefCounted<Slab, LocalRefCount> {
+public:
+    static constexpr size_t kSize = 16 * 1024;
+    static constexpr size_t kHeader = 64;
+    static constexpr size_t kCapacity = kSize - kHeader;
+    static constexpr size_t kMaxCachedPerThread = 256;  // 4 МиБ на поток
+
+    size_t used = 0;
+    alignas(kHeader) char bytes[kCapacity];
+
+    char* end() noexcept { return bytes + used; }
+    size_t available() const noexcept { return kCapacity - used; }
+
+    static IntrusivePtr<Slab> acquire() { return makeIntrusive<Slab>(); }
+
+    static void* operator new(size_t size) {
+        Cache& cache = threadCache();
+        if (size == sizeof(Slab) && !cache.blocks.empty()) {
+            void* block = cache.blocks.back();
+            cache.blocks.pop_back();
+            return block;
+        }
+        heapCounter().fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size, std::align_val_t{alignof(Slab)});
+    }
+
+    static void operator delete(void* block, size_t size) noexcept {
+        Cache& cache = threadCache();
+        if (size == sizeof(Slab) && cache.blocks.size() < kMaxCachedPerThread) {
+            cache.blocks.push_back(block);
+            return;
+        }
+        ::operator delete(block, std::align_val_t{alignof(Slab)});
+    }
+
+    /**
+     * @brief Сколько раз слаб пришлось брать из кучи (все потоки)
+     */
+    static size_t heapAllocations() noexcept { return heapCounter().load(std::memory_order_relaxed); }
+
+private:
+    struct Cache {
+        std::vector<void*> blocks;
+
+        ~Cache() {
+            for (void* block : blocks) {
+                ::operator delete(block, std::align_val_t{alignof(Slab)});
+            }
+        }
+    };
+
+    static Cache& threadCache() {
+        static thread_local Cache cache;
+        return cache;
+    }
+
+    static std::atomic<size_t>& heapCounter() {
+        static std::atomic<size_t> counter{0};
+        return counter;
+    }
+};
+
+static_assert(sizeof(Slab) == Slab::kSize, "Slab должен занимать ровно kSize байт");
+
+/**
+ * @brief Неизменяемые общие данные (статические ответы, кэш файлов)
+ */
+class SharedPayload : public RefCounted<SharedPayload, AtomicRefCount> {
+public:
+    explicit SharedPayload(std::string bytes) : bytes_(std::move(bytes)) {}
+
+    const char* data() const noexcept { return bytes_.data(); }
+    size_t size() const noexcept { return bytes_.size(); }
+
+private:
+    std::string bytes_;
+};
+
+/**
+ * @brief Срез данных: внутри слаба (владеющий) или чужой памяти (заимствованный)
+ *
+ * Заимствованный срез действителен только на время вызова; при добавлении
+ * в BufferChain его байты копируются.
+ */
+class BufferSlice {
+public:
+    BufferSlice() = default;
+    BufferSlice(IntrusivePtr<Slab> slab, const char* data, size_t size)
+        : slab_(std::move(slab)), data_(data), size_(size) {}
+
+    static BufferSlice borrowed(const char* data, size_t size) { return BufferSlice(nullptr, data, size); }
+
+    const char* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    bool owned() const noexcept { return static_cast<bool>(slab_); }
+    const IntrusivePtr<Slab>& slab() const noexcept { return slab_; }
+    std::string_view view() const noexcept { return std::string_view(data_, size_); }
+
+private:
+    IntrusivePtr<Slab> slab_;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Очередь исходящих данных из срезов слабов и SharedPayload
+ */
+class BufferChain {
+public:
+    static constexpr size_t kMaxIovecs = 64;
+
+    /**
+     * @brief Скопировать байты в хвостовой слаб (при нехватке места - в новые)
+     */
+    void append(std::string_view bytes) {
+        while (!bytes.empty()) {
+            Segment* tail = writableTail();
+            if (!tail) {
+                segments_.push_back(Segment{Slab::acquire(), nullptr, nullptr, 0});
+                tail = &segments_.back();
+                tail->data = tail->slab->end();
+            }
+            Slab& slab = *tail->slab;
+            size_t chunk = std::min(bytes.size(), slab.available());
+            std::memcpy(slab.end(), bytes.data(), chunk);
+            slab.used += chunk;
+            tail->size += chunk;
+            size_ += chunk;
+            bytes.remove_prefix(chunk);
+        }
+    }
+
+    /**
+     * @brief Добавить срез слаба без копирования (заимствованный - копируется)
+     */
+    void append(const BufferSlice& slice) {
+        if (!slice.owned()) {
+            append(slice.view());
+            return;
+        }
+        if (slice.size() == 0) {
+            return;
+        }
+        segments_.push_back(Segment{slice.slab(), nullptr, slice.data(), slice.size()});
+        size_ += slice.size();
+    }
+
+    /**
+     * @brief Сослаться на общие данные без копирования
+     */
+    void append(IntrusivePtr<SharedPayload> payload) {
+        if (!payload || payload->size() == 0) {
+            return;
+        }
+        const char* data = payload->data();
+        size_t size = payload->size();
+        segments_.push_back(Segment{nullptr, std::move(payload), data, size});
+        size_ += size;
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_t segmentCount() const noexcept { return segments_.size(); }
+
+    /**
+     * @brief Заполнить iovec неотправленными данными; возвращает число элементов
+     */
+    size_t fillIovecs(iovec* iovecs, size_t max_count) const {
+        size_t count = 0;
+        size_t skip = offset_;
+        for (const Segment& segment : segments_) {
+            if (count == max_count) break;
+            iovecs[count].iov_base = const_cast<char*>(segment.data + skip);
+            iovecs[count].iov_len = segment.size - skip;
+            skip = 0;
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Отметить bytes байт отправленными: сдвиг смещения, без копирования
+     */
+    void consume(size_t bytes) {
+        bytes = std::min(bytes, size_);
+        size_ -= bytes;
+        while (bytes > 0) {
+            Segment& head = segments_.front();
+            size_t left = head.size - offset_;
+            if (bytes < left) {
+                offset_ += bytes;
+                return;
+            }
+            bytes -= left;
+            offset_ = 0;
+            segments_.pop_front();
+        }
+    }
+
+    /**
+     * @brief Обойти неотправленные участки (для API без iovec)
+     */
+    template<typename Callback>
+    void forEachSegment(Callback&& callback) const {
+        size_t skip = offset_;
+        for (const Segment& segment : segments_) {
+            callback(segment.data + skip, segment.size - skip);
+            skip = 0;
+        }
+    }
+
+    void clear() {
+        segments_.clear();
+        offset_ = 0;
+        size_ = 0;
+    }
+
+    /**
+     * @brief Один writev неотправленных данных
+     * @return отправлено байт или -1 (errno как у writev)
+     */
+    ssize_t writeTo(int fd) {
+        iovec iovecs[kMaxIovecs];
+        size_t count = fillIovecs(iovecs, kMaxIovecs);
+        if (count == 0) {
+            return 0;
+        }
+        ssize_t written = ::writev(fd, iovecs, static_cast<int>(count));
+        if (written > 0) {
+            consume(static_cast<size_t>(written));
+        }
+        return written;
+    }
+
+    /**
+     * @brief То же для сокета: sendmsg с MSG_NOSIGNAL (writev при закрытом
+     * собеседнике посылает процессу SIGPIPE)
+     */
+    ssize_t sendTo(int fd) {
+        iovec iovecs[kMaxIovecs];
+        size_t count = fillIovecs(iovecs, kMaxIovecs);
+        if (count == 0) {
+            return 0;
+        }
+        msghdr message{};
+        message.msg_iov = iovecs;
+        message.msg_iovlen = count;
+        ssize_t written = ::sendmsg(fd, &message, MSG_NOSIGNAL);
+        if (written > 0) {
+            consume(static_cast<size_t>(written));
+        }
+        return written;
+    }
+
+private:
+    struct Segment {
+        IntrusivePtr<Slab> slab;
+        IntrusivePtr<SharedPayload> payload;
+        const char* data;
+        size_t size;
+    };
+
+    // Хвостовой сегмент можно наращивать, если после него в слаб никто не писал
+    Segment* writableTail() {
+        if (segments_.empty()) {
+            return nullptr;
+        }
+        Segment& tail = segments_.back();
+        if (!tail.slab || tail.slab->available() == 0 || tail.data + tail.size != tail.slab->end()) {
+            return nullptr;
+        }
+        return &tail;
+    }
+
+    std::deque<Segment> segments_;
+    size_t offset_ = 0;  // отправлено из первого сегмента
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Чтение из сокета в слабы пула
+ *
+ * Прочитанные байты возвращаются срезом, который держит слаб: его можно
+ * положить в BufferChain (echo, проксирование) без копирования.
+ */
+class ReadBuffer {
+public:
+    static constexpr size_t kMinReadSpace = 1024;
+
+    /**
+     * @brief Один read в свободное место текущего слаба
+     * @return прочитано байт, 0 при закрытии, -1 при ошибке (errno как у read)
+     */
+    ssize_t readFrom(int fd, BufferSlice& slice) {
+        if (!slab_ || slab_->available() < kMinReadSpace) {
+            slab_ = Slab::acquire();
+        }
+        char* target = slab_->end();
+        ssize_t received = ::read(fd, target, slab_->available());
+        if (received > 0) {
+            slab_->used += static_cast<size_t>(received);
+            slice = BufferSlice(slab_, target, static_cast<size_t>(received));
+        }
+        return received;
+    }
+
+    /**
+     * @brief Скопировать уже прочитанные кем-то байты (например, из кольца io_uring)
+     * @throws std::length_error если size больше ёмкости слаба
+     */
+    BufferSlice store(const char* data, size_t size) {
+        if (size > Slab::kCapacity) {
+            throw std::length_error("ReadBuffer::store: блок больше слаба");
+        }
+        if (!slab_ || slab_->available() < size) {
+            slab_ = Slab::acquire();
+        }
+        char* target = slab_->end();
+        std::memcpy(target, data, size);
+        slab_->used += size;
+        return BufferSlice(slab_, target, size);
+    }
+
+private:
+    IntrusivePtr<Slab> slab_;
+};
+
+} // namespace cpp_patterns
@@ -0,0 +1,75 @@
+/**
+ * @file counting_resource.h
+ * @brief memory_resource, считающий выделения, которые прошли через него
+ *
+ * Бенчмаркам уроков нужно число аллокаций на операцию. Замена глобального
+ * operator new считает всё подряд (потоки, iostream, контейнеры
+ * демонстраций), не видит array- и aligned-вариантов и даёт предупреждения
+ * -Wmismatched-new-delete. Здесь счёт ограничен тем, что явно направлено в
+ * ресурс: полиморфным аллокатором, std::pmr-контейнером или
+ * operator new класса.
+ *
+ * Счётчики атомарные: освобождать память может другой поток.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace cpp_patterns {
+
+/**
+ * @brief Снимок счётчиков; разность двух снимков - цена участка кода
+ */
+struct AllocationStats {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytes = 0;
+
+    AllocationStats operator-(const AllocationStats& before) const {
+        return {allocations - before.allocations, deallocations - before.deallocations, bytes - before.bytes};
+    }
+};
+
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+        : upstream_(upstream) {}
+
+    AllocationStats stats() const noexcept {
+        return {allocations_.load(std::memory_order_relaxed), deallocations_.load(std::memory_order_relaxed),
+                bytes_.load(std::memory_order_relaxed)};
+    }
+
+    std::pmr::memory_resource* upstream() const noexcept { return upstream_; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* p = upstream_->allocate(bytes, alignment);
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(bytes, std::memory_order_relaxed);
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        deallocations_.fetch_add(1, std::memory_order_relaxed);
+        upstream_->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource* upstream_;
+    std::atomic<uint64_t> allocations_{0};
+    std::atomic<uint64_t> deallocations_{0};
+    std::atomic<uint64_t> bytes_{0};
+};
+
+} // namespace cpp_patterns
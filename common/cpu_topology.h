@@ -0,0 +1,407 @@
+/**
+ * @file cpu_topology.h
+ * @brief Топология CPU и политики размещения потоков пулов
+ *
+ * Планировщик ОС свободно переносит воркеров между ядрами и NUMA-узлами:
+ * после переноса кэши холодные, а память очереди и состояния воркера
+ * оказывается на чужом узле. Здесь:
+ * - CpuTopology читает /sys/devices/system/{cpu,node} с учётом маски
+ *   sched_getaffinity (контейнеры, taskset); без sysfs - один узел;
+ * - ThreadPlacement - политики Compact (плотно: SMT-соседи, затем ядра
+ *   одного узла), Scatter (вразброс: сначала узлы, затем ядра, SMT в конце)
+ *   и Explicit (явный набор CPU для пула или bulkhead);
+ * - pinCurrentThread - закрепление потока через pthread_setaffinity_np;
+ * - buildStealOrder - порядок кражи «сначала ближние воркеры».
+ *
+ * Отдельной NUMA-аллокации (libnuma) нет: Linux размещает страницу на узле
+ * потока, который первым её коснулся (first touch). Поэтому воркер сначала
+ * закрепляется, а затем сам создаёт свою очередь и состояние.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace cpp_patterns {
+
+/**
+ * @brief Один логический CPU и его место в иерархии
+ */
+struct CpuInfo {
+    int cpu = 0;       // номер логического CPU
+    int core = 0;      // core_id (уникален только внутри пакета)
+    int package = 0;   // physical_package_id
+    int node = 0;      // NUMA-узел
+    int smtIndex = 0;  // порядковый номер среди SMT-соседей ядра
+};
+
+/**
+ * @brief Топология доступных процессу CPU
+ */
+class CpuTopology {
+public:
+    /**
+     * @brief Топология текущей машины (определяется один раз)
+     */
+    static const CpuTopology& system() {
+        static const CpuTopology topology = detect();
+        return topology;
+    }
+
+    static CpuTopology detect() {
+        CpuTopology topology;
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        bool hasMask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+        std::map<int, int> nodeOf;
+        for (int node : parseCpuList(readLine("/sys/devices/system/node/possible"))) {
+            std::string base = "/sys/devices/system/node/node" + std::to_string(node);
+            for (int cpu : parseCpuList(readLine(base + "/cpulist"))) {
+                nodeOf[cpu] = node;
+            }
+            std::istringstream distances(readLine(base + "/distance"));
+            std::vector<int> row;
+            for (int value; distances >> value;) {
+                row.push_back(value);
+            }
+            topology.nodeDistances_[node] = row;
+        }
+
+        for (int cpu : parseCpuList(readLine("/sys/devices/system/cpu/online"))) {
+            // cpu_set_t вмещает CPU_SETSIZE номеров: за ним CPU_ISSET читает
+            // мимо маски, а pinCurrentThread такой CPU всё равно не закрепит
+            if (cpu < 0 || cpu >= CPU_SETSIZE || (hasMask && !CPU_ISSET(cpu, &allowed))) {
+                continue;
+            }
+            std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+            CpuInfo info;
+            info.cpu = cpu;
+            info.core = readInt(base + "core_id", cpu);
+            info.package = readInt(base + "physical_package_id", 0);
+            info.node = nodeOf.count(cpu) ? nodeOf[cpu] : 0;
+            std::vector<int> siblings = parseCpuList(readLine(base + "thread_siblings_list"));
+            auto position = std::find(siblings.begin(), siblings.end(), cpu);
+            info.smtIndex = position == siblings.end() ? 0 : static_cast<int>(position - siblings.begin());
+            topology.cpus_.push_back(info);
+        }
+#endif
+        if (topology.cpus_.empty()) {
+            return uniform(std::max(1u, std::thread::hardware_concurrency()));
+        }
+        topology.countNodes();
+        return topology;
+    }
+
+    /**
+     * @brief Плоская топология: cpus ядер без SMT на одном узле
+     */
+    static CpuTopology uniform(size_t cpus) {
+        CpuTopology topology;
+        for (size_t i = 0; i < cpus; ++i) {
+            CpuInfo info;
+            info.cpu = static_cast<int>(i);
+            info.core = static_cast<int>(i);
+            topology.cpus_.push_back(info);
+        }
+        topology.countNodes();
+        return topology;
+    }
+
+    const std::vector<CpuInfo>& cpus() const { return cpus_; }
+    size_t cpuCount() const { return cpus_.size(); }
+    size_t nodeCount() const { return nodeCount_; }
+
+    const CpuInfo* find(int cpu) const {
+        for (const CpuInfo& info : cpus_) {
+            if (info.cpu == cpu) {
+                return &info;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Условное расстояние между CPU: меньше - ближе
+     *
+     * 0 - тот же CPU, 1 - SMT-сосед, 2 - тот же пакет и узел, 3 - тот же
+     * узел; для разных узлов - 10 + расстояние из nodeN/distance (SLIT).
+     * Неизвестные CPU (поток не закреплён) считаются равноудалёнными.
+     */
+    int distance(int cpuA, int cpuB) const {
+        const CpuInfo* a = find(cpuA);
+        const CpuInfo* b = find(cpuB);
+        if (!a || !b) {
+            return 0;
+        }
+        if (a->cpu == b->cpu) return 0;
+        if (a->node == b->node) {
+            if (a->package != b->package) return 3;
+            return a->core == b->core ? 1 : 2;
+        }
+        auto row = nodeDistances_.find(a->node);
+        if (row != nodeDistances_.end() && b->node >= 0 && static_cast<size_t>(b->node) < row->second.size()) {
+            return 10 + row->second[b->node];
+        }
+        return 30;
+    }
+
+    std::string describe() const {
+        std::ostringstream out;
+        size_t cores = 0;
+        std::vector<std::tuple<int, int, int>> seen;
+        for (const CpuInfo& info : cpus_) {
+            auto key = std::make_tuple(info.node, info.package, info.core);
+            if (std::find(seen.begin(), seen.end(), key) == seen.end()) {
+                seen.push_back(key);
+                ++cores;
+            }
+        }
+        out << cpus_.size() << " CPU, ядер: " << cores << ", NUMA-узлов: " << nodeCount_;
+        return out.str();
+    }
+
+    /**
+     * @brief Разбор формата cpulist: "0-3,8,10-11"
+     */
+    static std::vector<int> parseCpuList(const std::string& text) {
+        std::vector<int> result;
+        std::istringstream in(text);
+        std::string range;
+        while (std::getline(in, range, ',')) {
+            if (range.empty()) continue;
+            size_t dash = range.find('-');
+            try {
+                int first = std::stoi(range.substr(0, dash));
+                int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    result.push_back(cpu);
+                }
+            } catch (const std::exception&) {
+                return {};
+            }
+        }
+        return result;
+    }
+
+private:
+    static std::string readLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    static int readInt(const std::string& path, int fallback) {
+        std::string line = readLine(path);
+        try {
+            return line.empty() ? fallback : std::stoi(line);
+        } catch (const std::exception&) {
+            return fallback;
+        }
+    }
+
+    void countNodes() {
+        std::vector<int> nodes;
+        for (const CpuInfo& info : cpus_) {
+            if (std::find(nodes.begin(), nodes.end(), info.node) == nodes.end()) {
+                nodes.push_back(info.node);
+            }
+        }
+        nodeCount_ = nodes.size();
+    }
+
+    std::vector<CpuInfo> cpus_;
+    std::map<int, std::vector<int>> nodeDistances_;
+    size_t nodeCount_ = 1;
+};
+
+enum class PlacementPolicy {
+    None,      // решает планировщик ОС
+    Compact,   // плотно: общий L1/L2 у SMT-соседей, общий L3 и узел памяти
+    Scatter,   // вразброс: максимум кэша и пропускной способности памяти на поток
+    Explicit   // явный набор CPU (изоляция bulkhead-ов по ядрам)
+};
+
+inline const char* placementPolicyName(PlacementPolicy policy) {
+    switch (policy) {
+        case PlacementPolicy::None: return "none";
+        case PlacementPolicy::Compact: return "compact";
+        case PlacementPolicy::Scatter: return "scatter";
+        case PlacementPolicy::Explicit: return "explicit";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Политика размещения воркеров пула по CPU
+ */
+struct ThreadPlacement {
+    PlacementPolicy policy = PlacementPolicy::None;
+    std::vector<int> cpus;  // только для Explicit
+
+    static ThreadPlacement none() { return {}; }
+    static ThreadPlacement compact() { return {PlacementPolicy::Compact, {}}; }
+    static ThreadPlacement scatter() { return {PlacementPolicy::Scatter, {}}; }
+
+    static ThreadPlacement explicitCpus(std::vector<int> cpus) {
+        if (cpus.empty()) {
+            throw std::invalid_argument("ThreadPlacement: пустой набор CPU");
+        }
+        return {PlacementPolicy::Explicit, std::move(cpus)};
+    }
+
+    bool enabled() const { return policy != PlacementPolicy::None; }
+
+    /**
+     * @brief CPU для каждого из workers воркеров (-1 - не закреплять)
+     *
+     * Воркеров больше, чем CPU в порядке политики, - назначение идёт по кругу.
+     * @throws std::invalid_argument если явный CPU недоступен процессу
+     */
+    std::vector<int> assign(size_t workers, const CpuTopology& topology = CpuTopology::system()) const {
+        std::vector<int> order = cpuOrder(topology);
+        std::vector<int> result(workers, -1);
+        if (order.empty()) {
+            return result;
+        }
+        for (size_t i = 0; i < workers; ++i) {
+            result[i] = order[i % order.size()];
+        }
+        return result;
+    }
+
+    std::string describe() const {
+        std::string text = placementPolicyName(policy);
+        if (policy == PlacementPolicy::Explicit) {
+            text += " {";
+            for (size_t i = 0; i < cpus.size(); ++i) {
+                text += (i ? "," : "") + std::to_string(cpus[i]);
+            }
+            text += "}";
+        }
+        return text;
+    }
+
+private:
+    std::vector<int> cpuOrder(const CpuTopology& topology) const {
+        std::vector<CpuInfo> infos = topology.cpus();
+        std::vector<int> order;
+
+        switch (policy) {
+        case PlacementPolicy::None:
+            break;
+
+        case PlacementPolicy::Compact:
+            std::sort(infos.begin(), infos.end(), [](const CpuInfo& a, const CpuInfo& b) {
+                return std::tie(a.node, a.package, a.core, a.smtIndex, a.cpu) <
+                       std::tie(b.node, b.package, b.core, b.smtIndex, b.cpu);
+            });
+            for (const CpuInfo& info : infos) order.push_back(info.cpu);
+            break;
+
+        case PlacementPolicy::Scatter: {
+            // Внутри узла: сначала по одному CPU на ядро, SMT-соседи потом;
+            // между узлами - по очереди
+            std::sort(infos.begin(), infos.end(), [](const CpuInfo& a, const CpuInfo& b) {
+                return std::tie(a.node, a.smtIndex, a.package, a.core, a.cpu) <
+                       std::tie(b.node, b.smtIndex, b.package, b.core, b.cpu);
+            });
+            std::map<int, std::vector<int>> perNode;
+            for (const CpuInfo& info : infos) perNode[info.node].push_back(info.cpu);
+            for (size_t round = 0; order.size() < infos.size(); ++round) {
+                for (const auto& node : perNode) {
+                    if (round < node.second.size()) order.push_back(node.second[round]);
+                }
+            }
+            break;
+        }
+
+        case PlacementPolicy::Explicit:
+            for (int cpu : cpus) {
+                if (!topology.find(cpu)) {
+                    throw std::invalid_argument("ThreadPlacement: CPU " + std::to_string(cpu) +
+                                                " недоступен процессу");
+                }
+            }
+            order = cpus;
+            break;
+        }
+        return order;
+    }
+};
+
+/**
+ * @brief Закрепить текущий поток за CPU
+ * @return false, если закрепление не поддерживается или запрещено (cgroup cpuset)
+ */
+inline bool pinCurrentThread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+/**
+ * @brief CPU, на котором сейчас выполняется поток (-1, если неизвестно)
+ */
+inline int currentCpu() {
+#ifdef __linux__
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief Порядок кражи для каждого воркера: сначала ближние по топологии
+ *
+ * При равном расстоянии сохраняется кольцевой порядок (worker+1, worker+2, ...),
+ * так что без закрепления поведение совпадает с обходом соседей по кругу.
+ */
+inline std::vector<std::vector<size_t>> buildStealOrder(const std::vector<int>& workerCpus,
+                                                        const CpuTopology& topology = CpuTopology::system()) {
+    size_t count = workerCpus.size();
+    std::vector<std::vector<size_t>> order(count);
+    for (size_t worker = 0; worker < count; ++worker) {
+        std::vector<size_t>& victims = order[worker];
+        for (size_t offset = 1; offset < count; ++offset) {
+            victims.push_back((worker + offset) % count);
+        }
+        std::stable_sort(victims.begin(), victims.end(), [&](size_t a, size_t b) {
+            return topology.distance(workerCpus[worker], workerCpus[a]) <
+                   topology.distance(workerCpus[worker], workerCpus[b]);
+        });
+    }
+    return order;
+}
+
+} // namespace cpp_patterns
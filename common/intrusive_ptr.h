@@ -0,0 +1,216 @@
+/**
+ * @file intrusive_ptr.h
+ * @brief Интрузивный подсчёт ссылок для горячих путей
+ *
+ * std::shared_ptr хранит счётчик в отдельном control block (при
+ * shared_ptr<T>(new T) это вторая аллокация), весит два указателя и
+ * атомарно меняет счётчик на каждой копии и dynamic_pointer_cast.
+ * Здесь счётчик живёт внутри объекта:
+ * - RefCounted<T> - базовый класс со счётчиком (атомарным или нет);
+ * - IntrusivePtr<T> - владеющий указатель размером в один указатель;
+ * - BorrowedPtr<T> - невладеющий вид для цепочек вызовов, которым
+ *   не нужно трогать счётчик.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_patterns {
+
+/**
+ * @brief Атомарный счётчик: объект можно передавать между потоками
+ */
+struct AtomicRefCount {
+    using Counter = std::atomic<uint32_t>;
+
+    static void increment(Counter& c) noexcept { c.fetch_add(1, std::memory_order_relaxed); }
+
+    // acq_rel: все записи в объект видны потоку, который его удалит
+    static bool decrement(Counter& c) noexcept { return c.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+    static uint32_t load(const Counter& c) noexcept { return c.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Неатомарный счётчик для объектов, не покидающих свой поток
+ */
+struct LocalRefCount {
+    using Counter = uint32_t;
+
+    static void increment(Counter& c) noexcept { ++c; }
+    static bool decrement(Counter& c) noexcept { return --c == 0; }
+    static uint32_t load(const Counter& c) noexcept { return c; }
+};
+
+/**
+ * @brief Базовый класс объектов с интрузивным счётчиком ссылок
+ *
+ * Derived - корень иерархии; при наследовании от него у Derived должен
+ * быть виртуальный деструктор. Копирование объекта не копирует счётчик.
+ */
+template<typename Derived, typename CountPolicy = AtomicRefCount>
+class RefCounted {
+private:
+    mutable typename CountPolicy::Counter refs_{0};
+
+protected:
+    RefCounted() noexcept = default;
+    RefCounted(const RefCounted&) noexcept {}
+    RefCounted& operator=(const RefCounted&) noexcept { return *this; }
+    ~RefCounted() = default;
+
+public:
+    void addRef() const noexcept { CountPolicy::increment(refs_); }
+
+    void release() const noexcept {
+        if (CountPolicy::decrement(refs_)) {
+            delete static_cast<const Derived*>(this);
+        }
+    }
+
+    uint32_t refCount() const noexcept { return CountPolicy::load(refs_); }
+};
+
+template<typename T>
+class BorrowedPtr;
+
+/**
+ * @brief Владеющий указатель на объект с интрузивным счётчиком
+ */
+template<typename T>
+class IntrusivePtr {
+private:
+    T* ptr_ = nullptr;
+
+    template<typename U>
+    friend class IntrusivePtr;
+
+public:
+    struct AdoptTag {};
+
+    IntrusivePtr() noexcept = default;
+    IntrusivePtr(std::nullptr_t) noexcept {}
+
+    explicit IntrusivePtr(T* ptr) noexcept : ptr_(ptr) {
+        if (ptr_) ptr_->addRef();
+    }
+
+    /**
+     * @brief Принять уже учтённую ссылку без увеличения счётчика
+     */
+    IntrusivePtr(T* ptr, AdoptTag) noexcept : ptr_(ptr) {}
+
+    IntrusivePtr(const IntrusivePtr& other) noexcept : ptr_(other.ptr_) {
+        if (ptr_) ptr_->addRef();
+    }
+
+    IntrusivePtr(IntrusivePtr&& other) noexcept : ptr_(other.ptr_) { other.ptr_ = nullptr; }
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    IntrusivePtr(const IntrusivePtr<U>& other) noexcept : ptr_(other.ptr_) {
+        if (ptr_) ptr_->addRef();
+    }
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    IntrusivePtr(IntrusivePtr<U>&& other) noexcept : ptr_(other.ptr_) { other.ptr_ = nullptr; }
+
+    ~IntrusivePtr() {
+        if (ptr_) ptr_->release();
+    }
+
+    IntrusivePtr& operator=(IntrusivePtr other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void reset() noexcept { IntrusivePtr().swap(*this); }
+
+    void swap(IntrusivePtr& other) noexcept { std::swap(ptr_, other.ptr_); }
+
+    /**
+     * @brief Отдать ссылку без уменьшения счётчика (пара к AdoptTag)
+     */
+    T* detach() noexcept {
+        T* ptr = ptr_;
+        ptr_ = nullptr;
+        return ptr;
+    }
+
+    T* get() const noexcept { return ptr_; }
+    T& operator*() const noexcept { return *ptr_; }
+    T* operator->() const noexcept { return ptr_; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    BorrowedPtr<T> borrow() const noexcept { return BorrowedPtr<T>(ptr_); }
+
+    friend bool operator==(const IntrusivePtr& a, const IntrusivePtr& b) noexcept { return a.ptr_ == b.ptr_; }
+    friend bool operator!=(const IntrusivePtr& a, const IntrusivePtr& b) noexcept { return a.ptr_ != b.ptr_; }
+};
+
+/**
+ * @brief Невладеющий вид: не меняет счётчик, живёт не дольше владельца
+ *
+ * Используется как параметр функций вместо const IntrusivePtr<T>& или
+ * сырого T*, когда важно явно показать «только на время вызова».
+ */
+template<typename T>
+class BorrowedPtr {
+private:
+    T* ptr_ = nullptr;
+
+public:
+    BorrowedPtr() noexcept = default;
+    explicit BorrowedPtr(T* ptr) noexcept : ptr_(ptr) {}
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    BorrowedPtr(const IntrusivePtr<U>& owner) noexcept : ptr_(owner.get()) {}
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    BorrowedPtr(BorrowedPtr<U> other) noexcept : ptr_(other.get()) {}
+
+    /**
+     * @brief Получить собственную ссылку (например, чтобы сохранить объект)
+     */
+    IntrusivePtr<T> toOwned() const noexcept { return IntrusivePtr<T>(ptr_); }
+
+    T* get() const noexcept { return ptr_; }
+    T& operator*() const noexcept { return *ptr_; }
+    T* operator->() const noexcept { return ptr_; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+};
+
+/**
+ * @brief Аналог std::make_shared: одна аллокация, счётчик уже равен 1
+ */
+template<typename T, typename... Args>
+IntrusivePtr<T> makeIntrusive(Args&&... args) {
+    return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Приведение вниз по иерархии с передачей владения (без атомарных операций)
+ */
+template<typename T, typename U>
+IntrusivePtr<T> staticPointerCast(IntrusivePtr<U>&& ptr) noexcept {
+    return IntrusivePtr<T>(static_cast<T*>(ptr.detach()), typename IntrusivePtr<T>::AdoptTag{});
+}
+
+/**
+ * @brief Проверяемое приведение невладеющего вида: счётчик не меняется
+ */
+template<typename T, typename U>
+BorrowedPtr<T> dynamicPointerCast(BorrowedPtr<U> ptr) noexcept {
+    return BorrowedPtr<T>(dynamic_cast<T*>(ptr.get()));
+}
+
+} // namespace cpp_patterns
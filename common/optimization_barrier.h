@@ -0,0 +1,43 @@
+/**
+ * @file optimization_barrier.h
+ * @brief Барьеры оптимизатора для замеров в уроках и бенчмарках
+ *
+ * Результат замеряемого цикла, который никуда не уходит, компилятор
+ * вправе выбросить вместе с циклом. Печать «пустой строки при sink == 42»
+ * это предотвращает, но добавляет ветку и зависимость от iostream.
+ * doNotOptimize() заставляет считать значение использованным без
+ * генерации кода, clobberMemory() запрещает переносить обращения к
+ * памяти через точку вызова.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+namespace cpp_patterns {
+
+/**
+ * @brief Не дать компилятору выбросить вычисление value
+ */
+template<typename T>
+inline void doNotOptimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static_cast<void>(*reinterpret_cast<char const volatile*>(&value));
+#endif
+}
+
+/**
+ * @brief Запретить переупорядочивание обращений к памяти через эту точку
+ */
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+} // namespace cpp_patterns
@@ -0,0 +1,283 @@
+/**
+ * @file pool_instrumentation.h
+ * @brief Инструментирование пулов потоков: счётчики по воркерам и гистограммы задержек
+ *
+ * Типичная ошибка - хранить счётчики воркеров в std::vector<WorkerStats>
+ * подряд: соседние воркеры делят кэш-линию, и каждое завершение задачи
+ * гоняет её между ядрами (false sharing). Здесь:
+ * - WorkerCounters выровнен на кэш-линию и пишется только своим воркером
+ *   (relaxed load + store, без атомарных RMW);
+ * - LatencyHistogram - логарифмические корзины в стиле HDR: 16 корзин на
+ *   каждую степень двойки, относительная погрешность ~6%, диапазон 1 нс..2^64 нс;
+ * - PoolInstrumentation::snapshot() читает счётчики на ходу, не
+ *   останавливая воркеры (снимок согласован по каждому полю, но не между ними);
+ * - PoolClock - дешёвые метки времени (rdtsc на x86-64, иначе steady_clock).
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#define CPP_PATTERNS_HAS_RDTSC 1
+#endif
+
+namespace cpp_patterns {
+
+constexpr size_t kCacheLineSize = 64;
+
+/**
+ * @brief Источник меток времени для горячего пути
+ *
+ * now() возвращает тики; toNanos() переводит разность тиков в наносекунды.
+ * На x86-64 используется инвариантный TSC (в 2 раза дешевле steady_clock),
+ * частота калибруется один раз по steady_clock.
+ */
+class PoolClock {
+public:
+    static uint64_t now() noexcept {
+#ifdef CPP_PATTERNS_HAS_RDTSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    static uint64_t toNanos(uint64_t ticks) noexcept {
+        return static_cast<uint64_t>(static_cast<double>(ticks) * nanosPerTick());
+    }
+
+    static double nanosPerTick() noexcept {
+        static const double ratio = calibrate();
+        return ratio;
+    }
+
+private:
+    static double calibrate() noexcept {
+#ifdef CPP_PATTERNS_HAS_RDTSC
+        auto wallStart = std::chrono::steady_clock::now();
+        uint64_t ticksStart = __rdtsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        uint64_t ticks = __rdtsc() - ticksStart;
+        auto wall = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wallStart);
+        return ticks ? static_cast<double>(wall.count()) / static_cast<double>(ticks) : 1.0;
+#else
+        return static_cast<double>(std::chrono::steady_clock::period::num) * 1e9 /
+               static_cast<double>(std::chrono::steady_clock::period::den);
+#endif
+    }
+};
+
+/**
+ * @brief Снимок гистограммы: обычные числа, можно сливать и считать перцентили
+ */
+struct HistogramSnapshot {
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t sumNanos = 0;
+    uint64_t maxNanos = 0;
+
+    void merge(const HistogramSnapshot& other) {
+        if (counts.size() < other.counts.size()) {
+            counts.resize(other.counts.size(), 0);
+        }
+        for (size_t i = 0; i < other.counts.size(); ++i) {
+            counts[i] += other.counts[i];
+        }
+        total += other.total;
+        sumNanos += other.sumNanos;
+        maxNanos = std::max(maxNanos, other.maxNanos);
+    }
+
+    double meanNanos() const { return total ? static_cast<double>(sumNanos) / static_cast<double>(total) : 0.0; }
+
+    /**
+     * @brief Верхняя граница корзины, в которую попадает перцентиль p (0..100)
+     */
+    uint64_t percentileNanos(double p) const;
+};
+
+/**
+ * @brief Гистограмма задержек с логарифмическими корзинами (один писатель)
+ *
+ * record() вызывает только поток-владелец, поэтому вместо fetch_add
+ * используется relaxed load + store: это обычные mov без lock-префикса.
+ * Читатели (snapshot) могут работать параллельно.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+    static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    static size_t bucketFor(uint64_t nanos) noexcept {
+        if (nanos < kSubBuckets) {
+            return static_cast<size_t>(nanos);
+        }
+        unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(nanos));
+        unsigned shift = msb - kSubBucketBits;
+        return (shift + 1) * kSubBuckets + ((nanos >> shift) & (kSubBuckets - 1));
+    }
+
+    static uint64_t bucketUpperBound(size_t bucket) noexcept {
+        if (bucket < kSubBuckets) {
+            return bucket;
+        }
+        unsigned shift = static_cast<unsigned>(bucket / kSubBuckets) - 1;
+        uint64_t lower = (kSubBuckets + bucket % kSubBuckets) << shift;
+        return lower + ((uint64_t{1} << shift) - 1);
+    }
+
+    void record(uint64_t nanos) noexcept {
+        bump(counts_[bucketFor(nanos)], 1);
+        bump(sum_, nanos);
+        if (nanos > max_.load(std::memory_order_relaxed)) {
+            max_.store(nanos, std::memory_order_relaxed);
+        }
+    }
+
+    HistogramSnapshot snapshot() const {
+        HistogramSnapshot result;
+        result.counts.resize(kBucketCount);
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            result.counts[i] = counts_[i].load(std::memory_order_relaxed);
+            result.total += result.counts[i];
+        }
+        result.sumNanos = sum_.load(std::memory_order_relaxed);
+        result.maxNanos = max_.load(std::memory_order_relaxed);
+        return result;
+    }
+
+private:
+    static void bump(std::atomic<uint64_t>& counter, uint64_t delta) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+    std::array<std::atomic<uint64_t>, kBucketCount> counts_{};
+};
+
+inline uint64_t HistogramSnapshot::percentileNanos(double p) const {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(static_cast<double>(total) * std::clamp(p, 0.0, 100.0) / 100.0);
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(LatencyHistogram::bucketUpperBound(i), maxNanos);
+        }
+    }
+    return maxNanos;
+}
+
+/**
+ * @brief Счётчики одного воркера; занимают собственные кэш-линии
+ */
+struct alignas(kCacheLineSize) WorkerCounters {
+    std::atomic<uint64_t> tasksCompleted{0};
+    std::atomic<uint64_t> tasksFailed{0};
+    std::atomic<bool> isBusy{false};
+    LatencyHistogram queueWait;
+    LatencyHistogram execution;
+
+    /**
+     * @brief Учесть завершение задачи (вызывает только сам воркер)
+     */
+    void countTask(bool failed) noexcept {
+        auto& counter = failed ? tasksFailed : tasksCompleted;
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Записать задержки задачи в гистограммы (вызывает только сам воркер)
+     * @param enqueuedTicks метка PoolClock::now() при постановке в очередь
+     * @param startTicks метка начала выполнения
+     * @param endTicks метка окончания выполнения
+     */
+    void recordTiming(uint64_t enqueuedTicks, uint64_t startTicks, uint64_t endTicks) noexcept {
+        queueWait.record(PoolClock::toNanos(startTicks > enqueuedTicks ? startTicks - enqueuedTicks : 0));
+        execution.record(PoolClock::toNanos(endTicks > startTicks ? endTicks - startTicks : 0));
+    }
+};
+
+struct WorkerSnapshot {
+    uint64_t tasksCompleted = 0;
+    uint64_t tasksFailed = 0;
+    bool isBusy = false;
+    HistogramSnapshot queueWait;
+    HistogramSnapshot execution;
+};
+
+struct PoolStatsSnapshot {
+    std::vector<WorkerSnapshot> workers;
+    uint64_t tasksCompleted = 0;
+    uint64_t tasksFailed = 0;
+    HistogramSnapshot queueWait;  // слияние по всем воркерам
+    HistogramSnapshot execution;
+};
+
+/**
+ * @brief Набор WorkerCounters для пула фиксированного размера
+ *
+ * Замеры времени можно выключить на ходу (setEnabled): тогда воркер
+ * не берёт метки времени и не пишет гистограммы, но счётчики задач ведёт.
+ */
+class PoolInstrumentation {
+public:
+    explicit PoolInstrumentation(size_t workers)
+        : workers_(std::make_unique<WorkerCounters[]>(workers)), workerCount_(workers) {
+        PoolClock::nanosPerTick();  // калибровка до запуска воркеров
+    }
+
+    WorkerCounters& worker(size_t index) noexcept { return workers_[index]; }
+    const WorkerCounters& worker(size_t index) const noexcept { return workers_[index]; }
+    size_t workerCount() const noexcept { return workerCount_; }
+
+    bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled) noexcept { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    PoolStatsSnapshot snapshot() const {
+        PoolStatsSnapshot result;
+        result.workers.resize(workerCount_);
+        for (size_t i = 0; i < workerCount_; ++i) {
+            const WorkerCounters& source = workers_[i];
+            WorkerSnapshot& target = result.workers[i];
+            target.tasksCompleted = source.tasksCompleted.load(std::memory_order_relaxed);
+            target.tasksFailed = source.tasksFailed.load(std::memory_order_relaxed);
+            target.isBusy = source.isBusy.load(std::memory_order_relaxed);
+            target.queueWait = source.queueWait.snapshot();
+            target.execution = source.execution.snapshot();
+
+            result.tasksCompleted += target.tasksCompleted;
+            result.tasksFailed += target.tasksFailed;
+            result.queueWait.merge(target.queueWait);
+            result.execution.merge(target.execution);
+        }
+        return result;
+    }
+
+private:
+    std::unique_ptr<WorkerCounters[]> workers_;
+    size_t workerCount_;
+    alignas(kCacheLineSize) std::atomic<bool> enabled_{true};
+};
+
+} // namespace cpp_patterns
@@ -0,0 +1,471 @@
+/**
+ * @file simd_kernels.h
+ * @brief fill/copy/transform на SSE2, AVX2 и AVX-512 с выбором по процессору
+ *
+ * Каждое ядро собрано в нескольких вариантах через __attribute__((target)):
+ * программа компилируется для базового x86-64, а при первом обращении
+ * __builtin_cpu_supports выбирает лучший уровень, который есть у процессора
+ * и разрешён ОС. На других архитектурах и компиляторах остаются скалярные
+ * циклы, которые компилятор векторизует сам, если сможет.
+ *
+ * Загрузки и записи невыровненные (loadu/storeu): ядра принимают любые
+ * указатели, а на буфере из aligned_buffer.h ни одна из них не пересекает
+ * кэш-линию. transform считает dst = src * scale + offset без FMA, чтобы
+ * результат для float совпадал побитно на всех уровнях (пока сама программа
+ * не собрана с -mfma или -march=native: тогда FMA может вставить компилятор
+ * в скалярный хвост).
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CPP_PATTERNS_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define CPP_PATTERNS_SIMD_X86 0
+#endif
+
+namespace cpp_patterns::simd {
+
+enum class SimdLevel { Scalar, SSE2, AVX2, AVX512 };
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+    }
+    return "?";
+}
+
+inline bool isSupported(SimdLevel level) noexcept {
+#if CPP_PATTERNS_SIMD_X86
+    // Может вызываться из статических конструкторов, до инициализации libgcc
+    __builtin_cpu_init();
+    switch (level) {
+        case SimdLevel::Scalar: return true;
+        case SimdLevel::SSE2: return __builtin_cpu_supports("sse2");
+        case SimdLevel::AVX2: return __builtin_cpu_supports("avx2");
+        case SimdLevel::AVX512: return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+#else
+    return level == SimdLevel::Scalar;
+#endif
+}
+
+inline SimdLevel detectSimdLevel() noexcept {
+    for (SimdLevel level : {SimdLevel::AVX512, SimdLevel::AVX2, SimdLevel::SSE2}) {
+        if (isSupported(level)) {
+            return level;
+        }
+    }
+    return SimdLevel::Scalar;
+}
+
+/**
+ * @brief Уровни, доступные на этом процессоре, от скалярного к широкому
+ */
+inline std::vector<SimdLevel> supportedLevels() {
+    std::vector<SimdLevel> levels;
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (isSupported(level)) {
+            levels.push_back(level);
+        }
+    }
+    return levels;
+}
+
+/**
+ * @brief Таблица ядер одного уровня
+ */
+struct Kernels {
+    SimdLevel level;
+    void (*fillI32)(int32_t* dst, size_t count, int32_t value);
+    void (*fillF32)(float* dst, size_t count, float value);
+    void (*copyBytes)(void* dst, const void* src, size_t bytes);
+    void (*transformI32)(int32_t* dst, const int32_t* src, size_t count, int32_t scale, int32_t offset);
+    void (*transformF32)(float* dst, const float* src, size_t count, float scale, float offset);
+};
+
+namespace detail {
+
+// ---- Скалярный вариант --------------------------------------------------
+
+template<typename T>
+void scalarFill(T* dst, size_t count, T value) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = value;
+    }
+}
+
+inline void scalarCopy(void* dst, const void* src, size_t bytes) {
+    if (bytes > 0) {
+        std::memmove(dst, src, bytes);
+    }
+}
+
+template<typename T>
+void scalarTransform(T* dst, const T* src, size_t count, T scale, T offset) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = src[i] * scale + offset;
+    }
+}
+
+inline int32_t wrappingMulAdd(int32_t x, int32_t scale, int32_t offset) {
+    // Переполнение int32 - UB; SIMD-варианты считают по модулю 2^32, скалярный тоже
+    return static_cast<int32_t>(static_cast<uint32_t>(x) * static_cast<uint32_t>(scale) + static_cast<uint32_t>(offset));
+}
+
+inline void scalarTransformI32(int32_t* dst, const int32_t* src, size_t count, int32_t scale, int32_t offset) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = wrappingMulAdd(src[i], scale, offset);
+    }
+}
+
+#if CPP_PATTERNS_SIMD_X86
+
+// ---- SSE2: 4 элемента за инструкцию -------------------------------------
+
+__attribute__((target("sse2"))) inline void sse2FillI32(int32_t* dst, size_t count, int32_t value) {
+    __m128i v = _mm_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+    }
+    for (; i < count; ++i) {
+        dst[i] = value;
+    }
+}
+
+__attribute__((target("sse2"))) inline void sse2FillF32(float* dst, size_t count, float value) {
+    __m128 v = _mm_set1_ps(value);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, v);
+    }
+    for (; i < count; ++i) {
+        dst[i] = value;
+    }
+}
+
+__attribute__((target("sse2"))) inline void sse2Copy(void* dst, const void* src, size_t bytes) {
+    if (static_cast<char*>(dst) < static_cast<const char*>(src) + bytes &&
+        static_cast<const char*>(src) < static_cast<char*>(dst) + bytes) {
+        std::memmove(dst, src, bytes);  // перекрытие: порядок копирования важен
+        return;
+    }
+    auto* out = static_cast<char*>(dst);
+    auto* in = static_cast<const char*>(src);
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+    }
+    if (i < bytes) {
+        std::memcpy(out + i, in + i, bytes - i);
+    }
+}
+
+// В SSE2 нет умножения 32-битных целых: перемножаем чётные и нечётные
+// элементы через _mm_mul_epu32 и собираем младшие половины
+__attribute__((target("sse2"))) inline __m128i sse2MulLo32(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+__attribute__((target("sse2"))) inline void sse2TransformI32(int32_t* dst, const int32_t* src, size_t count,
+                                                             int32_t scale, int32_t offset) {
+    __m128i s = _mm_set1_epi32(scale);
+    __m128i o = _mm_set1_epi32(offset);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_add_epi32(sse2MulLo32(x, s), o));
+    }
+    for (; i < count; ++i) {
+        dst[i] = wrappingMulAdd(src[i], scale, offset);
+    }
+}
+
+__attribute__((target("sse2"))) inline void sse2TransformF32(float* dst, const float* src, size_t count, float scale,
+                                                             float offset) {
+    __m128 s = _mm_set1_ps(scale);
+    __m128 o = _mm_set1_ps(offset);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + i), s), o));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i] * scale + offset;
+    }
+}
+
+// ---- AVX2: 8 элементов ---------------------------------------------------
+
+__attribute__((target("avx2"))) inline void avx2FillI32(int32_t* dst, size_t count, int32_t value) {
+    __m256i v = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+    }
+    for (; i < count; ++i) {
+        dst[i] = value;
+    }
+}
+
+__attribute__((target("avx2"))) inline void avx2FillF32(float* dst, size_t count, float value) {
+    __m256 v = _mm256_set1_ps(value);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dst + i, v);
+    }
+    for (; i < count; ++i) {
+        dst[i] = value;
+    }
+}
+
+__attribute__((target("avx2"))) inline void avx2Copy(void* dst, const void* src, size_t bytes) {
+    if (static_cast<char*>(dst) < static_cast<const char*>(src) + bytes &&
+        static_cast<const char*>(src) < static_cast<char*>(dst) + bytes) {
+        std::memmove(dst, src, bytes);
+        return;
+    }
+    auto* out = static_cast<char*>(dst);
+    auto* in = static_cast<const char*>(src);
+    size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+    }
+    if (i < bytes) {
+        std::memcpy(out + i, in + i, bytes - i);
+    }
+}
+
+__attribute__((target("avx2"))) inline void avx2TransformI32(int32_t* dst, const int32_t* src, size_t count,
+                                                             int32_t scale, int32_t offset) {
+    __m256i s = _mm256_set1_epi32(scale);
+    __m256i o = _mm256_set1_epi32(offset);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_add_epi32(_mm256_mullo_epi32(x, s), o));
+    }
+    for (; i < count; ++i) {
+        dst[i] = wrappingMulAdd(src[i], scale, offset);
+    }
+}
+
+__attribute__((target("avx2"))) inline void avx2TransformF32(float* dst, const float* src, size_t count, float scale,
+                                                             float offset) {
+    __m256 s = _mm256_set1_ps(scale);
+    __m256 o = _mm256_set1_ps(offset);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), s), o));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i] * scale + offset;
+    }
+}
+
+// ---- AVX-512: 16 элементов, хвост - одной записью по маске ---------------
+// avx512f включает FMA, и GCC сливает _mm512_mul_ps + _mm512_add_ps в
+// vfmadd с одним округлением; пустой asm между ними это запрещает
+
+__attribute__((target("avx512f"))) inline __m512 avx512MulAdd(__m512 x, __m512 scale, __m512 offset) {
+    __m512 product = _mm512_mul_ps(x, scale);
+    __asm__("" : "+v"(product));
+    return _mm512_add_ps(product, offset);
+}
+
+__attribute__((target("avx512f"))) inline __mmask16 avx512TailMask(size_t remaining) {
+    return static_cast<__mmask16>((1u << remaining) - 1);
+}
+
+__attribute__((target("avx512f"))) inline void avx512FillI32(int32_t* dst, size_t count, int32_t value) {
+    __m512i v = _mm512_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm512_storeu_si512(dst + i, v);
+    }
+    if (i < count) {
+        _mm512_mask_storeu_epi32(dst + i, avx512TailMask(count - i), v);
+    }
+}
+
+__attribute__((target("avx512f"))) inline void avx512FillF32(float* dst, size_t count, float value) {
+    __m512 v = _mm512_set1_ps(value);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm512_storeu_ps(dst + i, v);
+    }
+    if (i < count) {
+        _mm512_mask_storeu_ps(dst + i, avx512TailMask(count - i), v);
+    }
+}
+
+__attribute__((target("avx512f"))) inline void avx512Copy(void* dst, const void* src, size_t bytes) {
+    if (static_cast<char*>(dst) < static_cast<const char*>(src) + bytes &&
+        static_cast<const char*>(src) < static_cast<char*>(dst) + bytes) {
+        std::memmove(dst, src, bytes);
+        return;
+    }
+    auto* out = static_cast<char*>(dst);
+    auto* in = static_cast<const char*>(src);
+    size_t i = 0;
+    for (; i + 64 <= bytes; i += 64) {
+        _mm512_storeu_si512(out + i, _mm512_loadu_si512(in + i));
+    }
+    if (i < bytes) {
+        std::memcpy(out + i, in + i, bytes - i);
+    }
+}
+
+__attribute__((target("avx512f"))) inline void avx512TransformI32(int32_t* dst, const int32_t* src, size_t count,
+                                                                  int32_t scale, int32_t offset) {
+    __m512i s = _mm512_set1_epi32(scale);
+    __m512i o = _mm512_set1_epi32(offset);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i x = _mm512_loadu_si512(src + i);
+        _mm512_storeu_si512(dst + i, _mm512_add_epi32(_mm512_mullo_epi32(x, s), o));
+    }
+    if (i < count) {
+        __mmask16 mask = avx512TailMask(count - i);
+        __m512i x = _mm512_maskz_loadu_epi32(mask, src + i);
+        _mm512_mask_storeu_epi32(dst + i, mask, _mm512_add_epi32(_mm512_mullo_epi32(x, s), o));
+    }
+}
+
+__attribute__((target("avx512f"))) inline void avx512TransformF32(float* dst, const float* src, size_t count,
+                                                                  float scale, float offset) {
+    __m512 s = _mm512_set1_ps(scale);
+    __m512 o = _mm512_set1_ps(offset);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm512_storeu_ps(dst + i, avx512MulAdd(_mm512_loadu_ps(src + i), s, o));
+    }
+    if (i < count) {
+        __mmask16 mask = avx512TailMask(count - i);
+        __m512 x = _mm512_maskz_loadu_ps(mask, src + i);
+        _mm512_mask_storeu_ps(dst + i, mask, avx512MulAdd(x, s, o));
+    }
+}
+
+#endif // CPP_PATTERNS_SIMD_X86
+
+} // namespace detail
+
+/**
+ * @brief Ядра заданного уровня
+ * @throws std::invalid_argument если процессор уровень не поддерживает
+ */
+inline const Kernels& kernelsFor(SimdLevel level) {
+    static const Kernels scalar{SimdLevel::Scalar, detail::scalarFill<int32_t>, detail::scalarFill<float>,
+                                detail::scalarCopy, detail::scalarTransformI32, detail::scalarTransform<float>};
+    if (!isSupported(level)) {
+        throw std::invalid_argument(std::string("Процессор не поддерживает ") + simdLevelName(level));
+    }
+#if CPP_PATTERNS_SIMD_X86
+    static const Kernels sse2{SimdLevel::SSE2, detail::sse2FillI32, detail::sse2FillF32,
+                              detail::sse2Copy, detail::sse2TransformI32, detail::sse2TransformF32};
+    static const Kernels avx2{SimdLevel::AVX2, detail::avx2FillI32, detail::avx2FillF32,
+                              detail::avx2Copy, detail::avx2TransformI32, detail::avx2TransformF32};
+    static const Kernels avx512{SimdLevel::AVX512, detail::avx512FillI32, detail::avx512FillF32,
+                                detail::avx512Copy, detail::avx512TransformI32, detail::avx512TransformF32};
+    switch (level) {
+        case SimdLevel::SSE2: return sse2;
+        case SimdLevel::AVX2: return avx2;
+        case SimdLevel::AVX512: return avx512;
+        case SimdLevel::Scalar: break;
+    }
+#endif
+    return scalar;
+}
+
+/**
+ * @brief Ядра лучшего уровня; выбираются один раз при первом вызове
+ */
+inline const Kernels& activeKernels() {
+    static const Kernels& kernels = kernelsFor(detectSimdLevel());
+    return kernels;
+}
+
+// ---- Обобщённый интерфейс ------------------------------------------------
+// int32_t и float идут в таблицу ядер, остальные тривиальные типы - в
+// скалярный цикл. Для целых transform считает по модулю 2^32.
+
+template<typename T>
+void fill(T* dst, size_t count, T value) {
+    if constexpr (std::is_same_v<T, int32_t>) {
+        activeKernels().fillI32(dst, count, value);
+    } else if constexpr (std::is_same_v<T, float>) {
+        activeKernels().fillF32(dst, count, value);
+    } else {
+        std::fill_n(dst, count, value);
+    }
+}
+
+template<typename T>
+void copy(T* dst, const T* src, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "copy работает с тривиально копируемыми типами");
+    activeKernels().copyBytes(dst, src, count * sizeof(T));
+}
+
+template<typename T>
+void transform(T* dst, const T* src, size_t count, T scale, T offset) {
+    if constexpr (std::is_same_v<T, int32_t>) {
+        activeKernels().transformI32(dst, src, count, scale, offset);
+    } else if constexpr (std::is_same_v<T, float>) {
+        activeKernels().transformF32(dst, src, count, scale, offset);
+    } else {
+        detail::scalarTransform(dst, src, count, scale, offset);
+    }
+}
+
+// Перегрузки для буферов: всё, у чего есть data() и size() (AlignedBuffer, vector, span)
+
+template<typename Buffer, typename T>
+void fill(Buffer& buffer, T value) {
+    fill(buffer.data(), buffer.size(), static_cast<typename Buffer::value_type>(value));
+}
+
+/**
+ * @throws std::invalid_argument если размеры буферов различаются
+ */
+template<typename Destination, typename Source>
+void copy(Destination& dst, const Source& src) {
+    if (dst.size() != src.size()) {
+        throw std::invalid_argument("copy: размеры буферов различаются");
+    }
+    copy(dst.data(), src.data(), src.size());
+}
+
+template<typename Destination, typename Source, typename T>
+void transform(Destination& dst, const Source& src, T scale, T offset) {
+    using Value = typename Destination::value_type;
+    if (dst.size() != src.size()) {
+        throw std::invalid_argument("transform: размеры буферов различаются");
+    }
+    transform(dst.data(), src.data(), src.size(), static_cast<Value>(scale), static_cast<Value>(offset));
+}
+
+} // namespace cpp_patterns::simd
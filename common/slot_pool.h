@@ -0,0 +1,137 @@
+/**
+ * @file slot_pool.h
+ * @brief Пул слотов фиксированного размера для фабрик с пулами
+ *
+ * PooledFactoryRegistry (factory_method.cpp) и PooledGameObjectFactory
+ * (product_factory.cpp) решают одну задачу - выдавать объекты конкретного
+ * типа без new/delete на каждый спавн, - поэтому пользуются одним пулом:
+ * - память берётся кусками и не возвращается в кучу до разрушения пула;
+ * - освобождённые слоты попадают в интрузивный список свободных;
+ * - SlotPoolDeleter<Base> возвращает объект в пул, так что Handle - это
+ *   обычный unique_ptr.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cpp_patterns {
+
+/**
+ * @brief Пул слотов фиксированного размера
+ *
+ * Не потокобезопасен: создание объектов идёт из одного (игрового) потока.
+ * Все выданные слоты должны быть возвращены раньше разрушения пула.
+ */
+class SlotPool {
+private:
+    struct AlignedDelete {
+        size_t align;
+        void operator()(unsigned char* p) const { ::operator delete(p, std::align_val_t(align)); }
+    };
+
+    size_t slotSize_;
+    size_t align_;
+    size_t slotsPerChunk_;
+    std::vector<std::unique_ptr<unsigned char, AlignedDelete>> chunks_;
+    void* freeList_ = nullptr;
+    size_t capacity_ = 0;
+    size_t inUse_ = 0;
+
+    void grow(size_t slots) {
+        auto* raw = static_cast<unsigned char*>(::operator new(slots * slotSize_, std::align_val_t(align_)));
+        chunks_.emplace_back(raw, AlignedDelete{align_});
+        // Новые слоты добавляются в начало списка свободных в порядке адресов
+        for (size_t i = slots; i-- > 0;) {
+            void* slot = raw + i * slotSize_;
+            *static_cast<void**>(slot) = freeList_;
+            freeList_ = slot;
+        }
+        capacity_ += slots;
+    }
+
+public:
+    SlotPool(size_t size, size_t align, size_t slotsPerChunk = 256)
+        : align_(std::max(align, alignof(void*))), slotsPerChunk_(slotsPerChunk) {
+        size_t minSize = std::max(size, sizeof(void*));
+        slotSize_ = (minSize + align_ - 1) / align_ * align_;
+    }
+
+    SlotPool(const SlotPool&) = delete;
+    SlotPool& operator=(const SlotPool&) = delete;
+
+    void* acquire() {
+        if (freeList_ == nullptr) {
+            grow(slotsPerChunk_);
+        }
+        void* slot = freeList_;
+        freeList_ = *static_cast<void**>(slot);
+        ++inUse_;
+        return slot;
+    }
+
+    void release(void* slot) {
+        *static_cast<void**>(slot) = freeList_;
+        freeList_ = slot;
+        --inUse_;
+    }
+
+    /**
+     * @brief Взять слот и создать в нём T; если конструктор бросил, слот возвращается
+     */
+    template<typename T, typename... Args>
+    T* construct(Args&&... args) {
+        void* slot = acquire();
+        try {
+            return new (slot) T(std::forward<Args>(args)...);
+        } catch (...) {
+            release(slot);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Гарантировать count свободных слотов одним выделением
+     */
+    void reserve(size_t count) {
+        size_t available = capacity_ - inUse_;
+        if (available < count) {
+            grow(std::max(count - available, slotsPerChunk_));
+        }
+    }
+
+    size_t capacity() const { return capacity_; }
+    size_t inUse() const { return inUse_; }
+};
+
+/**
+ * @brief Deleter для unique_ptr<Base>: разрушает объект и возвращает слот в пул
+ *
+ * Base должен быть полиморфным: адрес слота - адрес полного объекта,
+ * который восстанавливается через dynamic_cast<void*>.
+ */
+template<typename Base>
+struct SlotPoolDeleter {
+    static_assert(std::is_polymorphic_v<Base>, "SlotPoolDeleter требует полиморфный Base");
+
+    SlotPool* pool = nullptr;
+
+    void operator()(Base* object) const {
+        void* slot = dynamic_cast<void*>(object);
+        object->~Base();
+        pool->release(slot);
+    }
+};
+
+} // namespace cpp_patterns
@@ -0,0 +1,439 @@
+/**
+ * @file tracing.h
+ * @brief Трассировка зон выполнения с экспортом в Chrome trace-event JSON
+ *
+ * Timer из урока RAII печатает миллисекунды в std::cout из деструктора:
+ * это грубо, медленно и засоряет вывод. Здесь:
+ * - TraceZone - RAII-зона: метка PoolClock (TSC или steady_clock) в
+ *   конструкторе и одна запись события в деструкторе;
+ * - ThreadTraceBuffer - буфер потока из блоков по 16K событий; пишет только
+ *   владелец (relaxed/release store, без блокировок и атомарных RMW),
+ *   сборщик читает опубликованные события параллельно;
+ * - TraceCollector - реестр буферов и экспорт в JSON, который открывают
+ *   chrome://tracing и ui.perfetto.dev;
+ * - TraceSession - RAII-сеанс: включает трассировку и пишет файл при выходе.
+ *   Демонстрации уроков открывают сеанс, только если задана переменная
+ *   окружения CPP_PATTERNS_TRACE (см. traceRequested()): иначе каждый запуск
+ *   оставлял бы *_trace.json и замерял циклы с включёнными зонами.
+ *
+ * Пока сеанс не запущен, зона стоит одной relaxed-загрузки флага. Во
+ * включённом сеансе зона - две метки PoolClock, relaxed-загрузка номера
+ * сеанса и запись в буфер, указатель на который кэширован в thread_local:
+ * без обращения к синглтону, мьютекса и TLS-обёрток. Нижняя граница -
+ * два rdtsc; в виртуальной машине, где rdtsc эмулируется, они одни
+ * стоят больше 30 нс (см. demonstrateTracing в уроке 1.2).
+ * С -DCPP_PATTERNS_TRACING=0 макросы TRACE_* не генерируют кода.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include "pool_instrumentation.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifndef CPP_PATTERNS_TRACING
+#define CPP_PATTERNS_TRACING 1
+#endif
+
+namespace cpp_patterns {
+
+/**
+ * @brief Завершённая зона; name и category - строки со статическим временем жизни
+ */
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    uint64_t startTicks;
+    uint64_t endTicks;
+};
+
+/**
+ * @brief Буфер событий одного потока (один писатель, читатели - сборщик)
+ *
+ * Блоки выделяются по мере заполнения и не перемещаются, поэтому
+ * опубликованное событие можно читать без блокировки. После kMaxChunks
+ * блоков события отбрасываются и считаются в dropped().
+ */
+class ThreadTraceBuffer {
+public:
+    static constexpr size_t kChunkEvents = 16 * 1024;  // 512 КиБ на блок
+    static constexpr size_t kMaxChunks = 64;           // до 1M событий на поток за сеанс
+
+    ThreadTraceBuffer(uint32_t threadId, std::string threadName)
+        : threadId_(threadId), threadName_(std::move(threadName)) {}
+
+    ~ThreadTraceBuffer() {
+        for (auto& chunk : chunks_) {
+            delete chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    ThreadTraceBuffer(const ThreadTraceBuffer&) = delete;
+    ThreadTraceBuffer& operator=(const ThreadTraceBuffer&) = delete;
+
+    /**
+     * @brief Записать событие (только поток-владелец)
+     * @param generation номер сеанса: при смене сеанса буфер начинается заново
+     */
+    void record(const TraceEvent& event, uint32_t generation) noexcept {
+        size_t index = count_.load(std::memory_order_relaxed);
+        if (generation != generation_) {
+            generation_ = generation;
+            index = 0;
+            dropped_.store(0, std::memory_order_relaxed);
+        }
+        size_t chunkIndex = index / kChunkEvents;
+        if (chunkIndex >= kMaxChunks) {
+            dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        Chunk* chunk = chunks_[chunkIndex].load(std::memory_order_relaxed);
+        if (chunk == nullptr) {
+            chunk = new (std::nothrow) Chunk;
+            if (chunk == nullptr) {
+                dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+            chunks_[chunkIndex].store(chunk, std::memory_order_release);
+        }
+        chunk->events[index % kChunkEvents] = event;
+        // Публикация: сборщик видит событие только после этого store
+        count_.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Обойти опубликованные события (сборщик)
+     */
+    template<typename Callback>
+    void forEach(Callback&& callback) const {
+        size_t count = count_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            const Chunk* chunk = chunks_[i / kChunkEvents].load(std::memory_order_acquire);
+            callback(chunk->events[i % kChunkEvents]);
+        }
+    }
+
+    size_t size() const noexcept { return count_.load(std::memory_order_acquire); }
+    size_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    uint32_t threadId() const noexcept { return threadId_; }
+
+    // Поток завершился: после экспорта его буфер можно удалить
+    void retire() noexcept { retired_.store(true, std::memory_order_release); }
+    bool retired() const noexcept { return retired_.load(std::memory_order_acquire); }
+
+    std::string threadName() const {
+        std::lock_guard<std::mutex> lock(nameMutex_);
+        return threadName_;
+    }
+
+    void setThreadName(std::string name) {
+        std::lock_guard<std::mutex> lock(nameMutex_);
+        threadName_ = std::move(name);
+    }
+
+private:
+    struct Chunk {
+        std::array<TraceEvent, kChunkEvents> events;
+    };
+
+    uint32_t threadId_;
+    uint32_t generation_ = 0;  // только владелец
+    alignas(kCacheLineSize) std::atomic<size_t> count_{0};
+    std::atomic<size_t> dropped_{0};
+    std::atomic<bool> retired_{false};
+    std::array<std::atomic<Chunk*>, kMaxChunks> chunks_{};
+    mutable std::mutex nameMutex_;
+    std::string threadName_;
+};
+
+/**
+ * @brief Реестр буферов потоков и экспорт трассы
+ *
+ * Буферы принадлежат реестру (shared_ptr), поэтому события потока
+ * переживают сам поток. Экспорт - после stop(): события текущего
+ * сеанса не перезаписываются до следующего start().
+ */
+class TraceCollector {
+public:
+    static TraceCollector& instance() {
+        static TraceCollector collector;
+        return collector;
+    }
+
+    static bool enabled() noexcept { return activeGeneration() != 0; }
+
+    /**
+     * @brief Номер идущего сеанса; 0 - трассировка выключена
+     */
+    static uint32_t activeGeneration() noexcept { return sessionFlag().load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Начать сеанс; буферы завершившихся потоков освобождаются
+     */
+    void start() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                      [](const auto& buffer) { return buffer->retired(); }),
+                       buffers_.end());
+        startTicks_ = PoolClock::now();
+        if (++generation_ == 0) {
+            ++generation_;  // 0 занят под «выключено»
+        }
+        sessionFlag().store(generation_, std::memory_order_release);
+    }
+
+    void stop() { sessionFlag().store(0, std::memory_order_release); }
+
+    /**
+     * @brief Буфер текущего потока; первый вызов в потоке регистрирует его
+     *
+     * Быстрый путь - чтение thread_local указателя с константной
+     * инициализацией: компилятор обращается к нему напрямую через TLS.
+     */
+    static ThreadTraceBuffer& localBuffer() {
+        ThreadTraceBuffer* buffer = cachedBuffer();
+        if (buffer == nullptr) {
+            buffer = &instance().attachThread();
+        }
+        return *buffer;
+    }
+
+    void record(const char* name, const char* category, uint64_t startTicks, uint64_t endTicks) noexcept {
+        uint32_t generation = activeGeneration();
+        if (generation != 0) {
+            localBuffer().record(TraceEvent{name, category, startTicks, endTicks}, generation);
+        }
+    }
+
+    void setThreadName(std::string name) { localBuffer().setThreadName(std::move(name)); }
+
+    size_t eventCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t total = 0;
+        for (const auto& buffer : buffers_) {
+            total += liveEvents(*buffer);
+        }
+        return total;
+    }
+
+    size_t droppedCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t total = 0;
+        for (const auto& buffer : buffers_) {
+            total += buffer->dropped();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Chrome trace-event JSON: фаза "X" (начало + длительность) и имена потоков
+     */
+    void writeChromeTrace(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        double nanosPerTick = PoolClock::nanosPerTick();
+        auto micros = [&](uint64_t ticks) {
+            return static_cast<double>(ticks) * nanosPerTick / 1000.0;
+        };
+
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        auto separator = [&]() -> std::ostream& {
+            if (!first) out << ",";
+            first = false;
+            return out << "\n";
+        };
+
+        for (const auto& buffer : buffers_) {
+            if (liveEvents(*buffer) == 0) continue;
+            separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId()
+                        << ",\"args\":{\"name\":\"";
+            writeEscaped(out, buffer->threadName());
+            out << "\"}}";
+
+            buffer->forEach([&](const TraceEvent& event) {
+                if (event.startTicks < startTicks_) return;
+                char numbers[64];
+                std::snprintf(numbers, sizeof(numbers), "\"ts\":%.3f,\"dur\":%.3f",
+                              micros(event.startTicks - startTicks_),
+                              micros(event.endTicks > event.startTicks ? event.endTicks - event.startTicks : 0));
+                separator() << "{\"name\":\"";
+                writeEscaped(out, event.name);
+                out << "\",\"cat\":\"";
+                writeEscaped(out, event.category);
+                out << "\",\"ph\":\"X\"," << numbers << ",\"pid\":1,\"tid\":" << buffer->threadId() << "}";
+            });
+        }
+        out << "\n]}\n";
+    }
+
+    bool writeChromeTrace(const std::string& path) const {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        writeChromeTrace(file);
+        return static_cast<bool>(file);
+    }
+
+private:
+    TraceCollector() { PoolClock::nanosPerTick(); }  // калибровка до первой зоны
+
+    // Отмечает буфер завершившегося потока; нужен только на медленном пути
+    struct LocalSlot {
+        ThreadTraceBuffer* buffer = nullptr;
+
+        ~LocalSlot() {
+            if (buffer != nullptr) buffer->retire();
+            cachedBuffer() = nullptr;
+        }
+    };
+
+    // Константная инициализация: ни guard-переменной, ни TLS-обёртки
+    static std::atomic<uint32_t>& sessionFlag() {
+        static std::atomic<uint32_t> generation{0};
+        return generation;
+    }
+
+    static ThreadTraceBuffer*& cachedBuffer() noexcept {
+        static thread_local ThreadTraceBuffer* buffer = nullptr;
+        return buffer;
+    }
+
+    ThreadTraceBuffer& attachThread() {
+        thread_local LocalSlot slot;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint32_t id = ++nextThreadId_;
+            buffers_.push_back(std::make_shared<ThreadTraceBuffer>(id, "thread-" + std::to_string(id)));
+            slot.buffer = buffers_.back().get();
+        }
+        cachedBuffer() = slot.buffer;
+        return *slot.buffer;
+    }
+
+    // Буфер, не писавший в текущем сеансе, держит события прошлого
+    size_t liveEvents(const ThreadTraceBuffer& buffer) const {
+        size_t count = 0;
+        buffer.forEach([&](const TraceEvent& event) { count += event.startTicks >= startTicks_; });
+        return count;
+    }
+
+    static void writeEscaped(std::ostream& out, const std::string& text) {
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) out << c;
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> buffers_;
+    uint64_t startTicks_ = 0;
+    uint32_t nextThreadId_ = 0;
+    uint32_t generation_ = 0;  // под mutex_; опубликованный номер - в sessionFlag()
+};
+
+/**
+ * @brief RAII-зона: от конструктора до деструктора
+ */
+class TraceZone {
+public:
+    explicit TraceZone(const char* name, const char* category = "default") noexcept
+        : name_(name), category_(category), startTicks_(TraceCollector::enabled() ? PoolClock::now() : 0) {}
+
+    // Сеанс мог закончиться внутри зоны: тогда событие не пишется
+    ~TraceZone() {
+        if (startTicks_ != 0) {
+            uint64_t endTicks = PoolClock::now();
+            uint32_t generation = TraceCollector::activeGeneration();
+            if (generation != 0) {
+                TraceCollector::localBuffer().record(TraceEvent{name_, category_, startTicks_, endTicks}, generation);
+            }
+        }
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* name_;
+    const char* category_;
+    uint64_t startTicks_;  // 0 - трассировка была выключена на входе
+};
+
+/**
+ * @brief Запрошена ли трассировка: CPP_PATTERNS_TRACE задана и не равна "0"
+ */
+inline bool traceRequested() noexcept {
+    const char* value = std::getenv("CPP_PATTERNS_TRACE");
+    return value != nullptr && *value != '\0' && std::strcmp(value, "0") != 0;
+}
+
+/**
+ * @brief Сеанс трассировки: start() в конструкторе, stop() и файл в деструкторе
+ *
+ * С enabled == false сеанс ничего не делает: зоны остаются выключенными.
+ */
+class TraceSession {
+public:
+    explicit TraceSession(std::string path, bool enabled = true) : path_(std::move(path)), enabled_(enabled) {
+        if (enabled_) {
+            TraceCollector::instance().start();
+        }
+    }
+
+    ~TraceSession() {
+        if (!enabled_) {
+            return;
+        }
+        TraceCollector& collector = TraceCollector::instance();
+        collector.stop();
+        if (collector.writeChromeTrace(path_)) {
+            std::cout << "Трасса: " << collector.eventCount() << " событий (отброшено "
+                      << collector.droppedCount() << ") -> " << path_ << std::endl;
+        } else {
+            std::cerr << "Трасса: не удалось записать " << path_ << std::endl;
+        }
+    }
+
+    TraceSession(const TraceSession&) = delete;
+    TraceSession& operator=(const TraceSession&) = delete;
+
+private:
+    std::string path_;
+    bool enabled_;
+};
+
+} // namespace cpp_patterns
+
+#define CPP_PATTERNS_TRACE_CONCAT_(a, b) a##b
+#define CPP_PATTERNS_TRACE_CONCAT(a, b) CPP_PATTERNS_TRACE_CONCAT_(a, b)
+
+#if CPP_PATTERNS_TRACING
+#define TRACE_ZONE(name) ::cpp_patterns::TraceZone CPP_PATTERNS_TRACE_CONCAT(traceZone_, __LINE__)(name)
+#define TRACE_ZONE_CAT(name, category) \
+    ::cpp_patterns::TraceZone CPP_PATTERNS_TRACE_CONCAT(traceZone_, __LINE__)(name, category)
+#define TRACE_THREAD_NAME(name) ::cpp_patterns::TraceCollector::instance().setThreadName(name)
+#else
+#define TRACE_ZONE(name) static_cast<void>(0)
+#define TRACE_ZONE_CAT(name, category) static_cast<void>(0)
+#define TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
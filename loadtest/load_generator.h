@@ -0,0 +1,450 @@
+/**
+ * @file load_generator.h
+ * @brief Генератор нагрузки с открытым циклом: расписание прихода запросов и честные задержки
+ *
+ * Демо в 08-high-load гоняют несколько потоков в замкнутом цикле:
+ * «отправил - дождался - sleep_for - отправил». Пока сервис тормозит, такой
+ * клиент просто не отправляет новых запросов, и медленные секунды попадают
+ * в статистику одним замером вместо сотен (coordinated omission). Здесь:
+ * - ArrivalSchedule задаёт плановые моменты отправки заранее: с постоянным
+ *   интервалом или пуассоновским потоком, независимо от того, успевает ли система;
+ * - генератор раздаёт запросы пулу клиентских потоков; запрос, которому не
+ *   хватило свободного клиента, ждёт в очереди, и это ожидание входит в задержку;
+ * - задержка считается от запланированного момента отправки, а не от
+ *   фактического начала; время обслуживания пишется отдельно для сравнения;
+ * - гистограммы - LatencyHistogram из pool_instrumentation.h, по одной на
+ *   клиентский поток, writeHdrPercentiles() выводит их в формате HdrHistogram.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include "pool_instrumentation.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cpp_patterns::load {
+
+using Clock = std::chrono::steady_clock;
+
+enum class Arrival {
+    Constant,  // равные интервалы 1/rate
+    Poisson    // экспоненциальные интервалы со средним 1/rate
+};
+
+inline const char* arrivalName(Arrival arrival) {
+    return arrival == Arrival::Constant ? "constant" : "poisson";
+}
+
+/**
+ * @throws std::invalid_argument для неизвестного имени
+ */
+inline Arrival parseArrival(const std::string& name) {
+    if (name == "constant") return Arrival::Constant;
+    if (name == "poisson") return Arrival::Poisson;
+    throw std::invalid_argument("Неизвестное расписание: " + name + " (constant или poisson)");
+}
+
+struct LoadProfile {
+    double ratePerSecond = 200.0;
+    std::chrono::milliseconds duration{2000};
+    Arrival arrival = Arrival::Poisson;
+    size_t clients = 64;  // клиентских потоков: верхняя граница одновременных запросов
+    uint64_t seed = 42;
+};
+
+/**
+ * @brief Плановые моменты отправки как смещения от старта прогона
+ *
+ * Постоянный поток считает смещение от номера запроса, а не прибавляет
+ * интервал, чтобы округление не накапливалось.
+ */
+class ArrivalSchedule {
+public:
+    /**
+     * @throws std::invalid_argument если rate не положителен
+     */
+    ArrivalSchedule(Arrival arrival, double ratePerSecond, uint64_t seed)
+        : arrival_(arrival), ratePerSecond_(ratePerSecond), random_(seed), gap_(ratePerSecond > 0 ? ratePerSecond : 1.0) {
+        if (!(ratePerSecond > 0)) {
+            throw std::invalid_argument("Интенсивность нагрузки должна быть положительной");
+        }
+    }
+
+    std::chrono::nanoseconds next() {
+        double seconds = 0;
+        if (arrival_ == Arrival::Constant) {
+            seconds = static_cast<double>(count_++) / ratePerSecond_;
+        } else {
+            poissonSeconds_ += gap_(random_);
+            seconds = poissonSeconds_;
+        }
+        return std::chrono::nanoseconds(static_cast<int64_t>(seconds * 1e9));
+    }
+
+private:
+    Arrival arrival_;
+    double ratePerSecond_;
+    uint64_t count_ = 0;
+    double poissonSeconds_ = 0;
+    std::mt19937_64 random_;
+    std::exponential_distribution<double> gap_;
+};
+
+/**
+ * @brief Чем закончился запрос с точки зрения клиента
+ */
+enum class Outcome {
+    Ok,        // ответ сервиса
+    Fallback,  // сервис не ответил, клиент отдал запасной ответ
+    Rejected,  // отказ без обращения к сервису: открытый breaker, полный bulkhead
+    Failed     // ошибка дошла до клиента
+};
+
+constexpr size_t kOutcomeCount = 4;
+
+inline const char* outcomeName(Outcome outcome) {
+    switch (outcome) {
+        case Outcome::Ok: return "ok";
+        case Outcome::Fallback: return "fallback";
+        case Outcome::Rejected: return "отказ";
+        case Outcome::Failed: return "ошибка";
+    }
+    return "?";
+}
+
+struct RequestContext {
+    size_t client = 0;          // индекс клиентского потока, 0..clients-1
+    uint64_t sequence = 0;      // номер запроса в расписании
+    Clock::time_point intended; // плановый момент отправки
+    size_t group = 0;           // обработчик может отнести запрос к группе
+};
+
+/**
+ * @brief Один запрос; вызывается из всех клиентских потоков одновременно
+ *
+ * Исключение из обработчика считается исходом Failed.
+ */
+using RequestHandler = std::function<Outcome(RequestContext&)>;
+
+struct GroupStats {
+    std::string name;
+    std::array<uint64_t, kOutcomeCount> outcomes{};
+    HistogramSnapshot latency;      // от планового момента отправки
+    HistogramSnapshot serviceTime;  // от фактического начала обработки
+
+    uint64_t completed() const {
+        uint64_t total = 0;
+        for (uint64_t count : outcomes) total += count;
+        return total;
+    }
+
+    void merge(const GroupStats& other) {
+        for (size_t i = 0; i < kOutcomeCount; ++i) outcomes[i] += other.outcomes[i];
+        latency.merge(other.latency);
+        serviceTime.merge(other.serviceTime);
+    }
+};
+
+struct LoadReport {
+    std::string name;
+    LoadProfile profile;
+    uint64_t sent = 0;
+    double elapsedSeconds = 0;
+    uint64_t maxDispatchLagNanos = 0;  // насколько генератор опаздывал к плановому моменту
+    std::vector<GroupStats> groups;
+    std::vector<std::string> notes;    // строки от сценария: статистика breaker'а, кэша
+
+    GroupStats total() const {
+        GroupStats result;
+        result.name = "всего";
+        for (const auto& group : groups) result.merge(group);
+        return result;
+    }
+
+    double achievedRate() const {
+        return elapsedSeconds > 0 ? static_cast<double>(total().completed()) / elapsedSeconds : 0.0;
+    }
+};
+
+namespace detail {
+
+// Счётчики одного клиентского потока: пишет только он, читаются после join
+struct alignas(kCacheLineSize) ClientGroupCounters {
+    std::array<uint64_t, kOutcomeCount> outcomes{};
+    LatencyHistogram latency;
+    LatencyHistogram serviceTime;
+};
+
+inline uint64_t nanosBetween(Clock::time_point from, Clock::time_point to) {
+    return to > from ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count()) : 0;
+}
+
+} // namespace detail
+
+/**
+ * @brief Прогнать нагрузку по профилю и собрать задержки
+ * @param groups имена групп запросов; обработчик выбирает группу через context.group
+ * @throws std::invalid_argument при нулевом числе клиентов или пустом списке групп
+ *
+ * Вызывающий поток работает генератором: ждёт планового момента и кладёт
+ * запрос в очередь. Клиенты разбирают очередь; после окончания расписания
+ * очередь дорабатывается до конца, поэтому отчёт включает все отправленные запросы.
+ */
+inline LoadReport runLoad(const std::string& name, const LoadProfile& profile, const RequestHandler& handler,
+                          std::vector<std::string> groups = {"всего"}) {
+    if (profile.clients == 0) {
+        throw std::invalid_argument("Нужен хотя бы один клиентский поток");
+    }
+    if (groups.empty()) {
+        throw std::invalid_argument("Нужна хотя бы одна группа запросов");
+    }
+
+    struct Pending {
+        uint64_t sequence;
+        Clock::time_point intended;
+    };
+
+    ArrivalSchedule schedule(profile.arrival, profile.ratePerSecond, profile.seed);
+    const size_t groupCount = groups.size();
+    auto counters = std::make_unique<detail::ClientGroupCounters[]>(profile.clients * groupCount);
+    std::deque<Pending> queue;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool finished = false;
+
+    auto clientLoop = [&](size_t client) {
+        while (true) {
+            Pending pending;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&] { return finished || !queue.empty(); });
+                if (queue.empty()) {
+                    return;
+                }
+                pending = queue.front();
+                queue.pop_front();
+            }
+
+            RequestContext context{client, pending.sequence, pending.intended, 0};
+            Clock::time_point started = Clock::now();
+            Outcome outcome;
+            try {
+                outcome = handler(context);
+            } catch (const std::exception&) {
+                outcome = Outcome::Failed;
+            }
+            Clock::time_point done = Clock::now();
+
+            auto& slot = counters[client * groupCount + std::min(context.group, groupCount - 1)];
+            ++slot.outcomes[static_cast<size_t>(outcome)];
+            slot.latency.record(detail::nanosBetween(pending.intended, done));
+            slot.serviceTime.record(detail::nanosBetween(started, done));
+        }
+    };
+
+    std::vector<std::thread> clients;
+    clients.reserve(profile.clients);
+    for (size_t i = 0; i < profile.clients; ++i) {
+        clients.emplace_back(clientLoop, i);
+    }
+
+    LoadReport report;
+    report.name = name;
+    report.profile = profile;
+
+    const Clock::time_point start = Clock::now();
+    while (true) {
+        std::chrono::nanoseconds offset = schedule.next();
+        if (offset >= profile.duration) {
+            break;
+        }
+        Clock::time_point intended = start + offset;
+        std::this_thread::sleep_until(intended);
+        report.maxDispatchLagNanos = std::max(report.maxDispatchLagNanos, detail::nanosBetween(intended, Clock::now()));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(Pending{report.sent++, intended});
+        }
+        condition.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+    }
+    condition.notify_all();
+    for (auto& client : clients) {
+        client.join();
+    }
+    report.elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    for (size_t g = 0; g < groupCount; ++g) {
+        GroupStats stats;
+        stats.name = groups[g];
+        for (size_t client = 0; client < profile.clients; ++client) {
+            const auto& slot = counters[client * groupCount + g];
+            for (size_t i = 0; i < kOutcomeCount; ++i) stats.outcomes[i] += slot.outcomes[i];
+            stats.latency.merge(slot.latency.snapshot());
+            stats.serviceTime.merge(slot.serviceTime.snapshot());
+        }
+        report.groups.push_back(std::move(stats));
+    }
+    return report;
+}
+
+/**
+ * @brief Распределение перцентилей в формате outputPercentileDistribution из HdrHistogram
+ * @param unitNanos делитель значений: 1e6 - миллисекунды
+ *
+ * Шаг по перцентилям сгущается к хвосту (5 строк на каждое уполовинивание
+ * расстояния до 100%), файл читает HdrHistogram Plotter.
+ */
+inline void writeHdrPercentiles(std::ostream& out, const HistogramSnapshot& snapshot, double unitNanos = 1e6) {
+    char line[128];
+    std::snprintf(line, sizeof(line), "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    out << line;
+    if (snapshot.total == 0) {
+        return;
+    }
+
+    // Значение и накопленное число замеров для перцентиля level (0..100)
+    auto valueAt = [&](double level, uint64_t& countTo) {
+        double exactRank = std::ceil(static_cast<double>(snapshot.total) * level / 100.0);
+        uint64_t rank = std::clamp<uint64_t>(static_cast<uint64_t>(exactRank), 1, snapshot.total);
+        countTo = 0;
+        for (size_t i = 0; i < snapshot.counts.size(); ++i) {
+            countTo += snapshot.counts[i];
+            if (countTo >= rank) {
+                return std::min(LatencyHistogram::bucketUpperBound(i), snapshot.maxNanos);
+            }
+        }
+        return snapshot.maxNanos;
+    };
+
+    double level = 0;
+    for (int row = 0; row < 10000; ++row) {
+        uint64_t countTo = 0;
+        uint64_t value = valueAt(level, countTo);
+        if (countTo >= snapshot.total) {
+            break;
+        }
+        double fraction = level / 100.0;
+        std::snprintf(line, sizeof(line), "%12.3f %2.12f %10llu %14.2f\n", static_cast<double>(value) / unitNanos,
+                      fraction, static_cast<unsigned long long>(countTo), 1.0 / (1.0 - fraction));
+        out << line;
+        double halvings = std::floor(std::log2(100.0 / (100.0 - level))) + 1;
+        level += 100.0 / (5.0 * std::pow(2.0, halvings));
+    }
+    std::snprintf(line, sizeof(line), "%12.3f %2.12f %10llu\n", static_cast<double>(snapshot.maxNanos) / unitNanos, 1.0,
+                  static_cast<unsigned long long>(snapshot.total));
+    out << line;
+
+    // Корзины хранят только границы: σ по верхним границам, среднее - точное
+    double mean = snapshot.meanNanos();
+    double squares = 0;
+    for (size_t i = 0; i < snapshot.counts.size(); ++i) {
+        if (snapshot.counts[i] == 0) continue;
+        double value = static_cast<double>(std::min(LatencyHistogram::bucketUpperBound(i), snapshot.maxNanos));
+        squares += static_cast<double>(snapshot.counts[i]) * (value - mean) * (value - mean);
+    }
+    double deviation = std::sqrt(squares / static_cast<double>(snapshot.total));
+    std::snprintf(line, sizeof(line), "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", mean / unitNanos, deviation / unitNanos);
+    out << line;
+    std::snprintf(line, sizeof(line), "#[Max     = %12.3f, Total count    = %12llu]\n",
+                  static_cast<double>(snapshot.maxNanos) / unitNanos, static_cast<unsigned long long>(snapshot.total));
+    out << line;
+    std::snprintf(line, sizeof(line), "#[Buckets = %12zu, SubBuckets     = %12llu]\n",
+                  LatencyHistogram::kBucketCount / LatencyHistogram::kSubBuckets,
+                  static_cast<unsigned long long>(LatencyHistogram::kSubBuckets));
+    out << line;
+}
+
+namespace detail {
+
+inline void printPercentiles(std::ostream& out, const char* title, const HistogramSnapshot& snapshot) {
+    auto millis = [](uint64_t nanos) { return static_cast<double>(nanos) / 1e6; };
+    out << "    " << title << std::fixed << std::setprecision(2)
+        << "p50 " << millis(snapshot.percentileNanos(50))
+        << "  p90 " << millis(snapshot.percentileNanos(90))
+        << "  p99 " << millis(snapshot.percentileNanos(99))
+        << "  p99.9 " << millis(snapshot.percentileNanos(99.9))
+        << "  max " << millis(snapshot.maxNanos) << "\n";
+}
+
+inline void printGroup(std::ostream& out, const GroupStats& group) {
+    out << "  " << group.name << ": " << group.completed() << " запросов (";
+    for (size_t i = 0; i < kOutcomeCount; ++i) {
+        out << (i ? ", " : "") << outcomeName(static_cast<Outcome>(i)) << " " << group.outcomes[i];
+    }
+    out << ")\n";
+    printPercentiles(out, "от плана, мс:        ", group.latency);
+    printPercentiles(out, "обслуживание, мс:    ", group.serviceTime);
+}
+
+} // namespace detail
+
+inline void printReport(std::ostream& out, const LoadReport& report) {
+    const LoadProfile& profile = report.profile;
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << "\n" << report.name << "  (" << arrivalName(profile.arrival) << " " << std::fixed << std::setprecision(0)
+        << profile.ratePerSecond << "/с, " << std::setprecision(1) << std::chrono::duration<double>(profile.duration).count() << " с, "
+        << profile.clients << " клиентов)\n";
+    out << "  отправлено " << report.sent << " за " << std::setprecision(2) << report.elapsedSeconds << " с, выполнено "
+        << std::setprecision(1) << report.achievedRate() << "/с, опоздание генератора до "
+        << std::setprecision(2) << static_cast<double>(report.maxDispatchLagNanos) / 1e6 << " мс\n";
+    if (report.groups.size() > 1) {
+        for (const auto& group : report.groups) detail::printGroup(out, group);
+    }
+    detail::printGroup(out, report.total());
+    for (const auto& note : report.notes) {
+        out << "  " << note << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+/**
+ * @brief Сценарий: строит систему под нагрузкой, вызывает runLoad и дописывает заметки
+ */
+using ScenarioFunction = std::function<LoadReport(const std::string& name, const LoadProfile& profile)>;
+
+struct Scenario {
+    std::string name;
+    std::string description;
+    LoadProfile profile;  // профиль по умолчанию, ключи командной строки его перекрывают
+    ScenarioFunction run;
+};
+
+inline std::vector<Scenario>& scenarioRegistry() {
+    static std::vector<Scenario> registry;
+    return registry;
+}
+
+inline void registerScenario(std::string name, std::string description, LoadProfile profile, ScenarioFunction run) {
+    scenarioRegistry().push_back(Scenario{std::move(name), std::move(description), profile, std::move(run)});
+}
+
+} // namespace cpp_patterns::load
@@ -0,0 +1,153 @@
+/**
+ * @file loadtest_main.cpp
+ * @brief Точка входа нагрузочных сценариев: выбор сценария, профиль нагрузки, HDR-файлы
+ *
+ * Запуск:
+ *   loadtest [--scenario=REGEX] [--rate=N] [--duration-ms=N] [--arrival=constant|poisson]
+ *            [--clients=N] [--seed=N] [--hdr-dir=DIR]
+ *   loadtest --list
+ *
+ * Ключи профиля перекрывают значения сценария по умолчанию. С --hdr-dir
+ * для каждого сценария пишется NAME.hgrm (задержка от плана) и
+ * NAME.service.hgrm (время обслуживания) в формате HdrHistogram.
+ *
+ * Код возврата: 0 - успех, 2 - ошибка.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#include "load_generator.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <regex>
+#include <string>
+
+namespace {
+
+using namespace cpp_patterns::load;
+
+void printUsage() {
+    std::cout << "Использование:\n"
+              << "  loadtest [--scenario=REGEX] [--rate=N] [--duration-ms=N] [--arrival=constant|poisson]\n"
+              << "           [--clients=N] [--seed=N] [--hdr-dir=DIR]\n"
+              << "  loadtest --list\n";
+}
+
+bool readOption(const std::string& argument, const std::string& name, std::string& value) {
+    std::string prefix = "--" + name + "=";
+    if (argument.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    value = argument.substr(prefix.size());
+    return true;
+}
+
+// Переопределения профиля из командной строки
+struct ProfileOverrides {
+    std::optional<double> rate;
+    std::optional<long> durationMillis;
+    std::optional<Arrival> arrival;
+    std::optional<size_t> clients;
+    std::optional<uint64_t> seed;
+
+    LoadProfile apply(LoadProfile profile) const {
+        if (rate) profile.ratePerSecond = *rate;
+        if (durationMillis) profile.duration = std::chrono::milliseconds(*durationMillis);
+        if (arrival) profile.arrival = *arrival;
+        if (clients) profile.clients = *clients;
+        if (seed) profile.seed = *seed;
+        return profile;
+    }
+};
+
+void writeHdrFile(const std::filesystem::path& path, const cpp_patterns::HistogramSnapshot& snapshot) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Не удалось записать " + path.string());
+    }
+    writeHdrPercentiles(out, snapshot);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        std::string filter = ".*";
+        std::string hdrDir;
+        ProfileOverrides overrides;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            std::string value;
+            if (argument == "--help" || argument == "-h") {
+                printUsage();
+                return 0;
+            } else if (argument == "--list") {
+                for (const auto& scenario : scenarioRegistry()) {
+                    std::cout << scenario.name << "  - " << scenario.description << "\n";
+                }
+                return 0;
+            } else if (readOption(argument, "scenario", value)) {
+                filter = value;
+            } else if (readOption(argument, "rate", value)) {
+                overrides.rate = std::stod(value);
+            } else if (readOption(argument, "duration-ms", value)) {
+                overrides.durationMillis = std::stol(value);
+            } else if (readOption(argument, "arrival", value)) {
+                overrides.arrival = parseArrival(value);
+            } else if (readOption(argument, "clients", value)) {
+                overrides.clients = static_cast<size_t>(std::stoul(value));
+            } else if (readOption(argument, "seed", value)) {
+                overrides.seed = std::stoull(value);
+            } else if (readOption(argument, "hdr-dir", value)) {
+                hdrDir = value;
+            } else {
+                std::cerr << "Неизвестный аргумент: " << argument << "\n";
+                printUsage();
+                return 2;
+            }
+        }
+
+        if (!hdrDir.empty()) {
+            std::filesystem::create_directories(hdrDir);
+        }
+
+        std::regex pattern(filter);
+        size_t executed = 0;
+        for (const auto& scenario : scenarioRegistry()) {
+            if (!std::regex_search(scenario.name, pattern)) {
+                continue;
+            }
+            LoadReport report = scenario.run(scenario.name, overrides.apply(scenario.profile));
+            printReport(std::cout, report);
+            ++executed;
+
+            if (!hdrDir.empty()) {
+                std::string file = scenario.name;
+                std::replace(file.begin(), file.end(), '/', '_');
+                GroupStats total = report.total();
+                writeHdrFile(std::filesystem::path(hdrDir) / (file + ".hgrm"), total.latency);
+                writeHdrFile(std::filesystem::path(hdrDir) / (file + ".service.hgrm"), total.serviceTime);
+            }
+        }
+
+        if (executed == 0) {
+            std::cerr << "Нет сценариев по фильтру " << filter << "\n";
+            return 2;
+        }
+        if (!hdrDir.empty()) {
+            std::cout << "\nГистограммы HdrHistogram: " << hdrDir << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: " << e.what() << std::endl;
+        return 2;
+    }
+}
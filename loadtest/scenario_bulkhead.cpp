@@ -0,0 +1,108 @@
+/**
+ * @file scenario_bulkhead.cpp
+ * @brief Нагрузка на изоляцию ресурсов (урок 8.3): медленный сосед и быстрый сервис
+ *
+ * 80% запросов идут в быстрый payments (~2 мс), 20% - в reports (~5 мс),
+ * который во второй трети прогона замедляется в 40 раз. Вызовы сервисов
+ * выполняют пулы BulkheadManager урока, клиентский поток ждёт результата:
+ * - shared_pool - один bulkhead на 16 потоков на оба сервиса: reports
+ *   занимает все потоки, и payments ждёт в той же очереди;
+ * - isolated - у каждого сервиса свой bulkhead на 8 потоков и очередь до
+ *   16 задач; лишние запросы к reports отклоняются, payments не замечает
+ *   деградации соседа.
+ */
+
+#include "load_generator.h"
+#include "simulated_backend.h"
+
+#include "08-high-load/lesson_8_3_bulkhead/bulkhead_pattern.h"
+
+#include <future>
+#include <memory>
+#include <sstream>
+
+namespace {
+
+using namespace cpp_patterns::load;
+using namespace std::chrono_literals;
+
+enum Group : size_t { kPayments = 0, kReports = 1 };
+
+struct Services {
+    explicit Services(const LoadProfile& profile) {
+        reports.addSlowdown(profile.duration / 3, profile.duration * 2 / 3, 40.0);
+    }
+
+    SimulatedBackend payments{"payments", LatencyModel::logNormal(2ms, 0.25)};
+    SimulatedBackend reports{"reports", LatencyModel::logNormal(5ms, 0.25)};
+};
+
+// Каждый пятый запрос - отчёт; выбор по номеру, чтобы смесь не зависела от расписания
+Group classify(const RequestContext& context) {
+    return context.sequence % 5 == 4 ? kReports : kPayments;
+}
+
+const std::vector<std::string> kGroups = {"payments", "reports"};
+
+/**
+ * @brief Выполнить вызов сервиса в bulkhead и дождаться его
+ * @return false, если очередь bulkhead заполнена и задача отклонена
+ */
+bool callThrough(BulkheadManager& manager, ServiceType type, SimulatedBackend& backend) {
+    auto done = std::make_shared<std::promise<void>>();
+    std::future<void> result = done->get_future();
+    Task task([&backend, done] {
+        try {
+            backend.call();
+            done->set_value();
+        } catch (...) {
+            done->set_exception(std::current_exception());
+        }
+    }, type, backend.name());
+    if (!manager.execute(type, std::move(task))) {
+        return false;
+    }
+    result.get();
+    return true;
+}
+
+LoadReport runShared(const std::string& name, const LoadProfile& profile) {
+    Services services(profile);
+    BulkheadManager manager;
+    // Очередь не меньше числа клиентов: ждут все, отказов нет
+    manager.registerBulkhead(ServiceType::NORMAL, "shared", 16, profile.clients, {}, false);
+    return runLoad(name, profile, [&](RequestContext& context) {
+        context.group = classify(context);
+        SimulatedBackend& backend = context.group == kReports ? services.reports : services.payments;
+        return callThrough(manager, ServiceType::NORMAL, backend) ? Outcome::Ok : Outcome::Rejected;
+    }, kGroups);
+}
+
+LoadReport runIsolated(const std::string& name, const LoadProfile& profile) {
+    Services services(profile);
+    BulkheadManager manager;
+    manager.registerBulkhead(ServiceType::CRITICAL, "payments", 8, 16, {}, false);
+    manager.registerBulkhead(ServiceType::NORMAL, "reports", 8, 16, {}, false);
+    LoadReport report = runLoad(name, profile, [&](RequestContext& context) {
+        context.group = classify(context);
+        bool accepted = context.group == kReports
+            ? callThrough(manager, ServiceType::NORMAL, services.reports)
+            : callThrough(manager, ServiceType::CRITICAL, services.payments);
+        return accepted ? Outcome::Ok : Outcome::Rejected;
+    }, kGroups);
+    std::ostringstream note;
+    note << "bulkhead: отклонено payments " << manager.getBulkhead(ServiceType::CRITICAL)->getRejectedTasks()
+         << ", reports " << manager.getBulkhead(ServiceType::NORMAL)->getRejectedTasks();
+    report.notes.push_back(note.str());
+    return report;
+}
+
+const bool kRegistered = [] {
+    LoadProfile profile;
+    profile.ratePerSecond = 400;
+    registerScenario("bulkhead/shared_pool", "один пул на 16 соединений, reports замедляется x40", profile, runShared);
+    registerScenario("bulkhead/isolated", "пулы 8+8 с очередью 16, reports замедляется x40", profile, runIsolated);
+    return true;
+}();
+
+} // namespace
@@ -0,0 +1,125 @@
+/**
+ * @file scenario_cache_aside.cpp
+ * @brief Нагрузка на Cache-Aside (урок 8.1): MultiLevelCache перед медленной БД
+ *
+ * Ключи запросов распределены по Ципфу (s = 1) на 2000 записей: малая
+ * часть горячих ключей даёт большую часть обращений. Варианты:
+ * - no_cache - каждый запрос идёт в БД (~3 мс, логнормально);
+ * - multi_level - MultiLevelCache урока: L1 (LRU, 256 записей) и L2 (LFU,
+ *   1024 записи), оба в памяти процесса; промах загружает из БД в оба уровня;
+ * - flush_midway - то же, но посередине прогона кэш очищается: видно, сколько
+ *   длится прогрев и какой хвост даёт волна промахов.
+ */
+
+#include "load_generator.h"
+#include "simulated_backend.h"
+
+#include "08-high-load/lesson_8_1_cache_aside/cache_aside_pattern.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+using namespace cpp_patterns::load;
+using namespace std::chrono_literals;
+
+constexpr size_t kKeyCount = 2000;
+
+/**
+ * @brief Выборка ключей по закону Ципфа через предвычисленную функцию распределения
+ */
+class ZipfKeys {
+public:
+    ZipfKeys(size_t count, double exponent) : cumulative_(count) {
+        double sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += 1.0 / std::pow(static_cast<double>(i + 1), exponent);
+            cumulative_[i] = sum;
+        }
+        for (double& value : cumulative_) value /= sum;
+    }
+
+    size_t sample(std::mt19937_64& random) const {
+        double point = std::uniform_real_distribution<double>(0.0, 1.0)(random);
+        auto it = std::lower_bound(cumulative_.begin(), cumulative_.end(), point);
+        return static_cast<size_t>(std::min<std::ptrdiff_t>(it - cumulative_.begin(),
+                                                            static_cast<std::ptrdiff_t>(cumulative_.size()) - 1));
+    }
+
+private:
+    std::vector<double> cumulative_;
+};
+
+const ZipfKeys& zipfKeys() {
+    static const ZipfKeys keys(kKeyCount, 1.0);
+    return keys;
+}
+
+std::string databaseNote(const SimulatedBackend& database) {
+    std::ostringstream note;
+    note << "БД: " << database.calls() << " запросов";
+    return note.str();
+}
+
+LoadReport runNoCache(const std::string& name, const LoadProfile& profile) {
+    SimulatedBackend database("db", LatencyModel::logNormal(3ms, 0.4));
+    LoadReport report = runLoad(name, profile, [&](RequestContext&) {
+        database.call();
+        return Outcome::Ok;
+    });
+    report.notes.push_back(databaseNote(database));
+    return report;
+}
+
+std::string cacheNote(const MultiLevelCache<size_t, std::string>& cache) {
+    size_t l1 = cache.getL1Hits(), l2 = cache.getL2Hits(), misses = cache.getMisses();
+    size_t total = l1 + l2 + misses;
+    std::ostringstream note;
+    note << "кэш: L1 " << l1 << ", L2 " << l2 << ", промахов " << misses;
+    if (total > 0) {
+        note << " (попаданий " << std::fixed << std::setprecision(1)
+             << 100.0 * static_cast<double>(l1 + l2) / static_cast<double>(total) << "%)";
+    }
+    return note.str();
+}
+
+LoadReport runCached(const std::string& name, const LoadProfile& profile, bool flushMidway) {
+    SimulatedBackend database("db", LatencyModel::logNormal(3ms, 0.4));
+    MultiLevelCache<size_t, std::string> cache(256, 1024);
+    const ZipfKeys& keys = zipfKeys();
+    std::atomic<bool> flushed{!flushMidway};
+    const uint64_t midpoint = static_cast<uint64_t>(profile.ratePerSecond * std::chrono::duration<double>(profile.duration).count() / 2);
+
+    LoadReport report = runLoad(name, profile, [&](RequestContext& context) {
+        if (context.sequence >= midpoint && !flushed.exchange(true)) {
+            cache.clear();
+        }
+        // Cache-aside: промах читает БД и кладёт значение в оба уровня
+        size_t key = keys.sample(threadRandom());
+        std::string value;
+        if (!cache.get(key, value)) {
+            database.call();
+            cache.put(key, "UserData_" + std::to_string(key));
+        }
+        return Outcome::Ok;
+    });
+    report.notes.push_back(cacheNote(cache));
+    report.notes.push_back(databaseNote(database));
+    return report;
+}
+
+const bool kRegistered = [] {
+    LoadProfile profile;
+    profile.ratePerSecond = 1000;
+    registerScenario("cache_aside/no_cache", "каждый запрос в БД", profile, runNoCache);
+    registerScenario("cache_aside/multi_level", "MultiLevelCache урока: L1 LRU 256 + L2 LFU 1024 перед БД", profile,
+                     [](const std::string& name, const LoadProfile& p) { return runCached(name, p, false); });
+    registerScenario("cache_aside/flush_midway", "то же, кэш очищается посередине прогона", profile,
+                     [](const std::string& name, const LoadProfile& p) { return runCached(name, p, true); });
+    return true;
+}();
+
+} // namespace
@@ -0,0 +1,126 @@
+/**
+ * @file scenario_circuit_breaker.cpp
+ * @brief Нагрузка на устойчивый клиент (урок 8.2): зависание сервиса посередине прогона
+ *
+ * Сервис отвечает за ~5 мс с 1% ошибок, а во второй трети прогона висит
+ * 250 мс и отдаёт таймаут. Клиенты - классы урока из resilient_client.h,
+ * сервис - HTTPService урока с задержками SimulatedBackend:
+ * - direct - HTTPService::request без защиты: каждый запрос в окне ждёт таймаута;
+ * - retry - retryWithBackoff с RetryPolicy(3, 10 мс, x2): повторы удваивают
+ *   нагрузку на висящий сервис и растягивают хвост;
+ * - resilient - ResilientHTTPClient с CircuitBreakerConfig(5, 2, 200 мс),
+ *   таймаутом запроса 50 мс и fallback: после серии таймаутов цепь
+ *   размыкается, и запросы сразу получают запасной ответ (исход «отказ»),
+ *   не обращаясь к сервису.
+ */
+
+#include "load_generator.h"
+#include "simulated_backend.h"
+
+#include "08-high-load/lesson_8_2_circuit_breaker/resilient_client.h"
+
+#include <memory>
+#include <sstream>
+
+namespace {
+
+using namespace cpp_patterns::load;
+using namespace std::chrono_literals;
+
+// Дошёл ли текущий запрос клиента до сервиса: fallback без обращения - это отказ breaker'а
+thread_local bool serviceReached = false;
+
+/**
+ * @brief HTTPService урока, у которого задержки и сбои задаёт SimulatedBackend
+ */
+class SimulatedHTTPService : public HTTPService {
+public:
+    // Ответ ~5 мс с хвостом, 1% ошибок, зависание во второй трети прогона
+    SimulatedHTTPService(const LoadProfile& profile, std::chrono::microseconds timeout)
+        : HTTPService("api"), backend_("api", latency(), 0.01), timeout_(timeout) {
+        backend_.addHang(profile.duration / 3, profile.duration * 2 / 3, 250ms);
+    }
+
+    std::string request(const std::string& endpoint) override {
+        serviceReached = true;
+        backend_.call(timeout_);
+        return "Response from api for " + endpoint;
+    }
+
+    std::string note() const {
+        std::ostringstream note;
+        note << "сервис: " << backend_.calls() << " вызовов, " << backend_.failures() << " ошибок";
+        return note.str();
+    }
+
+private:
+    static LatencyModel latency() {
+        LatencyModel model = LatencyModel::logNormal(5ms, 0.3);
+        model.withSlowTail(0.005, 40ms);
+        return model;
+    }
+
+    SimulatedBackend backend_;
+    std::chrono::microseconds timeout_;
+};
+
+LoadReport runDirect(const std::string& name, const LoadProfile& profile) {
+    auto service = std::make_shared<SimulatedHTTPService>(profile, std::chrono::microseconds::max());
+    LoadReport report = runLoad(name, profile, [&](RequestContext&) {
+        service->request("/api/data");
+        return Outcome::Ok;
+    });
+    report.notes.push_back(service->note());
+    return report;
+}
+
+LoadReport runRetry(const std::string& name, const LoadProfile& profile) {
+    auto service = std::make_shared<SimulatedHTTPService>(profile, std::chrono::microseconds::max());
+    const RetryPolicy policy(3, 10ms, 2.0, false);
+    LoadReport report = runLoad(name, profile, [&](RequestContext&) {
+        retryWithBackoff([&] { return service->request("/api/data"); }, policy);
+        return Outcome::Ok;
+    });
+    report.notes.push_back(service->note());
+    return report;
+}
+
+LoadReport runResilient(const std::string& name, const LoadProfile& profile) {
+    const CircuitBreakerConfig config(5, 2, 200ms, 50ms, false);
+    auto service = std::make_shared<SimulatedHTTPService>(profile, config.request_timeout);
+    // Одна попытка: повторы за breaker'ом лишь продлевали бы зависание
+    ResilientHTTPClient client(service, "api", RetryPolicy(1, 0ms, 1.0, false), config);
+    thread_local bool fallbackUsed = false;
+    client.setFallback([](const std::string&) {
+        fallbackUsed = true;
+        return std::string("cached");
+    });
+
+    LoadReport report = runLoad(name, profile, [&](RequestContext&) {
+        serviceReached = false;
+        fallbackUsed = false;
+        client.request("/api/data");
+        if (!fallbackUsed) {
+            return Outcome::Ok;
+        }
+        return serviceReached ? Outcome::Fallback : Outcome::Rejected;
+    });
+    auto breaker = client.getCircuitBreaker();
+    std::ostringstream note;
+    note << "breaker: " << breaker->getStateName() << ", ошибок " << breaker->getFailedRequests()
+         << ", отклонил " << breaker->getRejectedRequests() << " из " << breaker->getTotalRequests();
+    report.notes.push_back(note.str());
+    report.notes.push_back(service->note());
+    return report;
+}
+
+const bool kRegistered = [] {
+    LoadProfile profile;
+    profile.ratePerSecond = 200;
+    registerScenario("circuit_breaker/direct", "вызов без защиты, сервис висит 250 мс во второй трети", profile, runDirect);
+    registerScenario("circuit_breaker/retry", "три попытки с backoff 10/20 мс", profile, runRetry);
+    registerScenario("circuit_breaker/resilient", "CircuitBreaker(5 ошибок, 200 мс), таймаут 50 мс, fallback", profile, runResilient);
+    return true;
+}();
+
+} // namespace
@@ -0,0 +1,147 @@
+/**
+ * @file scenario_reactor.cpp
+ * @brief Нагрузка на TCP-сервер на Reactor (урок 7.4) через loopback
+ *
+ * Сервер - MultiReactorServer урока на backend epoll: у каждого цикла свой
+ * слушающий сокет на общем порту (SO_REUSEPORT), ядро раскладывает соединения
+ * между ними, ответ уходит срезом принятого буфера без копирования. Каждый
+ * клиентский поток держит одно блокирующее соединение и на запрос отправляет
+ * 64 байта, ожидая эхо. Варианты:
+ * - echo - пустой обработчик: задержка - это системные вызовы и планировщик;
+ * - busy_handler - обработчик тратит 100 мкс CPU на сообщение, один цикл:
+ *   при загрузке выше половины хвост растёт из-за очереди в цикле;
+ * - busy_handler_multi - то же, цикл на каждое ядро.
+ */
+
+#include "load_generator.h"
+
+#ifdef __linux__
+
+#include "07-concurrency/lesson_7_4_reactor/reactor_pattern.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <system_error>
+
+namespace {
+
+using namespace cpp_patterns::load;
+using namespace std::chrono_literals;
+
+constexpr size_t kMessageSize = 64;
+
+[[noreturn]] void throwErrno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+/**
+ * @brief Обработчик эха для MultiReactorServer: CPU на каждые 64 байта, затем ответ без копии
+ */
+RequestCallback echoCallback(std::chrono::microseconds handlerCost) {
+    return [handlerCost](const cpp_patterns::BufferSlice& request, cpp_patterns::BufferChain& response) {
+        if (handlerCost.count() > 0) {
+            auto until = Clock::now() + handlerCost * static_cast<int64_t>((request.size() + kMessageSize - 1) / kMessageSize);
+            while (Clock::now() < until) {
+            }
+        }
+        response.append(request);
+    };
+}
+
+/**
+ * @brief Блокирующие соединения клиентов: слот i использует только клиентский поток i
+ */
+class EchoClients {
+public:
+    EchoClients(size_t clients, uint16_t port) : sockets_(clients, -1), port_(port) {}
+
+    ~EchoClients() {
+        for (int fd : sockets_) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    Outcome roundTrip(size_t client) {
+        int& fd = sockets_[client];
+        if (fd < 0) {
+            fd = connectTo(port_);
+        }
+        std::array<char, kMessageSize> message;
+        message.fill('x');
+        if (send(fd, message.data(), message.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(message.size())) {
+            throwErrno("send");
+        }
+        size_t received = 0;
+        while (received < message.size()) {
+            ssize_t n = recv(fd, message.data() + received, message.size() - received, 0);
+            if (n <= 0) {
+                throwErrno("recv");
+            }
+            received += static_cast<size_t>(n);
+        }
+        return Outcome::Ok;
+    }
+
+private:
+    static int connectTo(uint16_t port) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            throwErrno("socket");
+        }
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            close(fd);
+            throwErrno("connect");
+        }
+        return fd;
+    }
+
+    std::vector<int> sockets_;
+    uint16_t port_;
+};
+
+LoadReport runEcho(const std::string& name, const LoadProfile& profile, size_t loops, std::chrono::microseconds cost) {
+    MultiReactorServer server(loops, 0, echoCallback(cost), ShardingMode::ReusePort, ReactorBackend::Epoll);
+    server.start();
+    EchoClients clients(profile.clients, static_cast<uint16_t>(server.getPort()));
+    LoadReport report = runLoad(name, profile, [&](RequestContext& context) { return clients.roundTrip(context.client); });
+    server.stop();
+    std::ostringstream note;
+    note << "сервер: циклов epoll " << server.loopCount() << " (CPU " << server.describePlacement()
+         << "), обработчик " << cost.count() << " мкс на сообщение";
+    report.notes.push_back(note.str());
+    return report;
+}
+
+size_t coreCount() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+const bool kRegistered = [] {
+    LoadProfile profile;
+    profile.ratePerSecond = 5000;
+    profile.clients = 16;
+    registerScenario("reactor/echo", "один цикл epoll, эхо 64 байт", profile,
+                     [](const std::string& name, const LoadProfile& p) { return runEcho(name, p, 1, 0us); });
+    registerScenario("reactor/busy_handler", "один цикл, 100 мкс CPU на сообщение", profile,
+                     [](const std::string& name, const LoadProfile& p) { return runEcho(name, p, 1, 100us); });
+    registerScenario("reactor/busy_handler_multi", "цикл на ядро, 100 мкс CPU на сообщение", profile,
+                     [](const std::string& name, const LoadProfile& p) { return runEcho(name, p, coreCount(), 100us); });
+    return true;
+}();
+
+} // namespace
+
+#endif // __linux__
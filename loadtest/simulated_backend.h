@@ -0,0 +1,219 @@
+/**
+ * @file simulated_backend.h
+ * @brief Имитация удалённого сервиса: распределение задержек и внедрение отказов
+ *
+ * Заменяет HTTPService и Database из уроков 8.x под нагрузкой: те ждут
+ * фиксированные 30-50 мс и печатают каждую ошибку в консоль. Здесь:
+ * - LatencyModel - фиксированная, равномерная, экспоненциальная или
+ *   логнормальная задержка плюс редкий медленный хвост;
+ * - доля случайных ошибок и окна отказов по времени от старта: сервис
+ *   лежит (быстрая ошибка), висит (ошибка по таймауту) или замедлен в N раз;
+ * - генератор случайных чисел у каждого потока свой, call() не берёт мьютексов.
+ *
+ * @author Sehktel
+ * @license MIT License
+ * @copyright Copyright (c) 2025 Sehktel
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cpp_patterns::load {
+
+/**
+ * @brief Ошибка имитируемого сервиса
+ */
+class BackendError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Генератор случайных чисел потока; зерно смешивается с id потока
+ */
+inline std::mt19937_64& threadRandom() {
+    thread_local std::mt19937_64 random(std::hash<std::thread::id>{}(std::this_thread::get_id()) ^ 0x9E3779B97F4A7C15ull);
+    return random;
+}
+
+/**
+ * @brief Распределение времени ответа сервиса
+ */
+class LatencyModel {
+public:
+    using Duration = std::chrono::microseconds;
+
+    static LatencyModel fixed(Duration latency) { return LatencyModel(Kind::Fixed, toDouble(latency), 0); }
+
+    static LatencyModel uniform(Duration min, Duration max) {
+        return LatencyModel(Kind::Uniform, toDouble(min), toDouble(max));
+    }
+
+    static LatencyModel exponential(Duration mean) { return LatencyModel(Kind::Exponential, toDouble(mean), 0); }
+
+    /**
+     * @param sigma разброс логарифма: 0.25 - узкое распределение, 1.0 - длинный хвост
+     */
+    static LatencyModel logNormal(Duration median, double sigma) {
+        return LatencyModel(Kind::LogNormal, toDouble(median), sigma);
+    }
+
+    /**
+     * @brief Доля probability запросов отвечает за latency (GC-пауза, промах кэша БД)
+     */
+    LatencyModel& withSlowTail(double probability, Duration latency) {
+        tailProbability_ = probability;
+        tailMicros_ = toDouble(latency);
+        return *this;
+    }
+
+    Duration sample(std::mt19937_64& random) const {
+        if (tailProbability_ > 0 && std::uniform_real_distribution<double>(0.0, 1.0)(random) < tailProbability_) {
+            return Duration(static_cast<int64_t>(tailMicros_));
+        }
+        double micros = first_;
+        switch (kind_) {
+            case Kind::Fixed:
+                break;
+            case Kind::Uniform:
+                micros = std::uniform_real_distribution<double>(first_, second_)(random);
+                break;
+            case Kind::Exponential:
+                micros = std::exponential_distribution<double>(1.0 / first_)(random);
+                break;
+            case Kind::LogNormal:
+                micros = std::lognormal_distribution<double>(std::log(first_), second_)(random);
+                break;
+        }
+        return Duration(static_cast<int64_t>(micros));
+    }
+
+private:
+    enum class Kind { Fixed, Uniform, Exponential, LogNormal };
+
+    LatencyModel(Kind kind, double first, double second) : kind_(kind), first_(first), second_(second) {}
+
+    static double toDouble(Duration duration) { return static_cast<double>(duration.count()); }
+
+    Kind kind_;
+    double first_;
+    double second_;
+    double tailProbability_ = 0;
+    double tailMicros_ = 0;
+};
+
+enum class FaultMode {
+    Down,  // сразу ошибка: соединение отклонено
+    Hang,  // ответа нет, клиент получает ошибку по таймауту
+    Slow   // задержка умножается на slowdown
+};
+
+struct FaultWindow {
+    std::chrono::milliseconds from;
+    std::chrono::milliseconds to;
+    FaultMode mode;
+    double slowdown = 1.0;
+    std::chrono::milliseconds hang{0};
+};
+
+/**
+ * @brief Удалённый сервис под нагрузкой
+ *
+ * Окна отказов отсчитываются от restartClock() (по умолчанию - от
+ * создания), поэтому бэкенд создают непосредственно перед runLoad().
+ * Окна добавляют до начала нагрузки: call() читает их без блокировок.
+ */
+class SimulatedBackend {
+public:
+    SimulatedBackend(std::string name, LatencyModel latency, double failureRate = 0.0)
+        : name_(std::move(name)), latency_(latency), failureRate_(failureRate), epoch_(std::chrono::steady_clock::now()) {}
+
+    SimulatedBackend& addOutage(std::chrono::milliseconds from, std::chrono::milliseconds to) {
+        windows_.push_back(FaultWindow{from, to, FaultMode::Down});
+        return *this;
+    }
+
+    SimulatedBackend& addHang(std::chrono::milliseconds from, std::chrono::milliseconds to,
+                              std::chrono::milliseconds timeout) {
+        windows_.push_back(FaultWindow{from, to, FaultMode::Hang, 1.0, timeout});
+        return *this;
+    }
+
+    SimulatedBackend& addSlowdown(std::chrono::milliseconds from, std::chrono::milliseconds to, double factor) {
+        windows_.push_back(FaultWindow{from, to, FaultMode::Slow, factor});
+        return *this;
+    }
+
+    void restartClock() { epoch_ = std::chrono::steady_clock::now(); }
+
+    /**
+     * @brief Один запрос: занимает вызывающий поток на время ответа
+     * @param timeout таймаут клиента: если ответ дольше, поток ждёт только timeout
+     * @throws BackendError при внедрённом отказе или по таймауту клиента
+     */
+    void call(std::chrono::microseconds timeout = std::chrono::microseconds::max()) {
+        calls_.fetch_add(1, std::memory_order_relaxed);
+        std::mt19937_64& random = threadRandom();
+        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - epoch_);
+
+        auto wait = [&](std::chrono::microseconds latency) {
+            if (latency > timeout) {
+                std::this_thread::sleep_for(timeout);
+                fail("таймаут клиента");
+            }
+            std::this_thread::sleep_for(latency);
+        };
+
+        double slowdown = 1.0;
+        for (const auto& window : windows_) {
+            if (now < window.from || now >= window.to) {
+                continue;
+            }
+            if (window.mode == FaultMode::Down) {
+                fail("недоступен");
+            }
+            if (window.mode == FaultMode::Hang) {
+                wait(window.hang);
+                fail("таймаут");
+            }
+            slowdown *= window.slowdown;
+        }
+
+        auto latency = latency_.sample(random);
+        wait(std::chrono::microseconds(static_cast<int64_t>(static_cast<double>(latency.count()) * slowdown)));
+        if (failureRate_ > 0 && std::uniform_real_distribution<double>(0.0, 1.0)(random) < failureRate_) {
+            fail("ошибка обработки");
+        }
+    }
+
+    const std::string& name() const { return name_; }
+    uint64_t calls() const { return calls_.load(std::memory_order_relaxed); }
+    uint64_t failures() const { return failures_.load(std::memory_order_relaxed); }
+
+private:
+    [[noreturn]] void fail(const char* reason) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        throw BackendError(name_ + ": " + reason);
+    }
+
+    std::string name_;
+    LatencyModel latency_;
+    double failureRate_;
+    std::chrono::steady_clock::time_point epoch_;
+    std::vector<FaultWindow> windows_;
+    std::atomic<uint64_t> calls_{0};
+    std::atomic<uint64_t> failures_{0};
+};
+
+} // namespace cpp_patterns::load